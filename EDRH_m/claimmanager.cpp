@@ -25,6 +25,8 @@ void ClaimManager::initialize(SupabaseClient *supabaseClient, const QString &com
         connect(m_supabaseClient, &SupabaseClient::takenSystemsReceived,
                 this, &ClaimManager::onTakenSystemsReceived);
         qDebug() << "CLAIMS COUNTER DEBUG: Connected to takenSystemsReceived signal";
+        connect(m_supabaseClient, &SupabaseClient::takenWriteQueued,
+                this, &ClaimManager::onTakenWriteQueued);
         
         // CRITICAL FIX: Force data refresh on initialization
         qDebug() << "CLAIMS COUNTER DEBUG: Forcing initial data refresh";
@@ -372,6 +374,17 @@ void ClaimManager::onTakenSystemsReceived(const QJsonArray &taken)
         
         m_takenSystemsData = taken;
         
+        // Updates still queued in the client are newer than this snapshot
+        if (m_supabaseClient) {
+            for (const QJsonValue &value : taken) {
+                const QString systemName = value.toObject().value("system").toString();
+                const QJsonObject pending = m_supabaseClient->pendingTakenWrite(systemName);
+                if (!pending.isEmpty()) {
+                    applyPendingFields(systemName, pending);
+                }
+            }
+        }
+        
         // Count claims for debugging
         int claimCount = 0;
         for (const QJsonValue &value : taken) {
@@ -409,6 +422,30 @@ void ClaimManager::onTakenSystemsReceived(const QJsonArray &taken)
     }
 }
 
+void ClaimManager::onTakenWriteQueued(const QString &systemName, const QJsonObject &fields)
+{
+    // Keep the local snapshot in step with writes the client has not sent yet
+    if (applyPendingFields(systemName, fields) && fields.contains("done")) {
+        emit systemDoneStatusChanged(systemName, fields.value("done").toBool());
+        queryCurrentClaim();
+    }
+}
+
+bool ClaimManager::applyPendingFields(const QString &systemName, const QJsonObject &fields)
+{
+    for (int i = 0; i < m_takenSystemsData.size(); ++i) {
+        QJsonObject system = m_takenSystemsData[i].toObject();
+        if (system["system"].toString() == systemName && system["by_cmdr"].toString() == m_commanderName) {
+            for (auto it = fields.constBegin(); it != fields.constEnd(); ++it) {
+                system.insert(it.key(), it.value());
+            }
+            m_takenSystemsData[i] = system;
+            return true;
+        }
+    }
+    return false;
+}
+
 void ClaimManager::logClaimOperation(const QString &operation, const QString &systemName, bool success)
 {
     qDebug() << QString("[CLAIM_LOG] %1: %2 - %3")
@@ -5,6 +5,7 @@
 #include <QString>
 #include <QDebug>
 #include <QJsonArray>
+#include <QJsonObject>
 #include <QHash>
 #include <QDateTime>
 
@@ -43,6 +44,7 @@ signals:
 private slots:
     void onDatabaseOperationComplete(const QString &operation, bool success, const QString &data);
     void onTakenSystemsReceived(const QJsonArray &taken);
+    void onTakenWriteQueued(const QString &systemName, const QJsonObject &fields);
 
 private:
     SupabaseClient *m_supabaseClient;
@@ -52,6 +54,7 @@ private:
     struct PendingOverride { bool claimed; qint64 expireAtMs; };
     QHash<QString, PendingOverride> m_pendingOverrides;
     void pruneExpiredOverrides();
+    bool applyPendingFields(const QString &systemName, const QJsonObject &fields);
     
     bool queryCurrentClaim();
     bool querySystemStatus(const QString &systemName, QString &claimedBy, bool &isDone);
@@ -0,0 +1,338 @@
+#include "coordinatestore.h"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <QThreadPool>
+#include <QVariantMap>
+#include <QtConcurrent>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+// SSE2 is part of every x86-64 CPU; AVX2 is compiled per function and picked at runtime,
+// so the binary still starts on machines without it
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define EDRH_DISTANCE_SIMD
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define EDRH_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define EDRH_TARGET_AVX2
+#endif
+
+namespace {
+// Writes the squared distance from (px, py, pz) to each of `count` coordinates into out
+using Kernel = void (*)(const double *xs, const double *ys, const double *zs, int count,
+                        double px, double py, double pz, double *out);
+
+// Below this many systems one core is done before the pool would have started
+const int PARALLEL_MIN_SYSTEMS = 200000;
+const int PARALLEL_MIN_CHUNK = 50000;
+// Distances are computed a block at a time so selection reads them back from L1
+const int BLOCK_SIZE = 512;
+
+// All kernels add (dx² + dy²) + dz² in the same order, so every path returns identical
+// values and rankings don't depend on the CPU. The scalar one is only the benchmark's
+// baseline when a SIMD kernel is available.
+[[maybe_unused]] void scalarKernel(const double *xs, const double *ys, const double *zs, int count,
+                  double px, double py, double pz, double *out)
+{
+    for (int i = 0; i < count; ++i) {
+        const double dx = xs[i] - px;
+        const double dy = ys[i] - py;
+        const double dz = zs[i] - pz;
+        out[i] = (dx * dx + dy * dy) + dz * dz;
+    }
+}
+
+#ifdef EDRH_DISTANCE_SIMD
+void sse2Kernel(const double *xs, const double *ys, const double *zs, int count,
+                double px, double py, double pz, double *out)
+{
+    const __m128d cx = _mm_set1_pd(px);
+    const __m128d cy = _mm_set1_pd(py);
+    const __m128d cz = _mm_set1_pd(pz);
+    int i = 0;
+    for (; i + 2 <= count; i += 2) {
+        const __m128d dx = _mm_sub_pd(_mm_loadu_pd(xs + i), cx);
+        const __m128d dy = _mm_sub_pd(_mm_loadu_pd(ys + i), cy);
+        const __m128d dz = _mm_sub_pd(_mm_loadu_pd(zs + i), cz);
+        const __m128d xy = _mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy));
+        _mm_storeu_pd(out + i, _mm_add_pd(xy, _mm_mul_pd(dz, dz)));
+    }
+    scalarKernel(xs + i, ys + i, zs + i, count - i, px, py, pz, out + i);
+}
+
+EDRH_TARGET_AVX2
+void avx2Kernel(const double *xs, const double *ys, const double *zs, int count,
+                double px, double py, double pz, double *out)
+{
+    const __m256d cx = _mm256_set1_pd(px);
+    const __m256d cy = _mm256_set1_pd(py);
+    const __m256d cz = _mm256_set1_pd(pz);
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m256d dx = _mm256_sub_pd(_mm256_loadu_pd(xs + i), cx);
+        const __m256d dy = _mm256_sub_pd(_mm256_loadu_pd(ys + i), cy);
+        const __m256d dz = _mm256_sub_pd(_mm256_loadu_pd(zs + i), cz);
+        const __m256d xy = _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy));
+        _mm256_storeu_pd(out + i, _mm256_add_pd(xy, _mm256_mul_pd(dz, dz)));
+    }
+    scalarKernel(xs + i, ys + i, zs + i, count - i, px, py, pz, out + i);
+}
+
+bool cpuHasAvx2()
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#elif defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+    // The OS must save the YMM registers across context switches
+    __cpuid(info, 1);
+    const bool osSavesAvx = (info[2] & (1 << 27)) && (info[2] & (1 << 28));
+    if (!osSavesAvx || (_xgetbv(0) & 0x6) != 0x6) {
+        return false;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return false;
+#endif
+}
+#endif
+
+Kernel bestKernel()
+{
+#ifdef EDRH_DISTANCE_SIMD
+    static const Kernel kernel = cpuHasAvx2() ? avx2Kernel : sse2Kernel;
+    return kernel;
+#else
+    return scalarKernel;
+#endif
+}
+
+int chunkCount(int count)
+{
+    if (count < PARALLEL_MIN_SYSTEMS) {
+        return 1;
+    }
+    const int threads = qMax(1, QThreadPool::globalInstance()->maxThreadCount());
+    return qBound(1, count / PARALLEL_MIN_CHUNK, threads);
+}
+
+// Calls function(begin, end, chunk) over `chunks` contiguous slices of [0, count), on the
+// global thread pool when there is more than one
+template <typename Function>
+void forEachChunk(int count, int chunks, Function function)
+{
+    if (chunks <= 1) {
+        function(0, count, 0);
+        return;
+    }
+    QVector<int> chunkIndices(chunks);
+    std::iota(chunkIndices.begin(), chunkIndices.end(), 0);
+    QtConcurrent::blockingMap(chunkIndices, [&](int chunk) {
+        const int begin = int(qint64(count) * chunk / chunks);
+        const int end = int(qint64(count) * (chunk + 1) / chunks);
+        function(begin, end, chunk);
+    });
+}
+}
+
+void CoordinateStore::clear()
+{
+    m_x.clear();
+    m_y.clear();
+    m_z.clear();
+}
+
+void CoordinateStore::reserve(int count)
+{
+    m_x.reserve(count);
+    m_y.reserve(count);
+    m_z.reserve(count);
+}
+
+void CoordinateStore::append(double x, double y, double z)
+{
+    m_x.append(x);
+    m_y.append(y);
+    m_z.append(z);
+}
+
+void CoordinateStore::assign(const SystemRecordList &systems)
+{
+    clear();
+    reserve(int(systems.size()));
+    for (const SystemRecord &system : systems) {
+        append(system.x, system.y, system.z);
+    }
+}
+
+QVector<CoordinateStore::Match> CoordinateStore::nearest(double x, double y, double z, int limit,
+                                                         double maxDistance, int *inRange) const
+{
+    if (inRange) {
+        *inRange = 0;
+    }
+    if (maxDistance < 0.0 || isEmpty()) {
+        return QVector<Match>();
+    }
+
+    // Overflows to infinity for "no limit", which is what the comparison wants
+    const double maxSquared = maxDistance * maxDistance;
+    const int keep = qMax(0, limit);
+    const int count = size();
+    const int chunks = chunkCount(count);
+    const Kernel kernel = bestKernel();
+
+    // Each chunk trims its candidates to the best `keep` as it goes, so memory stays
+    // proportional to the limit rather than the catalogue
+    QVector<QVector<QPair<double, int>>> candidates(chunks);
+    QVector<int> counts(chunks, 0);
+    QVector<QPair<double, int>> *candidateData = candidates.data();
+    int *countData = counts.data();
+    forEachChunk(count, chunks, [&](int begin, int end, int chunk) {
+        QVector<QPair<double, int>> &ranked = candidateData[chunk];
+        double block[BLOCK_SIZE];
+        int matched = 0;
+        for (int first = begin; first < end; first += BLOCK_SIZE) {
+            const int length = qMin(BLOCK_SIZE, end - first);
+            kernel(m_x.constData() + first, m_y.constData() + first, m_z.constData() + first,
+                   length, x, y, z, block);
+            for (int i = 0; i < length; ++i) {
+                if (block[i] <= maxSquared) {
+                    ++matched;
+                    if (keep > 0) {
+                        ranked.append(qMakePair(block[i], first + i));
+                    }
+                }
+            }
+            if (ranked.size() > 2 * keep + BLOCK_SIZE) {
+                std::nth_element(ranked.begin(), ranked.begin() + keep, ranked.end());
+                ranked.resize(keep);
+            }
+        }
+        countData[chunk] = matched;
+    });
+
+    QVector<QPair<double, int>> ranked;
+    int matched = 0;
+    for (int chunk = 0; chunk < chunks; ++chunk) {
+        matched += counts.at(chunk);
+        ranked += candidates.at(chunk);
+    }
+    if (inRange) {
+        *inRange = matched;
+    }
+
+    const int kept = qMin(keep, int(ranked.size()));
+    std::partial_sort(ranked.begin(), ranked.begin() + kept, ranked.end());
+
+    QVector<Match> matches;
+    matches.reserve(kept);
+    for (int i = 0; i < kept; ++i) {
+        matches.append({ ranked.at(i).second, std::sqrt(ranked.at(i).first) });
+    }
+    return matches;
+}
+
+QVector<int> CoordinateStore::inRegion(double minX, double maxX, double minZ, double maxZ) const
+{
+    QVector<int> indices;
+    const double *xs = m_x.constData();
+    const double *zs = m_z.constData();
+    for (int i = 0; i < size(); ++i) {
+        if (xs[i] >= minX && xs[i] <= maxX && zs[i] >= minZ && zs[i] <= maxZ) {
+            indices.append(i);
+        }
+    }
+    return indices;
+}
+
+const char *CoordinateStore::kernelName()
+{
+#ifdef EDRH_DISTANCE_SIMD
+    return bestKernel() == avx2Kernel ? "avx2" : "sse2";
+#else
+    return "scalar";
+#endif
+}
+
+#ifdef EDRH_BENCHMARKS
+QVariantList CoordinateStore::benchmark()
+{
+    QVariantList results;
+    QRandomGenerator random(25);
+    const Kernel kernel = bestKernel();
+
+    for (int count : { 10000, 100000, 1000000 }) {
+        // Spread over roughly the populated part of the galaxy
+        CoordinateStore store;
+        store.reserve(count);
+        for (int i = 0; i < count; ++i) {
+            store.append(random.generateDouble() * 90000.0 - 45000.0,
+                         random.generateDouble() * 6000.0 - 3000.0,
+                         random.generateDouble() * 90000.0 - 20000.0);
+        }
+
+        const double px = 25.2;
+        const double py = -20.9;
+        const double pz = 25899.9;
+        QVector<double> squared(count);
+        double *out = squared.data();
+        // Enough passes that the small sizes don't just measure the timer
+        const int rounds = qMax(5, 20000000 / count);
+
+        auto timeKernel = [&](Kernel candidate, int chunks) {
+            QElapsedTimer timer;
+            timer.start();
+            for (int round = 0; round < rounds; ++round) {
+                forEachChunk(count, chunks, [&](int begin, int end, int) {
+                    candidate(store.m_x.constData() + begin, store.m_y.constData() + begin,
+                              store.m_z.constData() + begin, end - begin, px, py, pz, out + begin);
+                });
+            }
+            return timer.nsecsElapsed() / 1e6 / rounds;
+        };
+
+        const int chunks = chunkCount(count);
+        const double scalarMs = timeKernel(scalarKernel, 1);
+        const double simdMs = timeKernel(kernel, 1);
+        const double threadedMs = timeKernel(kernel, chunks);
+
+        QElapsedTimer timer;
+        timer.start();
+        for (int round = 0; round < rounds; ++round) {
+            store.nearest(px, py, pz, 500, std::numeric_limits<double>::max());
+        }
+        const double nearestMs = timer.nsecsElapsed() / 1e6 / rounds;
+
+        qDebug() << "Distance kernel benchmark:" << count << "systems, scalar" << scalarMs << "ms,"
+                 << kernelName() << simdMs << "ms," << chunks << "thread(s)" << threadedMs
+                 << "ms, nearest 500" << nearestMs << "ms";
+
+        QVariantMap result;
+        result["systems"] = count;
+        result["kernel"] = QString::fromLatin1(kernelName());
+        result["threads"] = chunks;
+        result["scalarMs"] = scalarMs;
+        result["simdMs"] = simdMs;
+        result["threadedMs"] = threadedMs;
+        result["nearestMs"] = nearestMs;
+        results.append(result);
+    }
+    return results;
+}
+#endif
@@ -0,0 +1,49 @@
+#ifndef COORDINATESTORE_H
+#define COORDINATESTORE_H
+
+#include <QVector>
+#include <QVariantList>
+#include "systemrecord.h"
+
+// Galactic coordinates held as three parallel arrays so distance queries stream through
+// memory and handle several systems per SIMD instruction (AVX2 or SSE2, picked at runtime,
+// scalar elsewhere). Queries compare squared distances and only take the square root of
+// rows they return. Stores past a few hundred thousand systems are split across the
+// global thread pool.
+class CoordinateStore
+{
+public:
+    struct Match {
+        int index;          // Position in the store, i.e. in the list it was built from
+        double distance;    // LY
+    };
+
+    void clear();
+    void reserve(int count);
+    void append(double x, double y, double z);
+    void assign(const SystemRecordList &systems);
+
+    int size() const { return int(m_x.size()); }
+    bool isEmpty() const { return m_x.isEmpty(); }
+
+    // The `limit` closest entries within maxDistance, closest first. inRange receives the
+    // number of entries within maxDistance, kept or not.
+    QVector<Match> nearest(double x, double y, double z, int limit, double maxDistance,
+                           int *inRange = nullptr) const;
+    // Entries inside an x/z rectangle, in store order (galaxy map regions)
+    QVector<int> inRegion(double minX, double maxX, double minZ, double maxZ) const;
+
+    // Kernel this CPU runs: "avx2", "sse2" or "scalar"
+    static const char *kernelName();
+#ifdef EDRH_BENCHMARKS
+    // Times the scalar, SIMD and threaded kernels on random stores of 10k, 100k and 1M systems
+    static QVariantList benchmark();
+#endif
+
+private:
+    QVector<double> m_x;
+    QVector<double> m_y;
+    QVector<double> m_z;
+};
+
+#endif // COORDINATESTORE_H
@@ -4,6 +4,7 @@
 #include "journalmonitor.h"
 #include "configmanager.h"
 #include "claimmanager.h"
+#include "jumpstore.h"
 #include <QGuiApplication>
 #include <QClipboard>
 #include <QDateTime>
@@ -16,6 +17,8 @@
 #include <algorithm>
 #include <QUrl>
 #include <cmath>
+#include <limits>
+#include <QElapsedTimer>
 #include <QFileDialog>
 #include <QStandardPaths>
 #include <QDir>
@@ -35,6 +38,7 @@ EDRHController::EDRHController(QObject *parent)
     , m_currentSystem("Unknown")
     , m_selectedCategory("All Categories")
     , m_jumpCount(0)
+    , m_totalJumpCount(0)
     , m_sessionTime("00:00:00")
     , m_mapWindowActive(false)
 
@@ -47,6 +51,7 @@ EDRHController::EDRHController(QObject *parent)
     , m_hasValidPosition(false)
     , m_sessionTimer(new QTimer(this))
     , m_journalTimer(new QTimer(this))
+    , m_galaxyMapPageTimer(new QTimer(this))
     , m_sessionStartTime(QDateTime::currentMSecsSinceEpoch())
     , m_unclaimedIndex(0)
     , m_suppressMainAppNotifications(false)
@@ -54,9 +59,15 @@ EDRHController::EDRHController(QObject *parent)
     , m_forcedCommanderName("")
 
 {
+    // List models handed to QML; the QVariantLists above stay the working copies
+    m_nearestSystemsModel = new SystemListModel(this);
+    m_unclaimedSystemsModel = new SystemListModel(this);
+    m_galaxyMapSystemsModel = new SystemListModel(this);
+    
     // Initialize galaxy map data
     m_visibleSystemsCount = 0;
     m_galaxyMapLoading = false;
+    m_galaxyMapCoordinatesStale = true;
     m_commanderPosition = QVariantMap();
     m_galaxyMapFilters = QVariantMap();
     
@@ -64,9 +75,19 @@ EDRHController::EDRHController(QObject *parent)
     connect(m_sessionTimer, &QTimer::timeout, this, &EDRHController::updateSessionTime);
     connect(m_journalTimer, &QTimer::timeout, this, &EDRHController::processJournalUpdate);
     
+    // The map tabs redraw everything on galaxyMapSystemsChanged, so a paged load tells them
+    // at most twice a second; the model itself gets plain row inserts for every page
+    m_galaxyMapPageTimer->setSingleShot(true);
+    m_galaxyMapPageTimer->setInterval(500);
+    connect(m_galaxyMapPageTimer, &QTimer::timeout, this, &EDRHController::galaxyMapSystemsChanged);
+    
     // Start session timer (update every second)
     m_sessionTimer->start(1000);
     
+    // Lifetime jump count follows the jump store as journals are ingested
+    connect(&JumpStore::instance(), &JumpStore::updated,
+            this, &EDRHController::updateTotalJumpCount, Qt::QueuedConnection);
+    
     // Initialize data
     initializeData();
 }
@@ -79,8 +100,21 @@ void EDRHController::setSupabaseClient(SupabaseClient *client)
         // Connect Supabase signals to our slots
         connect(m_supabaseClient, &SupabaseClient::systemsReceived,
                 this, &EDRHController::handleSystemsReceived);
+        connect(m_supabaseClient, &SupabaseClient::systemsPageReceived,
+                this, &EDRHController::handleSystemsPageReceived);
         connect(m_supabaseClient, &SupabaseClient::nearestSystemsReceived,
                 this, &EDRHController::handleNearestSystemsReceived);
+        connect(m_supabaseClient, &SupabaseClient::systemsNearPrefetched,
+                this, &EDRHController::handleSystemsNearPrefetched);
+        connect(m_supabaseClient, &SupabaseClient::catalogueUpdated,
+                this, [this](const QStringList &changedTables) {
+                    // Rankings made from an older catalogue (or from server boxes) are redone
+                    if (changedTables.contains("systems") && !m_navRoute.isEmpty()) {
+                        m_routePrefetch.clear();
+                        m_routePrefetchPending.clear();
+                        prefetchRouteSystems();
+                    }
+                });
         connect(m_supabaseClient, &SupabaseClient::takenSystemsReceived,
                 this, &EDRHController::handleTakenSystemsReceived);
         connect(m_supabaseClient, &SupabaseClient::categoriesReceived,
@@ -113,6 +147,11 @@ void EDRHController::setSupabaseClient(SupabaseClient *client)
                         }
                         emit systemClaimed(systemName, success);
                         
+                        ClaimState state = m_claimIndex.value(systemName);
+                        state.claimed = true;
+                        state.claimedBy = m_commanderName;
+                        setClaimState(systemName, state);
+                        
                         emit systemUpdated();
                         // Refresh taken systems to update claim status immediately
                         m_supabaseClient->getTakenSystems();
@@ -144,6 +183,7 @@ void EDRHController::setSupabaseClient(SupabaseClient *client)
                         
                         // ALWAYS emit signal to QML for server confirmation (popup needs to know)
                         emit systemUnclaimed(systemName, success);
+                        removeClaimState(systemName);
                         
                         emit systemUpdated();
                         
@@ -199,20 +239,14 @@ void EDRHController::setSupabaseClient(SupabaseClient *client)
                         if (!m_suppressMainAppNotifications) {
                             emit showMessage("Status Updated", QString("System status updated for %1").arg(systemName));
                         }
-                        // CRITICAL FIX: Update both caches immediately to fix claim detection
-                        // Update main cache
-                        for (int i = 0; i < m_allTakenSystemsData.size(); ++i) {
-                            QJsonObject takenSystem = m_allTakenSystemsData[i].toObject();
-                            if (takenSystem.value("system").toString() == systemName) {
-                                takenSystem["done"] = true;  // Mark as done in local cache
-                                m_allTakenSystemsData[i] = takenSystem;  // Update the array element
-                                qDebug() << "CACHE FIX: Updated main cache for" << systemName << "to done=true";
-                                break;
-                            }
+                        // Mark done in the claim index right away so claim detection is current
+                        auto claim = m_claimIndex.find(systemName);
+                        if (claim != m_claimIndex.end() && !claim->done) {
+                            ClaimState state = claim.value();
+                            state.done = true;
+                            setClaimState(systemName, state);
                         }
                         
-                        // Session cache removed - keeping only main cache update for simplicity
-                        
                         // Refresh data to show updated status
                         emit systemUpdated();
                         if (m_supabaseClient) {
@@ -227,6 +261,21 @@ void EDRHController::setSupabaseClient(SupabaseClient *client)
                 });
         connect(m_supabaseClient, &SupabaseClient::networkError,
                 this, &EDRHController::handleSupabaseError);
+        connect(m_supabaseClient, &SupabaseClient::offlineModeChanged,
+                this, [this](bool offline) {
+                    if (offline) {
+                        emit showMessage("Working Offline", "Database unreachable - using local data, changes are saved and sent when it is back");
+                    }
+                });
+        connect(m_supabaseClient, &SupabaseClient::offlineMutationConflict,
+                this, [this](const QString &systemName, const QString &operation, const QString &reason) {
+                    emit showError("Offline Change Not Applied", QString("%1 (%2): %3").arg(systemName, operation, reason));
+                });
+        connect(m_supabaseClient, &SupabaseClient::offlineReplayFinished,
+                this, [this](int applied, int conflicts) {
+                    emit showMessage("Back Online", QString("Sent %1 offline changes, %2 conflicts").arg(applied).arg(conflicts));
+                    emit systemUpdated();
+                });
         
         // TODO: Connect image upload completion signal when SupabaseClient implements it
         // connect(m_supabaseClient, &SupabaseClient::imageUploadCompleted,
@@ -337,9 +386,9 @@ void EDRHController::setJournalMonitor(JournalMonitor *monitor)
                         m_supabaseClient->updateCommanderLocation(m_commanderName, m_commanderX, m_commanderY, m_commanderZ, system);
                     }
                     
-                    // Force refresh nearest systems with new position
+                    // Re-rank nearest systems around the updated coordinates
                     qDebug() << "FORCE CMDR POSITION FIX: Refreshing nearest systems with updated coordinates";
-                    updateNearestSystems();
+                    refreshNearestForPosition();
                     updateUnclaimedSystems();
                     
                     emit commanderPositionChanged();
@@ -354,6 +403,9 @@ void EDRHController::setJournalMonitor(JournalMonitor *monitor)
                 this, [this](const QString &system, const QJsonObject &jumpData) {
                     setCurrentSystem(system);
                     
+                    // Arriving at a route waypoint: show the list ranked before we got here
+                    const bool prefetched = applyPrefetchedSystems(system);
+                    
                     // Extract coordinates from jump data for distance calculations
                     if (jumpData.contains("StarPos")) {
                         QJsonArray starPos = jumpData.value("StarPos").toArray();
@@ -379,10 +431,13 @@ void EDRHController::setJournalMonitor(JournalMonitor *monitor)
                         } else if (isCommanderSwitch) {
                             qDebug() << "Commander switch detected - updating distances from new position:" << m_commanderX << m_commanderY << m_commanderZ;
                         } else {
-                            qDebug() << "Position updated from FSD jump, fetching fresh systems with updated distance calculations";
+                            qDebug() << "Position updated from FSD jump, re-ranking systems around the new position";
+                        }
+                        // Coordinates don't change between jumps: re-rank locally, fetch only without a catalogue.
+                        // A prefetched waypoint list is already that ranking.
+                        if (!prefetched) {
+                            refreshNearestForPosition();
                         }
-                        // Use updateNearestSystems to get fresh data with correct distances from new position
-                        updateNearestSystems();
                     } else {
                         qDebug() << "Skipping distance recalculation during journal initialization";
                     }
@@ -410,6 +465,7 @@ void EDRHController::setJournalMonitor(JournalMonitor *monitor)
         connect(m_journalMonitor, &JournalMonitor::carrierJumpDetected,
                 this, [this](const QString &system, const QJsonObject &jumpData) {
                     setCurrentSystem(system);
+                    const bool prefetched = applyPrefetchedSystems(system);
                     
                     // Extract coordinates from jump data for distance calculations
                     if (jumpData.contains("StarPos")) {
@@ -433,10 +489,13 @@ void EDRHController::setJournalMonitor(JournalMonitor *monitor)
                                 if (isCommanderSwitch) {
                                     qDebug() << "Commander switch detected - updating distances from carrier position:" << m_commanderX << m_commanderY << m_commanderZ;
                                 } else {
-                                    qDebug() << "Position updated from carrier jump, fetching fresh systems with updated distance calculations";
+                                    qDebug() << "Position updated from carrier jump, re-ranking systems around the new position";
+                                }
+                                // Coordinates don't change between jumps: re-rank locally, fetch only without a catalogue.
+                                // A prefetched waypoint list is already that ranking.
+                                if (!prefetched) {
+                                    refreshNearestForPosition();
                                 }
-                                // Use updateNearestSystems to get fresh data with correct distances from new position
-                                updateNearestSystems();
                             } else {
                                 qDebug() << "Skipping distance recalculation during journal initialization";
                             }
@@ -461,6 +520,16 @@ void EDRHController::setJournalMonitor(JournalMonitor *monitor)
                     }
                 });
         
+        // Plotted route: rank nearest systems for every waypoint ahead of arrival
+        connect(m_journalMonitor, &JournalMonitor::navRouteChanged,
+                this, [this]() {
+                    m_navRoute = m_journalMonitor->navRoute();
+                    emit navRouteChanged();
+                    prefetchRouteSystems();
+                });
+        m_navRoute = m_journalMonitor->navRoute();
+        emit navRouteChanged();
+        
         qDebug() << "EDRHController connected to JournalMonitor";
         
         // Start session jump tracking after allowing journal initialization to complete
@@ -551,6 +620,7 @@ void EDRHController::setCommanderName(const QString &name)
     if (m_commanderName != actualCommander) {
         m_commanderName = actualCommander;
         emit commanderNameChanged();
+        updateTotalJumpCount();
         
         // Update SupabaseClient commander context for all database operations
         if (m_supabaseClient && !actualCommander.isEmpty() && actualCommander != "Unknown") {
@@ -637,6 +707,9 @@ void EDRHController::refreshData()
             m_supabaseClient->resetAuthFailures();
         }
         
+        // A manual refresh picks up images uploaded by others since we last asked
+        m_imagesRequested.clear();
+        
         // Load real data from Supabase - use updateNearestSystems to maintain distance sorting
         updateNearestSystems(); // This intelligently chooses between getSystems and getSystemsNear
         m_supabaseClient->getTakenSystems();
@@ -791,15 +864,8 @@ void EDRHController::viewSystem(const QString &systemName)
     // Note: System name copying is available by clicking the system name text
     // No automatic copying when viewing system details
     
-    // Find the system data in our nearest systems list
-    QVariantMap systemData;
-    for (const QVariant &systemVariant : m_nearestSystems) {
-        QVariantMap system = systemVariant.toMap();
-        if (system.value("name").toString() == systemName) {
-            systemData = system;
-            break;
-        }
-    }
+    // Find the system data in our nearest systems list (with its distance text)
+    QVariantMap systemData = m_nearestSystemsModel->get(m_nearestSystemsModel->indexOf(systemName));
     
     // If not found in nearest systems, try to get data from database
     if (systemData.isEmpty()) {
@@ -1171,7 +1237,7 @@ void EDRHController::markSystemAsPOI(const QString &systemName, const QString &p
     if (updated) {
         m_poiSystemStatus[systemName] = poiType;
         qDebug() << "Optimistic POI set for" << systemName << ":" << poiType;
-        emit nearestSystemsChanged();
+        updateNearestSystem(systemName, {{"poi", poiType}, {"potential_or_poi", poiType}});
     }
 }
 
@@ -1283,7 +1349,7 @@ void EDRHController::removePOIStatus(const QString &systemName)
     if (changed) {
         m_poiSystemStatus.remove(systemName);
         qDebug() << "Optimistic POI cleared for" << systemName;
-        emit nearestSystemsChanged();
+        updateNearestSystem(systemName, {{"poi", QString()}, {"potential_or_poi", QString()}});
     }
 }
 
@@ -1468,8 +1534,8 @@ void EDRHController::updateNearestSystems()
     // Use distance-based queries when we have valid commander position
     if (m_hasValidPosition) {
         qDebug() << "Using commander position for distance-based system sorting:" << m_commanderX << m_commanderY << m_commanderZ;
-        // Get nearby systems with distance calculation from current position (unlimited)
-        m_supabaseClient->getSystemsNear(m_commanderX, m_commanderY, m_commanderZ, 999999); // Effectively unlimited
+        // Only the neighbourhood is fetched - the server filters by a box that grows until it holds enough systems
+        m_supabaseClient->getSystemsNear(m_commanderX, m_commanderY, m_commanderZ, NEAREST_SYSTEMS_LIMIT);
     } else {
         qDebug() << "No valid commander position, fetching all systems without distance sorting";
         // Fallback to general systems list if no position available
@@ -1477,6 +1543,216 @@ void EDRHController::updateNearestSystems()
     }
 }
 
+void EDRHController::refreshNearestForPosition()
+{
+    // Without the local catalogue the known systems are only the last neighbourhood: show
+    // them re-ranked straight away, then let the server fill in the new one
+    const bool ranked = rerankNearestLocally();
+    if (!ranked || !m_supabaseClient || !m_supabaseClient->hasLocalCatalogue()) {
+        updateNearestSystems();
+    }
+}
+
+bool EDRHController::rerankNearestLocally()
+{
+    if (!m_hasValidPosition || !m_supabaseClient) {
+        return false;
+    }
+    
+    const bool catalogue = m_supabaseClient->hasLocalCatalogue();
+    const SystemRecordList &source = catalogue ? m_supabaseClient->catalogueSystems() : m_knownSystems;
+    const CoordinateStore &coordinates = catalogue ? m_supabaseClient->catalogueCoordinates() : m_knownCoordinates;
+    if (source.isEmpty()) {
+        return false;
+    }
+    
+    QElapsedTimer timer;
+    timer.start();
+    const SystemRecordList ranked = m_supabaseClient->rankSystemsNear(source, coordinates, m_commanderX, m_commanderY,
+                                                                      m_commanderZ, NEAREST_SYSTEMS_LIMIT,
+                                                                      std::numeric_limits<double>::max());
+    handleNearestSystemsReceived(ranked);
+    qDebug() << "Re-ranked" << ranked.size() << "of" << source.size() << "systems locally in" << timer.elapsed() << "ms";
+    return true;
+}
+
+void EDRHController::rememberSystemCoordinates(const SystemRecordList &systems)
+{
+    for (const SystemRecord &system : systems) {
+        if (system.name.isEmpty()) {
+            continue;
+        }
+        
+        auto existing = m_knownSystemIndex.constFind(system.name);
+        if (existing == m_knownSystemIndex.constEnd()) {
+            // Only the fields that never change; claim/POI/image state is joined at ranking time
+            SystemRecord known;
+            known.name = system.name;
+            known.categories = system.categories;
+            known.x = system.x;
+            known.y = system.y;
+            known.z = system.z;
+            m_knownSystemIndex.insert(system.name, m_knownSystems.size());
+            m_knownSystems.append(known);
+            m_knownCoordinates.append(known.x, known.y, known.z);
+            continue;
+        }
+        
+        QStringList &categories = m_knownSystems[existing.value()].categories;
+        for (const QString &category : system.categories) {
+            if (!categories.contains(category)) {
+                categories.append(category);
+            }
+        }
+    }
+}
+
+void EDRHController::rememberSystemCoordinates(const QJsonArray &systems)
+{
+    // Rows already transformed by SupabaseClient (name, category, x, y, z)
+    SystemRecordList records;
+    records.reserve(systems.size());
+    for (const QJsonValue &value : systems) {
+        const QJsonObject system = value.toObject();
+        SystemRecord record;
+        record.name = system.value("name").toString();
+        const QString category = system.value("category").toString();
+        if (!category.isEmpty()) {
+            record.categories.append(category);
+        }
+        record.x = system.value("x").toDouble();
+        record.y = system.value("y").toDouble();
+        record.z = system.value("z").toDouble();
+        records.append(record);
+    }
+    rememberSystemCoordinates(records);
+}
+
+void EDRHController::prefetchRouteSystems()
+{
+    if (m_navRoute.isEmpty() || !m_supabaseClient) {
+        m_routePrefetch.clear();
+        m_routePrefetchPending.clear();
+        return;
+    }
+    
+    // Waypoints already behind us are skipped
+    int start = 0;
+    for (int i = 0; i < m_navRoute.size(); ++i) {
+        if (m_navRoute[i].toMap().value("name").toString() == m_currentSystem) {
+            start = i + 1;
+            break;
+        }
+    }
+    
+    // Ranking the catalogue is cheap; server boxes are only requested a few jumps ahead
+    const bool catalogue = m_supabaseClient->hasLocalCatalogue();
+    const int end = qMin(int(m_navRoute.size()),
+                         start + (catalogue ? ROUTE_PREFETCH_WAYPOINTS : ROUTE_PREFETCH_REMOTE_WAYPOINTS));
+    
+    QSet<QString> ahead;
+    for (int i = start; i < end; ++i) {
+        ahead.insert(m_navRoute[i].toMap().value("name").toString());
+    }
+    for (auto it = m_routePrefetch.begin(); it != m_routePrefetch.end();) {
+        if (ahead.contains(it.key())) {
+            ++it;
+        } else {
+            it = m_routePrefetch.erase(it);
+        }
+    }
+    m_routePrefetchPending.intersect(ahead);
+    
+    int requested = 0;
+    for (int i = start; i < end; ++i) {
+        const QVariantMap waypoint = m_navRoute[i].toMap();
+        const QString name = waypoint.value("name").toString();
+        if (name.isEmpty() || m_routePrefetch.contains(name) || m_routePrefetchPending.contains(name)) {
+            continue;
+        }
+        
+        const double wx = waypoint.value("x").toDouble();
+        const double wy = waypoint.value("y").toDouble();
+        const double wz = waypoint.value("z").toDouble();
+        if (catalogue) {
+            m_routePrefetch.insert(name, m_supabaseClient->rankSystemsNear(
+                m_supabaseClient->catalogueSystems(), m_supabaseClient->catalogueCoordinates(),
+                wx, wy, wz, NEAREST_SYSTEMS_LIMIT, std::numeric_limits<double>::max()));
+        } else {
+            m_routePrefetchPending.insert(name);
+            m_supabaseClient->prefetchSystemsNear(name, wx, wy, wz, NEAREST_SYSTEMS_LIMIT);
+        }
+        ++requested;
+    }
+    
+    if (requested > 0) {
+        qDebug() << "Route prefetch:" << (catalogue ? "ranked" : "requested") << requested
+                 << "upcoming waypoints," << m_routePrefetch.size() << "ready";
+    }
+}
+
+void EDRHController::handleSystemsNearPrefetched(const QString &waypoint, const SystemRecordList &systems)
+{
+    // Dropped from the route (or already reached) while the box was on its way
+    if (!m_routePrefetchPending.remove(waypoint)) {
+        return;
+    }
+    rememberSystemCoordinates(systems);
+    m_routePrefetch.insert(waypoint, systems);
+}
+
+bool EDRHController::applyPrefetchedSystems(const QString &systemName)
+{
+    auto it = m_routePrefetch.find(systemName);
+    if (it == m_routePrefetch.end()) {
+        return false;
+    }
+    const SystemRecordList systems = it.value();
+    m_routePrefetch.erase(it);
+    
+    // Keep the next waypoints covered
+    prefetchRouteSystems();
+    
+    if (systems.isEmpty()) {
+        return false;
+    }
+    
+    // The ranking is ours; claim/POI/image state is joined as for any nearest list
+    qDebug() << "Route prefetch: showing" << systems.size() << "pre-ranked systems for" << systemName;
+    handleNearestSystemsReceived(systems);
+    return true;
+}
+
+void EDRHController::publishNearestSystems()
+{
+    if (m_nearestSystemsModel->setSystems(m_nearestSystems)) {
+        emit nearestSystemsChanged();
+    }
+}
+
+void EDRHController::publishUnclaimedSystems()
+{
+    if (m_unclaimedSystemsModel->setSystems(m_unclaimedSystems)) {
+        emit unclaimedSystemsChanged();
+    }
+}
+
+void EDRHController::publishGalaxyMapSystems()
+{
+    m_galaxyMapCoordinatesStale = true;
+    if (m_galaxyMapSystemsModel->setSystems(m_galaxyMapSystems)) {
+        emit galaxyMapSystemsChanged();
+    }
+}
+
+void EDRHController::updateNearestSystem(const QString &systemName, const QVariantMap &fields)
+{
+    // Caller has already patched m_nearestSystems; mirror the fields into the model row
+    if (m_nearestSystemsModel->updateSystem(systemName, fields)) {
+        emit nearestSystemsChanged();
+    }
+}
+
 void EDRHController::updateUnclaimedSystems()
 {
     QVariantList unclaimedSystems;
@@ -1492,31 +1768,17 @@ void EDRHController::updateUnclaimedSystems()
     }
     
     // Sort by distance (they should already be sorted, but make sure)
-    std::sort(unclaimedSystems.begin(), unclaimedSystems.end(), 
-              [](const QVariant &a, const QVariant &b) {
-                  QVariantMap systemA = a.toMap();
-                  QVariantMap systemB = b.toMap();
-                  
-                  // Extract numeric distance for comparison
-                  QString distA = systemA.value("distance").toString();
-                  QString distB = systemB.value("distance").toString();
-                  
-                  // Remove " LY" suffix and convert to double
-                  distA.remove(" LY");
-                  distB.remove(" LY");
-                  
-                  return distA.toDouble() < distB.toDouble();
-              });
+    unclaimedSystems = nearestRows(unclaimedSystems, unclaimedSystems.size());
     
     m_unclaimedSystems = unclaimedSystems;
-    emit unclaimedSystemsChanged();
+    publishUnclaimedSystems();
     emit unclaimedTotalChanged();
     emit currentUnclaimedSystemNameChanged();
     
     // Update nearest unclaimed display
     if (!unclaimedSystems.isEmpty() && m_unclaimedIndex < unclaimedSystems.size()) {
         QVariantMap nearest = unclaimedSystems[m_unclaimedIndex].toMap();
-        m_nearestDistanceText = nearest["distance"].toString();
+        m_nearestDistanceText = SystemListModel::formatDistance(nearest.value("distanceLy", -1.0).toDouble());
         m_nearestCategoryText = nearest["category"].toString();
         emit nearestDistanceTextChanged();
         emit nearestCategoryTextChanged();
@@ -1544,13 +1806,6 @@ void EDRHController::formatSessionTime()
     emit sessionTimeChanged();
 }
 
-void EDRHController::updateTotalJumpCount()
-{
-    // This function is deprecated - we now track session jumps only
-    // Session jumps are incremented directly in FSD/Carrier jump signal handlers
-    qDebug() << "updateTotalJumpCount() called but ignored - using session-only tracking";
-}
-
 // Placeholder implementations for database and file operations
 bool EDRHController::connectToDatabase()
 {
@@ -1614,112 +1869,129 @@ void EDRHController::updateCommanderLocation()
 }
 
 // Supabase response handlers
+QVariantMap EDRHController::buildSystemEntry(const QJsonObject &system)
+{
+    QVariantMap systemMap;
+    // Data is already transformed in SupabaseClient, so use 'name' not 'systems'
+    systemMap["name"] = system.value("name").toString();
+    
+    // Parse and format categories for multi-category support
+    QString rawCategory = system.value("category").toString();
+    QStringList categoryList = parseCategories(rawCategory);
+    systemMap["category"] = formatCategoriesForDisplay(categoryList);
+    systemMap["categoryList"] = QVariant::fromValue(categoryList); // Store raw list for filtering
+    systemMap["categoryColor"] = getCategoryColorForMulti(categoryList);
+    
+    // Calculate distance from current position if we have valid coordinates
+    double x = system.value("x").toDouble();
+    double y = system.value("y").toDouble();
+    double z = system.value("z").toDouble();
+    
+    if (m_hasValidPosition && x != 0.0 && y != 0.0 && z != 0.0) {
+        // Calculate distance from current commander position; formatted only when displayed
+        double dx = x - m_commanderX;
+        double dy = y - m_commanderY;
+        double dz = z - m_commanderZ;
+        systemMap["distanceLy"] = qSqrt(dx*dx + dy*dy + dz*dz);
+    } else {
+        // No position or coordinates available
+        systemMap["distanceLy"] = -1.0;
+    }
+    
+    systemMap["poi"] = system.value("poi").toString();
+    systemMap["done"] = system.value("done").toBool();
+    
+    // Determine claim status from the claim index
+    const ClaimState claim = m_claimIndex.value(systemMap["name"].toString());
+    systemMap["claimed"] = claim.claimed;
+    systemMap["claimedBy"] = claim.claimedBy;
+    systemMap["x"] = x;
+    systemMap["y"] = y;
+    systemMap["z"] = z;
+    return systemMap;
+}
+
+QVariantList EDRHController::nearestRows(const QVariantList &systems, int limit)
+{
+    // Pull each distance out of its map once, then only order the rows that will be kept
+    QVector<QPair<double, int>> ranked;
+    ranked.reserve(systems.size());
+    for (int i = 0; i < systems.size(); ++i) {
+        double distance = systems.at(i).toMap().value("distanceLy", -1.0).toDouble();
+        if (distance < 0.0) {
+            distance = std::numeric_limits<double>::infinity();
+        }
+        ranked.append(qMakePair(distance, i));
+    }
+    
+    const int keep = qBound(0, limit, int(ranked.size()));
+    std::partial_sort(ranked.begin(), ranked.begin() + keep, ranked.end());
+    
+    QVariantList nearest;
+    nearest.reserve(keep);
+    for (int i = 0; i < keep; ++i) {
+        nearest.append(systems.at(ranked.at(i).second));
+    }
+    return nearest;
+}
+
+void EDRHController::handleSystemsPageReceived(const QJsonArray &systems, int loaded, int total)
+{
+    ExceptionManager::instance().safeCatch("EDRHController::handleSystemsPageReceived", [&]() {
+    QVariantList rows;
+    rows.reserve(systems.size());
+    for (const QJsonValue &value : systems) {
+        rows.append(buildSystemEntry(value.toObject()));
+    }
+    rememberSystemCoordinates(systems);
+    
+    // The first page of a load replaces whatever an earlier load left behind
+    const bool firstPage = loaded == systems.size();
+    if (firstPage) {
+        m_galaxyMapSystems.clear();
+        m_galaxyMapSystemsModel->clear();
+    }
+    
+    // Only the new page reaches the model, as row inserts
+    m_galaxyMapSystems += rows;
+    m_galaxyMapSystemsModel->appendSystems(rows);
+    m_galaxyMapCoordinatesStale = true;
+    m_visibleSystemsCount = m_galaxyMapSystems.size();
+    emit visibleSystemsCountChanged();
+    if (!m_galaxyMapPageTimer->isActive()) {
+        m_galaxyMapPageTimer->start();
+    }
+    
+    // The nearest of everything so far are among the previous nearest and this page
+    if (m_hasValidPosition) {
+        m_nearestSystems = nearestRows(firstPage ? rows : m_nearestSystems + rows, NEAREST_SYSTEMS_LIMIT);
+        publishNearestSystems();
+    }
+    
+    qDebug() << "Galaxy map: loaded" << loaded << "of" << total << "systems so far";
+    });
+}
+
 void EDRHController::handleSystemsReceived(const QJsonArray &systems)
 {
     ExceptionManager::instance().safeCatch("EDRHController::handleSystemsReceived", [&]() {
         qDebug() << "Received" << systems.size() << "systems from Supabase";
+    rememberSystemCoordinates(systems);
     
     QVariantList systemsList;
+    systemsList.reserve(systems.size());
     for (const QJsonValue &value : systems) {
-        QJsonObject system = value.toObject();
-        
-        QVariantMap systemMap;
-        // Data is already transformed in SupabaseClient, so use 'name' not 'systems'
-        systemMap["name"] = system.value("name").toString();
-        
-        // Parse and format categories for multi-category support
-        QString rawCategory = system.value("category").toString();
-        QStringList categoryList = parseCategories(rawCategory);
-        systemMap["category"] = formatCategoriesForDisplay(categoryList);
-        systemMap["categoryList"] = QVariant::fromValue(categoryList); // Store raw list for filtering
-        systemMap["categoryColor"] = getCategoryColorForMulti(categoryList);
-        
-        // Calculate distance from current position if we have valid coordinates
-        double x = system.value("x").toDouble();
-        double y = system.value("y").toDouble();
-        double z = system.value("z").toDouble();
-        
-        if (m_hasValidPosition && x != 0.0 && y != 0.0 && z != 0.0) {
-            // Calculate distance from current commander position
-            double dx = x - m_commanderX;
-            double dy = y - m_commanderY;
-            double dz = z - m_commanderZ;
-            double distance = qSqrt(dx*dx + dy*dy + dz*dz);
-            systemMap["distance"] = QString::number(distance, 'f', 1) + " LY";
-        } else {
-            // No position or coordinates available
-            systemMap["distance"] = "N/A";
-        }
-        
-        systemMap["poi"] = system.value("poi").toString();
-        systemMap["done"] = system.value("done").toBool();
-        
-        // Determine claim status based on taken systems data
-        QString systemName = systemMap["name"].toString();
-        bool isClaimed = m_takenSystems.contains(systemName);
-        QString claimedBy = "";
-        
-        if (isClaimed) {
-            // Find who claimed this system from the taken systems data
-            for (const QJsonValue &takenValue : m_allTakenSystemsData) {
-                QJsonObject takenSystem = takenValue.toObject();
-                if (takenSystem.value("system").toString() == systemName) {
-                    claimedBy = takenSystem.value("by_cmdr").toString();  // Fixed: use correct field name
-                    if (claimedBy.compare("empty", Qt::CaseInsensitive) == 0) {
-                        // Normalize placeholder to unclaimed
-                        isClaimed = false;
-                        claimedBy.clear();
-                    }
-                    break;
-                }
-            }
-        }
-        
-        systemMap["claimed"] = isClaimed;
-        systemMap["claimedBy"] = claimedBy;
-        systemMap["x"] = x;
-        systemMap["y"] = y;
-        systemMap["z"] = z;
-        
-        systemsList.append(systemMap);
+        systemsList.append(buildSystemEntry(value.toObject()));
     }
     
-    // Sort by distance when we have position data
-    if (m_hasValidPosition) {
-        std::sort(systemsList.begin(), systemsList.end(), [](const QVariant &a, const QVariant &b) {
-            QVariantMap systemA = a.toMap();
-            QVariantMap systemB = b.toMap();
-            
-            QString distanceStrA = systemA.value("distance").toString();
-            QString distanceStrB = systemB.value("distance").toString();
-            
-            // Handle N/A distances
-            if (distanceStrA == "N/A") return false;
-            if (distanceStrB == "N/A") return true;
-            
-            // Extract numeric values from distance strings
-            distanceStrA.replace(" LY", "").replace("LY", "").replace(",", "");
-            distanceStrB.replace(" LY", "").replace("LY", "").replace(",", "");
-            
-            bool okA, okB;
-            double distanceA = distanceStrA.toDouble(&okA);
-            double distanceB = distanceStrB.toDouble(&okB);
-            
-            if (!okA && !okB) return false;
-            if (!okA) return false;
-            if (!okB) return true;
-            
-            return distanceA < distanceB;
-        });
-    }
-    
-    m_nearestSystems = systemsList;
-    emit nearestSystemsChanged();
+    // Keep the closest rows when we have position data; the galaxy map gets them all
+    m_nearestSystems = m_hasValidPosition ? nearestRows(systemsList, NEAREST_SYSTEMS_LIMIT) : systemsList;
+    publishNearestSystems();
     
     // Also update galaxy map systems with the real database data
     m_galaxyMapSystems = systemsList;
     m_visibleSystemsCount = systemsList.size();
-    emit galaxyMapSystemsChanged();
+    publishGalaxyMapSystems();
     emit visibleSystemsCountChanged();
     
     // Set loading to false now that we have data
@@ -1732,17 +2004,38 @@ void EDRHController::handleSystemsReceived(const QJsonArray &systems)
     });
 }
 
-void EDRHController::handleNearestSystemsReceived(const QJsonArray &systems)
+QVariantMap EDRHController::systemRecordToVariant(const SystemRecord &record)
+{
+    QVariantMap systemMap;
+    systemMap["name"] = record.name;
+    systemMap["categoryList"] = record.categories;
+    systemMap["category"] = formatCategoriesForDisplay(record.categories);
+    systemMap["categoryColor"] = getCategoryColorForMulti(record.categories);
+    systemMap["distanceLy"] = record.distance;
+    systemMap["poi"] = record.poi;
+    systemMap["done"] = record.done;
+    systemMap["claimed"] = record.claimed;
+    systemMap["claimedBy"] = record.claimedBy;
+    if (!record.images.isEmpty()) {
+        systemMap["images"] = record.images;
+    }
+    
+    // Store coordinates for popup display
+    systemMap["x"] = record.x;
+    systemMap["y"] = record.y;
+    systemMap["z"] = record.z;
+    return systemMap;
+}
+
+void EDRHController::handleNearestSystemsReceived(const SystemRecordList &systems)
 {
     ExceptionManager::instance().safeCatch("EDRHController::handleNearestSystemsReceived", [&]() {
         qDebug() << "Received" << systems.size() << "systems from Supabase";
+    rememberSystemCoordinates(systems);
     
-    // Step 1: Group systems by name and combine categories
-    QMap<QString, QVariantMap> systemsMap;
-
     // Preserve important per-system UI state across refreshes to avoid "forgetting"
     // images/POI/claim badges while other async feeds (POI, taken, images) arrive.
-    QMap<QString, QVariantMap> previousByName;
+    QHash<QString, QVariantMap> previousByName;
     for (const QVariant &item : m_nearestSystems) {
         const QVariantMap prev = item.toMap();
         const QString prevName = prev.value("name").toString();
@@ -1751,179 +2044,105 @@ void EDRHController::handleNearestSystemsReceived(const QJsonArray &systems)
         }
     }
     
-    for (const QJsonValue &value : systems) {
-        QJsonObject system = value.toObject();
-        QString systemName = system.value("name").toString();
-        
-        if (systemName.isEmpty()) continue;
+    // Step 1: Group systems by name and combine categories (rows arrive one per category)
+    SystemRecordList merged;
+    merged.reserve(systems.size());
+    QHash<QString, int> indexByName;
+    for (const SystemRecord &system : systems) {
+        if (system.name.isEmpty()) continue;
         
-        // Parse this system's category
-        QString rawCategory = system.value("category").toString();
-        
-        if (systemsMap.contains(systemName)) {
+        auto existing = indexByName.constFind(system.name);
+        if (existing != indexByName.constEnd()) {
             // System already exists, add category to existing entry
-            QVariantMap existingSystem = systemsMap[systemName];
-            QStringList existingCategories = existingSystem["categoryList"].toStringList();
-            
-            // Add new category if not already present
-            if (!rawCategory.isEmpty() && !existingCategories.contains(rawCategory)) {
-                existingCategories.append(rawCategory);
-                existingSystem["categoryList"] = existingCategories;
-                
-                // Update display category
-                existingSystem["category"] = formatCategoriesForDisplay(existingCategories);
-                existingSystem["categoryColor"] = getCategoryColorForMulti(existingCategories);
-                
-                systemsMap[systemName] = existingSystem;
-                // Debug: Combined categories for system
-            }
-        } else {
-            // New system, create entry
-            QVariantMap systemMap;
-            systemMap["name"] = systemName;
-            
-            // Initialize category list
-            QStringList categoryList;
-            if (!rawCategory.isEmpty()) {
-                categoryList.append(rawCategory);
-            }
-            systemMap["categoryList"] = categoryList;
-            systemMap["category"] = formatCategoriesForDisplay(categoryList);
-            systemMap["categoryColor"] = getCategoryColorForMulti(categoryList);
-            
-            // CRITICAL FIX: Only use cached distance if no fresh calculation exists
-            if (!systemMap.contains("distance") || systemMap["distance"].toString().isEmpty()) {
-                systemMap["distance"] = system.value("distance").toString();
-            }
-            
-            // Get POI status from loaded POI data instead of hardcoding
-            QString poiStatus = "";
-            
-            // Check if this system is in the detailed POI systems data
-            for (const QString &poiSystemName : m_poiSystems) {
-                if (poiSystemName == systemName) {
-                    qDebug() << "System" << systemName << "found in POI systems, determining actual status...";
-                    
-                    // Try to determine the actual POI type from available data
-                    // We need to check the system category or other indicators
-                    
-                    // Get the actual POI status from our stored map
-                    if (m_poiSystemStatus.contains(systemName)) {
-                        poiStatus = m_poiSystemStatus[systemName];
-                        qDebug() << "Found actual POI status for" << systemName << ":" << poiStatus;
-                    } else {
-                        // Fallback if not found in map
-                        poiStatus = "POI";
-                        qDebug() << "No POI status found for" << systemName << ", defaulting to POI";
-                    }
-                    
-                    qDebug() << "Set POI status for" << systemName << "to:" << poiStatus;
-                    break;
-                }
-            }
-            
-            // Additional fallback logic
-            if (poiStatus.isEmpty()) {
-                if (rawCategory.contains("Potential POI", Qt::CaseInsensitive)) {
-                    poiStatus = "Potential POI";
-                }
-            }
-            
-            // If we still do not have a POI status, preserve the previous one (avoids flicker)
-            if (poiStatus.isEmpty() && previousByName.contains(systemName)) {
-                const QVariantMap prev = previousByName.value(systemName);
-                const QString prevPoi = prev.value("poi").toString();
-                if (!prevPoi.isEmpty()) poiStatus = prevPoi;
-            }
-            systemMap["poi"] = poiStatus;
-            
-            // Determine claim status and done status based on complete taken systems data
-            bool isClaimed = false;
-            bool isDone = false;
-            QString claimedBy = "";
-            for (const QJsonValue &takenValue : m_allTakenSystemsData) {
-                const QJsonObject takenSystem = takenValue.toObject();
-                if (takenSystem.value("system").toString() == systemName) {
-                    isClaimed = true;
-                    claimedBy = takenSystem.value("by_cmdr").toString();
-                    isDone = takenSystem.value("done").toBool();
-                    if (claimedBy.compare("empty", Qt::CaseInsensitive) == 0) {
-                        isClaimed = false;
-                        claimedBy.clear();
-                    }
-                    break;
-                }
-            }
-            
-            systemMap["done"] = isDone;
-            
-            systemMap["claimed"] = isClaimed;
-            systemMap["claimedBy"] = claimedBy;
-
-            // Preserve uploaded/preset image URL if we already had it from a prior bulk load
-            if (previousByName.contains(systemName)) {
-                const QVariantMap prev = previousByName.value(systemName);
-                const QString prevImages = prev.value("images").toString();
-                if (!prevImages.isEmpty()) {
-                    systemMap["images"] = prevImages;
+            QStringList &existingCategories = merged[existing.value()].categories;
+            for (const QString &category : system.categories) {
+                if (!existingCategories.contains(category)) {
+                    existingCategories.append(category);
                 }
             }
-            
-            // Store coordinates for popup display
-            systemMap["x"] = system.value("x").toDouble();
-            systemMap["y"] = system.value("y").toDouble();
-            systemMap["z"] = system.value("z").toDouble();
-            
-            systemsMap[systemName] = systemMap;
+            continue;
         }
-    }
-    
-    // Step 2: Convert map back to list for UI
-    QVariantList systemsList;
-    for (auto it = systemsMap.begin(); it != systemsMap.end(); ++it) {
-        systemsList.append(it.value());
-    }
-    
-    // Step 3: Sort systems by distance (closest first)
-    std::sort(systemsList.begin(), systemsList.end(), [](const QVariant &a, const QVariant &b) {
-        QVariantMap systemA = a.toMap();
-        QVariantMap systemB = b.toMap();
         
-        QString distanceStrA = systemA.value("distance").toString();
-        QString distanceStrB = systemB.value("distance").toString();
+        indexByName.insert(system.name, merged.size());
+        merged.append(system);
+        SystemRecord &record = merged.last();
+        const QString rawCategory = record.categories.value(0);
         
-        // Extract numeric values from distance strings (remove "LY" suffix)
-        distanceStrA.replace(" LY", "").replace("LY", "").replace(",", "");
-        distanceStrB.replace(" LY", "").replace("LY", "").replace(",", "");
+        // Get POI status from loaded POI data instead of hardcoding
+        QString poiStatus = "";
+        if (m_poiSystems.contains(record.name)) {
+            // Get the actual POI status from our stored map, falling back to POI
+            poiStatus = m_poiSystemStatus.value(record.name, "POI");
+        }
         
-        bool okA, okB;
-        double distanceA = distanceStrA.toDouble(&okA);
-        double distanceB = distanceStrB.toDouble(&okB);
+        // Additional fallback logic
+        if (poiStatus.isEmpty()) {
+            if (rawCategory.contains("Potential POI", Qt::CaseInsensitive)) {
+                poiStatus = "Potential POI";
+            }
+        }
         
-        // If conversion failed, put those systems at the end
-        if (!okA && !okB) return false;
-        if (!okA) return false;
-        if (!okB) return true;
+        // If we still do not have a POI status, preserve the previous one (avoids flicker)
+        auto previous = previousByName.constFind(record.name);
+        if (poiStatus.isEmpty() && previous != previousByName.constEnd()) {
+            poiStatus = previous.value().value("poi").toString();
+        }
+        record.poi = poiStatus;
+        
+        // Determine claim status and done status from the claim index
+        const auto claim = m_claimIndex.constFind(record.name);
+        if (claim != m_claimIndex.constEnd()) {
+            record.claimed = claim->claimed;
+            record.claimedBy = claim->claimedBy;
+            record.done = claim->done;
+        }
         
-        return distanceA < distanceB;
+        // Preserve uploaded/preset image URL if we already had it from a prior bulk load
+        if (previous != previousByName.constEnd()) {
+            record.images = previous.value().value("images").toString();
+        } else {
+            record.images = m_systemImages.value(record.name);
+        }
+    }
+    
+    // Step 2: Order the closest systems (ties by name so refreshes don't shuffle rows)
+    const int keep = qMin(int(NEAREST_SYSTEMS_LIMIT), int(merged.size()));
+    std::partial_sort(merged.begin(), merged.begin() + keep, merged.end(),
+                      [](const SystemRecord &a, const SystemRecord &b) {
+        if (a.distance != b.distance) {
+            return a.distance < b.distance;
+        }
+        return a.name < b.name;
     });
+    merged.resize(keep);
+    
+    // Step 3: Convert for QML
+    QVariantList systemsList;
+    systemsList.reserve(merged.size());
+    for (const SystemRecord &record : std::as_const(merged)) {
+        systemsList.append(systemRecordToVariant(record));
+    }
     
     qDebug() << "Processed and combined" << systemsList.size() << "unique systems from" << systems.size() << "database entries";
     m_nearestSystems = systemsList;
-    emit nearestSystemsChanged();
+    publishNearestSystems();
     
-    // Load images for visible systems
+    // Load images for visible systems; images joined above are kept, so only systems that
+    // haven't been asked for yet cost a request (a jump usually brings none)
     if (!systemsList.isEmpty() && m_supabaseClient) {
         QStringList systemNames;
         // Get first 100 systems for image loading (to avoid overloading)
-        int count = qMin(100, systemsList.size());
+        int count = qMin(100, int(merged.size()));
         for (int i = 0; i < count; i++) {
-            QVariantMap system = systemsList[i].toMap();
-            systemNames.append(system["name"].toString());
+            const QString &name = merged.at(i).name;
+            if (!m_imagesRequested.contains(name)) {
+                m_imagesRequested.insert(name);
+                systemNames.append(name);
+            }
         }
         
         if (!systemNames.isEmpty()) {
-            qDebug() << "Loading images for" << systemNames.size() << "visible systems";
+            qDebug() << "Loading images for" << systemNames.size() << "newly visible systems";
             m_supabaseClient->loadSystemImagesForSystems(systemNames);
         }
     }
@@ -1931,11 +2150,14 @@ void EDRHController::handleNearestSystemsReceived(const QJsonArray &systems)
     // Update unclaimed systems based on the new nearest systems data
     updateUnclaimedSystems();
     
-    // CRITICAL FIX: Also populate galaxy map systems with the same data
-    m_galaxyMapSystems = systemsList;
-    m_visibleSystemsCount = systemsList.size();
-    emit galaxyMapSystemsChanged();
-    emit visibleSystemsCountChanged();
+    // CRITICAL FIX: Also populate galaxy map systems with the same data, but only to seed
+    // it - a re-rank on every jump must not replace the map with the 500 nearest rows
+    if (m_galaxyMapSystems.isEmpty() || m_galaxyMapLoading) {
+        m_galaxyMapSystems = systemsList;
+        m_visibleSystemsCount = systemsList.size();
+        publishGalaxyMapSystems();
+        emit visibleSystemsCountChanged();
+    }
     
     // Set loading to false now that we have data (for galaxy map)
     if (m_galaxyMapLoading) {
@@ -1943,6 +2165,11 @@ void EDRHController::handleNearestSystemsReceived(const QJsonArray &systems)
         emit galaxyMapLoadingChanged();
         qDebug() << "Galaxy map loading completed via handleNearestSystemsReceived - found" << systemsList.size() << "systems";
     }
+    
+    // A route plotted before the database was reachable can be prefetched now
+    if (!m_navRoute.isEmpty() && m_routePrefetch.isEmpty() && m_routePrefetchPending.isEmpty()) {
+        prefetchRouteSystems();
+    }
     });
 }
 
@@ -1955,23 +2182,13 @@ void EDRHController::handleTakenSystemsReceived(const QJsonArray &taken)
     if (taken.size() > 10) {  // Complete dataset has 396 systems, single queries have 0-1
         qDebug() << "Complete dataset detected - updating ClaimManager and UI";
         
-        // Store complete taken systems data for UI display ONLY
+        // Index the complete taken data for UI display ONLY
         // Actual claim management is handled by ClaimManager
-        m_allTakenSystemsData = taken;
+        rebuildClaimIndex(taken);
         
-        // Update nearest systems display to show claimed status
+        // Update nearest systems display to show claimed status; the model signals only
+        // the rows whose claim actually changed
         updateNearestSystemsWithClaimData();
-        
-        // Nudge cards to refresh claim badges without rebuilding list
-        // Gather the systems present to minimize work
-        QStringList names;
-        names.reserve(m_nearestSystems.size());
-        for (const QVariant &v : m_nearestSystems) {
-            const QVariantMap s = v.toMap();
-            const QString n = s.value("name").toString();
-            if (!n.isEmpty()) names.append(n);
-        }
-        if (!names.isEmpty()) emit systemImagesUpdated(names); // reuse lightweight signal
     } else {
         qDebug() << "Single-system query detected - skipping ClaimManager update to prevent data corruption";
         // SystemViewPopup will handle this data directly, don't corrupt ClaimManager's complete dataset
@@ -1980,39 +2197,78 @@ void EDRHController::handleTakenSystemsReceived(const QJsonArray &taken)
 
 void EDRHController::updateNearestSystemsWithClaimData()
 {
-    // Update the nearest systems list with claim data from m_allTakenSystemsData
+    // Update the nearest systems list with claim data from the claim index
     for (int i = 0; i < m_nearestSystems.size(); ++i) {
         QVariantMap system = m_nearestSystems[i].toMap();
-        QString systemName = system["name"].toString();
-        
-        // Find this system in taken data
-        bool isClaimed = false;
-        QString claimedBy;
-        bool isDone = false;
-        
-        for (const QJsonValue &value : m_allTakenSystemsData) {
-            QJsonObject takenSystem = value.toObject();
-            if (takenSystem["system"].toString() == systemName) {
-                isClaimed = true;
-                claimedBy = takenSystem["by_cmdr"].toString();
-                isDone = takenSystem["done"].toBool();
-                if (claimedBy.compare("empty", Qt::CaseInsensitive) == 0) {
-                    isClaimed = false;
-                    claimedBy.clear();
-                }
-                break;
-            }
-        }
+        const ClaimState claim = m_claimIndex.value(system["name"].toString());
         
         // Update system data
-        system["claimed"] = isClaimed;
-        system["claimedBy"] = claimedBy;
-        system["done"] = isDone;
+        system["claimed"] = claim.claimed;
+        system["claimedBy"] = claim.claimedBy;
+        system["done"] = claim.done;
         
         m_nearestSystems[i] = system;
     }
     
-    emit nearestSystemsChanged();
+    publishNearestSystems();
+}
+
+void EDRHController::rebuildClaimIndex(const QJsonArray &taken)
+{
+    m_claimIndex.clear();
+    m_claimIndex.reserve(taken.size());
+    for (const QJsonValue &value : taken) {
+        const QJsonObject takenSystem = value.toObject();
+        const QString systemName = takenSystem.value("system").toString();
+        if (systemName.isEmpty()) {
+            continue;
+        }
+        
+        ClaimState state;
+        state.claimedBy = takenSystem.value("by_cmdr").toString();
+        state.done = takenSystem.value("done").toBool();
+        state.claimed = true;
+        if (state.claimedBy.compare("empty", Qt::CaseInsensitive) == 0) {
+            // Normalize placeholder to unclaimed
+            state.claimed = false;
+            state.claimedBy.clear();
+        }
+        m_claimIndex.insert(systemName, state);
+    }
+    qDebug() << "Claim index rebuilt with" << m_claimIndex.size() << "systems";
+}
+
+void EDRHController::setClaimState(const QString &systemName, const ClaimState &state)
+{
+    m_claimIndex.insert(systemName, state);
+    applyClaimStateToRow(systemName);
+}
+
+void EDRHController::removeClaimState(const QString &systemName)
+{
+    if (m_claimIndex.remove(systemName) > 0) {
+        applyClaimStateToRow(systemName);
+    }
+}
+
+void EDRHController::applyClaimStateToRow(const QString &systemName)
+{
+    // The model rows mirror m_nearestSystems, so its name index finds the row without a scan
+    const int row = m_nearestSystemsModel->indexOf(systemName);
+    if (row < 0 || row >= m_nearestSystems.size()) {
+        return;
+    }
+    QVariantMap system = m_nearestSystems[row].toMap();
+    if (system.value("name").toString() != systemName) {
+        return;
+    }
+    
+    const ClaimState claim = m_claimIndex.value(systemName);
+    system["claimed"] = claim.claimed;
+    system["claimedBy"] = claim.claimedBy;
+    system["done"] = claim.done;
+    m_nearestSystems[row] = system;
+    updateNearestSystem(systemName, {{"claimed", claim.claimed}, {"claimedBy", claim.claimedBy}, {"done", claim.done}});
 }
 
 
@@ -2119,15 +2375,15 @@ void EDRHController::handlePOIDataForMerge(const QJsonArray &poiData)
     }
 
     if (systemsUpdated) {
-        qDebug() << "POI data merged, emitting nearestSystemsChanged signal";
+        qDebug() << "POI data merged, publishing the changed rows";
         
         // CRITICAL FIX: Also update galaxy map systems with the same POI data
         // since filtering uses galaxyMapSystems, not nearestSystems
         m_galaxyMapSystems = m_nearestSystems;
         m_visibleSystemsCount = m_nearestSystems.size();
         
-        emit nearestSystemsChanged();
-        emit galaxyMapSystemsChanged();
+        publishNearestSystems();
+        publishGalaxyMapSystems();
         emit visibleSystemsCountChanged();
         
         // Also update unclaimed systems since POI data affects them too
@@ -2154,6 +2410,16 @@ void EDRHController::handleSupabaseError(const QString &error)
     updateUnclaimedSystems();
 }
 
+void EDRHController::updateTotalJumpCount()
+{
+    const QString commander = m_commanderName == "Unknown" ? QString() : m_commanderName;
+    const int total = JumpStore::instance().totalJumps(commander);
+    if (m_totalJumpCount != total) {
+        m_totalJumpCount = total;
+        emit totalJumpCountChanged();
+    }
+}
+
 void EDRHController::handleCategoriesReceived(const QJsonArray &categories)
 {
     qDebug() << "Received" << categories.size() << "categories from Supabase";
@@ -2344,7 +2610,7 @@ void EDRHController::loadGalaxyMapData()
     
     // Clear existing data
     m_galaxyMapSystems.clear();
-    emit galaxyMapSystemsChanged(); // Emit to clear the QML side too
+    publishGalaxyMapSystems(); // Emit to clear the QML side too
     
     // Load all necessary data for galaxy map
     qDebug() << "Calling getSystems() for galaxy map...";
@@ -2363,7 +2629,7 @@ void EDRHController::loadGalaxyMapData()
         qDebug() << "Systems already loaded (" << m_nearestSystems.size() << "), using existing data for galaxy map";
         // Use existing data for galaxy map
         m_galaxyMapSystems = m_nearestSystems;
-        emit galaxyMapSystemsChanged();
+        publishGalaxyMapSystems();
         
         // Set loading to false since we have data
         m_galaxyMapLoading = false;
@@ -2417,7 +2683,7 @@ void EDRHController::updateGalaxyMapFilters(const QVariantMap &filters)
     m_galaxyMapSystems = filteredSystems;
     m_visibleSystemsCount = filteredSystems.size();
     
-    emit galaxyMapSystemsChanged();
+    publishGalaxyMapSystems();
     emit visibleSystemsCountChanged();
 }
 
@@ -2442,23 +2708,29 @@ void EDRHController::focusOnSystem(const QString &systemName)
 
 QVariantMap EDRHController::getSystemsInRegion(double minX, double maxX, double minZ, double maxZ)
 {
+    // Every change to m_galaxyMapSystems goes through publishGalaxyMapSystems(), which
+    // marks the coordinates stale; panning the map then only scans the arrays
+    if (m_galaxyMapCoordinatesStale) {
+        m_galaxyMapCoordinates.clear();
+        m_galaxyMapCoordinates.reserve(m_galaxyMapSystems.size());
+        for (const QVariant &system : std::as_const(m_galaxyMapSystems)) {
+            const QVariantMap systemMap = system.toMap();
+            m_galaxyMapCoordinates.append(systemMap.value("x").toDouble(), systemMap.value("y").toDouble(),
+                                          systemMap.value("z").toDouble());
+        }
+        m_galaxyMapCoordinatesStale = false;
+    }
+    
     QVariantMap result;
     QVariantList systemsInRegion;
-    int totalCount = 0;
-    
-    for (const auto &system : m_galaxyMapSystems) {
-        QVariantMap systemMap = system.toMap();
-        double x = systemMap["x"].toDouble();
-        double z = systemMap["z"].toDouble();
-        
-        if (x >= minX && x <= maxX && z >= minZ && z <= maxZ) {
-            systemsInRegion.append(systemMap);
-            totalCount++;
-        }
+    const QVector<int> indices = m_galaxyMapCoordinates.inRegion(minX, maxX, minZ, maxZ);
+    systemsInRegion.reserve(indices.size());
+    for (int index : indices) {
+        systemsInRegion.append(m_galaxyMapSystems.at(index));
     }
     
     result["systems"] = systemsInRegion;
-    result["count"] = totalCount;
+    result["count"] = int(indices.size());
     result["bounds"] = QVariantMap{
         {"minX", minX}, {"maxX", maxX},
         {"minZ", minZ}, {"maxZ", maxZ}
@@ -2478,7 +2750,7 @@ QString EDRHController::determineSystemType(const QVariantMap &systemData)
     }
     
     // Check if system is claimed by others
-    if (m_takenSystems.contains(systemName)) {
+    if (m_claimIndex.value(systemName).claimed) {
         return "othersClaims";
     }
     
@@ -2547,23 +2819,9 @@ bool EDRHController::isPotentialPOI(const QString &category)
 // Helper function to check if system is completed - SIMPLE AND RELIABLE
 bool EDRHController::isSystemCompleted(const QString &systemName) const
 {
-    qDebug() << "COMPLETION CHECK: Checking if system" << systemName << "is completed";
-    
-    // Simple, reliable check - just look through the current data
-    // If we can't find it or data is empty, assume not completed (safe default)
-    for (const auto &value : m_allTakenSystemsData) {
-        QJsonObject takenSystem = value.toObject();
-        QString system = takenSystem.value("system").toString();
-        
-        if (system == systemName) {
-            bool done = takenSystem.value("done").toBool();
-            qDebug() << "COMPLETION CHECK: Found" << systemName << "-> done:" << done;
-            return done;
-        }
-    }
-    
-    qDebug() << "COMPLETION CHECK:" << systemName << "not found -> not completed";
-    return false;  // Safe default: if we can't find it, assume not done
+    // If the system isn't in the claim index, assume not completed (safe default)
+    const auto claim = m_claimIndex.constFind(systemName);
+    return claim != m_claimIndex.constEnd() && claim->done;
 }
 
 void EDRHController::uploadImageToImgbb(const QString &filePath, const QString &systemName)
@@ -2603,15 +2861,7 @@ bool EDRHController::checkSystemVisitedInJournal(const QString &systemName) cons
         return false;
     }
     
-    // For now, return false as a placeholder. This function should
-    // check the journal monitor's visited systems data when that functionality
-    // is implemented in the JournalMonitor class.
-    // 
-    // Future implementation should call something like:
-    // return m_journalMonitor->isSystemVisited(systemName);
-    
-    qDebug() << "Journal visit check not yet implemented, returning false";
-    return false;
+    return m_journalMonitor->isSystemVisited(systemName, m_commanderName);
 }
 
 void EDRHController::saveSystemInformation(const QString &systemName, const QVariantMap &information)
@@ -2759,6 +3009,11 @@ void EDRHController::handleBulkSystemImagesLoaded(const QJsonObject &systemImage
 {
     qDebug() << "Received bulk system images for" << systemImages.size() << "systems";
     
+    // Remember every answer, including systems a re-rank has already moved off the list
+    for (auto it = systemImages.constBegin(); it != systemImages.constEnd(); ++it) {
+        m_systemImages[it.key()] = it.value().toString();
+    }
+    
     // Update nearest systems with image data
     bool updated = false;
     QStringList updatedSystems;
@@ -2768,19 +3023,16 @@ void EDRHController::handleBulkSystemImagesLoaded(const QJsonObject &systemImage
         
         if (systemImages.contains(systemName)) {
             system["images"] = systemImages[systemName].toString();
-            m_systemImages[systemName] = system["images"].toString();
             m_nearestSystems[i] = system;
+            // One dataChanged per row; the cards themselves stay alive
+            m_nearestSystemsModel->updateSystem(systemName, {{"images", system["images"]}});
             updated = true;
             updatedSystems.append(systemName);
         }
     }
     
     if (updated) {
-        qDebug() << "Updated system data with images - NOT emitting nearestSystemsChanged to preserve component state";
-        // CRITICAL FIX: Don't emit nearestSystemsChanged for image updates only
-        // This was causing SystemCard components to be destroyed/recreated, 
-        // which corrupted claim status and caused the 2-system bug
-        // Image updates are handled automatically by property bindings
+        qDebug() << "Updated image rows for" << updatedSystems.size() << "systems";
         emit systemImagesUpdated(updatedSystems);
     }
 }
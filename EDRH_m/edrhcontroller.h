@@ -6,6 +6,9 @@
 #include <QString>
 #include <QVariantList>
 #include <QVariantMap>
+#include <QHash>
+#include <QSet>
+#include <QVector>
 #include <QTimer>
 #include <QJsonArray>
 #include <QNetworkAccessManager>
@@ -17,6 +20,8 @@ class ClaimManager;
 
 // Include complete definition for use in Q_PROPERTY
 #include "supabaseclient.h"
+#include "systemlistmodel.h"
+#include "coordinatestore.h"
 
 class EDRHController : public QObject
 {
@@ -28,11 +33,12 @@ class EDRHController : public QObject
     Q_PROPERTY(QString currentSystem READ currentSystem WRITE setCurrentSystem NOTIFY currentSystemChanged)
     Q_PROPERTY(QString appVersion READ appVersion CONSTANT)
     Q_PROPERTY(bool isAdmin READ isAdmin NOTIFY isAdminChanged)
-    Q_PROPERTY(QVariantList nearestSystems READ nearestSystems NOTIFY nearestSystemsChanged)
-    Q_PROPERTY(QVariantList unclaimedSystems READ unclaimedSystems NOTIFY unclaimedSystemsChanged)
+    Q_PROPERTY(SystemListModel* nearestSystems READ nearestSystems CONSTANT)
+    Q_PROPERTY(SystemListModel* unclaimedSystems READ unclaimedSystems CONSTANT)
     Q_PROPERTY(QString selectedCategory READ selectedCategory WRITE setSelectedCategory NOTIFY selectedCategoryChanged)
     Q_PROPERTY(QVariantList availableCategories READ availableCategories NOTIFY availableCategoriesChanged)
     Q_PROPERTY(int jumpCount READ jumpCount NOTIFY jumpCountChanged)
+    Q_PROPERTY(int totalJumpCount READ totalJumpCount NOTIFY totalJumpCountChanged)
     Q_PROPERTY(QString sessionTime READ sessionTime NOTIFY sessionTimeChanged)
     Q_PROPERTY(bool mapWindowActive READ mapWindowActive NOTIFY mapWindowActiveChanged)
 
@@ -47,7 +53,7 @@ class EDRHController : public QObject
     Q_PROPERTY(ClaimManager* claimManager READ claimManager CONSTANT)
     
     // Galaxy Map Properties
-    Q_PROPERTY(QVariantList galaxyMapSystems READ galaxyMapSystems NOTIFY galaxyMapSystemsChanged)
+    Q_PROPERTY(SystemListModel* galaxyMapSystems READ galaxyMapSystems CONSTANT)
     Q_PROPERTY(QVariantMap commanderPosition READ commanderPosition NOTIFY commanderPositionChanged)
     Q_PROPERTY(int visibleSystemsCount READ visibleSystemsCount NOTIFY visibleSystemsCountChanged)
     Q_PROPERTY(bool galaxyMapLoading READ galaxyMapLoading NOTIFY galaxyMapLoadingChanged)
@@ -55,6 +61,7 @@ class EDRHController : public QObject
     Q_PROPERTY(double commanderX READ commanderX NOTIFY commanderPositionChanged)
     Q_PROPERTY(double commanderZ READ commanderZ NOTIFY commanderPositionChanged)
     Q_PROPERTY(QStringList allDetectedCommanders READ getAllDetectedCommanders NOTIFY allDetectedCommandersChanged)
+    Q_PROPERTY(QVariantList navRoute READ navRoute NOTIFY navRouteChanged)
     
 public:
     explicit EDRHController(QObject *parent = nullptr);
@@ -70,8 +77,8 @@ public:
     QString currentSystem() const { return m_currentSystem; }
     QString appVersion() const { return "0.9.5"; }
     bool isAdmin() const;
-    QVariantList nearestSystems() const { return m_nearestSystems; }
-    QVariantList unclaimedSystems() const { return m_unclaimedSystems; }
+    SystemListModel* nearestSystems() const { return m_nearestSystemsModel; }
+    SystemListModel* unclaimedSystems() const { return m_unclaimedSystemsModel; }
     QString selectedCategory() const { return m_selectedCategory; }
     QVariantList availableCategories() const { return m_availableCategories; }
     int jumpCount() const { return m_jumpCount; }
@@ -79,13 +86,15 @@ public:
     bool mapWindowActive() const { return m_mapWindowActive; }
     
     // Galaxy Map getters
-    QVariantList galaxyMapSystems() const { return m_galaxyMapSystems; }
+    SystemListModel* galaxyMapSystems() const { return m_galaxyMapSystemsModel; }
     QVariantMap commanderPosition() const { return m_commanderPosition; }
     int visibleSystemsCount() const { return m_visibleSystemsCount; }
     bool galaxyMapLoading() const { return m_galaxyMapLoading; }
     QVariantList allCommanderLocations() const { return m_allCommanderLocations; }
     double commanderX() const { return m_commanderX; }
     double commanderZ() const { return m_commanderZ; }
+    QVariantList navRoute() const { return m_navRoute; }
+    int totalJumpCount() const { return m_totalJumpCount; }
 
     QString nearestDistanceText() const { return m_nearestDistanceText; }
     QString nearestCategoryText() const { return m_nearestCategoryText; }
@@ -182,6 +191,7 @@ signals:
     void commanderNameChanged();
     void currentSystemChanged();
     void isAdminChanged();
+    // Emitted after the matching list model changed in any way (views bind to the model itself)
     void nearestSystemsChanged();
     void unclaimedSystemsChanged();
     void selectedCategoryChanged();
@@ -204,6 +214,8 @@ signals:
     void visibleSystemsCountChanged();
     void galaxyMapLoadingChanged();
     void allCommanderLocationsChanged();
+    void navRouteChanged();
+    void totalJumpCountChanged();
     
     // Action signals
     void showMessage(const QString &title, const QString &message);
@@ -239,7 +251,9 @@ private slots:
     
     // Supabase response handlers
     void handleSystemsReceived(const QJsonArray &systems);
-    void handleNearestSystemsReceived(const QJsonArray &systems);
+    void handleSystemsPageReceived(const QJsonArray &systems, int loaded, int total);
+    void handleNearestSystemsReceived(const SystemRecordList &systems);
+    void handleSystemsNearPrefetched(const QString &waypoint, const SystemRecordList &systems);
     void handleTakenSystemsReceived(const QJsonArray &taken);
     void handleCategoriesReceived(const QJsonArray &categories);
     void handlePOISReceived(const QJsonArray &pois);
@@ -248,6 +262,7 @@ private slots:
     void handleAllCommanderLocationsReceived(const QJsonArray &locations);
     void handleBulkSystemImagesLoaded(const QJsonObject &systemImages);
     void handleSupabaseError(const QString &error);
+    void updateTotalJumpCount();
     
 private:
     // External dependencies
@@ -262,16 +277,27 @@ private:
     QString m_currentSystem;
     QVariantList m_nearestSystems;
     QVariantList m_unclaimedSystems;
+    SystemListModel *m_nearestSystemsModel;
+    SystemListModel *m_unclaimedSystemsModel;
     QString m_selectedCategory;
     QVariantList m_availableCategories;
     QStringList m_poiSystems; // Store POI system names
     QMap<QString, QString> m_poiSystemStatus; // Store actual POI status (POI/Potential POI) for each system
-    QStringList m_takenSystems; // Store all taken system names
 
-    QJsonArray m_allTakenSystemsData; // Store complete taken systems data for detailed queries
+    // Claim state per system name, built once per complete taken payload and patched in
+    // place by claim/unclaim/status replies. "empty" placeholder rows count as unclaimed.
+    struct ClaimState {
+        QString claimedBy;
+        bool claimed = false;
+        bool done = false;
+    };
+    QHash<QString, ClaimState> m_claimIndex;
     // Fast lookup for uploaded primary images by system name (ImgBB URLs)
     QMap<QString, QString> m_systemImages;
+    QSet<QString> m_imagesRequested;    // Systems whose images have been asked for once already
     int m_jumpCount;
+    int m_totalJumpCount;   // Lifetime jumps for the commander, from the jump store
+    static const int NEAREST_SYSTEMS_LIMIT = 500;   // Rows requested around the commander
     QString m_sessionTime;
     bool m_mapWindowActive;
 
@@ -293,6 +319,7 @@ private:
     // Internal utilities
     QTimer *m_sessionTimer;
     QTimer *m_journalTimer;
+    QTimer *m_galaxyMapPageTimer;   // Coalesces galaxyMapSystemsChanged during a paged load
     qint64 m_sessionStartTime;
     int m_unclaimedIndex;
     
@@ -301,15 +328,42 @@ private:
     void loadCategories();
     void updateNearestSystems();
     void updateUnclaimedSystems();
+    
+    // New position: re-rank from coordinates already in memory, fetching only when the
+    // local catalogue isn't there to rank against
+    void refreshNearestForPosition();
+    bool rerankNearestLocally();
+    void rememberSystemCoordinates(const SystemRecordList &systems);
+    void rememberSystemCoordinates(const QJsonArray &systems);
     void updateNearestSystemsWithClaimData();
+    void rebuildClaimIndex(const QJsonArray &taken);
+    void setClaimState(const QString &systemName, const ClaimState &state);
+    void removeClaimState(const QString &systemName);
+    void applyClaimStateToRow(const QString &systemName);
     void formatSessionTime();
-    void updateTotalJumpCount();
+    
+    // Push the working lists into their models; only the rows that differ are signalled
+    void publishNearestSystems();
+    void publishUnclaimedSystems();
+    void publishGalaxyMapSystems();
+    // One row changed in place (optimistic POI edits, images)
+    void updateNearestSystem(const QString &systemName, const QVariantMap &fields);
+    
+    // Route prefetch: nearest systems pre-ranked for every upcoming waypoint of the plotted route
+    void prefetchRouteSystems();
+    bool applyPrefetchedSystems(const QString &systemName);
     
     // Multi-category parsing and formatting (from v1.4incomplete.py specification)
     QStringList parseCategories(const QString &categoryString);
     QString formatCategoriesForDisplay(const QStringList &categories);
     QString getCategoryColorForMulti(const QStringList &categories);
     
+    // Row of m_nearestSystems / m_galaxyMapSystems for one transformed database system
+    QVariantMap buildSystemEntry(const QJsonObject &system);
+    QVariantMap systemRecordToVariant(const SystemRecord &record);
+    // The closest limit rows by distanceLy, closest first; unknown distances rank last
+    static QVariantList nearestRows(const QVariantList &systems, int limit);
+    
     // Database and file operations (placeholder for now)
     bool connectToDatabase();
     bool loadJournalData();
@@ -323,12 +377,29 @@ private:
     
     // Galaxy Map data
     QVariantList m_galaxyMapSystems;
+    SystemListModel *m_galaxyMapSystemsModel;
+    CoordinateStore m_galaxyMapCoordinates;     // Rebuilt from m_galaxyMapSystems on the next region query
+    bool m_galaxyMapCoordinatesStale;
     QVariantMap m_commanderPosition;
     int m_visibleSystemsCount;
     QVariantList m_allCommanderLocations;
     bool m_galaxyMapLoading;
     QVariantMap m_galaxyMapFilters;
     
+    // Coordinates of every system seen in a systems reply, for ranking before the local
+    // catalogue has been downloaded. One record per name with its categories merged.
+    SystemRecordList m_knownSystems;
+    QHash<QString, int> m_knownSystemIndex;
+    CoordinateStore m_knownCoordinates;
+    
+    // Plotted route and the nearest systems prepared for each waypoint before arrival, ranked
+    // from the local catalogue or fetched as the waypoint's own box without one
+    QVariantList m_navRoute;
+    QHash<QString, SystemRecordList> m_routePrefetch;
+    QSet<QString> m_routePrefetchPending;                   // Waypoints with a box query in flight
+    static const int ROUTE_PREFETCH_WAYPOINTS = 25;         // Ahead of us, ranked from the catalogue
+    static const int ROUTE_PREFETCH_REMOTE_WAYPOINTS = 5;   // Ahead of us, fetched from the server
+    
     // Forced commander settings
     bool m_forcedCommanderEnabled;
     QString m_forcedCommanderName;
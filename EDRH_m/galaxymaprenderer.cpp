@@ -3,6 +3,7 @@
 #include <QPainter>
 #include <QBrush>
 #include <QPen>
+#include <QPolygonF>
 #include <QFont>
 #include <QPixmap>
 #include <QDebug>
@@ -260,6 +261,9 @@ void GalaxyMapRenderer::drawStars(QPainter *painter)
         qDebug() << "drawStars: Warning - 0 stars rendered out of" << m_realStars.size() << "total stars";
     }
     
+    // Plotted route underneath the commander markers
+    drawNavRoute(painter);
+    
     // Draw commander locations (current commander + all commanders in admin mode)
     drawCommanderLocations(painter);
 }
@@ -293,6 +297,36 @@ void GalaxyMapRenderer::drawCommanderLocations(QPainter *painter)
     }
 }
 
+void GalaxyMapRenderer::drawNavRoute(QPainter *painter)
+{
+    if (m_navRoute.size() < 2) {
+        return;
+    }
+    
+    QPolygonF path;
+    path.reserve(m_navRoute.size());
+    for (const auto &waypointVariant : m_navRoute) {
+        QVariantMap waypoint = waypointVariant.toMap();
+        path.append(galacticToMap(waypoint.value("x", 0.0).toReal(), waypoint.value("z", 0.0).toReal()));
+    }
+    
+    // Keep the line readable at any zoom
+    qreal lineWidth = 2.0 / qMax(0.1, m_zoomLevel);
+    painter->setPen(QPen(QColor(0, 191, 255, 200), lineWidth, Qt::DashLine));
+    painter->setBrush(Qt::NoBrush);
+    painter->drawPolyline(path);
+    
+    // Waypoint dots, with the destination highlighted
+    qreal dotSize = 4.0 / qMax(0.1, m_zoomLevel);
+    painter->setPen(Qt::NoPen);
+    for (int i = 0; i < path.size(); ++i) {
+        bool isDestination = (i == path.size() - 1);
+        painter->setBrush(isDestination ? QColor(255, 127, 80) : QColor(0, 191, 255));
+        qreal size = isDestination ? dotSize * 2.0 : dotSize;
+        painter->drawEllipse(QRectF(path[i].x() - size/2, path[i].y() - size/2, size, size));
+    }
+}
+
 void GalaxyMapRenderer::drawCommanderMarker(QPainter *painter, const QPointF &position, const QColor &color, const QString &name, bool isCurrent)
 {
     // Calculate screen-space size (bigger when zoomed out, smaller when zoomed in)
@@ -499,6 +533,32 @@ QColor GalaxyMapRenderer::getStarColor(const QString &type) const
     return QColor(255, 255, 255);
 }
 
+QPointF GalaxyMapRenderer::galacticToMap(qreal x, qreal z) const
+{
+    // Use EXACT same transformation as Python v1.4incomplete.py
+    const qreal LY_PER_PIXEL = 40.0;
+    const qreal ORIG_OFF_X = 1124.0;
+    const qreal ORIG_OFF_Y = 1749.0;
+    
+    // Step 1: Transform to pixel coordinates (same as Python)
+    qreal px = ORIG_OFF_X + x / LY_PER_PIXEL;
+    qreal py = ORIG_OFF_Y - z / LY_PER_PIXEL;  // CRITICAL: Minus for Z coordinate!
+    
+    // Step 2: Python scaling logic - base_full = 2250x2250 resized to base_med 800x800 * zoom
+    const qreal base_full_width = 2250.0;
+    const qreal base_med_width = 800.0;
+    const qreal zoom = 1.5;  // Default zoom to make galaxy bigger (Python default is 1.0 but that's too small)
+    qreal resized_width = base_med_width * zoom;
+    qreal scale = resized_width / base_full_width;
+    
+    // Center the scaled image in the window (Python: x0, y0 = (cw-im_w)/2, (ch-im_h)/2)
+    qreal x0 = (width() - resized_width) / 2.0;
+    qreal y0 = (height() - resized_width) / 2.0;
+    
+    // Apply final transformation (Python: cx, cy = x0 + px*scale, y0 + py*scale)
+    return QPointF(x0 + px * scale, y0 + py * scale);
+}
+
 QPointF GalaxyMapRenderer::worldToScreen(const QPointF &worldPos) const
 {
     QPointF screen = worldPos;
@@ -651,6 +711,16 @@ void GalaxyMapRenderer::setShowAllCommanders(bool show)
     update();  // Redraw to show/hide commander locations
 }
 
+void GalaxyMapRenderer::setNavRoute(const QVariantList &route)
+{
+    if (m_navRoute == route)
+        return;
+    
+    m_navRoute = route;
+    emit navRouteChanged();
+    update();  // Redraw the route overlay
+}
+
 void GalaxyMapRenderer::setIsAdminMode(bool isAdmin)
 {
     if (m_isAdminMode == isAdmin)
@@ -808,47 +878,7 @@ void GalaxyMapRenderer::loadRealStarSystems()
         star.starClass = category;  // Use category as star class for now
         
         // Convert Elite Dangerous galactic coordinates to screen coordinates
-        // Use EXACT same transformation as Python v1.4incomplete.py
-        const qreal LY_PER_PIXEL = 40.0;
-        const qreal ORIG_OFF_X = 1124.0;
-        const qreal ORIG_OFF_Y = 1749.0;
-        
-        // Step 1: Transform to pixel coordinates (same as Python)
-        qreal px = ORIG_OFF_X + star.x / LY_PER_PIXEL;
-        qreal py = ORIG_OFF_Y - star.z / LY_PER_PIXEL;  // CRITICAL: Minus for Z coordinate!
-        
-        // Step 2: Python scaling logic (EXACTLY like Python v1.4incomplete.py):
-        // Python: base_full = 2250x2250, base_med = 800x800, zoom = 1.0 default
-        // Python: resized = base_med * zoom, scale = resized.width / base_full.width
-        
-        qreal base_full_width = 2250.0;
-        qreal base_full_height = 2250.0;
-        qreal base_med_width = 800.0;   // Python resizes original to 800x800
-        qreal zoom = 1.5;  // Default zoom to make galaxy bigger (Python default is 1.0 but that's too small)
-        
-        // Calculate resized dimensions (Python: base_med.width * zoom)
-        qreal resized_width = base_med_width * zoom;
-        qreal resized_height = base_med_width * zoom;  // Square image
-        
-        // Calculate scale factor (Python: scale = resized.width / base_full.width)
-        qreal scale = resized_width / base_full_width;
-        
-        qreal canvas_width = width();
-        qreal canvas_height = height();
-        
-        // Use the calculated scale for positioning
-        qreal image_width = resized_width;
-        qreal image_height = resized_height;
-        
-        // Center the scaled image in the window (Python: x0, y0 = (cw-im_w)/2, (ch-im_h)/2)
-        qreal x0 = (canvas_width - image_width) / 2.0;
-        qreal y0 = (canvas_height - image_height) / 2.0;
-        
-        // Apply final transformation (Python: cx, cy = x0 + px*scale, y0 + py*scale)
-        star.position = QPointF(
-            x0 + px * scale,
-            y0 + py * scale
-        );
+        star.position = galacticToMap(star.x, star.z);
         
         // Skip systems with extreme coordinates
         if (qAbs(star.position.x()) > width() * 5 || qAbs(star.position.y()) > height() * 5) {
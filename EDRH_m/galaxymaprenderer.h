@@ -25,6 +25,7 @@ class GalaxyMapRenderer : public QQuickPaintedItem
     Q_PROPERTY(QVariantList allCommanderLocations READ allCommanderLocations WRITE setAllCommanderLocations NOTIFY allCommanderLocationsChanged)
     Q_PROPERTY(bool showAllCommanders READ showAllCommanders WRITE setShowAllCommanders NOTIFY showAllCommandersChanged)
     Q_PROPERTY(bool isAdminMode READ isAdminMode WRITE setIsAdminMode NOTIFY isAdminModeChanged)
+    Q_PROPERTY(QVariantList navRoute READ navRoute WRITE setNavRoute NOTIFY navRouteChanged)
 
 public:
     explicit GalaxyMapRenderer(QQuickItem *parent = nullptr);
@@ -51,6 +52,7 @@ protected:
     QVariantList allCommanderLocations() const { return m_allCommanderLocations; }
     bool showAllCommanders() const { return m_showAllCommanders; }
     bool isAdminMode() const { return m_isAdminMode; }
+    QVariantList navRoute() const { return m_navRoute; }
 
     // Property setters
     void setZoomLevel(qreal zoomLevel);
@@ -66,6 +68,7 @@ protected:
     void setAllCommanderLocations(const QVariantList &locations);
     void setShowAllCommanders(bool show);
     void setIsAdminMode(bool isAdmin);
+    void setNavRoute(const QVariantList &route);
 
 signals:
     void zoomLevelChanged();
@@ -82,6 +85,7 @@ signals:
     void allCommanderLocationsChanged();
     void showAllCommandersChanged();
     void isAdminModeChanged();
+    void navRouteChanged();
     void systemRightClicked(const QString &systemName, qreal x, qreal y, qreal z);
 
 private:
@@ -104,11 +108,13 @@ private:
     void loadSampleEliteStars();
     void repositionStarsAfterResize();
     QPointF worldToScreen(const QPointF &worldPos) const;
+    QPointF galacticToMap(qreal x, qreal z) const;
     QColor getStarColor(const QString &type) const;
     void drawBackground(QPainter *painter);
     void drawStars(QPainter *painter);
     void drawUI(QPainter *painter);
     void drawCommanderLocations(QPainter *painter);
+    void drawNavRoute(QPainter *painter);
     void drawCommanderMarker(QPainter *painter, const QPointF &position, const QColor &color, const QString &name, bool isCurrent);
     StarSystem* findSystemAtPosition(const QPointF &pos);
     bool isSystemVisible(const StarSystem &system) const;
@@ -132,6 +138,7 @@ private:
     QVariantList m_allCommanderLocations;
     bool m_showAllCommanders;
     bool m_isAdminMode;
+    QVariantList m_navRoute;
     
     // Add mouse position tracking
     QPointF m_lastMousePosition;
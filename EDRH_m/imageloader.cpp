@@ -85,6 +85,9 @@ void ImageLoader::loadImage(const QString &url, const QString &systemName)
     
     // Increment retry count for this attempt
     m_retryCount[normalizedUrl] = retryCount + 1;
+    if (retryCount > 0) {
+        m_networkMetrics.recordRetry(metricsTag(normalizedUrl));
+    }
     
     // Download the image with optimizations for ImgBB
     QNetworkRequest request{QUrl(normalizedUrl)};
@@ -121,6 +124,13 @@ void ImageLoader::loadImage(const QString &url, const QString &systemName)
     });
     timeoutTimer->start();
     m_pendingDownloads[reply] = normalizedUrl;
+    m_downloadTimings[reply].timer.start();
+    connect(reply, &QNetworkReply::metaDataChanged, this, [this, reply]() {
+        auto it = m_downloadTimings.find(reply);
+        if (it != m_downloadTimings.end() && it->firstByteMs < 0) {
+            it->firstByteMs = it->timer.elapsed();
+        }
+    });
     
     connect(reply, &QNetworkReply::finished, this, &ImageLoader::handleImageDownloaded);
     connect(reply, QOverload<QNetworkReply::NetworkError>::of(&QNetworkReply::errorOccurred),
@@ -297,6 +307,11 @@ void ImageLoader::handleImageDownloaded()
     QString url = m_pendingDownloads.value(reply);
     m_pendingDownloads.remove(reply);
     
+    const NetworkRequestTiming timing = m_downloadTimings.take(reply);
+    m_networkMetrics.recordReply(metricsTag(url), reply->error() != QNetworkReply::NoError,
+                                 timing.timer.isValid() ? timing.timer.elapsed() : -1,
+                                 timing.firstByteMs, 0, reply->bytesAvailable());
+    
     if (reply->error() == QNetworkReply::NoError) {
         QByteArray data = reply->readAll();
         
@@ -378,6 +393,22 @@ void ImageLoader::handleNetworkError(QNetworkReply::NetworkError error)
     emit imageLoadFailed(url, QString("Network error: %1").arg(error));
 }
 
+QVariantList ImageLoader::networkStats() const
+{
+    return m_networkMetrics.toVariantList();
+}
+
+void ImageLoader::resetNetworkStats()
+{
+    m_networkMetrics.reset();
+}
+
+QString ImageLoader::metricsTag(const QString &url)
+{
+    // Per host: the image hosts differ far more from each other than individual images do
+    return "IMAGE:" + QUrl(url).host();
+}
+
 bool ImageLoader::isImageCached(const QString &url)
 {
     QString fileName = generateCacheFileName(url);
@@ -10,6 +10,7 @@
 #include <QTimer>
 #include <QQmlEngine>
 #include <QJsonArray>
+#include "networkmetrics.h"
 
 class ImageLoader : public QObject
 {
@@ -34,6 +35,10 @@ public:
     
     // Preload common images
     Q_INVOKABLE void preloadCommonImages();
+    
+    // Download stats per host ("IMAGE:i.ibb.co"), same shape as SupabaseClient::operationStats()
+    Q_INVOKABLE QVariantList networkStats() const;
+    Q_INVOKABLE void resetNetworkStats();
 
 public slots:
     // Handle preset images from database
@@ -57,6 +62,8 @@ private:
     QHash<QString, QString> m_presetImages; // Category -> preset URL
     QHash<QNetworkReply*, QString> m_pendingDownloads; // Reply -> URL
     QHash<QString, int> m_retryCount; // URL -> retry attempts (prevent infinite loops)
+    QHash<QNetworkReply*, NetworkRequestTiming> m_downloadTimings;
+    NetworkMetrics m_networkMetrics;
     QString m_cacheDir;
     
     void initializeCache();
@@ -65,6 +72,7 @@ private:
     void saveImageToCache(const QString &url, const QByteArray &data);
     bool isImageCached(const QString &url);
     QString normalizeImgurUrl(const QString &url);
+    static QString metricsTag(const QString &url);
 };
 
 #endif // IMAGELOADER_H 
\ No newline at end of file
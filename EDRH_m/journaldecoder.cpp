@@ -0,0 +1,420 @@
+#include "journaldecoder.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QJsonParseError>
+#include <QElapsedTimer>
+#include <QDebug>
+#include <charconv>
+#include <cstring>
+
+namespace {
+
+template <size_t N>
+inline bool equals(QByteArrayView view, const char (&literal)[N])
+{
+    return view.size() == qsizetype(N - 1) && std::memcmp(view.data(), literal, N - 1) == 0;
+}
+
+inline bool isJsonSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+// Decode a JSON string body that contains escape sequences
+QString unescapeJsonString(QByteArrayView raw)
+{
+    QString result;
+    result.reserve(raw.size());
+    qsizetype runStart = 0;
+    qsizetype i = 0;
+
+    while (i < raw.size()) {
+        if (raw[i] != '\\' || i + 1 >= raw.size()) {
+            ++i;
+            continue;
+        }
+
+        result += QString::fromUtf8(raw.sliced(runStart, i - runStart));
+        const char escape = raw[i + 1];
+        i += 2;
+
+        switch (escape) {
+        case 'n': result += QLatin1Char('\n'); break;
+        case 't': result += QLatin1Char('\t'); break;
+        case 'r': result += QLatin1Char('\r'); break;
+        case 'b': result += QLatin1Char('\b'); break;
+        case 'f': result += QLatin1Char('\f'); break;
+        case 'u':
+            if (i + 4 <= raw.size()) {
+                bool ok = false;
+                ushort code = QByteArray(raw.sliced(i, 4).data(), 4).toUShort(&ok, 16);
+                if (ok) {
+                    result += QChar(code);
+                }
+                i += 4;
+            }
+            break;
+        default:
+            // \" \\ \/ and anything unexpected map to the character itself
+            result += QLatin1Char(escape);
+            break;
+        }
+        runStart = i;
+    }
+
+    result += QString::fromUtf8(raw.sliced(runStart));
+    return result;
+}
+
+}
+
+bool JournalEvent::isLocationEvent() const
+{
+    return type == JournalEventType::FSDJump || type == JournalEventType::CarrierJump ||
+           type == JournalEventType::Location;
+}
+
+QString JournalEvent::eventName() const
+{
+    switch (type) {
+    case JournalEventType::Fileheader: return QStringLiteral("Fileheader");
+    case JournalEventType::Commander: return QStringLiteral("Commander");
+    case JournalEventType::LoadGame: return QStringLiteral("LoadGame");
+    case JournalEventType::FSDJump: return QStringLiteral("FSDJump");
+    case JournalEventType::CarrierJump: return QStringLiteral("CarrierJump");
+    case JournalEventType::Location: return QStringLiteral("Location");
+    case JournalEventType::SwitchUser: return QStringLiteral("SwitchUser");
+    case JournalEventType::NavRoute: return QStringLiteral("NavRoute");
+    case JournalEventType::NavRouteClear: return QStringLiteral("NavRouteClear");
+    case JournalEventType::Other: break;
+    }
+    return QString();
+}
+
+QJsonObject JournalEvent::toJson() const
+{
+    QJsonObject obj;
+    obj["event"] = eventName();
+    obj["timestamp"] = timestamp;
+    if (!starSystem.isEmpty()) {
+        obj["StarSystem"] = starSystem;
+    }
+    if (hasStarPos) {
+        obj["StarPos"] = QJsonArray{starPos[0], starPos[1], starPos[2]};
+    }
+    if (type == JournalEventType::FSDJump && jumpDist > 0.0) {
+        obj["JumpDist"] = jumpDist;
+    }
+    return obj;
+}
+
+JournalEventType JournalDecoder::classify(QByteArrayView line)
+{
+    // The game always writes "event":"Name" without whitespace
+    static const QByteArrayView needle("\"event\":\"");
+    qsizetype start = line.indexOf(needle);
+    if (start < 0) {
+        return JournalEventType::Other;
+    }
+    start += needle.size();
+
+    qsizetype end = line.indexOf('"', start);
+    if (end < 0) {
+        return JournalEventType::Other;
+    }
+
+    const QByteArrayView name = line.sliced(start, end - start);
+    switch (name.size()) {
+    case 7:
+        if (equals(name, "FSDJump")) return JournalEventType::FSDJump;
+        break;
+    case 8:
+        if (equals(name, "Location")) return JournalEventType::Location;
+        if (equals(name, "LoadGame")) return JournalEventType::LoadGame;
+        if (equals(name, "NavRoute")) return JournalEventType::NavRoute;
+        break;
+    case 9:
+        if (equals(name, "Commander")) return JournalEventType::Commander;
+        break;
+    case 10:
+        if (equals(name, "Fileheader")) return JournalEventType::Fileheader;
+        if (equals(name, "SwitchUser")) return JournalEventType::SwitchUser;
+        break;
+    case 11:
+        if (equals(name, "CarrierJump")) return JournalEventType::CarrierJump;
+        break;
+    case 13:
+        if (equals(name, "NavRouteClear")) return JournalEventType::NavRouteClear;
+        break;
+    default:
+        break;
+    }
+    return JournalEventType::Other;
+}
+
+bool JournalDecoder::decode(QByteArrayView line, JournalEvent &event)
+{
+    event = JournalEvent();
+    event.type = classify(line);
+    if (event.type == JournalEventType::Other) {
+        return false;
+    }
+
+    event.timestamp = QString::fromLatin1(timestampOf(line));
+
+    switch (event.type) {
+    case JournalEventType::Fileheader:
+        event.odyssey = equals(rawValue(line, "Odyssey"), "true");
+        break;
+    case JournalEventType::Commander:
+        event.commander = stringValue(line, "Name");
+        event.fid = stringValue(line, "FID");
+        break;
+    case JournalEventType::LoadGame:
+        event.commander = stringValue(line, "Commander");
+        event.fid = stringValue(line, "FID");
+        break;
+    case JournalEventType::FSDJump:
+        parseDouble(rawValue(line, "JumpDist"), event.jumpDist);
+        Q_FALLTHROUGH();
+    case JournalEventType::CarrierJump:
+    case JournalEventType::Location:
+        event.starSystem = stringValue(line, "StarSystem");
+        event.hasStarPos = parseStarPos(line, event.starPos);
+        if (event.starSystem.isEmpty()) {
+            return false;
+        }
+        break;
+    case JournalEventType::SwitchUser:
+    case JournalEventType::NavRoute:
+    case JournalEventType::NavRouteClear:
+    case JournalEventType::Other:
+        break;
+    }
+
+    return true;
+}
+
+QByteArrayView JournalDecoder::timestampOf(QByteArrayView line)
+{
+    return rawValue(line, "timestamp");
+}
+
+QByteArrayView JournalDecoder::rawValue(QByteArrayView line, QByteArrayView key)
+{
+    // Build "key": on the stack - keys are short field names
+    char needle[64];
+    if (key.size() + 3 > qsizetype(sizeof(needle))) {
+        return QByteArrayView();
+    }
+    needle[0] = '"';
+    std::memcpy(needle + 1, key.data(), key.size());
+    needle[key.size() + 1] = '"';
+    needle[key.size() + 2] = ':';
+
+    // Only keys of the outer object count - FSDJump's "Factions" and "SystemFaction" carry
+    // their own "Name" keys. Depth and string state are tracked from the start of the line
+    // up to each match, so the bytes before a key are scanned once.
+    const QByteArrayView pattern(needle, key.size() + 3);
+    qsizetype pos = line.indexOf(pattern);
+    qsizetype scanned = 0;
+    int depth = 0;
+    bool inString = false;
+    while (pos >= 0) {
+        for (; scanned < pos; ++scanned) {
+            const char c = line[scanned];
+            if (inString) {
+                if (c == '\\') {
+                    ++scanned;
+                } else if (c == '"') {
+                    inString = false;
+                }
+            } else if (c == '"') {
+                inString = true;
+            } else if (c == '{' || c == '[') {
+                ++depth;
+            } else if (c == '}' || c == ']') {
+                --depth;
+            }
+        }
+        if (!inString && depth == 1) {
+            break;
+        }
+        pos = line.indexOf(pattern, pos + 1);
+    }
+    if (pos < 0) {
+        return QByteArrayView();
+    }
+    pos += key.size() + 3;
+    while (pos < line.size() && isJsonSpace(line[pos])) {
+        ++pos;
+    }
+    if (pos >= line.size()) {
+        return QByteArrayView();
+    }
+
+    if (line[pos] == '"') {
+        // String body up to the first unescaped quote
+        qsizetype end = pos + 1;
+        while (end < line.size()) {
+            if (line[end] == '\\') {
+                end += 2;
+                continue;
+            }
+            if (line[end] == '"') {
+                return line.sliced(pos + 1, end - pos - 1);
+            }
+            ++end;
+        }
+        return QByteArrayView();
+    }
+
+    if (line[pos] == '[') {
+        qsizetype end = line.indexOf(']', pos);
+        return end < 0 ? QByteArrayView() : line.sliced(pos, end - pos + 1);
+    }
+
+    // Number, bool or null - runs to the next delimiter
+    qsizetype end = pos;
+    while (end < line.size() && line[end] != ',' && line[end] != '}' && !isJsonSpace(line[end])) {
+        ++end;
+    }
+    return line.sliced(pos, end - pos);
+}
+
+QString JournalDecoder::stringValue(QByteArrayView line, QByteArrayView key)
+{
+    QByteArrayView raw = rawValue(line, key);
+    if (raw.isEmpty()) {
+        return QString();
+    }
+    if (raw.indexOf('\\') < 0) {
+        return QString::fromUtf8(raw);
+    }
+    return unescapeJsonString(raw);
+}
+
+bool JournalDecoder::parseStarPos(QByteArrayView line, double out[3])
+{
+    QByteArrayView array = rawValue(line, "StarPos");
+    if (array.size() < 2 || array.front() != '[') {
+        return false;
+    }
+
+    qsizetype pos = 1;
+    for (int i = 0; i < 3; ++i) {
+        while (pos < array.size() && (isJsonSpace(array[pos]) || array[pos] == ',')) {
+            ++pos;
+        }
+        qsizetype end = pos;
+        while (end < array.size() && array[end] != ',' && array[end] != ']' && !isJsonSpace(array[end])) {
+            ++end;
+        }
+        if (!parseDouble(array.sliced(pos, end - pos), out[i])) {
+            return false;
+        }
+        pos = end;
+    }
+    return true;
+}
+
+bool JournalDecoder::parseDouble(QByteArrayView text, double &value)
+{
+    if (text.isEmpty()) {
+        return false;
+    }
+    const char *begin = text.data();
+    const char *end = begin + text.size();
+    auto result = std::from_chars(begin, end, value);
+    return result.ec == std::errc() && result.ptr == end;
+}
+
+#ifdef EDRH_BENCHMARKS
+QVariantMap JournalDecoder::benchmark(const QStringList &filePaths)
+{
+    QList<QByteArray> contents;
+    qint64 totalBytes = 0;
+    for (const QString &filePath : filePaths) {
+        QFile file(filePath);
+        if (file.open(QIODevice::ReadOnly)) {
+            contents.append(file.readAll());
+            totalBytes += contents.last().size();
+        }
+    }
+
+    QVariantMap result;
+    result["files"] = contents.size();
+    result["bytes"] = totalBytes;
+    if (totalBytes == 0) {
+        qDebug() << "Journal decoder benchmark: no journal data to read";
+        return result;
+    }
+
+    // Previous path: QTextStream -> QString -> UTF-8 -> QJsonDocument for every line
+    int legacyEvents = 0;
+    QElapsedTimer timer;
+    timer.start();
+    for (const QByteArray &data : contents) {
+        QTextStream stream(data);
+        while (!stream.atEnd()) {
+            QString line = stream.readLine().trimmed();
+            if (line.isEmpty()) {
+                continue;
+            }
+            QJsonParseError parseError;
+            QJsonDocument doc = QJsonDocument::fromJson(line.toUtf8(), &parseError);
+            if (parseError.error != QJsonParseError::NoError) {
+                continue;
+            }
+            QString event = doc.object().value("event").toString();
+            if (event == "Commander" || event == "LoadGame" || event == "FSDJump" ||
+                event == "CarrierJump" || event == "Location") {
+                legacyEvents++;
+            }
+        }
+    }
+    const qint64 legacyNs = qMax<qint64>(1, timer.nsecsElapsed());
+
+    // Decoder path over the same bytes
+    int decoderEvents = 0;
+    JournalEvent event;
+    timer.restart();
+    for (const QByteArray &data : contents) {
+        QByteArrayView view(data);
+        qsizetype lineStart = 0;
+        while (lineStart < view.size()) {
+            qsizetype newline = view.indexOf('\n', lineStart);
+            if (newline < 0) {
+                newline = view.size();
+            }
+            if (decode(view.sliced(lineStart, newline - lineStart), event) &&
+                (event.isLocationEvent() || event.type == JournalEventType::Commander ||
+                 event.type == JournalEventType::LoadGame)) {
+                decoderEvents++;
+            }
+            lineStart = newline + 1;
+        }
+    }
+    const qint64 decoderNs = qMax<qint64>(1, timer.nsecsElapsed());
+
+    const double megabytes = totalBytes / (1024.0 * 1024.0);
+    const double legacyMBps = megabytes / (legacyNs / 1e9);
+    const double decoderMBps = megabytes / (decoderNs / 1e9);
+
+    result["legacyMBps"] = legacyMBps;
+    result["decoderMBps"] = decoderMBps;
+    result["legacyEvents"] = legacyEvents;
+    result["decoderEvents"] = decoderEvents;
+    result["speedup"] = decoderMBps / legacyMBps;
+
+    qDebug() << "Journal decoder benchmark:" << contents.size() << "files," << QString::number(megabytes, 'f', 1) << "MB";
+    qDebug() << "  QJsonDocument path:" << QString::number(legacyMBps, 'f', 1) << "MB/s," << legacyEvents << "events";
+    qDebug() << "  Byte decoder path: " << QString::number(decoderMBps, 'f', 1) << "MB/s," << decoderEvents << "events";
+    qDebug() << "  Speedup:" << QString::number(decoderMBps / legacyMBps, 'f', 1) << "x";
+
+    return result;
+}
+#endif
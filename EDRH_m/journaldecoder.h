@@ -0,0 +1,72 @@
+#ifndef JOURNALDECODER_H
+#define JOURNALDECODER_H
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QString>
+#include <QStringList>
+#include <QJsonObject>
+#include <QVariantMap>
+
+// The only journal events the app cares about. Everything else is skipped without parsing.
+enum class JournalEventType {
+    Other,
+    Fileheader,
+    Commander,
+    LoadGame,
+    FSDJump,
+    CarrierJump,
+    Location,
+    SwitchUser,
+    NavRoute,       // Route plotted - waypoints are in NavRoute.json
+    NavRouteClear
+};
+
+// Fields extracted from one interesting journal line
+struct JournalEvent
+{
+    JournalEventType type = JournalEventType::Other;
+    QString timestamp;
+    QString starSystem;     // FSDJump, CarrierJump, Location
+    double starPos[3] = {0.0, 0.0, 0.0};
+    bool hasStarPos = false;
+    double jumpDist = 0.0;  // FSDJump only
+    QString commander;      // Commander (Name) or LoadGame (Commander)
+    QString fid;            // Commander, LoadGame
+    bool odyssey = false;   // Fileheader
+
+    bool isLocationEvent() const;
+    QString eventName() const;
+
+    // Minimal JSON form (event, timestamp, StarSystem, StarPos) used by the jump signals
+    QJsonObject toJson() const;
+};
+
+// Decodes journal lines straight from their UTF-8 bytes.
+// The "event" value is classified with a plain byte search, and only the fields of the
+// handful of events we use are extracted - no QString or QJsonDocument for the rest.
+class JournalDecoder
+{
+public:
+    static JournalEventType classify(QByteArrayView line);
+
+    // Returns false for uninteresting or malformed lines
+    static bool decode(QByteArrayView line, JournalEvent &event);
+
+    // Top-level "timestamp" value, without decoding anything else
+    static QByteArrayView timestampOf(QByteArrayView line);
+
+#ifdef EDRH_BENCHMARKS
+    // Compare this decoder with the previous QString + QJsonDocument path over the given
+    // journal files and report MB/s for both
+    static QVariantMap benchmark(const QStringList &filePaths);
+#endif
+
+private:
+    static QByteArrayView rawValue(QByteArrayView line, QByteArrayView key);
+    static QString stringValue(QByteArrayView line, QByteArrayView key);
+    static bool parseStarPos(QByteArrayView line, double out[3]);
+    static bool parseDouble(QByteArrayView text, double &value);
+};
+
+#endif // JOURNALDECODER_H
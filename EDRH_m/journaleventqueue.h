@@ -0,0 +1,67 @@
+#ifndef JOURNALEVENTQUEUE_H
+#define JOURNALEVENTQUEUE_H
+
+#include <QVector>
+#include <atomic>
+#include "journaldecoder.h"
+
+// Single-producer/single-consumer ring buffer carrying decoded journal events from the
+// reader thread to the GUI thread. Neither side ever takes a lock; the producer only
+// publishes a slot after it is fully written and the consumer only frees it after reading.
+class JournalEventQueue
+{
+public:
+    explicit JournalEventQueue(int capacity = 4096)
+        : m_slots(roundUpToPowerOfTwo(capacity))
+        , m_mask(m_slots.size() - 1)
+        , m_head(0)
+        , m_tail(0)
+    {
+    }
+
+    // Producer side - returns false when the queue is full
+    bool push(JournalEvent &&event)
+    {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) >= size_t(m_slots.size())) {
+            return false;
+        }
+        m_slots[int(tail & m_mask)] = std::move(event);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side - returns false when the queue is empty
+    bool pop(JournalEvent &event)
+    {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        event = std::move(m_slots[int(head & m_mask)]);
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool isEmpty() const
+    {
+        return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+    }
+
+private:
+    static int roundUpToPowerOfTwo(int value)
+    {
+        int result = 1;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    QVector<JournalEvent> m_slots;
+    const size_t m_mask;
+    alignas(64) std::atomic<size_t> m_head;  // Next slot to read (consumer)
+    alignas(64) std::atomic<size_t> m_tail;  // Next slot to write (producer)
+};
+
+#endif // JOURNALEVENTQUEUE_H
@@ -0,0 +1,376 @@
+#include "journalindex.h"
+#include "journaldecoder.h"
+#include "journallinereader.h"
+#include <QStandardPaths>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QJsonDocument>
+#include <QJsonParseError>
+#include <QSet>
+#include <QDebug>
+#include <QAtomicInt>
+#include <QtConcurrent>
+#include <functional>
+
+QMutex JournalIndex::s_mutex;
+JournalIndex* JournalIndex::s_instance = nullptr;
+
+namespace {
+
+// Bump whenever the summary layout changes so stale indexes are rebuilt
+const int kIndexVersion = 1;
+
+}
+
+QString JournalFileSummary::fileName() const
+{
+    return QFileInfo(filePath).fileName();
+}
+
+QJsonObject JournalFileSummary::toJson() const
+{
+    QJsonObject obj;
+    obj["size"] = static_cast<double>(size);
+    obj["mtime"] = static_cast<double>(lastModified);
+    obj["commander"] = commander;
+    obj["last_commander"] = lastCommander;
+    obj["commanders"] = QJsonArray::fromStringList(commanders);
+    obj["load_games"] = loadGames;
+    obj["odyssey"] = odyssey;
+    obj["fsd_jumps"] = fsdJumps;
+    obj["carrier_jumps"] = carrierJumps;
+    obj["switch_user"] = switchUserEvents;
+    obj["first_timestamp"] = firstTimestamp;
+    obj["last_timestamp"] = lastTimestamp;
+    obj["last_location"] = lastLocation;
+    obj["visited"] = QJsonArray::fromStringList(visitedSystems);
+    return obj;
+}
+
+JournalFileSummary JournalFileSummary::fromJson(const QJsonObject &obj)
+{
+    JournalFileSummary summary;
+    summary.size = static_cast<qint64>(obj.value("size").toDouble());
+    summary.lastModified = static_cast<qint64>(obj.value("mtime").toDouble());
+    summary.commander = obj.value("commander").toString();
+    summary.lastCommander = obj.value("last_commander").toString();
+    for (const QJsonValue &value : obj.value("commanders").toArray()) {
+        summary.commanders.append(value.toString());
+    }
+    summary.loadGames = obj.value("load_games").toArray();
+    summary.odyssey = obj.value("odyssey").toBool();
+    summary.fsdJumps = obj.value("fsd_jumps").toInt();
+    summary.carrierJumps = obj.value("carrier_jumps").toInt();
+    summary.switchUserEvents = obj.value("switch_user").toInt();
+    summary.firstTimestamp = obj.value("first_timestamp").toString();
+    summary.lastTimestamp = obj.value("last_timestamp").toString();
+    summary.lastLocation = obj.value("last_location").toObject();
+    for (const QJsonValue &value : obj.value("visited").toArray()) {
+        summary.visitedSystems.append(value.toString());
+    }
+    return summary;
+}
+
+JournalIndex::JournalIndex(QObject *parent)
+    : QObject(parent)
+    , m_dirty(false)
+{
+    qRegisterMetaType<JournalFileSummary>("JournalFileSummary");
+    qRegisterMetaType<QList<JournalFileSummary>>("QList<JournalFileSummary>");
+    
+    QString appDataPath = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    QDir().mkpath(appDataPath);
+    m_indexFile = QDir(appDataPath).filePath("journal_index.json");
+    load();
+}
+
+JournalIndex& JournalIndex::instance()
+{
+    QMutexLocker locker(&s_mutex);
+    if (!s_instance) {
+        s_instance = new JournalIndex();
+    }
+    return *s_instance;
+}
+
+QList<JournalFileSummary> JournalIndex::refresh(const QString &journalPath)
+{
+    QList<JournalFileSummary> summaries;
+    QDir journalDir(journalPath);
+    if (journalPath.isEmpty() || !journalDir.exists()) {
+        return summaries;
+    }
+
+    // Archived Journal.*.log.gz files are part of the history too
+    const QFileInfoList journalFiles = JournalLineReader::historyJournals(journalDir);
+
+    // Work out which journals are stale while holding the lock, then parse them without it
+    QStringList staleFiles;
+    {
+        QMutexLocker locker(&m_mutex);
+        for (const QFileInfo &fileInfo : journalFiles) {
+            auto it = m_entries.constFind(fileInfo.absoluteFilePath());
+            if (it == m_entries.constEnd() || it->size != fileInfo.size() ||
+                it->lastModified != fileInfo.lastModified().toMSecsSinceEpoch()) {
+                staleFiles.append(fileInfo.absoluteFilePath());
+            }
+        }
+    }
+
+    QList<JournalFileSummary> parsed;
+    if (!staleFiles.isEmpty()) {
+        parsed = scanFiles(staleFiles);
+        qDebug() << "Journal index: parsed" << parsed.size() << "new or changed journals out of" << journalFiles.size();
+    }
+
+    QMutexLocker locker(&m_mutex);
+
+    for (const JournalFileSummary &summary : parsed) {
+        m_entries.insert(summary.filePath, summary);
+        m_dirty = true;
+    }
+
+    // Merge in folder order so callers always see newest first
+    QSet<QString> presentFiles;
+    for (const QFileInfo &fileInfo : journalFiles) {
+        const QString filePath = fileInfo.absoluteFilePath();
+        presentFiles.insert(filePath);
+        auto it = m_entries.constFind(filePath);
+        if (it != m_entries.constEnd()) {
+            summaries.append(it.value());
+        }
+    }
+
+    // Drop entries for journals that were deleted from this folder
+    const QString folderPrefix = journalDir.absolutePath() + "/";
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (it.key().startsWith(folderPrefix) && !presentFiles.contains(it.key())) {
+            it = m_entries.erase(it);
+            m_dirty = true;
+        } else {
+            ++it;
+        }
+    }
+
+    if (m_dirty) {
+        save();
+    }
+
+    return summaries;
+}
+
+void JournalIndex::refreshAsync(const QString &journalPath)
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        if (m_asyncRefreshes.contains(journalPath)) {
+            // The running refresh will report for this folder as well
+            return;
+        }
+        m_asyncRefreshes.insert(journalPath);
+    }
+
+    QtConcurrent::run([this, journalPath]() {
+        QList<JournalFileSummary> summaries = refresh(journalPath);
+        {
+            QMutexLocker locker(&m_mutex);
+            m_asyncRefreshes.remove(journalPath);
+        }
+        emit refreshFinished(journalPath, summaries);
+    });
+}
+
+QList<JournalFileSummary> JournalIndex::scanFiles(const QStringList &filePaths)
+{
+    const int total = filePaths.size();
+    QAtomicInt completed(0);
+
+    std::function<JournalFileSummary(const QString &)> scan = [this, &completed, total](const QString &filePath) {
+        JournalFileSummary summary = scanFile(filePath);
+        int done = ++completed;
+        if (done == total || done % 25 == 0) {
+            emit scanProgress(done, total);
+        }
+        return summary;
+    };
+
+    // Results come back in input order regardless of which worker finished first
+    return QtConcurrent::blockingMapped<QList<JournalFileSummary>>(filePaths, scan);
+}
+
+JournalFileSummary JournalIndex::summaryForFile(const QString &filePath)
+{
+    QMutexLocker locker(&m_mutex);
+
+    QFileInfo fileInfo(filePath);
+    if (!fileInfo.exists()) {
+        return JournalFileSummary();
+    }
+
+    const QString absolutePath = fileInfo.absoluteFilePath();
+    const qint64 mtime = fileInfo.lastModified().toMSecsSinceEpoch();
+
+    auto it = m_entries.find(absolutePath);
+    if (it == m_entries.end() || it->size != fileInfo.size() || it->lastModified != mtime) {
+        it = m_entries.insert(absolutePath, scanFile(absolutePath));
+        m_dirty = true;
+        save();
+    }
+
+    return it.value();
+}
+
+bool JournalIndex::cachedSummary(const QString &filePath, JournalFileSummary &summary)
+{
+    QMutexLocker locker(&m_mutex);
+
+    QFileInfo fileInfo(filePath);
+    auto it = m_entries.constFind(fileInfo.absoluteFilePath());
+    if (it == m_entries.constEnd() || it->size != fileInfo.size() ||
+        it->lastModified != fileInfo.lastModified().toMSecsSinceEpoch()) {
+        return false;
+    }
+
+    summary = it.value();
+    return true;
+}
+
+JournalFileSummary JournalIndex::scanFile(const QString &filePath)
+{
+    JournalFileSummary summary;
+    QFileInfo fileInfo(filePath);
+    summary.filePath = fileInfo.absoluteFilePath();
+    summary.size = fileInfo.size();
+    summary.lastModified = fileInfo.lastModified().toMSecsSinceEpoch();
+
+    // Plain and gzip-archived journals are read the same way, in chunks
+    JournalLineReader reader(filePath);
+    if (!reader.open()) {
+        qDebug() << "Journal index: could not open" << filePath;
+        return summary;
+    }
+
+    QSet<QString> visited;
+    JournalEvent event;
+    QByteArray line;
+
+    while (reader.readLine(line)) {
+
+        QByteArrayView timestamp = JournalDecoder::timestampOf(line);
+        if (!timestamp.isEmpty()) {
+            if (summary.firstTimestamp.isEmpty()) {
+                summary.firstTimestamp = QString::fromLatin1(timestamp);
+            }
+            summary.lastTimestamp = QString::fromLatin1(timestamp);
+        }
+
+        // The decoder skips everything except the handful of events we index
+        if (!JournalDecoder::decode(line, event)) {
+            continue;
+        }
+
+        switch (event.type) {
+        case JournalEventType::SwitchUser:
+            summary.switchUserEvents++;
+            break;
+        case JournalEventType::Fileheader:
+            summary.odyssey = event.odyssey;
+            break;
+        case JournalEventType::Commander:
+        case JournalEventType::LoadGame:
+            if (event.commander.isEmpty()) {
+                break;
+            }
+            if (summary.commander.isEmpty()) {
+                summary.commander = event.commander;
+            }
+            summary.lastCommander = event.commander;
+            if (!summary.commanders.contains(event.commander)) {
+                summary.commanders.append(event.commander);
+            }
+            if (event.type == JournalEventType::LoadGame) {
+                QJsonObject loadGame;
+                loadGame["Commander"] = event.commander;
+                loadGame["FID"] = event.fid;
+                summary.loadGames.append(loadGame);
+            }
+            break;
+        case JournalEventType::FSDJump:
+        case JournalEventType::CarrierJump:
+        case JournalEventType::Location:
+            if (event.type == JournalEventType::FSDJump) {
+                summary.fsdJumps++;
+            } else if (event.type == JournalEventType::CarrierJump) {
+                summary.carrierJumps++;
+            }
+            if (!visited.contains(event.starSystem)) {
+                visited.insert(event.starSystem);
+                summary.visitedSystems.append(event.starSystem);
+            }
+            summary.lastLocation = event.toJson();
+            break;
+        case JournalEventType::NavRoute:
+        case JournalEventType::NavRouteClear:
+        case JournalEventType::Other:
+            break;
+        }
+    }
+
+    reader.close();
+    return summary;
+}
+
+void JournalIndex::load()
+{
+    QFile file(m_indexFile);
+    if (!file.exists() || !file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    QJsonParseError error;
+    QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &error);
+    file.close();
+
+    if (error.error != QJsonParseError::NoError) {
+        qDebug() << "Failed to parse journal index file:" << error.errorString();
+        return;
+    }
+
+    QJsonObject root = doc.object();
+    if (root.value("version").toInt() != kIndexVersion) {
+        qDebug() << "Journal index format changed, rebuilding";
+        return;
+    }
+
+    QJsonObject files = root.value("files").toObject();
+    for (auto it = files.constBegin(); it != files.constEnd(); ++it) {
+        JournalFileSummary summary = JournalFileSummary::fromJson(it.value().toObject());
+        summary.filePath = it.key();
+        m_entries.insert(it.key(), summary);
+    }
+
+    qDebug() << "Journal index loaded with" << m_entries.size() << "files";
+}
+
+void JournalIndex::save()
+{
+    QJsonObject files;
+    for (auto it = m_entries.constBegin(); it != m_entries.constEnd(); ++it) {
+        files[it.key()] = it.value().toJson();
+    }
+
+    QJsonObject root;
+    root["version"] = kIndexVersion;
+    root["files"] = files;
+
+    QFile file(m_indexFile);
+    if (file.open(QIODevice::WriteOnly)) {
+        file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+        file.close();
+        m_dirty = false;
+    } else {
+        qDebug() << "Failed to save journal index file:" << file.errorString();
+    }
+}
@@ -0,0 +1,88 @@
+#ifndef JOURNALINDEX_H
+#define JOURNALINDEX_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QSet>
+#include <QMetaType>
+
+// Everything the app needs to know about one journal file, so it never has to be re-parsed
+struct JournalFileSummary
+{
+    QString filePath;
+    qint64 size = 0;
+    qint64 lastModified = 0;        // Milliseconds since epoch
+    QString commander;              // First Commander/LoadGame in the file - the journal owner
+    QString lastCommander;          // Last Commander/LoadGame in the file
+    QStringList commanders;         // Every commander name seen in the file, in order of appearance
+    QJsonArray loadGames;           // One {Commander, FID} object per LoadGame event
+    bool odyssey = false;
+    int fsdJumps = 0;
+    int carrierJumps = 0;
+    int switchUserEvents = 0;
+    QString firstTimestamp;
+    QString lastTimestamp;
+    QJsonObject lastLocation;       // event, timestamp, StarSystem and StarPos of the latest FSDJump/CarrierJump/Location
+    QStringList visitedSystems;     // Unique StarSystem values from FSDJump/CarrierJump/Location
+
+    QString fileName() const;
+    QJsonObject toJson() const;
+    static JournalFileSummary fromJson(const QJsonObject &obj);
+};
+
+Q_DECLARE_METATYPE(JournalFileSummary)
+
+// Persistent per-file journal index shared by every journal scan.
+// Files are keyed by path and only re-parsed when their size or modification time changes.
+class JournalIndex : public QObject
+{
+    Q_OBJECT
+
+public:
+    static JournalIndex& instance();
+
+    // Bring the index up to date with the journal folder and return all summaries, newest first.
+    // Changed files are parsed in parallel; the calling thread blocks until they are done.
+    QList<JournalFileSummary> refresh(const QString &journalPath);
+
+    // Same as refresh() but runs on the worker pool and reports through refreshFinished()
+    void refreshAsync(const QString &journalPath);
+
+    // Summary for a single file, re-parsing it only if it changed since it was indexed
+    JournalFileSummary summaryForFile(const QString &filePath);
+
+    // Summary for a single file only if the index already has it up to date - never parses
+    bool cachedSummary(const QString &filePath, JournalFileSummary &summary);
+
+    // Parse one journal file from scratch
+    static JournalFileSummary scanFile(const QString &filePath);
+
+signals:
+    void scanProgress(int completed, int total);
+    void refreshFinished(const QString &journalPath, const QList<JournalFileSummary> &summaries);
+
+private:
+    JournalIndex(QObject *parent = nullptr);
+
+    QList<JournalFileSummary> scanFiles(const QStringList &filePaths);
+
+    void load();
+    void save();
+
+    static QMutex s_mutex;
+    static JournalIndex* s_instance;
+
+    QMutex m_mutex;
+    QString m_indexFile;
+    QHash<QString, JournalFileSummary> m_entries;  // Absolute file path -> summary
+    bool m_dirty;
+    QSet<QString> m_asyncRefreshes;  // Journal folders with a refreshAsync() still running
+};
+
+#endif // JOURNALINDEX_H
@@ -0,0 +1,244 @@
+#include "journallinereader.h"
+#include <QDebug>
+#include <cstring>
+
+#ifdef EDRH_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace {
+
+const qint64 kReadChunkSize = 64 * 1024;
+const int kInflateChunkSize = 256 * 1024;
+
+}
+
+struct JournalLineReader::Inflater
+{
+#ifdef EDRH_HAVE_ZLIB
+    z_stream stream;
+    QByteArray input;
+    bool initialised = false;
+
+    ~Inflater()
+    {
+        if (initialised) {
+            inflateEnd(&stream);
+        }
+    }
+#endif
+};
+
+JournalLineReader::JournalLineReader(const QString &filePath)
+    : m_file(filePath)
+    , m_archive(isArchive(filePath))
+    , m_atEnd(false)
+    , m_position(0)
+    , m_consumed(0)
+    , m_lastLineComplete(true)
+{
+}
+
+JournalLineReader::~JournalLineReader()
+{
+    close();
+}
+
+bool JournalLineReader::isArchive(const QString &filePath)
+{
+    return filePath.endsWith(".gz", Qt::CaseInsensitive);
+}
+
+bool JournalLineReader::archivesSupported()
+{
+#ifdef EDRH_HAVE_ZLIB
+    return true;
+#else
+    return false;
+#endif
+}
+
+QStringList JournalLineReader::historyNameFilters()
+{
+    QStringList filters;
+    filters << "Journal.*.log";
+    if (archivesSupported()) {
+        filters << "Journal.*.log.gz";
+    }
+    return filters;
+}
+
+QFileInfoList JournalLineReader::historyJournals(const QDir &directory)
+{
+    QFileInfoList journals;
+    const QFileInfoList candidates = directory.entryInfoList(historyNameFilters(),
+                                                             QDir::Files | QDir::Readable, QDir::Time);
+    for (const QFileInfo &fileInfo : candidates) {
+        if (isArchive(fileInfo.fileName()) && directory.exists(fileInfo.completeBaseName())) {
+            continue;
+        }
+        journals.append(fileInfo);
+    }
+    return journals;
+}
+
+bool JournalLineReader::open()
+{
+    if (m_archive && !archivesSupported()) {
+        qDebug() << "Journal archive skipped, built without zlib:" << m_file.fileName();
+        return false;
+    }
+
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    m_buffer.clear();
+    m_position = 0;
+    m_consumed = 0;
+    m_lastLineComplete = true;
+    m_atEnd = false;
+
+#ifdef EDRH_HAVE_ZLIB
+    if (m_archive) {
+        m_inflater.reset(new Inflater);
+        std::memset(&m_inflater->stream, 0, sizeof(z_stream));
+        // 15 + 32: maximum window, detect the gzip header automatically
+        if (inflateInit2(&m_inflater->stream, 15 + 32) != Z_OK) {
+            qDebug() << "Failed to initialise inflater for" << m_file.fileName();
+            m_inflater.reset();
+            m_file.close();
+            return false;
+        }
+        m_inflater->initialised = true;
+    }
+#endif
+
+    return true;
+}
+
+void JournalLineReader::close()
+{
+    m_inflater.reset();
+    m_file.close();
+    m_buffer.clear();
+    m_position = 0;
+}
+
+bool JournalLineReader::readLine(QByteArray &line)
+{
+    while (true) {
+        qsizetype newline = m_buffer.indexOf('\n', m_position);
+        if (newline >= 0) {
+            line = m_buffer.mid(m_position, newline - m_position).trimmed();
+            m_consumed += newline + 1 - m_position;
+            m_position = newline + 1;
+            if (!line.isEmpty()) {
+                m_lastLineComplete = true;
+                return true;
+            }
+            continue;
+        }
+
+        // Keep the partial line and pull in the next chunk
+        m_buffer.remove(0, m_position);
+        m_position = 0;
+        if (!fillBuffer()) {
+            // A journal cut off mid-write still yields its last line
+            line = m_buffer.trimmed();
+            m_consumed += m_buffer.size();
+            m_buffer.clear();
+            m_lastLineComplete = false;
+            return !line.isEmpty();
+        }
+    }
+}
+
+bool JournalLineReader::skipTo(qint64 offset)
+{
+    if (offset <= m_consumed) {
+        return offset == m_consumed;
+    }
+
+    if (!m_archive) {
+        m_buffer.clear();
+        m_position = 0;
+        if (offset > m_file.size() || !m_file.seek(offset)) {
+            return false;
+        }
+        m_consumed = offset;
+        return true;
+    }
+
+    // Archives have to be inflated up to the offset
+    while (m_consumed + (m_buffer.size() - m_position) < offset) {
+        m_consumed += m_buffer.size() - m_position;
+        m_buffer.clear();
+        m_position = 0;
+        if (!fillBuffer()) {
+            return false;
+        }
+    }
+    m_position += offset - m_consumed;
+    m_consumed = offset;
+    return true;
+}
+
+bool JournalLineReader::fillBuffer()
+{
+    if (m_atEnd) {
+        return false;
+    }
+
+    if (!m_archive) {
+        QByteArray chunk = m_file.read(kReadChunkSize);
+        if (chunk.isEmpty()) {
+            m_atEnd = true;
+            return false;
+        }
+        m_buffer.append(chunk);
+        return true;
+    }
+
+#ifdef EDRH_HAVE_ZLIB
+    z_stream &stream = m_inflater->stream;
+    const qsizetype startSize = m_buffer.size();
+
+    // Loop until some output is produced, as a small input chunk can be all header
+    while (m_buffer.size() == startSize) {
+        if (stream.avail_in == 0) {
+            m_inflater->input = m_file.read(kReadChunkSize);
+            if (m_inflater->input.isEmpty()) {
+                m_atEnd = true;
+                return false;
+            }
+            stream.next_in = reinterpret_cast<Bytef *>(m_inflater->input.data());
+            stream.avail_in = uInt(m_inflater->input.size());
+        }
+
+        m_buffer.resize(startSize + kInflateChunkSize);
+        stream.next_out = reinterpret_cast<Bytef *>(m_buffer.data() + startSize);
+        stream.avail_out = uInt(kInflateChunkSize);
+
+        int result = inflate(&stream, Z_NO_FLUSH);
+        m_buffer.resize(startSize + (kInflateChunkSize - qsizetype(stream.avail_out)));
+
+        if (result == Z_STREAM_END) {
+            // gzip allows several members back to back (e.g. appended archives)
+            if (stream.avail_in > 0 || !m_file.atEnd()) {
+                inflateReset(&stream);
+            } else if (m_buffer.size() == startSize) {
+                m_atEnd = true;
+                return false;
+            }
+        } else if (result != Z_OK && result != Z_BUF_ERROR) {
+            qDebug() << "Corrupt journal archive" << m_file.fileName() << "- zlib error" << result;
+            m_atEnd = true;
+            return m_buffer.size() > startSize;
+        }
+    }
+    return true;
+#else
+    return false;
+#endif
+}
@@ -0,0 +1,58 @@
+#ifndef JOURNALLINEREADER_H
+#define JOURNALLINEREADER_H
+
+#include <QFile>
+#include <QByteArray>
+#include <QString>
+#include <QStringList>
+#include <QDir>
+#include <QFileInfo>
+#include <memory>
+
+// Forward reader for history scans that treats Journal.*.log and gzip archived
+// Journal.*.log.gz the same. Archives are inflated in fixed-size chunks straight
+// from the file - nothing is written to disk and the whole journal is never in memory.
+class JournalLineReader
+{
+public:
+    explicit JournalLineReader(const QString &filePath);
+    ~JournalLineReader();
+
+    bool open();
+    void close();
+
+    // Next non-empty line, trimmed; returns false at the end of the journal or on a read error
+    bool readLine(QByteArray &line);
+
+    // Decoded bytes consumed so far, up to the end of the last line returned
+    qint64 position() const { return m_consumed; }
+    // False when the last line returned had no newline yet (a journal still being written)
+    bool lastLineComplete() const { return m_lastLineComplete; }
+    // Skip to a decoded byte offset - a seek for plain journals, inflate-and-discard for archives
+    bool skipTo(qint64 offset);
+
+    static bool isArchive(const QString &filePath);
+    static bool archivesSupported();
+
+    // Name filters for every journal a history scan should read
+    static QStringList historyNameFilters();
+
+    // Every journal in the folder, newest first; an archive is skipped while its plain log still exists
+    static QFileInfoList historyJournals(const QDir &directory);
+
+private:
+    struct Inflater;
+
+    bool fillBuffer();
+
+    QFile m_file;
+    bool m_archive;
+    bool m_atEnd;
+    std::unique_ptr<Inflater> m_inflater;
+    QByteArray m_buffer;    // Decoded bytes not yet returned as lines
+    qsizetype m_position;   // Start of the next line in m_buffer
+    qint64 m_consumed;
+    bool m_lastLineComplete;
+};
+
+#endif // JOURNALLINEREADER_H
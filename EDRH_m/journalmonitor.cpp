@@ -1,32 +1,63 @@
 #include "journalmonitor.h"
+#include "journalreversereader.h"
+#include "journallinereader.h"
+#include "jumpstore.h"
 #include <QStandardPaths>
 #include <QJsonArray>
 #include <QJsonParseError>
 #include <QFile>
+#include <QSaveFile>
 #include <QTextStream>
 #include <QDebug>
 #include <QFileInfo>
 #include <QRegularExpression>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QTimer>
 
 JournalMonitor::JournalMonitor(QObject *parent)
     : QObject(parent)
     , m_fileWatcher(new QFileSystemWatcher(this))
-    , m_updateTimer(new QTimer(this))
+    , m_readerThread(new QThread(this))
+    , m_reader(new JournalReaderWorker(&m_eventQueue))
     , m_isMonitoring(false)
-    , m_lastFileSize(0)
     , m_forcedCommanderEnabled(false)
 {
-    // Set up timer for periodic checks
-    m_updateTimer->setInterval(1000); // Check every second
-    m_updateTimer->setSingleShot(false);
-    
-    // Connect signals
+    // Journal updates are driven entirely by file system notifications - no polling
     connect(m_fileWatcher, &QFileSystemWatcher::fileChanged, 
             this, &JournalMonitor::onFileChanged);
     connect(m_fileWatcher, &QFileSystemWatcher::directoryChanged, 
             this, &JournalMonitor::onDirectoryChanged);
-    connect(m_updateTimer, &QTimer::timeout, 
-            this, &JournalMonitor::checkForUpdates);
+    
+    // Journal reads happen on the reader thread; only decoded events reach the GUI thread
+    m_reader->moveToThread(m_readerThread);
+    connect(m_readerThread, &QThread::finished, m_reader, &QObject::deleteLater);
+    connect(m_reader, &JournalReaderWorker::eventsAvailable,
+            this, &JournalMonitor::onReaderEventsAvailable);
+    connect(m_reader, &JournalReaderWorker::fileRead,
+            this, &JournalMonitor::onReaderFileRead);
+    connect(m_reader, &JournalReaderWorker::readFailed,
+            this, &JournalMonitor::onReaderReadFailed);
+    m_readerThread->setObjectName("JournalReader");
+    m_readerThread->start();
+    
+    // Full-history scans run on the worker pool and report back here
+    connect(&JournalIndex::instance(), &JournalIndex::refreshFinished,
+            this, &JournalMonitor::onJournalIndexRefreshed);
+    connect(&JournalIndex::instance(), &JournalIndex::scanProgress,
+            this, &JournalMonitor::journalScanProgress);
+    
+    // Byte offsets are persisted so a relaunch resumes the live journal instead of replaying it
+    QString appDataPath = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    QDir().mkpath(appDataPath);
+    m_tailStateFile = QDir(appDataPath).filePath("journal_tail_state.json");
+    loadTailState();
+}
+
+JournalMonitor::~JournalMonitor()
+{
+    m_readerThread->quit();
+    m_readerThread->wait();
 }
 
 void JournalMonitor::setJournalPath(const QString &path)
@@ -68,6 +99,10 @@ void JournalMonitor::startMonitoring()
     updateCurrentJournalFile();
     
     if (!m_currentJournalFile.isEmpty()) {
+        // Resume from the saved offset if we were already tailing this file, otherwise read it from the start
+        if (!restoreTailState(m_currentJournalFile)) {
+            m_fileOffsets.remove(QFileInfo(m_currentJournalFile).fileName());
+        }
         processJournalFile(m_currentJournalFile);
         
         // Watch the current journal file
@@ -76,11 +111,22 @@ void JournalMonitor::startMonitoring()
         }
     }
     
+    // The plotted route lives next to the journals and is rewritten on every NavRoute event
+    const QString navRouteFile = navRouteFilePath();
+    if (QFileInfo::exists(navRouteFile)) {
+        if (!m_fileWatcher->files().contains(navRouteFile)) {
+            m_fileWatcher->addPath(navRouteFile);
+        }
+        loadNavRoute();
+    }
+    
     // Scan all journals for commanders at startup
     scanAllJournalsForCommanders();
     
+    // Bring the jump history up to date in the background
+    JumpStore::instance().ingestFolderAsync(m_journalPath);
+    
     m_isMonitoring = true;
-    m_updateTimer->start();
     emit isMonitoringChanged();
     
     qDebug() << "Journal monitoring started for:" << m_journalPath;
@@ -88,7 +134,7 @@ void JournalMonitor::startMonitoring()
 
 void JournalMonitor::stopMonitoring()
 {
-    m_updateTimer->stop();
+    saveTailState();
     m_fileWatcher->removePaths(m_fileWatcher->files());
     m_fileWatcher->removePaths(m_fileWatcher->directories());
     
@@ -180,99 +226,334 @@ QString JournalMonitor::getLatestJournalFile()
 
 void JournalMonitor::onFileChanged(const QString &path)
 {
-    if (path == m_currentJournalFile) {
-        QFileInfo fileInfo(path);
-        if (fileInfo.size() > m_lastFileSize) {
-            qDebug() << "Journal file changed, processing updates...";
-            processJournalFile(path);
-            m_lastFileSize = fileInfo.size();
+    if (path == navRouteFilePath()) {
+        loadNavRoute();
+        if (QFileInfo::exists(path) && !m_fileWatcher->files().contains(path)) {
+            m_fileWatcher->addPath(path);
         }
+        return;
+    }
+    
+    if (path != m_currentJournalFile) {
+        return;
+    }
+    
+    if (!QFileInfo::exists(path)) {
+        // File was deleted or renamed away - the directory watcher will pick up its replacement
+        qDebug() << "Current journal file disappeared:" << path;
+        return;
+    }
+    
+    processJournalFile(path);
+    
+    // Some writers replace the file instead of appending, which silently drops it from the watcher
+    if (!m_fileWatcher->files().contains(path)) {
+        m_fileWatcher->addPath(path);
     }
 }
 
 void JournalMonitor::onDirectoryChanged(const QString &path)
 {
-    Q_UNUSED(path)
-    // Check if a new journal file was created
-    updateCurrentJournalFile();
+    // A directory notification means a journal was created, removed or renamed.
+    // The newest file is always the live one, even before it contains a jump.
+    const QString navRouteFile = navRouteFilePath();
+    if (QFileInfo::exists(navRouteFile) && !m_fileWatcher->files().contains(navRouteFile)) {
+        m_fileWatcher->addPath(navRouteFile);
+        loadNavRoute();
+    }
+    
+    QStringList journalFiles = findJournalFiles(path);
+    if (journalFiles.isEmpty()) {
+        return;
+    }
+    
+    QString newestJournal = journalFiles.first();
+    if (newestJournal != m_currentJournalFile) {
+        qDebug() << "New journal file detected:" << newestJournal;
+        
+        // Pick up the final lines (Shutdown etc.) of the previous journal before switching
+        if (!m_currentJournalFile.isEmpty() && QFileInfo::exists(m_currentJournalFile)) {
+            processJournalFile(m_currentJournalFile);
+        }
+        
+        setCurrentJournalFile(newestJournal);
+        processJournalFile(m_currentJournalFile);
+    }
 }
 
-void JournalMonitor::checkForUpdates()
+void JournalMonitor::processJournalFile(const QString &filePath)
 {
-    if (!m_currentJournalFile.isEmpty()) {
-        QFileInfo fileInfo(m_currentJournalFile);
-        if (fileInfo.exists() && fileInfo.size() > m_lastFileSize) {
-            processJournalFile(m_currentJournalFile);
-            m_lastFileSize = fileInfo.size();
+    // Notifications that arrive while a read is running fold into one follow-up read
+    if (m_readsInFlight.contains(filePath)) {
+        m_rereadRequested.insert(filePath);
+        return;
+    }
+    
+    m_readsInFlight.insert(filePath);
+    const qint64 offset = m_fileOffsets.value(QFileInfo(filePath).fileName(), 0);
+    JournalReaderWorker *reader = m_reader;
+    QMetaObject::invokeMethod(reader, [reader, filePath, offset]() {
+        reader->readFile(filePath, offset);
+    }, Qt::QueuedConnection);
+}
+
+void JournalMonitor::onReaderEventsAvailable()
+{
+    drainEvents();
+}
+
+void JournalMonitor::onReaderFileRead(const QString &filePath, qint64 offset, int eventCount)
+{
+    // Normally already drained by onReaderEventsAvailable(), which is queued ahead of this
+    drainEvents();
+    
+    m_readsInFlight.remove(filePath);
+    m_fileOffsets[QFileInfo(filePath).fileName()] = offset;
+    saveTailState();
+    
+    if (eventCount > 0) {
+        qDebug() << "Journal reader:" << eventCount << "events from" << QFileInfo(filePath).fileName();
+        // The store reads the new bytes on the pool; its updated() signal reports the result
+        JumpStore::instance().ingestFileAsync(filePath);
+    }
+    
+    if (m_rereadRequested.remove(filePath)) {
+        processJournalFile(filePath);
+    }
+}
+
+void JournalMonitor::onReaderReadFailed(const QString &filePath, const QString &error)
+{
+    emit journalError(error);
+    m_readsInFlight.remove(filePath);
+    m_rereadRequested.remove(filePath);
+    
+    // Usually transient (file locked by the game or an AV scan): try again shortly rather
+    // than waiting for a watcher notification that may not come
+    QTimer::singleShot(READ_RETRY_DELAY_MS, this, [this, filePath]() {
+        if (m_isMonitoring && QFileInfo::exists(filePath)) {
+            processJournalFile(filePath);
+        }
+    });
+}
+
+void JournalMonitor::drainEvents()
+{
+    m_reader->clearWakePending();
+    
+    // Commander changes and visits are applied in order, but a burst of arrivals
+    // (startup replay, catching up after sleep) only delivers the latest position
+    JournalEvent event;
+    JournalEvent latestLocation;
+    int locationEvents = 0;
+    int routeEvents = 0;
+    bool routeCleared = false;
+    while (m_eventQueue.pop(event)) {
+        switch (event.type) {
+        case JournalEventType::NavRoute:
+        case JournalEventType::NavRouteClear:
+            routeEvents++;
+            routeCleared = event.type == JournalEventType::NavRouteClear;
+            break;
+        case JournalEventType::Commander:
+        case JournalEventType::LoadGame:
+            extractCommanderName(event.commander);
+            break;
+        case JournalEventType::FSDJump:
+        case JournalEventType::CarrierJump:
+        case JournalEventType::Location:
+            // Every arrival counts as a visit for the journal owner, even if a forced commander filters the jump
+            m_visitedSystems.insert(m_actualJournalCommander, event.starSystem);
+            
+            // JOURNAL = CMDR RULE: jumps from other commanders never become the latest position
+            if (m_forcedCommanderEnabled && !m_forcedCommanderName.isEmpty() &&
+                m_actualJournalCommander != m_forcedCommanderName) {
+                qDebug() << "Ignoring" << event.eventName() << "to" << event.starSystem << "from journal commander" << m_actualJournalCommander
+                         << "(Force Main CMDR is set to" << m_forcedCommanderName << ")";
+                break;
+            }
+            latestLocation = event;
+            locationEvents++;
+            break;
+        default:
+            break;
         }
     }
     
-    // Check for new journal files
-    QString latestJournal = getLatestJournalFile();
-    if (!latestJournal.isEmpty() && latestJournal != m_currentJournalFile) {
-        qDebug() << "New journal file detected:" << latestJournal;
-        updateCurrentJournalFile();
+    // Only the last route event matters; NavRoute.json already holds its waypoints
+    if (routeEvents > 0) {
+        if (routeCleared) {
+            clearNavRoute();
+        } else {
+            loadNavRoute();
+        }
+    }
+    
+    if (locationEvents == 0) {
+        return;
+    }
+    if (locationEvents > 1) {
+        qDebug() << "Coalesced" << locationEvents << "location events into a single update for" << latestLocation.starSystem;
+    }
+    
+    switch (latestLocation.type) {
+    case JournalEventType::FSDJump:
+        processFSDJump(latestLocation);
+        break;
+    case JournalEventType::CarrierJump:
+        processCarrierJump(latestLocation);
+        break;
+    default:
+        processLocation(latestLocation);
+        break;
     }
 }
 
-void JournalMonitor::processJournalFile(const QString &filePath)
+QString JournalMonitor::navRouteFilePath() const
 {
-    QFile file(filePath);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        emit journalError("Failed to open journal file: " + filePath);
+    return m_journalPath.isEmpty() ? QString() : QDir(m_journalPath).filePath("NavRoute.json");
+}
+
+void JournalMonitor::loadNavRoute()
+{
+    QFile file(navRouteFilePath());
+    if (!file.open(QIODevice::ReadOnly)) {
         return;
     }
     
-    QTextStream stream(&file);
+    QJsonParseError error;
+    QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &error);
+    file.close();
     
-    // If we're processing incrementally, seek to the last position
-    if (m_lastFileSize > 0) {
-        stream.seek(m_lastFileSize);
+    // The game rewrites the file in place, so a notification can land mid-write; the next one will succeed
+    if (error.error != QJsonParseError::NoError) {
+        qDebug() << "NavRoute.json not readable yet:" << error.errorString();
+        return;
     }
     
-    while (!stream.atEnd()) {
-        QString line = stream.readLine().trimmed();
-        if (!line.isEmpty()) {
-            processJournalLine(line);
+    QVariantList route;
+    const QJsonArray waypoints = doc.object().value("Route").toArray();
+    for (const QJsonValue &value : waypoints) {
+        QJsonObject waypoint = value.toObject();
+        QJsonArray starPos = waypoint.value("StarPos").toArray();
+        if (starPos.size() < 3) {
+            continue;
         }
+        
+        QVariantMap entry;
+        entry["name"] = waypoint.value("StarSystem").toString();
+        entry["x"] = starPos[0].toDouble();
+        entry["y"] = starPos[1].toDouble();
+        entry["z"] = starPos[2].toDouble();
+        entry["starClass"] = waypoint.value("StarClass").toString();
+        route.append(entry);
     }
     
-    file.close();
+    if (route == m_navRoute) {
+        return;
+    }
+    
+    m_navRoute = route;
+    emit navRouteChanged();
+    qDebug() << "Nav route updated:" << m_navRoute.size() << "waypoints";
+}
+
+void JournalMonitor::clearNavRoute()
+{
+    if (m_navRoute.isEmpty()) {
+        return;
+    }
+    
+    m_navRoute.clear();
+    emit navRouteChanged();
+    qDebug() << "Nav route cleared";
 }
 
-void JournalMonitor::processJournalLine(const QString &line)
+void JournalMonitor::loadTailState()
 {
-    QJsonParseError parseError;
-    QJsonDocument doc = QJsonDocument::fromJson(line.toUtf8(), &parseError);
+    QFile file(m_tailStateFile);
+    if (!file.exists() || !file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+    
+    QJsonParseError error;
+    QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &error);
+    file.close();
     
-    if (parseError.error != QJsonParseError::NoError) {
-        return; // Skip invalid JSON lines
+    if (error.error != QJsonParseError::NoError) {
+        qDebug() << "Failed to parse journal tail state file:" << error.errorString();
+        return;
     }
     
-    QJsonObject entry = doc.object();
-    QString event = entry.value("event").toString();
+    QJsonObject state = doc.object();
+    QJsonObject offsets = state.value("offsets").toObject();
+    for (auto it = offsets.constBegin(); it != offsets.constEnd(); ++it) {
+        m_fileOffsets.insert(it.key(), static_cast<qint64>(it.value().toDouble()));
+    }
+    m_tailSession = state.value("session").toObject();
+}
+
+void JournalMonitor::saveTailState()
+{
+    QJsonObject offsets;
+    for (auto it = m_fileOffsets.constBegin(); it != m_fileOffsets.constEnd(); ++it) {
+        offsets[it.key()] = static_cast<double>(it.value());
+    }
     
-    if (event == "Commander") {
-        extractCommanderName(entry);
-    } else if (event == "FSDJump") {
-        processFSDJump(entry);
-    } else if (event == "CarrierJump") {
-        processCarrierJump(entry);
-    } else if (event == "Location") {
-        processLocation(entry);
-    } else if (event == "LoadGame") {
-        extractCommanderName(entry);
+    m_tailSession = QJsonObject();
+    m_tailSession["file"] = QFileInfo(m_currentJournalFile).fileName();
+    m_tailSession["commander"] = m_actualJournalCommander;
+    m_tailSession["system"] = m_currentSystem;
+    m_tailSession["lastJump"] = m_lastJumpData;
+    
+    QJsonObject state;
+    state["version"] = "1.0";
+    state["offsets"] = offsets;
+    state["session"] = m_tailSession;
+    
+    // Written to a temporary file and renamed, so a crash mid-write keeps the previous state
+    QSaveFile file(m_tailStateFile);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qDebug() << "Failed to save journal tail state file:" << file.errorString();
+        return;
+    }
+    file.write(QJsonDocument(state).toJson(QJsonDocument::Compact));
+    if (!file.commit()) {
+        qDebug() << "Failed to save journal tail state file:" << file.errorString();
     }
 }
 
-void JournalMonitor::extractCommanderName(const QJsonObject &entry)
+bool JournalMonitor::restoreTailState(const QString &filePath)
 {
-    QString commander = entry.value("Name").toString();
-    if (commander.isEmpty()) {
-        // Try LoadGame event format
-        commander = entry.value("Commander").toString();
+    const QString fileName = QFileInfo(filePath).fileName();
+    if (m_tailSession.value("file").toString() != fileName) {
+        return false;
     }
     
+    qint64 offset = m_fileOffsets.value(fileName, 0);
+    if (offset <= 0 || offset > QFileInfo(filePath).size()) {
+        return false;
+    }
+    
+    qDebug() << "Resuming journal" << fileName << "at byte offset" << offset;
+    
+    // Re-apply the state the skipped part of the file would have produced
+    QString commander = m_tailSession.value("commander").toString();
+    if (!commander.isEmpty()) {
+        extractCommanderName(commander);
+    }
+    
+    QJsonObject lastJump = m_tailSession.value("lastJump").toObject();
+    QString lastSystem = lastJump.value("StarSystem").toString();
+    if (!lastSystem.isEmpty() && lastSystem != m_currentSystem) {
+        applyLocation(lastSystem, lastJump);
+    }
+    
+    return true;
+}
+
+void JournalMonitor::extractCommanderName(const QString &commander)
+{
     if (!commander.isEmpty()) {
         // Track the actual journal owner (before any forced commander override)
         m_actualJournalCommander = commander;
@@ -303,9 +584,9 @@ void JournalMonitor::extractCommanderName(const QJsonObject &entry)
     }
 }
 
-void JournalMonitor::processFSDJump(const QJsonObject &entry)
+void JournalMonitor::processFSDJump(const JournalEvent &event)
 {
-    QString system = entry.value("StarSystem").toString();
+    const QString &system = event.starSystem;
     if (!system.isEmpty() && system != m_currentSystem) {
         // JOURNAL = CMDR RULE: If Force Main CMDR is active, ignore jumps from other commanders
         if (m_forcedCommanderEnabled && !m_forcedCommanderName.isEmpty()) {
@@ -318,16 +599,16 @@ void JournalMonitor::processFSDJump(const QJsonObject &entry)
         }
         
         m_currentSystem = system;
-        m_lastJumpData = entry;
+        m_lastJumpData = event.toJson();
         emit currentSystemChanged();
-        emit fsdJumpDetected(system, entry);
+        emit fsdJumpDetected(system, m_lastJumpData);
         qDebug() << "FSD Jump to:" << system;
     }
 }
 
-void JournalMonitor::processCarrierJump(const QJsonObject &entry)
+void JournalMonitor::processCarrierJump(const JournalEvent &event)
 {
-    QString system = entry.value("StarSystem").toString();
+    const QString &system = event.starSystem;
     if (!system.isEmpty() && system != m_currentSystem) {
         // JOURNAL = CMDR RULE: If Force Main CMDR is active, ignore jumps from other commanders
         if (m_forcedCommanderEnabled && !m_forcedCommanderName.isEmpty()) {
@@ -340,41 +621,62 @@ void JournalMonitor::processCarrierJump(const QJsonObject &entry)
         }
         
         m_currentSystem = system;
-        m_lastJumpData = entry;
+        m_lastJumpData = event.toJson();
         emit currentSystemChanged();
-        emit carrierJumpDetected(system, entry);
+        emit carrierJumpDetected(system, m_lastJumpData);
         qDebug() << "Carrier Jump to:" << system;
     }
 }
 
-void JournalMonitor::processLocation(const QJsonObject &entry)
+void JournalMonitor::processLocation(const JournalEvent &event)
 {
-    QString system = entry.value("StarSystem").toString();
-    if (!system.isEmpty() && system != m_currentSystem) {
-        m_currentSystem = system;
-        m_lastJumpData = entry;
-        emit currentSystemChanged();
-        
-        // Extract coordinates from Location event just like FSD jumps
-        if (entry.contains("StarPos")) {
-            emit fsdJumpDetected(system, entry);
-        }
-        
-        qDebug() << "Location update:" << system;
+    if (!event.starSystem.isEmpty() && event.starSystem != m_currentSystem) {
+        applyLocation(event.starSystem, event.toJson());
+    }
+}
+
+void JournalMonitor::applyLocation(const QString &system, const QJsonObject &locationData)
+{
+    m_currentSystem = system;
+    m_lastJumpData = locationData;
+    emit currentSystemChanged();
+    
+    // Extract coordinates from Location event just like FSD jumps
+    if (locationData.contains("StarPos")) {
+        emit fsdJumpDetected(system, locationData);
     }
+    
+    qDebug() << "Location update:" << system;
 }
 
 void JournalMonitor::updateCurrentJournalFile()
 {
     QString latestJournal = getLatestJournalFile();
     if (!latestJournal.isEmpty() && latestJournal != m_currentJournalFile) {
+        setCurrentJournalFile(latestJournal);
+    }
+}
+
+void JournalMonitor::setCurrentJournalFile(const QString &filePath)
+{
+    if (!filePath.isEmpty() && filePath != m_currentJournalFile) {
         // Stop watching old file
         if (!m_currentJournalFile.isEmpty()) {
             m_fileWatcher->removePath(m_currentJournalFile);
         }
         
-        m_currentJournalFile = latestJournal;
-        m_lastFileSize = 0; // Reset to process entire file
+        // Only the previous and the new journal can still receive writes - forget older offsets
+        const QString previousName = QFileInfo(m_currentJournalFile).fileName();
+        const QString newName = QFileInfo(filePath).fileName();
+        for (auto it = m_fileOffsets.begin(); it != m_fileOffsets.end();) {
+            if (it.key() != previousName && it.key() != newName) {
+                it = m_fileOffsets.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        
+        m_currentJournalFile = filePath;
         
         // Extract commander from new journal file to track actual journal owner
         QString newJournalCommander = extractCommanderFromJournal(m_currentJournalFile);
@@ -486,35 +788,76 @@ int JournalMonitor::countTotalJumps() const
         return 0;
     }
     
-    // Get all journal files
+    // Jump counts come from the columnar jump store. New journal bytes are ingested in the
+    // background; the count grows through JumpStore::updated() once they are in.
+    JumpStore &store = JumpStore::instance();
+    store.ingestFolderAsync(m_journalPath);
+    
+    // Total jumps counted so far
+    return store.totalJumps();
+}
+
+QVariantMap JournalMonitor::jumpStatistics(const QString &commanderName) const
+{
+    QElapsedTimer timer;
+    timer.start();
+    
+    // Statistics cover what has been ingested so far; anything newer follows in the background
+    JumpStore &store = JumpStore::instance();
+    if (!m_journalPath.isEmpty()) {
+        store.ingestFolderAsync(m_journalPath);
+    }
+    
+    QVariantMap perDay;
+    const QMap<QDate, int> days = store.jumpsPerDay(commanderName);
+    for (auto it = days.constBegin(); it != days.constEnd(); ++it) {
+        perDay.insert(it.key().toString("yyyy-MM-dd"), it.value());
+    }
+    
+    QVariantMap perCommander;
+    const QHash<QString, int> commanders = store.jumpsPerCommander();
+    for (auto it = commanders.constBegin(); it != commanders.constEnd(); ++it) {
+        perCommander.insert(it.key(), it.value());
+    }
+    
+    QVariantMap result;
+    result["totalJumps"] = store.totalJumps(commanderName);
+    result["totalDistance"] = store.totalDistance(commanderName);
+    result["jumpsPerDay"] = perDay;
+    result["jumpsPerCommander"] = perCommander;
+    
+    qDebug() << "Jump statistics for" << (commanderName.isEmpty() ? QString("all commanders") : commanderName)
+             << "computed in" << timer.elapsed() << "ms";
+    return result;
+}
+
+QString JournalMonitor::firstVisitDate(const QString &systemName, const QString &commanderName) const
+{
+    const QDateTime first = JumpStore::instance().firstVisit(systemName, commanderName);
+    return first.isValid() ? first.toString(Qt::ISODate) : QString();
+}
+
+#ifdef EDRH_BENCHMARKS
+QVariantMap JournalMonitor::benchmarkJournalDecoder(int maxFiles) const
+{
+    if (m_journalPath.isEmpty()) {
+        qDebug() << "No journal path set for decoder benchmark";
+        return QVariantMap();
+    }
+    
+    QDir journalDir(m_journalPath);
     QStringList filters;
     filters << "Journal.*.log";
-    QFileInfoList journalFiles = journalDir.entryInfoList(filters, QDir::Files | QDir::Readable, QDir::Name);
-    
-    int totalJumps = 0;
+    QFileInfoList journalFiles = journalDir.entryInfoList(filters, QDir::Files | QDir::Readable, QDir::Time);
     
-    for (const QFileInfo &fileInfo : journalFiles) {
-        QFile file(fileInfo.absoluteFilePath());
-        if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-            qDebug() << "Could not open journal file for jump counting:" << fileInfo.absoluteFilePath();
-            continue;
-        }
-        
-        QTextStream stream(&file);
-        QString line;
-        while (stream.readLineInto(&line)) {
-            // Count FSDJump and CarrierJump events
-            if (line.contains("\"event\":\"FSDJump\"") || line.contains("\"event\":\"CarrierJump\"")) {
-                totalJumps++;
-            }
-        }
-        
-        file.close();
+    QStringList filePaths;
+    for (int i = 0; i < qMin(maxFiles, journalFiles.size()); i++) {
+        filePaths.append(journalFiles[i].absoluteFilePath());
     }
     
-    // Total jumps counted
-    return totalJumps;
-} 
+    return JournalDecoder::benchmark(filePaths);
+}
+#endif
 
 QString JournalMonitor::extractCommanderFromJournal(const QString &journalFilePath)
 {
@@ -535,145 +878,31 @@ QString JournalMonitor::extractCommanderFromJournal(const QString &journalFilePa
     QString currentJournalName = QFileInfo(filePath).fileName();
     qDebug() << "[DEBUG] Starting commander extraction from:" << currentJournalName;
     
-    // First, scan the CURRENT journal from BOTTOM to TOP (latest entries first)
-    QFile file(filePath);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        qDebug() << "[ERROR] Could not open journal file:" << filePath;
-        return "Unknown";
-    }
-    
-    QTextStream stream(&file);
-    QStringList lines;
-    while (!stream.atEnd()) {
-        lines.append(stream.readLine());
-    }
-    file.close();
-    
-    qDebug() << "[DEBUG] Current journal has" << lines.size() << "lines";
-    
-    // Read from bottom to top (latest entries first)
-    for (int i = lines.size() - 1; i >= 0; i--) {
-        QString line = lines[i].trimmed();
-        if (line.isEmpty()) {
-            continue;
-        }
-        
-        // Look for LoadGame or Commander events
-        if (line.contains("\"event\":\"LoadGame\"") || line.contains("\"event\":\"Commander\"")) {
-            qDebug() << "[DEBUG] Found potential commander event at line" << (i+1) << ":" << line.left(100) << "...";
-            
-            QJsonParseError parseError;
-            QJsonDocument doc = QJsonDocument::fromJson(line.toUtf8(), &parseError);
-            
-            if (parseError.error == QJsonParseError::NoError) {
-                QJsonObject data = doc.object();
-                QString commander;
-                
-                if (data.value("event").toString() == "LoadGame") {
-                    commander = data.value("Commander").toString();
-                    if (!commander.isEmpty()) {
-                        qDebug() << "[DEBUG] ✓ FOUND LoadGame commander in current journal:" << commander;
-                        emit commanderDetected(commander);
-                        return commander;
-                    }
-                } else if (data.value("event").toString() == "Commander") {
-                    commander = data.value("Name").toString();
-                    if (!commander.isEmpty()) {
-                        qDebug() << "[DEBUG] ✓ FOUND Commander event in current journal:" << commander;
-                        emit commanderDetected(commander);
-                        return commander;
-                    }
-                }
-            } else {
-                // Fallback to regex if JSON parsing fails
-                QRegularExpression loadGameRegex("\"Commander\"\\s*:\\s*\"([^\"]+)\"");
-                QRegularExpression commanderRegex("\"Name\"\\s*:\\s*\"([^\"]+)\"");
-                
-                QRegularExpressionMatch match;
-                if (line.contains("\"event\":\"LoadGame\"")) {
-                    match = loadGameRegex.match(line);
-                    if (match.hasMatch()) {
-                        QString commander = match.captured(1);
-                        qDebug() << "[DEBUG] ✓ FOUND commander via LoadGame regex in current journal:" << commander;
-                        emit commanderDetected(commander);
-                        return commander;
-                    }
-                } else if (line.contains("\"event\":\"Commander\"")) {
-                    match = commanderRegex.match(line);
-                    if (match.hasMatch()) {
-                        QString commander = match.captured(1);
-                        qDebug() << "[DEBUG] ✓ FOUND commander via Commander regex in current journal:" << commander;
-                        emit commanderDetected(commander);
-                        return commander;
-                    }
-                }
-            }
-        }
+    // The latest Commander/LoadGame event of the current journal wins
+    QString commander = latestCommanderInJournal(filePath);
+    if (!commander.isEmpty()) {
+        qDebug() << "[DEBUG] ✓ FOUND commander in current journal:" << commander;
+        emit commanderDetected(commander);
+        return commander;
     }
     
     // If NO commander found in current journal, check the most recent journals
     qDebug() << "[WARNING] No commander found in current journal" << currentJournalName << ", checking recent journals...";
     
     QStringList allJournals = findJournalFiles(m_journalPath);
-    
-    qDebug() << "[DEBUG] Found" << allJournals.size() << "total journals to check";
+    const QString currentPath = QFileInfo(filePath).absoluteFilePath();
     
     // Check the most recent journals (excluding current one we already checked)
     for (int i = 0; i < qMin(10, allJournals.size()); i++) {
-        QString journalPath = allJournals[i];
-        QString journalName = QFileInfo(journalPath).fileName();
-        
-        if (journalPath == filePath) {
-            qDebug() << "[DEBUG] Skipping current journal:" << journalName;
-            continue;
-        }
-        
-        qDebug() << "[DEBUG] Checking recent journal:" << journalName;
-        
-        QFile recentFile(journalPath);
-        if (!recentFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-            qDebug() << "[DEBUG] Error reading recent journal" << journalName;
+        if (allJournals[i] == currentPath) {
             continue;
         }
         
-        QTextStream recentStream(&recentFile);
-        QStringList recentLines;
-        while (!recentStream.atEnd()) {
-            recentLines.append(recentStream.readLine());
-        }
-        recentFile.close();
-        
-        // Read from bottom to top (latest entries first)
-        for (int j = recentLines.size() - 1; j >= 0; j--) {
-            QString line = recentLines[j].trimmed();
-            if (line.isEmpty()) {
-                continue;
-            }
-            
-            if (line.contains("\"event\":\"LoadGame\"") && line.contains("\"Commander\"")) {
-                QJsonParseError parseError;
-                QJsonDocument doc = QJsonDocument::fromJson(line.toUtf8(), &parseError);
-                
-                if (parseError.error == QJsonParseError::NoError) {
-                    QJsonObject data = doc.object();
-                    QString commander = data.value("Commander").toString();
-                    if (!commander.isEmpty()) {
-                        qDebug() << "[DEBUG] ✓ FOUND commander" << commander << "in recent journal:" << journalName;
-                        emit commanderDetected(commander);
-                        return commander;
-                    }
-                } else {
-                    // Fallback regex
-                    QRegularExpression regex("\"Commander\"\\s*:\\s*\"([^\"]+)\"");
-                    QRegularExpressionMatch match = regex.match(line);
-                    if (match.hasMatch()) {
-                        QString commander = match.captured(1);
-                        qDebug() << "[DEBUG] ✓ FOUND commander via regex" << commander << "in recent journal:" << journalName;
-                        emit commanderDetected(commander);
-                        return commander;
-                    }
-                }
-            }
+        commander = latestCommanderInJournal(allJournals[i]);
+        if (!commander.isEmpty()) {
+            qDebug() << "[DEBUG] ✓ FOUND commander" << commander << "in recent journal:" << QFileInfo(allJournals[i]).fileName();
+            emit commanderDetected(commander);
+            return commander;
         }
     }
     
@@ -681,6 +910,24 @@ QString JournalMonitor::extractCommanderFromJournal(const QString &journalFilePa
     return "Unknown";
 }
 
+QString JournalMonitor::latestCommanderInJournal(const QString &filePath) const
+{
+    // Unchanged journals are answered by the index; anything else is read backwards
+    // from the end so only the tail of a large live journal is touched
+    JournalFileSummary summary;
+    if (JournalIndex::instance().cachedSummary(filePath, summary)) {
+        return summary.lastCommander;
+    }
+    
+    JournalEvent event;
+    bool found = JournalReverseReader::findLatest(filePath, [](const JournalEvent &candidate) {
+        return (candidate.type == JournalEventType::Commander || candidate.type == JournalEventType::LoadGame) &&
+               !candidate.commander.isEmpty();
+    }, event);
+    
+    return found ? event.commander : QString();
+}
+
 QStringList JournalMonitor::getAllDetectedCommanders() const
 {
     return m_allDetectedCommanders;
@@ -693,53 +940,41 @@ void JournalMonitor::scanAllJournalsForCommanders()
         return;
     }
     
-    qDebug() << "Scanning all journals for commanders...";
+    qDebug() << "Scanning all journals for commanders in the background...";
+    
+    // Results arrive in onJournalIndexRefreshed() so the UI never waits on a full-history scan
+    JournalIndex::instance().refreshAsync(m_journalPath);
+}
+
+void JournalMonitor::onJournalIndexRefreshed(const QString &journalPath, const QList<JournalFileSummary> &summaries)
+{
+    if (journalPath != m_journalPath) {
+        return;
+    }
     
-    QStringList allJournals = findJournalFiles(m_journalPath);
     int commandersFound = 0;
     
-    // Check ALL journals for commander events
-    for (const QString &journalPath : allJournals) {
-        QString journalName = QFileInfo(journalPath).fileName();
-        
-        QFile file(journalPath);
-        if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-            continue;
+    // Rebuild the visited-systems index from the complete history; the live tail keeps it current afterwards
+    m_visitedSystems.clear();
+    for (const JournalFileSummary &summary : summaries) {
+        const QString owner = summary.commander.isEmpty() ? summary.lastCommander : summary.commander;
+        for (const QString &system : summary.visitedSystems) {
+            m_visitedSystems.insert(owner, system);
         }
-        
-        QTextStream stream(&file);
-        QStringList lines;
-        while (!stream.atEnd()) {
-            lines.append(stream.readLine());
-        }
-        file.close();
-        
-        // Read from bottom to top (latest entries first) for efficiency
-        for (int i = lines.size() - 1; i >= 0; i--) {
-            QString line = lines[i].trimmed();
-            if (line.isEmpty()) continue;
-            
-            // Look for Commander or LoadGame events
-            if (line.contains("\"event\":\"LoadGame\"") || line.contains("\"event\":\"Commander\"")) {
-                QJsonParseError parseError;
-                QJsonDocument doc = QJsonDocument::fromJson(line.toUtf8(), &parseError);
-                
-                if (parseError.error == QJsonParseError::NoError) {
-                    QJsonObject data = doc.object();
-                    QString commander;
-                    
-                    if (data.value("event").toString() == "LoadGame") {
-                        commander = data.value("Commander").toString();
-                    } else if (data.value("event").toString() == "Commander") {
-                        commander = data.value("Name").toString();
-                    }
-                    
-                    if (!commander.isEmpty() && !m_allDetectedCommanders.contains(commander)) {
-                        m_allDetectedCommanders.append(commander);
-                        commandersFound++;
-                        qDebug() << "Found commander:" << commander << "in" << journalName;
-                    }
-                }
+    }
+    if (!m_currentSystem.isEmpty()) {
+        m_visitedSystems.insert(m_actualJournalCommander, m_currentSystem);
+    }
+    qDebug() << "Visited systems index:" << m_visitedSystems.systemCount() << "visits across"
+             << m_visitedSystems.commanderCount() << "commanders";
+    
+    // Every commander seen in any journal, as recorded by the index
+    for (const JournalFileSummary &summary : summaries) {
+        for (const QString &commander : summary.commanders) {
+            if (!commander.isEmpty() && !m_allDetectedCommanders.contains(commander)) {
+                m_allDetectedCommanders.append(commander);
+                commandersFound++;
+                qDebug() << "Found commander:" << commander << "in" << summary.fileName();
             }
         }
     }
@@ -752,6 +987,19 @@ void JournalMonitor::scanAllJournalsForCommanders()
     }
 }
 
+bool JournalMonitor::isSystemVisited(const QString &systemName, const QString &commanderName) const
+{
+    if (systemName.isEmpty()) {
+        return false;
+    }
+    
+    // No commander means "visited by anyone playing on this machine"
+    if (commanderName.isEmpty()) {
+        return m_visitedSystems.containsAnyCommander(systemName);
+    }
+    return m_visitedSystems.contains(commanderName, systemName);
+}
+
 void JournalMonitor::switchToCommander(const QString &commanderName)
 {
     if (commanderName.isEmpty() || m_journalPath.isEmpty()) {
@@ -769,117 +1017,43 @@ void JournalMonitor::switchToCommander(const QString &commanderName)
         return;
     }
     
-    // Get all journal files sorted by modification time (newest first)
-    QStringList filters;
-    filters << "Journal.*.log";
-    QFileInfoList journalFiles = journalDir.entryInfoList(filters, QDir::Files | QDir::Readable, QDir::Time);
-    std::reverse(journalFiles.begin(), journalFiles.end()); // Newest first
-    
     QString latestSystem;
     QJsonObject latestJumpData;
-    QDateTime latestTimestamp;
     
-    // Scan all journal files to find those belonging to the target commander
-    for (const QFileInfo &fileInfo : journalFiles) {
-        QFile file(fileInfo.absoluteFilePath());
-        if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-            continue;
-        }
+    // Journals are chronological, so the newest journal owned by this commander that has a
+    // location event holds the latest location. Unchanged journals come from the index;
+    // the rest are checked from the head for the owner and from the tail for the location.
+    const QFileInfoList journalFiles = JournalLineReader::historyJournals(QDir(m_journalPath));
+    for (const QFileInfo &journalInfo : journalFiles) {
+        const QString journalFile = journalInfo.absoluteFilePath();
+        QString owner;
+        QJsonObject location;
         
-        qDebug() << "[DEBUG] Scanning journal:" << fileInfo.baseName();
-        
-        QTextStream stream(&file);
-        QString journalCommander;
-        bool isOdyssey = false;
-        
-        // Read the first few lines to identify the journal owner
-        QString line;
-        int lineCount = 0;
-        while (stream.readLineInto(&line) && lineCount < 10) { // Check first 10 lines for commander
-            lineCount++;
-            line = line.trimmed();
-            if (line.isEmpty()) continue;
-            
-            QJsonParseError parseError;
-            QJsonDocument doc = QJsonDocument::fromJson(line.toUtf8(), &parseError);
-            if (parseError.error != QJsonParseError::NoError) {
-                continue;
-            }
-            
-            QJsonObject entry = doc.object();
-            QString event = entry.value("event").toString();
-            
-            // Check Fileheader for Odyssey status
-            if (event == "Fileheader") {
-                isOdyssey = entry.value("Odyssey").toBool();
-                qDebug() << "[DEBUG] Journal" << fileInfo.baseName() << "Odyssey:" << isOdyssey;
-            }
-            
-            // The first Commander event determines who owns this entire journal
-            if (event == "Commander") {
-                journalCommander = entry.value("Name").toString();
-                qDebug() << "[DEBUG] Journal" << fileInfo.baseName() << "belongs to commander:" << journalCommander;
-                break; // Found the journal owner, no need to read more
-            } else if (event == "LoadGame") {
-                journalCommander = entry.value("Commander").toString();
-                qDebug() << "[DEBUG] Journal" << fileInfo.baseName() << "belongs to commander (LoadGame):" << journalCommander;
-                break; // Found the journal owner, no need to read more
+        JournalFileSummary summary;
+        if (JournalIndex::instance().cachedSummary(journalFile, summary)) {
+            owner = summary.commander;
+            location = summary.lastLocation;
+        } else {
+            owner = JournalReverseReader::readOwner(journalFile);
+            if (owner == commanderName) {
+                JournalEvent event;
+                if (JournalReverseReader::findLatest(journalFile, [](const JournalEvent &candidate) {
+                        return candidate.isLocationEvent();
+                    }, event)) {
+                    location = event.toJson();
+                }
             }
         }
         
-        // If this journal doesn't belong to our target commander, skip it
-        if (journalCommander != commanderName) {
-            qDebug() << "FORCE CMDR LOCATION DEBUG: Skipping journal" << fileInfo.baseName() << "- belongs to" << journalCommander << "not" << commanderName;
-            file.close();
+        // The first Commander event determines who owns this entire journal
+        if (owner != commanderName || location.value("StarSystem").toString().isEmpty()) {
             continue;
         }
         
-        qDebug() << "[DEBUG] Found journal for" << commanderName << ":" << fileInfo.baseName() << "(Odyssey:" << isOdyssey << ")";
-        qDebug() << "FORCE CMDR LOCATION DEBUG: Processing journal" << fileInfo.baseName() << "for" << commanderName;
-        
-        // This journal belongs to our target commander, scan for latest location
-        QString latestSystemInFile;
-        QJsonObject latestJumpInFile;
-        QDateTime latestEventTimeInFile;
-        
-        // Reset stream to beginning to scan all events
-        stream.seek(0);
-        while (stream.readLineInto(&line)) {
-            line = line.trimmed();
-            if (line.isEmpty()) continue;
-            
-            QJsonParseError parseError;
-            QJsonDocument doc = QJsonDocument::fromJson(line.toUtf8(), &parseError);
-            if (parseError.error != QJsonParseError::NoError) {
-                continue;
-            }
-            
-            QJsonObject entry = doc.object();
-            QString event = entry.value("event").toString();
-            
-            // Track location events (FSDJump, CarrierJump, Location)
-            if (event == "FSDJump" || event == "CarrierJump" || event == "Location") {
-                QString system = entry.value("StarSystem").toString();
-                QDateTime eventTime = QDateTime::fromString(entry.value("timestamp").toString(), Qt::ISODate);
-                
-                if (!system.isEmpty() && (latestEventTimeInFile.isNull() || eventTime > latestEventTimeInFile)) {
-                    latestSystemInFile = system;
-                    latestJumpInFile = entry;
-                    latestEventTimeInFile = eventTime;
-                    qDebug() << "[DEBUG] Found location event for" << commanderName << ":" << system << "at" << eventTime.toString();
-                }
-            }
-        }
-        
-        file.close();
-        
-        // Check if this journal has the most recent location across all journals
-        if (!latestSystemInFile.isEmpty() && (latestTimestamp.isNull() || latestEventTimeInFile > latestTimestamp)) {
-            latestSystem = latestSystemInFile;
-            latestJumpData = latestJumpInFile;
-            latestTimestamp = latestEventTimeInFile;
-            qDebug() << "[DEBUG] Most recent location for" << commanderName << ":" << latestSystem << "from" << fileInfo.baseName() << "at" << latestEventTimeInFile.toString();
-        }
+        latestSystem = location.value("StarSystem").toString();
+        latestJumpData = location;
+        qDebug() << "[DEBUG] Most recent location for" << commanderName << ":" << latestSystem << "from" << QFileInfo(journalFile).fileName();
+        break;
     }
     
     if (!latestSystem.isEmpty()) {
@@ -3,11 +3,18 @@
 
 #include <QObject>
 #include <QFileSystemWatcher>
-#include <QTimer>
 #include <QJsonObject>
 #include <QJsonDocument>
 #include <QString>
 #include <QDir>
+#include <QHash>
+#include <QSet>
+#include <QThread>
+#include <QVariantList>
+#include "journalindex.h"
+#include "journaldecoder.h"
+#include "visitedsystemsindex.h"
+#include "journalreaderworker.h"
 
 class JournalMonitor : public QObject
 {
@@ -17,15 +24,18 @@ class JournalMonitor : public QObject
     Q_PROPERTY(QString currentSystem READ currentSystem NOTIFY currentSystemChanged)
     Q_PROPERTY(QString journalPath READ journalPath WRITE setJournalPath NOTIFY journalPathChanged)
     Q_PROPERTY(bool isMonitoring READ isMonitoring NOTIFY isMonitoringChanged)
+    Q_PROPERTY(QVariantList navRoute READ navRoute NOTIFY navRouteChanged)
 
 public:
     explicit JournalMonitor(QObject *parent = nullptr);
+    ~JournalMonitor();
     
     // Property getters
     QString commanderName() const { return m_commanderName; }
     QString currentSystem() const { return m_currentSystem; }
     QString journalPath() const { return m_journalPath; }
     bool isMonitoring() const { return m_isMonitoring; }
+    QVariantList navRoute() const { return m_navRoute; }
     
     // Property setters
     void setJournalPath(const QString &path);
@@ -37,6 +47,11 @@ public:
     Q_INVOKABLE QString autoDetectJournalFolder();
     Q_INVOKABLE QString getLatestJournalFile();
     Q_INVOKABLE int countTotalJumps() const;
+    Q_INVOKABLE QVariantMap jumpStatistics(const QString &commanderName = QString()) const;
+    Q_INVOKABLE QString firstVisitDate(const QString &systemName, const QString &commanderName = QString()) const;
+#ifdef EDRH_BENCHMARKS
+    Q_INVOKABLE QVariantMap benchmarkJournalDecoder(int maxFiles = 50) const;
+#endif
     
     // Commander extraction - following v1.4incomplete.py pattern
     Q_INVOKABLE QString extractCommanderFromJournal(const QString &journalFilePath = "");
@@ -44,6 +59,9 @@ public:
     Q_INVOKABLE void scanAllJournalsForCommanders();
     Q_INVOKABLE void switchToCommander(const QString &commanderName);
     
+    // Visit checks are answered from memory; the index is built from every journal in the configured folder
+    Q_INVOKABLE bool isSystemVisited(const QString &systemName, const QString &commanderName = QString()) const;
+    
     // Force commander management
     void setForcedCommander(const QString &forcedCommander, bool enabled);
 
@@ -59,23 +77,38 @@ signals:
     void fsdJumpDetected(const QString &system, const QJsonObject &jumpData);
     void carrierJumpDetected(const QString &system, const QJsonObject &jumpData);
     void positionUpdate(const QString &system, double x, double y, double z);
+    void navRouteChanged();  // Plotted route replaced or cleared
     void journalError(const QString &error);
+    void journalScanProgress(int completed, int total);  // Full-history scan progress (files parsed)
 
 private slots:
     void onFileChanged(const QString &path);
     void onDirectoryChanged(const QString &path);
-    void checkForUpdates();
+    void onJournalIndexRefreshed(const QString &journalPath, const QList<JournalFileSummary> &summaries);
+    void onReaderEventsAvailable();
+    void onReaderFileRead(const QString &filePath, qint64 offset, int eventCount);
+    void onReaderReadFailed(const QString &filePath, const QString &error);
 
 private:
     QFileSystemWatcher *m_fileWatcher;
-    QTimer *m_updateTimer;
+    
+    // Journal reading and decoding runs on its own thread; decoded events come back through the queue
+    QThread *m_readerThread;
+    JournalReaderWorker *m_reader;
+    JournalEventQueue m_eventQueue;
+    QSet<QString> m_readsInFlight;      // Files with a read queued on the reader thread
+    QSet<QString> m_rereadRequested;    // Files that changed again while their read was in flight
+    static const int READ_RETRY_DELAY_MS = 1000;    // After the game or a scanner held a journal open
     QString m_journalPath;
     QString m_commanderName;
     QString m_currentSystem;
     QString m_currentJournalFile;
     bool m_isMonitoring;
-    qint64 m_lastFileSize;
+    QHash<QString, qint64> m_fileOffsets;  // Journal file name -> byte offset of the last complete line read
+    QString m_tailStateFile;
+    QJsonObject m_tailSession;  // Commander/location snapshot saved alongside the offsets
     QJsonObject m_lastJumpData;
+    QVariantList m_navRoute;  // Waypoints from NavRoute.json: name, x, y, z, starClass
     QStringList m_allDetectedCommanders;  // Track all commanders found across journals
     
     // Forced commander state for jump filtering
@@ -85,18 +118,29 @@ private:
     // Track the actual journal file owner (not the effective commander)
     QString m_actualJournalCommander;
     
+    VisitedSystemsIndex m_visitedSystems;  // Commander -> systems arrived in, from the index plus the live tail
+    
     // Helper methods
     void processJournalFile(const QString &filePath);
-    void processJournalLine(const QString &line);
-    void extractCommanderName(const QJsonObject &entry);
-    void processFSDJump(const QJsonObject &entry);
-    void processCarrierJump(const QJsonObject &entry);
-    void processLocation(const QJsonObject &entry);
+    void loadTailState();
+    void saveTailState();
+    bool restoreTailState(const QString &filePath);
+    void drainEvents();
+    QString navRouteFilePath() const;
+    void loadNavRoute();
+    void clearNavRoute();
+    void extractCommanderName(const QString &commander);
+    void processFSDJump(const JournalEvent &event);
+    void processCarrierJump(const JournalEvent &event);
+    void processLocation(const JournalEvent &event);
+    void applyLocation(const QString &system, const QJsonObject &locationData);
     void updateCurrentJournalFile();
+    void setCurrentJournalFile(const QString &filePath);
     QStringList findJournalFiles(const QString &directory);
     QString findLatestJournalWithFSDJump(const QString &directory);
     bool hasValidJournalData(const QString &filePath);
     QString extractCommanderFromPath(const QString &filePath);
+    QString latestCommanderInJournal(const QString &filePath) const;
 };
 
 #endif // JOURNALMONITOR_H 
\ No newline at end of file
@@ -0,0 +1,91 @@
+#include "journalreaderworker.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QThread>
+#include <QDebug>
+
+JournalReaderWorker::JournalReaderWorker(JournalEventQueue *queue, QObject *parent)
+    : QObject(parent)
+    , m_queue(queue)
+    , m_wakePending(false)
+{
+}
+
+void JournalReaderWorker::readFile(const QString &filePath, qint64 offset)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        emit readFailed(filePath, "Failed to open journal file: " + filePath);
+        return;
+    }
+
+    const qint64 fileSize = file.size();
+
+    // A file smaller than our offset has been truncated or replaced - start over
+    if (fileSize < offset) {
+        qDebug() << "Journal file shrank from" << offset << "to" << fileSize << "bytes, re-reading:" << QFileInfo(filePath).fileName();
+        offset = 0;
+    }
+
+    if (fileSize == offset) {
+        emit fileRead(filePath, offset, 0);
+        return;
+    }
+
+    if (!file.seek(offset)) {
+        emit readFailed(filePath, "Failed to seek in journal file: " + filePath);
+        return;
+    }
+
+    // Work on raw bytes so the offset stays exact regardless of UTF-8 content.
+    // Only complete lines are consumed; a trailing partial line is left for the next notification.
+    int eventCount = 0;
+    QByteArray pending;
+    JournalEvent event;
+    while (!file.atEnd()) {
+        QByteArray chunk = file.read(64 * 1024);
+        if (chunk.isEmpty()) {
+            break;
+        }
+        pending.append(chunk);
+
+        qsizetype lineStart = 0;
+        qsizetype newline;
+        while ((newline = pending.indexOf('\n', lineStart)) != -1) {
+            QByteArrayView line = QByteArrayView(pending).sliced(lineStart, newline - lineStart).trimmed();
+            if (!line.isEmpty() && JournalDecoder::decode(line, event)) {
+                pushEvent(std::move(event));
+                eventCount++;
+            }
+            lineStart = newline + 1;
+        }
+
+        offset += lineStart;
+        pending.remove(0, lineStart);
+    }
+
+    file.close();
+
+    // One wake-up for the whole read; fileRead is queued behind it so the consumer has
+    // drained every event before it records the new offset
+    if (eventCount > 0) {
+        wakeConsumer();
+    }
+    emit fileRead(filePath, offset, eventCount);
+}
+
+void JournalReaderWorker::pushEvent(JournalEvent &&event)
+{
+    // Backpressure: hand the consumer what we have so far and wait for room
+    while (!m_queue->push(std::move(event))) {
+        wakeConsumer();
+        QThread::msleep(1);
+    }
+}
+
+void JournalReaderWorker::wakeConsumer()
+{
+    if (!m_wakePending.exchange(true, std::memory_order_acq_rel)) {
+        emit eventsAvailable();
+    }
+}
@@ -0,0 +1,40 @@
+#ifndef JOURNALREADERWORKER_H
+#define JOURNALREADERWORKER_H
+
+#include <QObject>
+#include <QString>
+#include <atomic>
+#include "journaleventqueue.h"
+
+// Lives on the journal reader thread. Reads new bytes from a journal, decodes the
+// interesting lines and pushes them onto the shared event queue. The GUI thread is
+// woken once per read, so a large backlog arrives as a single batch.
+class JournalReaderWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit JournalReaderWorker(JournalEventQueue *queue, QObject *parent = nullptr);
+
+    // Called by the consumer before it drains, so the next push posts a fresh wake-up
+    void clearWakePending() { m_wakePending.store(false, std::memory_order_release); }
+
+public slots:
+    // Read filePath from offset to its last complete line
+    void readFile(const QString &filePath, qint64 offset);
+
+signals:
+    void eventsAvailable();
+    void fileRead(const QString &filePath, qint64 offset, int eventCount);
+    // Open or seek failed; nothing was read and the offset is unchanged
+    void readFailed(const QString &filePath, const QString &error);
+
+private:
+    void pushEvent(JournalEvent &&event);
+    void wakeConsumer();
+
+    JournalEventQueue *m_queue;
+    std::atomic<bool> m_wakePending;
+};
+
+#endif // JOURNALREADERWORKER_H
@@ -0,0 +1,131 @@
+#include "journalreversereader.h"
+#include "journallinereader.h"
+#include <QDebug>
+
+JournalReverseReader::JournalReverseReader(const QString &filePath, qint64 blockSize)
+    : m_file(filePath)
+    , m_blockSize(blockSize)
+    , m_position(0)
+{
+}
+
+bool JournalReverseReader::open()
+{
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    m_position = m_file.size();
+    m_buffer.clear();
+    return true;
+}
+
+void JournalReverseReader::close()
+{
+    m_file.close();
+    m_buffer.clear();
+}
+
+bool JournalReverseReader::readPreviousBlock()
+{
+    if (m_position <= 0) {
+        return false;
+    }
+
+    const qint64 readSize = qMin(m_blockSize, m_position);
+    m_position -= readSize;
+    if (!m_file.seek(m_position)) {
+        return false;
+    }
+
+    QByteArray block = m_file.read(readSize);
+    if (block.size() != readSize) {
+        return false;
+    }
+
+    m_buffer.prepend(block);
+    return true;
+}
+
+bool JournalReverseReader::readPreviousLine(QByteArray &line)
+{
+    while (true) {
+        // Skip trailing newlines so blank lines never come back as results
+        while (!m_buffer.isEmpty() && (m_buffer.endsWith('\n') || m_buffer.endsWith('\r'))) {
+            m_buffer.chop(1);
+        }
+
+        qsizetype newline = m_buffer.lastIndexOf('\n');
+        if (newline >= 0) {
+            line = m_buffer.mid(newline + 1).trimmed();
+            m_buffer.truncate(newline);
+            if (!line.isEmpty()) {
+                return true;
+            }
+            continue;
+        }
+
+        // No complete line in the buffer - pull in the previous block, or emit the first line of the file
+        if (!readPreviousBlock()) {
+            line = m_buffer.trimmed();
+            m_buffer.clear();
+            return !line.isEmpty();
+        }
+    }
+}
+
+bool JournalReverseReader::findLatest(const QString &filePath,
+                                      const std::function<bool(const JournalEvent &)> &predicate,
+                                      JournalEvent &event)
+{
+    // A gzip stream cannot be walked backwards - read it forwards and keep the last match
+    if (JournalLineReader::isArchive(filePath)) {
+        JournalLineReader forwardReader(filePath);
+        if (!forwardReader.open()) {
+            return false;
+        }
+        bool found = false;
+        JournalEvent candidate;
+        QByteArray line;
+        while (forwardReader.readLine(line)) {
+            if (JournalDecoder::decode(line, candidate) && predicate(candidate)) {
+                event = candidate;
+                found = true;
+            }
+        }
+        return found;
+    }
+
+    JournalReverseReader reader(filePath);
+    if (!reader.open()) {
+        qDebug() << "Reverse reader: could not open" << filePath;
+        return false;
+    }
+
+    QByteArray line;
+    while (reader.readPreviousLine(line)) {
+        if (JournalDecoder::decode(line, event) && predicate(event)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+QString JournalReverseReader::readOwner(const QString &filePath, int maxLines)
+{
+    JournalLineReader reader(filePath);
+    if (!reader.open()) {
+        return QString();
+    }
+
+    JournalEvent event;
+    QByteArray line;
+    int lineCount = 0;
+    while (lineCount < maxLines && reader.readLine(line)) {
+        lineCount++;
+        if (JournalDecoder::decode(line, event) &&
+            (event.type == JournalEventType::Commander || event.type == JournalEventType::LoadGame)) {
+            return event.commander;
+        }
+    }
+    return QString();
+}
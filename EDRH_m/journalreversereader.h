@@ -0,0 +1,41 @@
+#ifndef JOURNALREVERSEREADER_H
+#define JOURNALREVERSEREADER_H
+
+#include <QFile>
+#include <QByteArray>
+#include <QString>
+#include <functional>
+#include "journaldecoder.h"
+
+// Reads a journal from the end towards the start, one line at a time.
+// Only one fixed-size block plus the line being assembled is held in memory,
+// so finding the latest event costs the same for a 10 KB or a 50 MB journal.
+class JournalReverseReader
+{
+public:
+    explicit JournalReverseReader(const QString &filePath, qint64 blockSize = 64 * 1024);
+
+    bool open();
+    void close();
+
+    // Next line walking backwards; returns false once the start of the file is reached
+    bool readPreviousLine(QByteArray &line);
+
+    // Latest event in the file accepted by the predicate, decoded into event
+    static bool findLatest(const QString &filePath,
+                           const std::function<bool(const JournalEvent &)> &predicate,
+                           JournalEvent &event);
+
+    // Journal owner: the first Commander/LoadGame within the first few lines
+    static QString readOwner(const QString &filePath, int maxLines = 10);
+
+private:
+    bool readPreviousBlock();
+
+    QFile m_file;
+    qint64 m_blockSize;
+    qint64 m_position;      // Start of the bytes not yet loaded into m_buffer
+    QByteArray m_buffer;    // Unconsumed bytes, always ending at a line boundary
+};
+
+#endif // JOURNALREVERSEREADER_H
@@ -0,0 +1,654 @@
+#include "jumpstore.h"
+#include "journaldecoder.h"
+#include "journallinereader.h"
+#include <QStandardPaths>
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonParseError>
+#include <QElapsedTimer>
+#include <QtConcurrent>
+#include <QDebug>
+
+QMutex JumpStore::s_mutex;
+JumpStore* JumpStore::s_instance = nullptr;
+
+namespace {
+
+// Bump whenever the column layout changes so stale stores are rebuilt
+const int kStoreVersion = 1;
+
+struct ColumnSpec {
+    const char *name;
+    int width;
+};
+
+const ColumnSpec kColumns[8] = {
+    {"timestamp", 8},   // qint64, ms since epoch (UTC)
+    {"commander", 2},   // quint16 index into commanders.txt
+    {"system", 4},      // quint32 index into systems.txt
+    {"x", 4},           // float StarPos
+    {"y", 4},
+    {"z", 4},
+    {"distance", 4},    // float JumpDist (0 for carrier jumps)
+    {"kind", 1}         // quint8 JumpKind
+};
+
+const qint64 kMsPerDay = 24 * 60 * 60 * 1000;
+
+// Jumps read from journals before they are appended and recorded in sources.json together
+const int kCommitBatchJumps = 20000;
+
+template <typename T>
+void appendColumn(QFile &file, const QVector<T> &values)
+{
+    if (values.isEmpty()) {
+        return;
+    }
+    file.seek(file.size());
+    file.write(reinterpret_cast<const char *>(values.constData()), values.size() * qint64(sizeof(T)));
+}
+
+}
+
+JumpStore::JumpStore(QObject *parent)
+    : QObject(parent)
+    , m_rowCount(0)
+    , m_savedRowCount(-1)
+{
+    QString appDataPath = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    m_storePath = QDir(appDataPath).filePath("jump_store");
+    QDir().mkpath(m_storePath);
+
+    loadSources();
+    loadDictionaries();
+    openColumns();
+
+    qDebug() << "Jump store opened with" << m_rowCount << "jumps," << m_systemNames.size() << "systems,"
+             << m_commanderNames.size() << "commanders";
+}
+
+JumpStore::~JumpStore()
+{
+    for (auto &column : m_columns) {
+        if (column && column->data) {
+            column->file.unmap(column->data);
+        }
+    }
+}
+
+JumpStore& JumpStore::instance()
+{
+    QMutexLocker locker(&s_mutex);
+    if (!s_instance) {
+        s_instance = new JumpStore();
+    }
+    return *s_instance;
+}
+
+bool JumpStore::openColumns()
+{
+    QDir storeDir(m_storePath);
+    qint64 rows = -1;
+
+    for (int i = 0; i < 8; ++i) {
+        m_columns[i].reset(new Column);
+        m_columns[i]->width = kColumns[i].width;
+        m_columns[i]->file.setFileName(storeDir.filePath(QString("%1.col").arg(kColumns[i].name)));
+        if (!m_columns[i]->file.open(QIODevice::ReadWrite)) {
+            qDebug() << "Jump store: cannot open column" << kColumns[i].name << m_columns[i]->file.errorString();
+            return false;
+        }
+        const qint64 columnRows = m_columns[i]->file.size() / kColumns[i].width;
+        rows = rows < 0 ? columnRows : qMin(rows, columnRows);
+    }
+
+    // A crash mid-append can leave columns of different lengths - cut them back to the shortest,
+    // and past the rows sources.json accounts for, which would otherwise be ingested again
+    m_rowCount = qMax<qint64>(0, rows);
+    if (m_savedRowCount >= 0 && m_savedRowCount < m_rowCount) {
+        qDebug() << "Jump store: dropping" << m_rowCount - m_savedRowCount << "jumps appended after the last saved progress";
+        m_rowCount = m_savedRowCount;
+    }
+    for (auto &column : m_columns) {
+        const qint64 expected = m_rowCount * column->width;
+        if (column->file.size() != expected) {
+            qDebug() << "Jump store: truncating" << column->file.fileName() << "to" << m_rowCount << "rows";
+            column->file.resize(expected);
+        }
+    }
+
+    mapColumns();
+    return true;
+}
+
+void JumpStore::mapColumns()
+{
+    for (auto &column : m_columns) {
+        if (column->data) {
+            column->file.unmap(column->data);
+            column->data = nullptr;
+        }
+        if (m_rowCount > 0) {
+            column->data = column->file.map(0, m_rowCount * column->width);
+            if (!column->data) {
+                qDebug() << "Jump store: failed to map" << column->file.fileName() << column->file.errorString();
+            }
+        }
+    }
+}
+
+void JumpStore::appendRows(const Rows &rows)
+{
+    if (rows.timestamps.isEmpty()) {
+        return;
+    }
+
+    // Dictionaries first, so every id written to a column can be resolved after a crash
+    m_systemDictionary.flush();
+
+    appendColumn(m_columns[0]->file, rows.timestamps);
+    appendColumn(m_columns[1]->file, rows.commanders);
+    appendColumn(m_columns[2]->file, rows.systems);
+    appendColumn(m_columns[3]->file, rows.x);
+    appendColumn(m_columns[4]->file, rows.y);
+    appendColumn(m_columns[5]->file, rows.z);
+    appendColumn(m_columns[6]->file, rows.distances);
+    appendColumn(m_columns[7]->file, rows.kinds);
+    for (auto &column : m_columns) {
+        column->file.flush();
+    }
+
+    m_rowCount += rows.timestamps.size();
+    mapColumns();
+}
+
+quint16 JumpStore::commanderId(const QString &name)
+{
+    auto it = m_commanderIds.constFind(name);
+    if (it != m_commanderIds.constEnd()) {
+        return it.value();
+    }
+
+    const quint16 id = quint16(m_commanderNames.size());
+    m_commanderNames.append(name);
+    m_commanderIds.insert(name, id);
+
+    QFile file(QDir(m_storePath).filePath("commanders.txt"));
+    if (file.open(QIODevice::Append)) {
+        file.write(name.toUtf8() + '\n');
+        file.close();
+    }
+    return id;
+}
+
+quint32 JumpStore::systemId(const QString &name)
+{
+    auto it = m_systemIds.constFind(name);
+    if (it != m_systemIds.constEnd()) {
+        return it.value();
+    }
+
+    const quint32 id = quint32(m_systemNames.size());
+    m_systemNames.append(name);
+    m_systemIds.insert(name, id);
+    m_systemDictionary.write(name.toUtf8() + '\n');
+    return id;
+}
+
+int JumpStore::commanderIndex(const QString &name) const
+{
+    if (name.isEmpty()) {
+        return -1;
+    }
+    return m_commanderIds.contains(name) ? int(m_commanderIds.value(name)) : -2;
+}
+
+int JumpStore::ingestFolder(const QString &journalPath)
+{
+    QDir journalDir(journalPath);
+    if (journalPath.isEmpty() || !journalDir.exists()) {
+        return 0;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // Oldest first so the columns stay roughly chronological. Journals are read without the
+    // lock; queries only wait while a batch of them is appended.
+    const QFileInfoList journals = JournalLineReader::historyJournals(journalDir);
+    int added = 0;
+    int total = 0;
+    QVector<Ingest> batch;
+    int batchJumps = 0;
+    auto commitBatch = [&]() {
+        QMutexLocker locker(&m_mutex);
+        added += commitLocked(batch);
+        total = int(m_rowCount);
+        batch.clear();
+        batchJumps = 0;
+    };
+
+    for (auto it = journals.crbegin(); it != journals.crend(); ++it) {
+        Ingest ingest;
+        if (readJournal(it->absoluteFilePath(), ingest)) {
+            batchJumps += ingest.jumps.size();
+            batch.append(ingest);
+        }
+        if (batchJumps >= kCommitBatchJumps) {
+            commitBatch();
+        }
+    }
+    if (!batch.isEmpty()) {
+        commitBatch();
+    }
+
+    if (added > 0) {
+        qDebug() << "Jump store: ingested" << added << "jumps from" << journals.size() << "journals in" << timer.elapsed() << "ms";
+        emit updated(total);
+    }
+    return added;
+}
+
+void JumpStore::ingestFolderAsync(const QString &journalPath)
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        if (m_asyncIngests.contains(journalPath)) {
+            return;
+        }
+        m_asyncIngests.insert(journalPath);
+    }
+
+    QtConcurrent::run([this, journalPath]() {
+        ingestFolder(journalPath);
+        QMutexLocker locker(&m_mutex);
+        m_asyncIngests.remove(journalPath);
+    });
+}
+
+int JumpStore::ingestFile(const QString &filePath)
+{
+    Ingest ingest;
+    if (!readJournal(filePath, ingest)) {
+        return 0;
+    }
+
+    int added = 0;
+    int total = 0;
+    {
+        QMutexLocker locker(&m_mutex);
+        added = commitLocked({ingest});
+        total = int(m_rowCount);
+    }
+
+    if (added > 0) {
+        emit updated(total);
+    }
+    return added;
+}
+
+void JumpStore::ingestFileAsync(const QString &filePath)
+{
+    {
+        // Growth noticed while the file is being read is picked up by one more pass
+        QMutexLocker locker(&m_mutex);
+        if (m_asyncIngests.contains(filePath)) {
+            m_asyncReruns.insert(filePath);
+            return;
+        }
+        m_asyncIngests.insert(filePath);
+    }
+
+    QtConcurrent::run([this, filePath]() {
+        forever {
+            ingestFile(filePath);
+            QMutexLocker locker(&m_mutex);
+            if (!m_asyncReruns.remove(filePath)) {
+                m_asyncIngests.remove(filePath);
+                return;
+            }
+        }
+    });
+}
+
+bool JumpStore::readJournal(const QString &filePath, Ingest &ingest) const
+{
+    QFileInfo fileInfo(filePath);
+    if (!fileInfo.exists()) {
+        return false;
+    }
+
+    // An archive shares its progress with the plain journal it was compressed from
+    ingest.key = JournalLineReader::isArchive(filePath) ? fileInfo.completeBaseName() : fileInfo.fileName();
+    const qint64 mtime = fileInfo.lastModified().toMSecsSinceEpoch();
+    Source source;
+    {
+        QMutexLocker locker(&m_mutex);
+        ingest.known = m_sources.contains(ingest.key);
+        source = m_sources.value(ingest.key);
+    }
+    if (ingest.known && source.size == fileInfo.size() && source.lastModified == mtime) {
+        return false;
+    }
+    ingest.baseOffset = source.offset;
+
+    JournalLineReader reader(filePath);
+    if (!reader.open()) {
+        return false;
+    }
+
+    // A journal shorter than what we already ingested was replaced; its old rows stay and
+    // the new content is only tracked from here on so nothing is counted twice
+    bool resync = false;
+    if (source.offset > 0 && !reader.skipTo(source.offset)) {
+        qDebug() << "Jump store:" << ingest.key << "is shorter than its ingested offset, resyncing without re-importing";
+        reader.close();
+        if (!reader.open()) {
+            return false;
+        }
+        resync = true;
+    }
+
+    QString commander = source.commander;
+    qint64 committed = reader.position();
+    JournalEvent event;
+    QByteArray line;
+
+    while (reader.readLine(line)) {
+        // Leave a line that is still being written for the next ingest
+        if (!reader.lastLineComplete()) {
+            break;
+        }
+        committed = reader.position();
+
+        if (!JournalDecoder::decode(line, event)) {
+            continue;
+        }
+
+        switch (event.type) {
+        case JournalEventType::Commander:
+        case JournalEventType::LoadGame:
+            if (!event.commander.isEmpty()) {
+                commander = event.commander;
+            }
+            break;
+        case JournalEventType::FSDJump:
+        case JournalEventType::CarrierJump: {
+            if (resync) {
+                break;
+            }
+            PendingJump jump;
+            jump.timestamp = QDateTime::fromString(event.timestamp, Qt::ISODate).toMSecsSinceEpoch();
+            jump.commander = commander;
+            jump.system = event.starSystem;
+            jump.x = float(event.starPos[0]);
+            jump.y = float(event.starPos[1]);
+            jump.z = float(event.starPos[2]);
+            jump.distance = float(event.jumpDist);
+            jump.kind = event.type == JournalEventType::FSDJump ? quint8(FSDJump) : quint8(CarrierJump);
+            ingest.jumps.append(jump);
+            break;
+        }
+        default:
+            break;
+        }
+    }
+    reader.close();
+
+    ingest.source.size = fileInfo.size();
+    ingest.source.lastModified = mtime;
+    ingest.source.offset = committed;
+    ingest.source.commander = commander;
+    return true;
+}
+
+int JumpStore::commitLocked(const QVector<Ingest> &ingests)
+{
+    Rows rows;
+    bool sourcesChanged = false;
+    for (const Ingest &ingest : ingests) {
+        // Another ingest got to this journal first; its rows are already in
+        const auto current = m_sources.constFind(ingest.key);
+        const bool known = current != m_sources.constEnd();
+        if (known != ingest.known || (known && current->offset != ingest.baseOffset)) {
+            continue;
+        }
+
+        for (const PendingJump &jump : ingest.jumps) {
+            rows.timestamps.append(jump.timestamp);
+            rows.commanders.append(commanderId(jump.commander));
+            rows.systems.append(systemId(jump.system));
+            rows.x.append(jump.x);
+            rows.y.append(jump.y);
+            rows.z.append(jump.z);
+            rows.distances.append(jump.distance);
+            rows.kinds.append(jump.kind);
+        }
+        m_sources.insert(ingest.key, ingest.source);
+        sourcesChanged = true;
+    }
+
+    // The rows only count once sources.json records them with their offsets; a crash
+    // before that cuts the columns back on the next start and the journals are re-read
+    appendRows(rows);
+    if (sourcesChanged) {
+        saveSources();
+    }
+    return rows.timestamps.size();
+}
+
+int JumpStore::totalJumps(const QString &commander) const
+{
+    QMutexLocker locker(&m_mutex);
+    const int wanted = commanderIndex(commander);
+    if (wanted == -1) {
+        return int(m_rowCount);
+    }
+    if (wanted == -2 || m_rowCount == 0) {
+        return 0;
+    }
+
+    const quint16 *commanders = commanderColumn();
+    int count = 0;
+    for (qint64 i = 0; i < m_rowCount; ++i) {
+        count += commanders[i] == wanted;
+    }
+    return count;
+}
+
+double JumpStore::totalDistance(const QString &commander) const
+{
+    QMutexLocker locker(&m_mutex);
+    const int wanted = commanderIndex(commander);
+    if (wanted == -2 || m_rowCount == 0) {
+        return 0.0;
+    }
+
+    const float *distances = distanceColumn();
+    const quint16 *commanders = commanderColumn();
+    double total = 0.0;
+    for (qint64 i = 0; i < m_rowCount; ++i) {
+        if (wanted == -1 || commanders[i] == wanted) {
+            total += distances[i];
+        }
+    }
+    return total;
+}
+
+QMap<QDate, int> JumpStore::jumpsPerDay(const QString &commander) const
+{
+    QMutexLocker locker(&m_mutex);
+    QMap<QDate, int> result;
+    const int wanted = commanderIndex(commander);
+    if (wanted == -2 || m_rowCount == 0) {
+        return result;
+    }
+
+    // Bucket by UTC day number first; only one QDate per distinct day is ever built
+    const qint64 *stamps = timestamps();
+    const quint16 *commanders = commanderColumn();
+    QHash<qint64, int> perDay;
+    for (qint64 i = 0; i < m_rowCount; ++i) {
+        if (wanted == -1 || commanders[i] == wanted) {
+            perDay[stamps[i] / kMsPerDay]++;
+        }
+    }
+
+    for (auto it = perDay.constBegin(); it != perDay.constEnd(); ++it) {
+        result.insert(QDateTime::fromMSecsSinceEpoch(it.key() * kMsPerDay, Qt::UTC).date(), it.value());
+    }
+    return result;
+}
+
+QDateTime JumpStore::firstVisit(const QString &systemName, const QString &commander) const
+{
+    QMutexLocker locker(&m_mutex);
+    const int wanted = commanderIndex(commander);
+    auto systemIt = m_systemIds.constFind(systemName);
+    if (wanted == -2 || systemIt == m_systemIds.constEnd() || m_rowCount == 0) {
+        return QDateTime();
+    }
+
+    const quint32 systemId = systemIt.value();
+    const quint32 *systems = systemColumn();
+    const quint16 *commanders = commanderColumn();
+    const qint64 *stamps = timestamps();
+    qint64 first = -1;
+    for (qint64 i = 0; i < m_rowCount; ++i) {
+        if (systems[i] == systemId && (wanted == -1 || commanders[i] == wanted) &&
+            (first < 0 || stamps[i] < first)) {
+            first = stamps[i];
+        }
+    }
+    return first < 0 ? QDateTime() : QDateTime::fromMSecsSinceEpoch(first, Qt::UTC);
+}
+
+QHash<QString, int> JumpStore::jumpsPerCommander() const
+{
+    QMutexLocker locker(&m_mutex);
+    QHash<QString, int> result;
+    if (m_rowCount == 0) {
+        return result;
+    }
+
+    QVector<int> counts(m_commanderNames.size(), 0);
+    const quint16 *commanders = commanderColumn();
+    for (qint64 i = 0; i < m_rowCount; ++i) {
+        if (commanders[i] < counts.size()) {
+            counts[commanders[i]]++;
+        }
+    }
+    for (int i = 0; i < counts.size(); ++i) {
+        if (counts[i] > 0) {
+            result.insert(m_commanderNames[i], counts[i]);
+        }
+    }
+    return result;
+}
+
+void JumpStore::loadDictionaries()
+{
+    QDir storeDir(m_storePath);
+
+    QFile commanders(storeDir.filePath("commanders.txt"));
+    if (commanders.open(QIODevice::ReadOnly)) {
+        const QList<QByteArray> lines = commanders.readAll().split('\n');
+        for (const QByteArray &line : lines) {
+            if (!line.isEmpty()) {
+                m_commanderIds.insert(QString::fromUtf8(line), quint16(m_commanderNames.size()));
+                m_commanderNames.append(QString::fromUtf8(line));
+            }
+        }
+        commanders.close();
+    }
+
+    m_systemDictionary.setFileName(storeDir.filePath("systems.txt"));
+    if (m_systemDictionary.open(QIODevice::ReadOnly)) {
+        const QList<QByteArray> lines = m_systemDictionary.readAll().split('\n');
+        for (const QByteArray &line : lines) {
+            if (!line.isEmpty()) {
+                m_systemIds.insert(QString::fromUtf8(line), quint32(m_systemNames.size()));
+                m_systemNames.append(QString::fromUtf8(line));
+            }
+        }
+        m_systemDictionary.close();
+    }
+    m_systemDictionary.open(QIODevice::Append);
+}
+
+void JumpStore::loadSources()
+{
+    QFile file(QDir(m_storePath).filePath("sources.json"));
+    if (!file.exists() || !file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    QJsonParseError error;
+    QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &error);
+    file.close();
+
+    if (error.error != QJsonParseError::NoError) {
+        qDebug() << "Failed to parse jump store sources:" << error.errorString();
+        return;
+    }
+
+    QJsonObject root = doc.object();
+    if (root.value("version").toInt() != kStoreVersion) {
+        // Old layout - start the store over so columns and sources agree
+        qDebug() << "Jump store format changed, rebuilding";
+        QDir storeDir(m_storePath);
+        for (const ColumnSpec &spec : kColumns) {
+            storeDir.remove(QString("%1.col").arg(spec.name));
+        }
+        storeDir.remove("commanders.txt");
+        storeDir.remove("systems.txt");
+        return;
+    }
+
+    m_savedRowCount = root.contains("rows") ? static_cast<qint64>(root.value("rows").toDouble()) : -1;
+
+    QJsonObject sources = root.value("sources").toObject();
+    for (auto it = sources.constBegin(); it != sources.constEnd(); ++it) {
+        QJsonObject obj = it.value().toObject();
+        Source source;
+        source.size = static_cast<qint64>(obj.value("size").toDouble());
+        source.lastModified = static_cast<qint64>(obj.value("mtime").toDouble());
+        source.offset = static_cast<qint64>(obj.value("offset").toDouble());
+        source.commander = obj.value("commander").toString();
+        m_sources.insert(it.key(), source);
+    }
+}
+
+void JumpStore::saveSources()
+{
+    QJsonObject sources;
+    for (auto it = m_sources.constBegin(); it != m_sources.constEnd(); ++it) {
+        QJsonObject obj;
+        obj["size"] = static_cast<double>(it->size);
+        obj["mtime"] = static_cast<double>(it->lastModified);
+        obj["offset"] = static_cast<double>(it->offset);
+        obj["commander"] = it->commander;
+        sources[it.key()] = obj;
+    }
+
+    QJsonObject root;
+    root["version"] = kStoreVersion;
+    root["rows"] = static_cast<double>(m_rowCount);
+    root["sources"] = sources;
+
+    // Replaced in one step so the offsets and the row count always belong together
+    QSaveFile file(QDir(m_storePath).filePath("sources.json"));
+    if (!file.open(QIODevice::WriteOnly)) {
+        qDebug() << "Failed to save jump store sources:" << file.errorString();
+        return;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    if (!file.commit()) {
+        qDebug() << "Failed to save jump store sources:" << file.errorString();
+    } else {
+        m_savedRowCount = m_rowCount;
+    }
+}
@@ -0,0 +1,133 @@
+#ifndef JUMPSTORE_H
+#define JUMPSTORE_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <QMap>
+#include <QDate>
+#include <QDateTime>
+#include <QFile>
+#include <QMutex>
+#include <QSet>
+#include <QVector>
+#include <memory>
+
+// Append-only history of every FSDJump and CarrierJump across all commanders.
+// Each field lives in its own fixed-width column file that is memory-mapped for queries,
+// so history statistics are a scan over a few flat arrays instead of a re-read of the journals.
+// Journals are ingested incrementally: each one remembers how many bytes were already consumed.
+class JumpStore : public QObject
+{
+    Q_OBJECT
+
+public:
+    static JumpStore& instance();
+    ~JumpStore();
+
+    // Append jumps from every journal in the folder that has grown since the last ingest (oldest first)
+    int ingestFolder(const QString &journalPath);
+    void ingestFolderAsync(const QString &journalPath);
+
+    // Append jumps written to one journal since it was last ingested
+    int ingestFile(const QString &filePath);
+    void ingestFileAsync(const QString &filePath);
+
+    // Queries - an empty commander means every commander
+    int totalJumps(const QString &commander = QString()) const;
+    double totalDistance(const QString &commander = QString()) const;
+    QMap<QDate, int> jumpsPerDay(const QString &commander = QString()) const;
+    QDateTime firstVisit(const QString &systemName, const QString &commander = QString()) const;
+    QHash<QString, int> jumpsPerCommander() const;
+
+signals:
+    void updated(int totalJumps);
+
+private:
+    JumpStore(QObject *parent = nullptr);
+
+    enum JumpKind : quint8 {
+        FSDJump = 0,
+        CarrierJump = 1
+    };
+
+    struct Column {
+        QFile file;
+        int width = 0;
+        uchar *data = nullptr;
+    };
+
+    struct Rows {
+        QVector<qint64> timestamps;
+        QVector<quint16> commanders;
+        QVector<quint32> systems;
+        QVector<float> x, y, z;
+        QVector<float> distances;
+        QVector<quint8> kinds;
+    };
+
+    struct Source {
+        qint64 size = 0;
+        qint64 lastModified = 0;
+        qint64 offset = 0;      // Decoded bytes already ingested
+        QString commander;      // Commander active at that offset
+    };
+
+    // Jumps read from one journal, still carrying names; ids are only assigned under the lock
+    struct PendingJump {
+        qint64 timestamp = 0;
+        QString commander;
+        QString system;
+        float x = 0, y = 0, z = 0;
+        float distance = 0;
+        quint8 kind = FSDJump;
+    };
+
+    struct Ingest {
+        QString key;
+        qint64 baseOffset = 0;  // Source offset the read started from
+        bool known = false;     // Source existed when the read started
+        Source source;          // Progress after the read
+        QVector<PendingJump> jumps;
+    };
+
+    bool openColumns();
+    void mapColumns();
+    void appendRows(const Rows &rows);
+    bool readJournal(const QString &filePath, Ingest &ingest) const;
+    int commitLocked(const QVector<Ingest> &ingests);
+    quint16 commanderId(const QString &name);
+    quint32 systemId(const QString &name);
+    int commanderIndex(const QString &name) const;  // -1 for "any", -2 for unknown
+
+    void loadDictionaries();
+    void loadSources();
+    void saveSources();
+
+    const qint64 *timestamps() const { return reinterpret_cast<const qint64 *>(m_columns[0]->data); }
+    const quint16 *commanderColumn() const { return reinterpret_cast<const quint16 *>(m_columns[1]->data); }
+    const quint32 *systemColumn() const { return reinterpret_cast<const quint32 *>(m_columns[2]->data); }
+    const float *distanceColumn() const { return reinterpret_cast<const float *>(m_columns[6]->data); }
+
+    static QMutex s_mutex;
+    static JumpStore* s_instance;
+
+    mutable QMutex m_mutex;
+    QString m_storePath;
+    std::unique_ptr<Column> m_columns[8];  // timestamp, commander, system, x, y, z, distance, kind
+    qint64 m_rowCount;
+
+    QStringList m_commanderNames;
+    QHash<QString, quint16> m_commanderIds;
+    QStringList m_systemNames;
+    QHash<QString, quint32> m_systemIds;
+    QFile m_systemDictionary;
+
+    QHash<QString, Source> m_sources;  // Journal name (without .gz) -> ingest progress
+    qint64 m_savedRowCount;            // Rows sources.json accounts for; -1 if it predates the count
+    QSet<QString> m_asyncIngests;
+    QSet<QString> m_asyncReruns;
+};
+
+#endif // JUMPSTORE_H
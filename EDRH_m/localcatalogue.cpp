@@ -0,0 +1,336 @@
+#include "localcatalogue.h"
+#include <QDir>
+#include <QSaveFile>
+#include <QSet>
+#include <QCborValue>
+#include <QCborMap>
+#include <QtEndian>
+#include <QDebug>
+#include <cstring>
+
+namespace {
+
+// File layout (little endian):
+//   "EDRC" | version u32 | row count u32 | row offsets u32[rows] | rows
+// and each row is: key length u16 | key | CBOR length u32 | CBOR map
+const char kMagic[4] = {'E', 'D', 'R', 'C'};
+const quint32 kVersion = 1;
+const qint64 kHeaderSize = 12;
+
+template <typename T>
+void appendLittleEndian(QByteArray &out, T value)
+{
+    const T le = qToLittleEndian(value);
+    out.append(reinterpret_cast<const char *>(&le), sizeof(T));
+}
+
+}
+
+LocalCatalogue::LocalCatalogue(const QString &directory)
+    : m_directory(directory)
+{
+    for (const QString &name : tables()) {
+        m_tables.insert(name, std::make_shared<Table>());
+    }
+}
+
+LocalCatalogue::~LocalCatalogue()
+{
+    for (auto &table : m_tables) {
+        if (table->data) {
+            table->file.unmap(table->data);
+        }
+    }
+}
+
+QStringList LocalCatalogue::tables()
+{
+    return {"systems", "taken", "pois", "system_information"};
+}
+
+void LocalCatalogue::load()
+{
+    QDir().mkpath(m_directory);
+    for (auto it = m_tables.begin(); it != m_tables.end(); ++it) {
+        Table &table = *it.value();
+        table.file.setFileName(QDir(m_directory).filePath(it.key() + ".bin"));
+        mapTable(table);
+        if (table.present) {
+            qDebug() << "Local catalogue:" << it.key() << "has" << table.rowCount << "rows";
+        }
+    }
+}
+
+void LocalCatalogue::mapTable(Table &table)
+{
+    if (table.data) {
+        table.file.unmap(table.data);
+        table.data = nullptr;
+    }
+    table.file.close();
+    table.size = 0;
+    table.rowCount = 0;
+    table.keys.clear();
+    table.present = false;
+
+    if (!table.file.exists() || !table.file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    table.size = table.file.size();
+    if (table.size >= kHeaderSize) {
+        table.data = table.file.map(0, table.size);
+    }
+    if (!table.data || std::memcmp(table.data, kMagic, 4) != 0 ||
+        qFromLittleEndian<quint32>(table.data + 4) != kVersion) {
+        qDebug() << "Local catalogue: ignoring unreadable" << table.file.fileName();
+        if (table.data) {
+            table.file.unmap(table.data);
+            table.data = nullptr;
+        }
+        table.file.close();
+        return;
+    }
+
+    const quint32 rows = qFromLittleEndian<quint32>(table.data + 8);
+    if (kHeaderSize + qint64(rows) * 4 > table.size) {
+        qDebug() << "Local catalogue: truncated" << table.file.fileName();
+        table.file.unmap(table.data);
+        table.data = nullptr;
+        table.file.close();
+        return;
+    }
+
+    table.rowCount = int(rows);
+    table.keys.reserve(table.rowCount);
+    for (int i = 0; i < table.rowCount; ++i) {
+        QByteArray key;
+        storedRow(table, i, &key);
+        table.keys.insert(key, i);
+    }
+    table.present = true;
+}
+
+LocalCatalogue::Table *LocalCatalogue::table(const QString &name) const
+{
+    auto it = m_tables.constFind(name);
+    return it == m_tables.constEnd() ? nullptr : it.value().get();
+}
+
+QByteArray LocalCatalogue::storedRow(const Table &table, int index, QByteArray *key) const
+{
+    const quint32 offset = qFromLittleEndian<quint32>(table.data + kHeaderSize + qint64(index) * 4);
+    if (offset + 6 > table.size) {
+        return QByteArray();
+    }
+
+    const uchar *ptr = table.data + offset;
+    const quint16 keyLength = qFromLittleEndian<quint16>(ptr);
+    ptr += 2;
+    if (key) {
+        *key = QByteArray(reinterpret_cast<const char *>(ptr), keyLength);
+    }
+    ptr += keyLength;
+
+    const quint32 length = qFromLittleEndian<quint32>(ptr);
+    ptr += 4;
+    if ((ptr - table.data) + qint64(length) > table.size) {
+        return QByteArray();
+    }
+    // Points into the mapping - only valid until the table is remapped
+    return QByteArray::fromRawData(reinterpret_cast<const char *>(ptr), length);
+}
+
+bool LocalCatalogue::hasTable(const QString &name) const
+{
+    Table *t = table(name);
+    return t && t->present;
+}
+
+int LocalCatalogue::rowCount(const QString &name) const
+{
+    Table *t = table(name);
+    return t ? t->rowCount : 0;
+}
+
+QJsonObject LocalCatalogue::row(const QString &name, int index) const
+{
+    Table *t = table(name);
+    if (!t || index < 0 || index >= t->rowCount) {
+        return QJsonObject();
+    }
+    return QCborValue::fromCbor(storedRow(*t, index)).toMap().toJsonObject();
+}
+
+QCborMap LocalCatalogue::rowMap(const QString &name, int index) const
+{
+    Table *t = table(name);
+    if (!t || index < 0 || index >= t->rowCount) {
+        return QCborMap();
+    }
+    return QCborValue::fromCbor(storedRow(*t, index)).toMap();
+}
+
+QJsonArray LocalCatalogue::rows(const QString &name) const
+{
+    QJsonArray result;
+    Table *t = table(name);
+    if (!t) {
+        return result;
+    }
+    for (int i = 0; i < t->rowCount; ++i) {
+        result.append(QCborValue::fromCbor(storedRow(*t, i)).toMap().toJsonObject());
+    }
+    return result;
+}
+
+QStringList LocalCatalogue::keyColumns(const QString &table)
+{
+    if (table == "systems") {
+        return {"systems", "category"};
+    }
+    if (table == "taken") {
+        return {"system", "by_cmdr"};
+    }
+    return {"system"};
+}
+
+QByteArray LocalCatalogue::rowKey(const QString &name, const QJsonObject &row) const
+{
+    if (row.contains("id")) {
+        return "id:" + row.value("id").toVariant().toString().toUtf8();
+    }
+
+    // Tables without an id fall back to the columns the app treats as unique
+    QByteArray key;
+    for (const QString &column : keyColumns(name)) {
+        key += row.value(column).toVariant().toString().toUtf8();
+        key += '\x1f';
+    }
+    return key;
+}
+
+bool LocalCatalogue::upsert(const QString &name, const QJsonObject &row)
+{
+    Table *t = table(name);
+    if (!t) {
+        return false;
+    }
+
+    const QByteArray key = rowKey(name, row);
+    const QByteArray cbor = QCborValue::fromJsonValue(row).toCbor();
+
+    auto staged = t->staged.find(key);
+    if (staged != t->staged.end()) {
+        if (staged.value() == cbor) {
+            return false;
+        }
+        staged.value() = cbor;
+        return true;
+    }
+
+    const int index = t->keys.value(key, -1);
+    const bool unchanged = index >= 0 && storedRow(*t, index) == cbor;
+    if (unchanged && !t->replacing) {
+        return false;
+    }
+
+    t->staged.insert(key, cbor);
+    t->stagedOrder.append(key);
+    return !unchanged;
+}
+
+void LocalCatalogue::beginReplace(const QString &name)
+{
+    if (Table *t = table(name)) {
+        t->staged.clear();
+        t->stagedOrder.clear();
+        t->replacing = true;
+    }
+}
+
+void LocalCatalogue::discard(const QString &name)
+{
+    if (Table *t = table(name)) {
+        t->staged.clear();
+        t->stagedOrder.clear();
+        t->replacing = false;
+    }
+}
+
+bool LocalCatalogue::commit(const QString &name)
+{
+    Table *t = table(name);
+    if (!t) {
+        return false;
+    }
+    if (t->present && t->staged.isEmpty() && !t->replacing) {
+        return true;
+    }
+
+    // Stored rows keep their position (with staged updates applied), new rows go last
+    QVector<quint32> offsets;
+    QByteArray body;
+    QSet<QByteArray> written;
+    quint32 rows = quint32(t->stagedOrder.size());
+    if (!t->replacing) {
+        rows += quint32(t->rowCount);
+        for (const QByteArray &key : std::as_const(t->stagedOrder)) {
+            rows -= t->keys.contains(key) ? 1 : 0;
+        }
+    }
+    const qint64 bodyStart = kHeaderSize + qint64(rows) * 4;
+
+    auto appendRow = [&](const QByteArray &key, const QByteArray &cbor) {
+        offsets.append(quint32(bodyStart + body.size()));
+        appendLittleEndian(body, quint16(key.size()));
+        body.append(key);
+        appendLittleEndian(body, quint32(cbor.size()));
+        body.append(cbor);
+        written.insert(key);
+    };
+
+    if (!t->replacing) {
+        for (int i = 0; i < t->rowCount; ++i) {
+            QByteArray key;
+            const QByteArray stored = storedRow(*t, i, &key);
+            appendRow(key, t->staged.value(key, stored));
+        }
+    }
+    for (const QByteArray &key : std::as_const(t->stagedOrder)) {
+        if (!written.contains(key)) {
+            appendRow(key, t->staged.value(key));
+        }
+    }
+
+    QByteArray header;
+    header.append(kMagic, 4);
+    appendLittleEndian(header, kVersion);
+    appendLittleEndian(header, quint32(offsets.size()));
+    for (quint32 offset : std::as_const(offsets)) {
+        appendLittleEndian(header, offset);
+    }
+    // The mapping has to go before the file can be replaced (Windows refuses otherwise)
+    if (t->data) {
+        t->file.unmap(t->data);
+        t->data = nullptr;
+    }
+    t->file.close();
+
+    QSaveFile out(t->file.fileName());
+    bool ok = out.open(QIODevice::WriteOnly);
+    if (ok) {
+        out.write(header);
+        out.write(body);
+        ok = out.commit();
+    }
+    if (!ok) {
+        qDebug() << "Local catalogue: failed to write" << t->file.fileName() << out.errorString();
+    }
+
+    t->staged.clear();
+    t->stagedOrder.clear();
+    t->replacing = false;
+    mapTable(*t);
+    return ok;
+}
@@ -0,0 +1,68 @@
+#ifndef LOCALCATALOGUE_H
+#define LOCALCATALOGUE_H
+
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QCborMap>
+#include <QFile>
+#include <QHash>
+#include <QVector>
+#include <memory>
+
+// On-disk copy of the database tables the app reads on every refresh (systems, taken,
+// pois, system_information). Each table is one binary file of CBOR rows behind an
+// offset table; the file is memory-mapped and rows are only decoded when asked for.
+// Changes are staged with upsert() and written out in one go by commit().
+class LocalCatalogue
+{
+public:
+    explicit LocalCatalogue(const QString &directory);
+    ~LocalCatalogue();
+
+    // Tables kept in the catalogue, in sync order
+    static QStringList tables();
+    // Columns that identify a row of a table without an id column
+    static QStringList keyColumns(const QString &table);
+
+    void load();
+
+    // True once the table has been downloaded at least once
+    bool hasTable(const QString &table) const;
+    int rowCount(const QString &table) const;
+    QJsonObject row(const QString &table, int index) const;
+    QCborMap rowMap(const QString &table, int index) const;     // Without the JSON conversion
+    QJsonArray rows(const QString &table) const;
+
+    // Stage a row; returns false when an identical row is already stored
+    bool upsert(const QString &table, const QJsonObject &row);
+    // Drop the stored rows on the next commit, keeping only what is staged from now on
+    void beginReplace(const QString &table);
+    bool commit(const QString &table);
+    void discard(const QString &table);
+
+private:
+    struct Table {
+        QFile file;
+        uchar *data = nullptr;
+        qint64 size = 0;
+        int rowCount = 0;
+        QHash<QByteArray, int> keys;                // Row key -> row index
+        QHash<QByteArray, QByteArray> staged;       // Row key -> CBOR
+        QVector<QByteArray> stagedOrder;            // New keys in arrival order
+        bool replacing = false;
+        bool present = false;
+    };
+
+    Table *table(const QString &name) const;
+    void mapTable(Table &table);
+    QByteArray rowKey(const QString &table, const QJsonObject &row) const;
+    QByteArray storedRow(const Table &table, int index, QByteArray *key = nullptr) const;
+
+    QString m_directory;
+    QHash<QString, std::shared_ptr<Table>> m_tables;
+};
+
+#endif // LOCALCATALOGUE_H
@@ -103,6 +103,9 @@ int main(int argc, char *argv[])
     ClaimManager claimManager;
     EDRHController controller;
     
+    // Journal visit checks made during claims are answered by the journal monitor
+    supabaseClient.setJournalMonitor(&journalMonitor);
+    
     // Set up the configuration connections BEFORE loading QML
     // This ensures the signal connection is ready when QML calls loadConfig()
     QObject::connect(&configManager, &ConfigManager::configLoaded, [&]() {
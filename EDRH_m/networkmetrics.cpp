@@ -0,0 +1,103 @@
+#include "networkmetrics.h"
+#include <QVector>
+#include <algorithm>
+
+const qint64 NetworkMetrics::LatencyBucketBoundsMs[LatencyBucketCount - 1] = {
+    50, 100, 250, 500, 1000, 2500, 5000, 10000
+};
+
+void NetworkMetrics::recordReply(const QString &tag, bool error, qint64 latencyMs, qint64 firstByteMs,
+                                 qint64 bytesUp, qint64 bytesDown)
+{
+    Operation &operation = m_operations[tag];
+    operation.count++;
+    if (error) {
+        operation.errors++;
+    }
+    operation.bytesUp += bytesUp;
+    operation.bytesDown += bytesDown;
+    if (firstByteMs >= 0) {
+        operation.totalFirstByteMs += firstByteMs;
+        operation.firstByteSamples++;
+    }
+    if (latencyMs >= 0) {
+        operation.totalLatencyMs += latencyMs;
+        operation.maxLatencyMs = qMax(operation.maxLatencyMs, latencyMs);
+        const qint64 *bound = std::lower_bound(std::begin(LatencyBucketBoundsMs), std::end(LatencyBucketBoundsMs), latencyMs);
+        operation.latencyHistogram[bound - std::begin(LatencyBucketBoundsMs)]++;
+    }
+}
+
+void NetworkMetrics::recordRetry(const QString &tag)
+{
+    m_operations[tag].retries++;
+}
+
+void NetworkMetrics::reset()
+{
+    m_operations.clear();
+}
+
+qint64 NetworkMetrics::percentileMs(const Operation &operation, double fraction)
+{
+    // Upper bound of the bucket the percentile falls in; the slowest bucket reports the max seen
+    int samples = 0;
+    for (int count : operation.latencyHistogram) {
+        samples += count;
+    }
+    const int target = qMax(1, int(samples * fraction + 0.5));
+    int seen = 0;
+    for (int i = 0; i < LatencyBucketCount - 1; ++i) {
+        seen += operation.latencyHistogram[i];
+        if (seen >= target) {
+            return qMin(LatencyBucketBoundsMs[i], operation.maxLatencyMs);
+        }
+    }
+    return operation.maxLatencyMs;
+}
+
+QVariantList NetworkMetrics::toVariantList() const
+{
+    QVector<QVariantMap> entries;
+    for (auto it = m_operations.constBegin(); it != m_operations.constEnd(); ++it) {
+        const Operation &operation = it.value();
+        QVariantMap entry;
+        entry["operation"] = it.key().isEmpty() ? QStringLiteral("unknown") : it.key();
+        entry["count"] = operation.count;
+        entry["errors"] = operation.errors;
+        entry["retries"] = operation.retries;
+        entry["bytesUp"] = operation.bytesUp;
+        entry["bytesDown"] = operation.bytesDown;
+        entry["averageLatencyMs"] = operation.count > 0 ? double(operation.totalLatencyMs) / operation.count : 0.0;
+        entry["maxLatencyMs"] = operation.maxLatencyMs;
+        entry["p50LatencyMs"] = percentileMs(operation, 0.50);
+        entry["p95LatencyMs"] = percentileMs(operation, 0.95);
+        entry["averageFirstByteMs"] = operation.firstByteSamples > 0
+            ? double(operation.totalFirstByteMs) / operation.firstByteSamples : -1.0;
+
+        QVariantList histogram;
+        for (int i = 0; i < LatencyBucketCount; ++i) {
+            QVariantMap bucket;
+            bucket["le"] = i < LatencyBucketCount - 1 ? QVariant(LatencyBucketBoundsMs[i]) : QVariant(QStringLiteral("inf"));
+            bucket["count"] = operation.latencyHistogram[i];
+            histogram.append(bucket);
+        }
+        entry["latencyHistogram"] = histogram;
+        entries.append(entry);
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const QVariantMap &a, const QVariantMap &b) {
+        return a.value("averageLatencyMs").toDouble() > b.value("averageLatencyMs").toDouble();
+    });
+
+    QVariantList result;
+    for (const QVariantMap &entry : entries) {
+        result.append(entry);
+    }
+    return result;
+}
+
+QJsonArray NetworkMetrics::toJson() const
+{
+    return QJsonArray::fromVariantList(toVariantList());
+}
@@ -0,0 +1,57 @@
+#ifndef NETWORKMETRICS_H
+#define NETWORKMETRICS_H
+
+#include <QString>
+#include <QHash>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QVariantList>
+#include <QElapsedTimer>
+
+// Timing of one request in flight, filled in as its reply progresses
+struct NetworkRequestTiming
+{
+    QElapsedTimer timer;        // Started when the request was sent
+    qint64 firstByteMs = -1;    // Headers in; -1 until then
+    qint64 bytesUp = 0;
+};
+
+// Request counters per operation tag ("GET:systems_near", "IMAGE:i.ibb.co"): errors, retries,
+// bytes each way, time to first byte and a latency histogram. Not thread-safe; each owner
+// records from its own thread.
+class NetworkMetrics
+{
+public:
+    // Upper bounds of the latency buckets in ms; one more bucket holds everything slower
+    static constexpr int LatencyBucketCount = 9;
+    static const qint64 LatencyBucketBoundsMs[LatencyBucketCount - 1];
+
+    void recordReply(const QString &tag, bool error, qint64 latencyMs, qint64 firstByteMs,
+                     qint64 bytesUp, qint64 bytesDown);
+    void recordRetry(const QString &tag);
+    void reset();
+
+    // One entry per tag, slowest average first
+    QVariantList toVariantList() const;
+    QJsonArray toJson() const;
+
+private:
+    struct Operation {
+        int count = 0;
+        int errors = 0;
+        int retries = 0;
+        qint64 bytesUp = 0;
+        qint64 bytesDown = 0;
+        qint64 totalFirstByteMs = 0;
+        int firstByteSamples = 0;
+        qint64 totalLatencyMs = 0;
+        qint64 maxLatencyMs = 0;
+        int latencyHistogram[LatencyBucketCount] = {};
+    };
+
+    static qint64 percentileMs(const Operation &operation, double fraction);
+
+    QHash<QString, Operation> m_operations;
+};
+
+#endif // NETWORKMETRICS_H
@@ -151,14 +151,14 @@ Rectangle {
                         accentColor: Theme.infoColor
                     }
                     
-                    // Jump count stat
+                    // Jump count stat: this session, and the commander's lifetime total from the jump store
                     StatCard {
                         Layout.fillWidth: true
                         Layout.preferredHeight: 75  // Increased from 50 to 75
                         Layout.maximumHeight: 75    // Prevent stretching
                         Layout.minimumHeight: 60    // Prevent collapsing
-                        title: "JUMPS THIS SESSION"
-                        value: edrhController.jumpCount.toString()
+                        title: "JUMPS SESSION / TOTAL"
+                        value: edrhController.jumpCount + " / " + edrhController.totalJumpCount
                         icon: ""
                         accentColor: Theme.warningColor
                     }
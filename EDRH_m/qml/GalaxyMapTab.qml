@@ -27,10 +27,10 @@ Rectangle {
     
     function updateSystemsFromController() {
         if (typeof edrhController !== 'undefined' && edrhController.galaxyMapSystems) {
-            console.log("Updating galaxy map with", edrhController.galaxyMapSystems.length, "real systems from database")
+            console.log("Updating galaxy map with", edrhController.galaxyMapSystems.count, "real systems from database")
             
             // Convert systems data for the canvas
-            mapCanvas.allSystems = edrhController.galaxyMapSystems
+            mapCanvas.allSystems = edrhController.galaxyMapSystems.toList()
             mapCanvas.requestRedraw()
             
             // Update loading state
@@ -525,7 +525,7 @@ Rectangle {
                             type: "database",
                             claimed: dbSystem.claimed || false,
                             claimedBy: dbSystem.claimedBy || "",
-                            distance: dbSystem.distance || "N/A"
+                            distance: dbSystem.distanceLy >= 0 ? dbSystem.distanceLy.toFixed(1) + " LY" : "N/A"
                         })
                     }
                     
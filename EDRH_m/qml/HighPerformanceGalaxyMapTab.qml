@@ -30,7 +30,7 @@ Item {
             }
             
             // Also try refreshData if no systems are available, but only if journal is verified
-            if (edrhController && (!edrhController.galaxyMapSystems || edrhController.galaxyMapSystems.length === 0)) {
+            if (edrhController && edrhController.galaxyMapSystems.count === 0) {
                 // Check journal verification status before attempting data refresh
                 if (typeof edrhController.refreshData === 'function' && configManager && configManager.journalVerified) {
                     console.log("Galaxy Map: Journal verified, calling refreshData")
@@ -70,7 +70,7 @@ Item {
         console.log("=== updateSystemsData called ===")
         console.log("  edrhController available:", typeof edrhController !== 'undefined')
         if (edrhController) {
-            console.log("  galaxyMapSystems count:", edrhController.galaxyMapSystems ? edrhController.galaxyMapSystems.length : 0)
+            console.log("  galaxyMapSystems count:", edrhController.galaxyMapSystems.count)
         }
         updateFilteredSystems()
     }
@@ -158,7 +158,7 @@ Item {
         try {
             console.log("=== updateFilteredSystems called ===")
             var filtered = []
-            var sourceData = edrhController.galaxyMapSystems || []
+            var sourceData = edrhController.galaxyMapSystems.toList()
             
             console.log("  Source data count:", sourceData.length)
             
@@ -531,6 +531,9 @@ Item {
         isAdminMode: edrhController.isAdmin || false
         allCommanderLocations: edrhController.allCommanderLocations || []
         
+        // Plotted route from NavRoute.json
+        navRoute: edrhController.navRoute || []
+        
         // Connect to filtered star data from EDRH controller
         starSystems: root.filteredGalaxyMapSystems || []
         
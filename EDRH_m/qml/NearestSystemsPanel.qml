@@ -1,6 +1,7 @@
 import QtQuick 2.15
 import QtQuick.Controls 2.15
 import QtQuick.Layouts 1.15
+import QtQml.Models 2.15
 
 Rectangle {
     id: root
@@ -31,55 +32,84 @@ Rectangle {
         }
     }
     
-    // Filtered systems model
-    property var filteredSystemsModel: []
-    
     // Pagination properties - smaller initial load to encourage Load More usage
     property int systemsPerPage: 20
     property int currentlyShowing: 20
-    property var displayedSystemsModel: []
     
-    // Update filtered systems when source data or filters change
-    function updateFilteredSystems() {
-        var filtered = []
-        var sourceData = edrhController.nearestSystems || []
+    // Rows come straight from the controller's list model. Each row is tagged "matched"
+    // when it passes the filters and "shown" when it is also within the current page, so
+    // a claim or image change only touches the delegate of the row that changed.
+    DelegateModel {
+        id: systemsDelegateModel
+        model: edrhController.nearestSystems
         
-        for (var i = 0; i < sourceData.length; i++) {
-            var system = sourceData[i]
-            if (filterManager.matchesFilter(system)) {
-                filtered.push(system)
+        groups: [
+            DelegateModelGroup { id: matchedGroup; name: "matched" },
+            DelegateModelGroup { id: shownGroup; name: "shown" }
+        ]
+        filterOnGroup: "shown"
+        
+        items.onChanged: function(removed, inserted) {
+            for (var i = 0; i < inserted.length; i++) {
+                updateItemFilter(inserted[i].index, inserted[i].count)
             }
+            updateDisplayedSystems()
         }
         
-        filteredSystemsModel = filtered
+        delegate: SystemCard {
+            width: systemsList.width - 16  // Adjusted for increased margins
+            systemData: model.systemData
+            
+            onSystemClicked: function(systemName) {
+                edrhController.viewSystem(systemName)
+            }
+            
+            onSystemNameCopyRequested: function(systemName) {
+                edrhController.copyToClipboard(systemName)
+            }
+        }
+    }
+    
+    // Re-run the filters for a range of source rows
+    function updateItemFilter(first, count) {
+        var items = systemsDelegateModel.items
+        var last = Math.min(first + count, items.count)
+        for (var i = first; i < last; i++) {
+            var item = items.get(i)
+            var matches = filterManager.matchesFilter(item.model.systemData)
+            item.inMatched = matches
+            if (!matches) {
+                item.inShown = false
+            }
+        }
+    }
+    
+    // Update filtered systems when filters change
+    function updateFilteredSystems() {
+        updateItemFilter(0, systemsDelegateModel.items.count)
         updateDisplayedSystems()
     }
     
     // Update displayed systems based on pagination
     function updateDisplayedSystems() {
-        var displayed = []
-        var maxToShow = Math.min(currentlyShowing, filteredSystemsModel.length)
-        
-        for (var i = 0; i < maxToShow; i++) {
-            displayed.push(filteredSystemsModel[i])
+        for (var i = 0; i < matchedGroup.count; i++) {
+            matchedGroup.get(i).inShown = i < currentlyShowing
         }
-        
-        displayedSystemsModel = displayed
     }
     
     // Show more systems
     function showMoreSystems() {
         // Save current scroll position
         var oldContentY = systemsList.contentY
-        var oldCount = displayedSystemsModel.length
+        var oldCount = shownGroup.count
         
-        currentlyShowing = Math.min(currentlyShowing + systemsPerPage, filteredSystemsModel.length)
+        currentlyShowing = Math.min(currentlyShowing + systemsPerPage, matchedGroup.count)
         updateDisplayedSystems()
         
         // Restore scroll position after adding new items
         Qt.callLater(function() {
             // Maintain scroll position or scroll to just above the new items
-            var newItemsAdded = displayedSystemsModel.length - oldCount
+            var newItemsAdded = shownGroup.count - oldCount
             if (newItemsAdded > 0) {
                 // Keep current view position, don't jump to top
                 systemsList.contentY = oldContentY
@@ -93,12 +123,15 @@ Rectangle {
         updateDisplayedSystems()
     }
     
-    // Watch for changes in source data
+    // Rows edited in place may start or stop matching the filters
     Connections {
-        target: edrhController
-        function onNearestSystemsChanged() {
+        target: edrhController.nearestSystems
+        function onDataChanged(topLeft, bottomRight, roles) {
+            updateItemFilter(topLeft.row, bottomRight.row - topLeft.row + 1)
+            updateDisplayedSystems()
+        }
+        function onModelReset() {
             resetPagination()
-            updateFilteredSystems()
         }
     }
     
@@ -393,32 +426,19 @@ Rectangle {
                 // Improve scrolling behavior
                 boundsBehavior: Flickable.StopAtBounds
                 
-                model: displayedSystemsModel
-                
-                delegate: SystemCard {
-                    width: systemsList.width - 16  // Adjusted for increased margins
-                    systemData: modelData
-                    
-                    onSystemClicked: function(systemName) {
-                        edrhController.viewSystem(systemName)
-                    }
-                    
-                    onSystemNameCopyRequested: function(systemName) {
-                        edrhController.copyToClipboard(systemName)
-                    }
-                }
+                model: systemsDelegateModel
                 
                 // Footer with Load More button at bottom of scroll
                 footer: Item {
                     width: systemsList.width
-                    height: currentlyShowing < filteredSystemsModel.length ? 100 : 50
+                    height: currentlyShowing < matchedGroup.count ? 100 : 50
                     
                     // Systems count info
                     Text {
                         anchors.top: parent.top
                         anchors.left: parent.left
                         anchors.margins: 10
-                        text: "Showing " + displayedSystemsModel.length + " of " + filteredSystemsModel.length + " systems"
+                        text: "Showing " + shownGroup.count + " of " + matchedGroup.count + " systems"
                         color: Theme.textSecondary
                         font.pixelSize: 13
                     }
@@ -428,9 +448,9 @@ Rectangle {
                         id: footerShowMoreBtn
                         anchors.centerIn: parent
                         anchors.topMargin: 20
-                        text: "Load " + Math.min(systemsPerPage, filteredSystemsModel.length - currentlyShowing) + " More Systems"
-                        visible: currentlyShowing < filteredSystemsModel.length
-                        enabled: currentlyShowing < filteredSystemsModel.length
+                        text: "Load " + Math.min(systemsPerPage, matchedGroup.count - currentlyShowing) + " More Systems"
+                        visible: currentlyShowing < matchedGroup.count
+                        enabled: currentlyShowing < matchedGroup.count
                         
                         width: 200
                         height: 40
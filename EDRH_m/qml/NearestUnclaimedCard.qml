@@ -13,6 +13,28 @@ Rectangle {
     Layout.preferredHeight: 180
     Layout.maximumHeight: 180
     
+    // Row of the unclaimed model at unclaimedIndex, refreshed when that model changes
+    property var currentSystem: ({})
+    
+    function refreshCurrentSystem() {
+        currentSystem = edrhController.unclaimedSystems.get(edrhController.unclaimedIndex)
+    }
+    
+    Component.onCompleted: refreshCurrentSystem()
+    
+    Connections {
+        target: edrhController
+        function onUnclaimedIndexChanged() { root.refreshCurrentSystem() }
+    }
+    
+    Connections {
+        target: edrhController.unclaimedSystems
+        function onDataChanged() { root.refreshCurrentSystem() }
+        function onModelReset() { root.refreshCurrentSystem() }
+        function onRowsInserted() { root.refreshCurrentSystem() }
+        function onRowsRemoved() { root.refreshCurrentSystem() }
+    }
+    
     ColumnLayout {
         anchors.fill: parent
         anchors.margins: 15
@@ -40,7 +62,7 @@ Rectangle {
             
             // System count
             Text {
-                text: "(" + edrhController.nearestSystems.length + " systems)"
+                text: "(" + edrhController.nearestSystems.count + " systems)"
                 font.pixelSize: 12  // Increased from 10 to 12
                 color: Theme.textMuted
                 font.italic: true
@@ -108,37 +130,31 @@ Rectangle {
                 Text {
                     text: {
                         // Get current unclaimed system data to determine POI status
-                        var systems = edrhController.unclaimedSystems || []
-                        if (systems.length > 0 && edrhController.unclaimedIndex < systems.length) {
-                            var currentSystem = systems[edrhController.unclaimedIndex]
-                            if (currentSystem && typeof currentSystem === 'object') {
-                                var poi = currentSystem.potential_or_poi || currentSystem.poi || ""
-                                if (poi === "POI") return "• Confirmed POI"
-                                if (poi === "Potential POI") return "• Potential POI"
-                                
-                                // Check if it's claimed/done
-                                if (currentSystem.done) return "• System Done"
-                                if (currentSystem.claimed) return "• System Claimed"
-                                
-                                // Default for unclaimed systems
-                                return "• Unclaimed System"
-                            }
+                        var currentSystem = root.currentSystem
+                        if (currentSystem && currentSystem.name) {
+                            var poi = currentSystem.potential_or_poi || currentSystem.poi || ""
+                            if (poi === "POI") return "• Confirmed POI"
+                            if (poi === "Potential POI") return "• Potential POI"
+                            
+                            // Check if it's claimed/done
+                            if (currentSystem.done) return "• System Done"
+                            if (currentSystem.claimed) return "• System Claimed"
+                            
+                            // Default for unclaimed systems
+                            return "• Unclaimed System"
                         }
                         return "• No System Selected"
                     }
                     font.pixelSize: 11  // Increased from 8 to 11
                     font.bold: true  // Make it bold
                     color: {
-                        var systems = edrhController.unclaimedSystems || []
-                        if (systems.length > 0 && edrhController.unclaimedIndex < systems.length) {
-                            var currentSystem = systems[edrhController.unclaimedIndex]
-                            if (currentSystem && typeof currentSystem === 'object') {
-                                var poi = currentSystem.potential_or_poi || currentSystem.poi || ""
-                                if (poi === "POI") return "#48bb78"  // Green for confirmed POI
-                                if (poi === "Potential POI") return "#f6ad55"  // Orange for potential POI
-                                if (currentSystem.done) return "#AAFFAA"  // Light green for done
-                                if (currentSystem.claimed) return "#FF6B6B"  // Red for claimed
-                            }
+                        var currentSystem = root.currentSystem
+                        if (currentSystem && currentSystem.name) {
+                            var poi = currentSystem.potential_or_poi || currentSystem.poi || ""
+                            if (poi === "POI") return "#48bb78"  // Green for confirmed POI
+                            if (poi === "Potential POI") return "#f6ad55"  // Orange for potential POI
+                            if (currentSystem.done) return "#AAFFAA"  // Light green for done
+                            if (currentSystem.claimed) return "#FF6B6B"  // Red for claimed
                         }
                         return Theme.warningColor  // Default color
                     }
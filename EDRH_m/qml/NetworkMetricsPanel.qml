@@ -0,0 +1,188 @@
+import QtQuick 2.15
+import QtQuick.Controls 2.15
+import QtQuick.Layouts 1.15
+
+// Debug view of per-operation request metrics from SupabaseClient and ImageLoader (Ctrl+Shift+M)
+Dialog {
+    id: metricsPanel
+
+    property var supabaseStats: []
+    property var imageStats: []
+    property string statusText: ""
+
+    title: "Network Metrics"
+    modal: false
+    width: 760
+    height: 520
+    anchors.centerIn: parent
+
+    function refresh() {
+        supabaseStats = supabaseClient.operationStats()
+        imageStats = imageLoader.networkStats()
+    }
+
+    function formatBytes(bytes) {
+        if (bytes < 1024) return bytes + " B"
+        if (bytes < 1024 * 1024) return (bytes / 1024).toFixed(1) + " KB"
+        return (bytes / (1024 * 1024)).toFixed(1) + " MB"
+    }
+
+    function formatMs(ms) {
+        return ms < 0 ? "-" : Math.round(ms) + " ms"
+    }
+
+    onOpened: {
+        statusText = ""
+        refresh()
+    }
+
+    Timer {
+        interval: 1000
+        repeat: true
+        running: metricsPanel.visible
+        onTriggered: metricsPanel.refresh()
+    }
+
+    background: Rectangle {
+        color: "#141414"
+        border.color: "#FF7F50"
+        border.width: 2
+        radius: 8
+    }
+
+    header: Rectangle {
+        color: "#FF7F50"
+        height: 40
+        radius: 8
+
+        Text {
+            anchors.centerIn: parent
+            text: "Network Metrics"
+            color: "white"
+            font.pixelSize: 16
+            font.bold: true
+        }
+    }
+
+    component StatsHeader: RowLayout {
+        spacing: 8
+        Repeater {
+            model: ["Operation", "Count", "Err", "Retry", "Avg", "p95", "TTFB", "Up", "Down"]
+            Text {
+                Layout.preferredWidth: index === 0 ? 220 : 56
+                text: modelData
+                color: "#FF7F50"
+                font.pixelSize: 11
+                font.bold: true
+            }
+        }
+    }
+
+    component StatsRow: RowLayout {
+        property var stats: ({})
+        spacing: 8
+        Text { Layout.preferredWidth: 220; text: stats.operation; color: "white"; font.pixelSize: 11; elide: Text.ElideRight }
+        Text { Layout.preferredWidth: 56; text: stats.count; color: "#CCCCCC"; font.pixelSize: 11 }
+        Text { Layout.preferredWidth: 56; text: stats.errors; color: stats.errors > 0 ? "#E74C3C" : "#CCCCCC"; font.pixelSize: 11 }
+        Text { Layout.preferredWidth: 56; text: stats.retries; color: stats.retries > 0 ? "#F39C12" : "#CCCCCC"; font.pixelSize: 11 }
+        Text { Layout.preferredWidth: 56; text: metricsPanel.formatMs(stats.averageLatencyMs); color: "#CCCCCC"; font.pixelSize: 11 }
+        Text { Layout.preferredWidth: 56; text: metricsPanel.formatMs(stats.p95LatencyMs); color: "#CCCCCC"; font.pixelSize: 11 }
+        Text { Layout.preferredWidth: 56; text: metricsPanel.formatMs(stats.averageFirstByteMs); color: "#CCCCCC"; font.pixelSize: 11 }
+        Text { Layout.preferredWidth: 56; text: metricsPanel.formatBytes(stats.bytesUp); color: "#CCCCCC"; font.pixelSize: 11 }
+        Text { Layout.preferredWidth: 56; text: metricsPanel.formatBytes(stats.bytesDown); color: "#CCCCCC"; font.pixelSize: 11 }
+    }
+
+    ColumnLayout {
+        anchors.fill: parent
+        anchors.margins: 12
+        spacing: 8
+
+        Text {
+            text: "Database (" + metricsPanel.supabaseStats.length + " operations)"
+            color: "white"
+            font.pixelSize: 13
+            font.bold: true
+        }
+
+        StatsHeader {}
+
+        ListView {
+            Layout.fillWidth: true
+            Layout.fillHeight: true
+            Layout.preferredHeight: 3
+            clip: true
+            model: metricsPanel.supabaseStats
+            delegate: StatsRow { stats: modelData }
+            ScrollBar.vertical: ScrollBar {}
+        }
+
+        Text {
+            text: "Images (" + metricsPanel.imageStats.length + " hosts)"
+            color: "white"
+            font.pixelSize: 13
+            font.bold: true
+        }
+
+        StatsHeader {}
+
+        ListView {
+            Layout.fillWidth: true
+            Layout.fillHeight: true
+            Layout.preferredHeight: 1
+            clip: true
+            model: metricsPanel.imageStats
+            delegate: StatsRow { stats: modelData }
+            ScrollBar.vertical: ScrollBar {}
+        }
+
+        Text {
+            Layout.fillWidth: true
+            text: metricsPanel.statusText
+            color: "#AAAAAA"
+            font.pixelSize: 11
+            elide: Text.ElideMiddle
+            visible: text.length > 0
+        }
+
+        RowLayout {
+            Layout.alignment: Qt.AlignRight
+            spacing: 10
+
+            Button {
+                text: "Reset"
+                onClicked: {
+                    supabaseClient.resetOperationStats()
+                    imageLoader.resetNetworkStats()
+                    metricsPanel.statusText = ""
+                    metricsPanel.refresh()
+                }
+            }
+
+            Button {
+                text: "Benchmark Distances"
+                // Only built with EDRH_BENCHMARKS
+                visible: typeof supabaseClient.benchmarkDistanceKernel === "function"
+                onClicked: {
+                    let results = supabaseClient.benchmarkDistanceKernel()
+                    metricsPanel.statusText = results.map(function(r) {
+                        return r.systems + ": scalar " + r.scalarMs.toFixed(2) + " ms, " + r.kernel + " "
+                               + r.simdMs.toFixed(2) + " ms, " + r.threads + "T " + r.threadedMs.toFixed(2) + " ms"
+                    }).join("  |  ")
+                }
+            }
+
+            Button {
+                text: "Save Snapshot"
+                onClicked: {
+                    let path = supabaseClient.writeNetworkMetricsSnapshot({ "images": imageLoader.networkStats() })
+                    metricsPanel.statusText = path.length > 0 ? "Saved to " + path : "Failed to write snapshot"
+                }
+            }
+
+            Button {
+                text: "Close"
+                onClicked: metricsPanel.close()
+            }
+        }
+    }
+}
@@ -1197,6 +1197,17 @@ ApplicationWindow {
         }
     }
     
+    // Network metrics debug panel
+    NetworkMetricsPanel {
+        id: networkMetricsPanel
+    }
+    
+    Shortcut {
+        sequence: "Ctrl+Shift+M"
+        context: Qt.ApplicationShortcut
+        onActivated: networkMetricsPanel.visible ? networkMetricsPanel.close() : networkMetricsPanel.open()
+    }
+    
     // SystemViewPopup debounce protection
     property string lastSystemPopupRequest: ""
     property bool systemPopupInProgress: false
@@ -1,4 +1,5 @@
 #include "supabaseclient.h"
+#include "journalmonitor.h"
 #include <QNetworkRequest>
 #include <QNetworkReply>
 #include <QJsonDocument>
@@ -9,16 +10,44 @@
 #include <QtMath>
 #include <QDateTime>
 #include <QSet>
+#include <QVector>
 #include <QStandardPaths>
 #include <QDir>
+#include <QCborMap>
 #include <QFile>
+#include <QSaveFile>
+#include <QScopeGuard>
 #include <QTimer>
+#include <QCoreApplication>
+#include <QtConcurrent>
+#include <QFutureWatcher>
 #include <algorithm>
+#include <limits>
 #include <cmath>
 
 SupabaseClient::SupabaseClient(QObject *parent)
     : QObject(parent)
     , m_networkManager(new QNetworkAccessManager(this))
+    , m_journalMonitor(nullptr)
+    , m_systemsNearRadius(0.0)
+    , m_systemsNearGeneration(0)
+    , m_catalogueSystemsStale(true)
+    , m_nextSystemLookupId(0)
+    , m_systemLookupRpcAvailable(true)
+    , m_writeFlushTimer(nullptr)
+    , m_shuttingDown(false)
+    , m_offline(false)
+    , m_offlineProbeTimer(nullptr)
+    , m_replayOfflineAfterSync(false)
+    , m_replayingOffline(false)
+    , m_replayScope(0)
+    , m_replayOutstanding(0)
+    , m_replayRetryLater(false)
+    , m_replayApplied(0)
+    , m_replayConflicts(0)
+    , m_catalogue(QDir(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation)).filePath("catalogue"))
+    , m_catalogueSyncing(false)
+    , m_catalogueChanges(0)
     , m_lastAuthFailureTime(0)
     , m_consecutiveAuthFailures(0)
     , m_syncInProgress(false)
@@ -34,6 +63,33 @@ SupabaseClient::SupabaseClient(QObject *parent)
     QDir().mkpath(appDataPath);
     m_syncStateFile = QDir(appDataPath).filePath("database_sync_state.json");
     loadSyncState();
+    m_catalogue.load();
+    registerReplyHandlers();
+    
+    // Write-behind queue for taken updates and location, also drained when the app quits
+    m_writeFlushTimer = new QTimer(this);
+    m_writeFlushTimer->setSingleShot(true);
+    m_writeFlushTimer->setInterval(WRITE_FLUSH_DELAY_MS);
+    connect(m_writeFlushTimer, &QTimer::timeout, this, &SupabaseClient::flushPendingWrites);
+    if (QCoreApplication::instance()) {
+        connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this, &SupabaseClient::journalWritesOnShutdown);
+    }
+    
+    // Offline mode: mutations made without a connection wait in a journal until the backend is back
+    m_offlineJournalFile = QDir(appDataPath).filePath("offline_mutations.jsonl");
+    m_offlineProbeTimer = new QTimer(this);
+    m_offlineProbeTimer->setInterval(OFFLINE_PROBE_INTERVAL_MS);
+    connect(m_offlineProbeTimer, &QTimer::timeout, this, &SupabaseClient::probeBackend);
+    loadOfflineJournal();
+    
+    // Background journal scans requested by detectCommanderRenames()
+    connect(&JournalIndex::instance(), &JournalIndex::refreshFinished,
+            this, [this](const QString &journalPath, const QList<JournalFileSummary> &summaries) {
+        if (!m_pendingRenameScanPath.isEmpty() && journalPath == m_pendingRenameScanPath) {
+            m_pendingRenameScanPath.clear();
+            processCommanderRenameScan(summaries);
+        }
+    });
 }
 
 void SupabaseClient::markSystemAsEdited(const QString &systemName)
@@ -53,24 +109,7 @@ void SupabaseClient::markSystemAsEdited(const QString &systemName)
     // Update the edited flag in taken table
     QJsonObject updateData;
     updateData["edited"] = true;
-    
-    QString endpoint = QString("taken?system=eq.%1&by_cmdr=eq.%2")
-                      .arg(QUrl::toPercentEncoding(systemName))
-                      .arg(QUrl::toPercentEncoding(m_currentCommander));
-    
-    QNetworkRequest request = createRequest(endpoint);
-    request.setRawHeader("x-commander-name", m_currentCommander.toUtf8());
-    
-    QJsonDocument doc(updateData);
-    QNetworkReply *reply = m_networkManager->sendCustomRequest(request, "PATCH", doc.toJson());
-    
-    if (reply) {
-        reply->setProperty("operation", "UPDATE:system_edited");
-        reply->setProperty("systemName", systemName);
-        qDebug() << "PATCH request sent to mark" << systemName << "as edited";
-    } else {
-        qDebug() << "Failed to create PATCH request for edited flag";
-    }
+    queueTakenWrite(systemName, updateData);
 }
 
 void SupabaseClient::getCurrentCommanderSystems()
@@ -99,7 +138,7 @@ void SupabaseClient::getCurrentCommanderSystems()
     QNetworkReply *reply = m_networkManager->get(request);
     
     if (reply) {
-        reply->setProperty("operation", "GET:current_commander_taken");
+        trackRequest(reply, SupabaseOperation::GetCurrentCommanderTaken);
         qDebug() << "getCurrentCommanderSystems: Request sent for commander" << m_currentCommander << "with edited flag";
     } else {
         qDebug() << "getCurrentCommanderSystems: Failed to create network request!";
@@ -175,11 +214,11 @@ void SupabaseClient::getSystemInformationFromCategory(const QString &systemName,
     
     
     if (reply) {
-        reply->setProperty("operation", "GET:system_information_category");
-        reply->setProperty("systemName", systemName);
-        reply->setProperty("category", category);
-        reply->setProperty("fallbackUrl", uppercaseUrl);  // Store the uppercase URL as fallback
-        reply->setProperty("triedLowercase", true);
+        trackRequest(reply, SupabaseOperation::GetSystemInformationCategory);
+        requestContext(reply).systemName = systemName;
+        requestContext(reply).category = category;
+        requestContext(reply).fallbackUrl = uppercaseUrl;  // Store the uppercase URL as fallback
+        requestContext(reply).triedLowercase = true;
         qDebug() << "getSystemInformationFromCategory: Request sent for" << systemName;
     } else {
         qDebug() << "getSystemInformationFromCategory: Failed to create network request!";
@@ -382,10 +421,15 @@ void SupabaseClient::makeRequest(const QString &method, const QString &endpoint,
     
     if (reply) {
         // Store operation type for reply handling
-        reply->setProperty("operation", method + ":" + endpoint);
+        trackRequest(reply, method + ":" + endpoint);
     }
 }
 
+void SupabaseClient::setJournalMonitor(JournalMonitor *journalMonitor)
+{
+    m_journalMonitor = journalMonitor;
+}
+
 void SupabaseClient::setCommanderContext(const QString &commanderName)
 {
     if (m_supabaseUrl.isEmpty() || m_supabaseKey.isEmpty()) {
@@ -424,6 +468,11 @@ void SupabaseClient::getSystems()
         return;
     }
     
+    if (m_catalogue.hasTable("systems")) {
+        loadCatalogueSystemsPaged();
+        return;
+    }
+    
     // Check if we should skip due to recent authentication failures
     if (shouldSkipRequestDueToAuthFailure()) {
         qDebug() << "❌ Skipping getSystems() due to authentication failure cooldown";
@@ -434,16 +483,7 @@ void SupabaseClient::getSystems()
     
     // Query the real table: systems (same as getSystemsNear)
     // Order by category first, then by system name for consistent display  
-    QNetworkRequest request = createRequest("systems?select=systems,category,x,y,z&order=category.asc,systems.asc");
-    QNetworkReply *reply = m_networkManager->get(request);
-    
-    if (reply) {
-        reply->setProperty("operation", "GET:systems");
-        qDebug() << "✅ getSystems: Request sent successfully, operation tagged as GET:systems";
-        qDebug() << "Request URL:" << reply->request().url().toString();
-    } else {
-        qDebug() << "❌ getSystems: Failed to create network request!";
-    }
+    startBulkFetch(SupabaseOperation::GetSystems, "systems?select=systems,category,x,y,z&order=category.asc,systems.asc");
 }
 
 void SupabaseClient::getTakenSystems()
@@ -454,21 +494,28 @@ void SupabaseClient::getTakenSystems()
         return;
     }
     
+    // Serve the local copy right away (it already holds this client's own writes), then
+    // sync; changes made by others arrive as a second takenSystemsReceived. The sync is a
+    // full download, so callers within the GET:taken TTL of the last one share it, and a
+    // sync already running is joined by startCatalogueSync().
+    if (m_catalogue.hasTable("taken")) {
+        emit takenSystemsReceived(localTakenSystems());
+        const qint64 sinceSync = QDateTime::currentMSecsSinceEpoch() - m_catalogueSyncedAt.value("taken", 0);
+        if (sinceSync >= cacheTtl("GET:taken")) {
+            startCatalogueSync({"taken"});
+        }
+        return;
+    }
+    
     qDebug() << "Fetching ALL claimed systems from taken table...";
     
     // Fetch ALL taken systems so UI can determine claim status correctly
     QString endpoint = "taken?select=*&order=id.desc";
-    
-    QNetworkRequest request = createRequest(endpoint);
-    QNetworkReply *reply = m_networkManager->get(request);
-    
-    if (reply) {
-        reply->setProperty("operation", "GET:taken");
-        qDebug() << "getTakenSystems: Request sent for ALL taken systems";
-    } else {
-        qDebug() << "getTakenSystems: Failed to create network request!";
-        emit networkError("Failed to create taken systems request");
+    if (serveOrJoinGet("GET:taken", endpoint)) {
+        return;
     }
+    
+    startBulkFetch(SupabaseOperation::GetTaken, endpoint);
 }
 
 
@@ -492,9 +539,9 @@ void SupabaseClient::getSystemDetails(const QString &systemName, const QString &
     QNetworkReply *reply = m_networkManager->get(request);
     
     if (reply) {
-        reply->setProperty("operation", "GET:system_details");
-        reply->setProperty("systemName", systemName);
-        reply->setProperty("category", category);
+        trackRequest(reply, SupabaseOperation::GetSystemDetails);
+        requestContext(reply).systemName = systemName;
+        requestContext(reply).category = category;
         qDebug() << "getSystemDetails: Request sent for system" << systemName;
     } else {
         qDebug() << "getSystemDetails: Failed to create network request!";
@@ -518,8 +565,8 @@ void SupabaseClient::getSystemDetailsRobust(const QString &systemName)
     QNetworkReply *reply = m_networkManager->get(request);
     
     if (reply) {
-        reply->setProperty("operation", "GET:system_category_lookup");
-        reply->setProperty("systemName", systemName);
+        trackRequest(reply, SupabaseOperation::GetSystemCategoryLookup);
+        requestContext(reply).systemName = systemName;
         qDebug() << "getSystemDetailsRobust: Looking up category for system" << systemName;
     } else {
         qDebug() << "getSystemDetailsRobust: Failed to create category lookup request!";
@@ -547,10 +594,10 @@ void SupabaseClient::getSystemDetailsWithFieldName(const QString &systemName, co
     QNetworkReply *reply = m_networkManager->get(request);
     
     if (reply) {
-        reply->setProperty("operation", "GET:system_details_robust");
-        reply->setProperty("systemName", systemName);
-        reply->setProperty("category", category);
-        reply->setProperty("fieldName", fieldName);
+        trackRequest(reply, SupabaseOperation::GetSystemDetailsRobust);
+        requestContext(reply).systemName = systemName;
+        requestContext(reply).category = category;
+        requestContext(reply).fieldName = fieldName;
         qDebug() << "getSystemDetailsWithFieldName: Request sent for system" << systemName << "using field" << fieldName;
     } else {
         qDebug() << "getSystemDetailsWithFieldName: Failed to create network request!";
@@ -566,7 +613,11 @@ void SupabaseClient::getPOISystems(const QString &commanderName)
         return;
     }
     
-    if (shouldSkipRequestDueToAuthFailure()) {
+    // Offline or in the auth cooldown the local catalogue answers instead of the server
+    if (m_offline || shouldSkipRequestDueToAuthFailure()) {
+        if (m_catalogue.hasTable("system_information")) {
+            handleListResponse("GET:pois", localSystemInformation());
+        }
         return;
     }
     
@@ -579,6 +630,9 @@ void SupabaseClient::getPOISystems(const QString &commanderName)
     
     // Query systems with POI status from system_information table
     QString endpoint = "system_information?select=system,potential_or_poi,discoverer,submitter,name&order=system.asc";
+    if (serveOrJoinGet("GET:pois", endpoint)) {
+        return;
+    }
     
     QNetworkRequest request = createRequest(endpoint);
     
@@ -591,7 +645,8 @@ void SupabaseClient::getPOISystems(const QString &commanderName)
     QNetworkReply *reply = m_networkManager->get(request);
     
     if (reply) {
-        reply->setProperty("operation", "GET:pois");
+        trackRequest(reply, SupabaseOperation::GetPois);
+        trackGet(reply, "GET:pois", endpoint);
         qDebug() << "getPOISystems: Request sent, operation tagged as GET:pois";
     } else {
         qDebug() << "getPOISystems: Failed to create network request!";
@@ -615,12 +670,16 @@ void SupabaseClient::getPresetImages(bool includeRichard)
         // Richard=true means hidden in special subsection, Richard=false/null means visible
         endpoint += "&or=(Richard.is.null,Richard.eq.false)";
     }
+    if (serveOrJoinGet("GET:preset_images", endpoint)) {
+        return;
+    }
     
     QNetworkRequest request = createRequest(endpoint);
     QNetworkReply *reply = m_networkManager->get(request);
     
     if (reply) {
-        reply->setProperty("operation", "GET:preset_images");
+        trackRequest(reply, SupabaseOperation::GetPresetImages);
+        trackGet(reply, "GET:preset_images", endpoint);
         qDebug() << "getPresetImages: Request sent, operation tagged as GET:preset_images";
     } else {
         qDebug() << "getPresetImages: Failed to create network request!";
@@ -645,11 +704,17 @@ void SupabaseClient::getCategories()
     qDebug() << "Fetching categories from systems table...";
     
     // Get distinct categories from systems table, ordered alphabetically
-    QNetworkRequest request = createRequest("systems?select=category&order=category.asc");
+    const QString endpoint = "systems?select=category&order=category.asc";
+    if (serveOrJoinGet("GET:categories_systems", endpoint)) {
+        return;
+    }
+    
+    QNetworkRequest request = createRequest(endpoint);
     QNetworkReply *reply = m_networkManager->get(request);
     
     if (reply) {
-        reply->setProperty("operation", "GET:categories_systems");
+        trackRequest(reply, SupabaseOperation::GetCategoriesSystems);
+        trackGet(reply, "GET:categories_systems", endpoint);
         qDebug() << "getCategories: Request sent for systems categories, operation tagged as GET:categories_systems";
     } else {
         qDebug() << "getCategories: Failed to create network request!";
@@ -668,11 +733,17 @@ void SupabaseClient::getRichardCategories()
     qDebug() << "Fetching Richard categories from Supabase preset_images table...";
     
     // Get Richard categories from preset_images table where Richard=true
-    QNetworkRequest request = createRequest("preset_images?select=category&Richard=eq.true");
+    const QString endpoint = "preset_images?select=category&Richard=eq.true";
+    if (serveOrJoinGet("GET:categories_richard", endpoint)) {
+        return;
+    }
+    
+    QNetworkRequest request = createRequest(endpoint);
     QNetworkReply *reply = m_networkManager->get(request);
     
     if (reply) {
-        reply->setProperty("operation", "GET:categories_richard");
+        trackRequest(reply, SupabaseOperation::GetCategoriesRichard);
+        trackGet(reply, "GET:categories_richard", endpoint);
         qDebug() << "getRichardCategories: Request sent, operation tagged as GET:categories_richard";
     } else {
         qDebug() << "getRichardCategories: Failed to create network request!";
@@ -688,6 +759,20 @@ void SupabaseClient::getSystemsNear(double x, double y, double z, int limit)
         return;
     }
     
+    // A new position supersedes any expansion still in flight
+    m_systemsNearQueries.insert(QString(), ++m_systemsNearGeneration);
+    m_systemsNearRows.remove(QString());
+    
+    // Rank straight from the local catalogue once it has been downloaded
+    if (hasLocalCatalogue()) {
+        SystemRecordList sortedSystems = rankSystemsNear(catalogueSystems(), catalogueCoordinates(), x, y, z, limit,
+                                                         std::numeric_limits<double>::max());
+        qDebug() << "systems_near: ranked" << sortedSystems.size() << "systems from the local catalogue";
+        m_cachedNearestSystems = sortedSystems;
+        emit nearestSystemsReceived(sortedSystems);
+        return;
+    }
+    
     // Check if we should skip due to recent authentication failures
     if (shouldSkipRequestDueToAuthFailure()) {
         // Skip silently during cooldown period
@@ -696,10 +781,37 @@ void SupabaseClient::getSystemsNear(double x, double y, double z, int limit)
     
     qDebug() << "Fetching systems near coordinates:" << x << y << z << "with limit:" << limit;
     
-    // Use PostgREST/Supabase to find systems within a reasonable range
-    // We'll fetch systems and calculate distances client-side for now
-    // In production, you'd use a proper spatial query
-    QString endpoint = QString("systems?select=systems,category,x,y,z&limit=%1&order=systems.asc").arg(limit);
+    const double radius = m_systemsNearRadius > 0.0 ? m_systemsNearRadius : SYSTEMS_NEAR_INITIAL_RADIUS;
+    requestSystemsNear(QString(), x, y, z, limit, radius, m_systemsNearGeneration);
+}
+
+void SupabaseClient::prefetchSystemsNear(const QString &waypoint, double x, double y, double z, int limit)
+{
+    if (waypoint.isEmpty() || m_supabaseUrl.isEmpty() || m_supabaseKey.isEmpty() || shouldSkipRequestDueToAuthFailure()) {
+        return;
+    }
+    
+    // A repeated waypoint (route re-plotted) drops the earlier request's pages
+    m_systemsNearQueries.insert(waypoint, ++m_systemsNearGeneration);
+    m_systemsNearRows.remove(waypoint);
+    
+    const double radius = m_systemsNearRadius > 0.0 ? m_systemsNearRadius : SYSTEMS_NEAR_INITIAL_RADIUS;
+    requestSystemsNear(waypoint, x, y, z, limit, radius, m_systemsNearGeneration);
+}
+
+void SupabaseClient::requestSystemsNear(const QString &waypoint, double x, double y, double z, int limit,
+                                        double radius, int generation, int offset)
+{
+    // Only the box around the commander is downloaded; distances are refined client-side
+    // and the box grows until it holds `limit` systems within `radius`. The box is paged in
+    // a stable order so the server's row cap can't cut it short.
+    QString endpoint = QString("systems?select=systems,category,x,y,z"
+                               "&x=gte.%1&x=lte.%2&y=gte.%3&y=lte.%4&z=gte.%5&z=lte.%6"
+                               "&order=systems.asc,category.asc&limit=%7&offset=%8")
+                           .arg(x - radius, 0, 'f', 2).arg(x + radius, 0, 'f', 2)
+                           .arg(y - radius, 0, 'f', 2).arg(y + radius, 0, 'f', 2)
+                           .arg(z - radius, 0, 'f', 2).arg(z + radius, 0, 'f', 2)
+                           .arg(SYSTEMS_NEAR_PAGE_SIZE).arg(offset);
     
     QNetworkRequest request = createRequest(endpoint);
     
@@ -711,20 +823,113 @@ void SupabaseClient::getSystemsNear(double x, double y, double z, int limit)
     QNetworkReply *reply = m_networkManager->get(request);
     
     if (reply) {
-        reply->setProperty("operation", "GET:systems_near");
-        reply->setProperty("refX", x);
-        reply->setProperty("refY", y);
-        reply->setProperty("refZ", z);
+        trackRequest(reply, SupabaseOperation::GetSystemsNear);
+        requestContext(reply).refX = x;
+        requestContext(reply).refY = y;
+        requestContext(reply).refZ = z;
+        requestContext(reply).limit = limit;
+        requestContext(reply).radius = radius;
+        requestContext(reply).generation = generation;
+        requestContext(reply).waypoint = waypoint;
+        requestContext(reply).offset = offset;
         // Reduce logging frequency for this common operation
-        if (m_consecutiveAuthFailures == 0) {
-            qDebug() << "getSystemsNear: Request sent, operation tagged as GET:systems_near";
+        if (m_consecutiveAuthFailures == 0 && offset == 0) {
+            qDebug() << "getSystemsNear: Request sent for" << radius << "LY box, operation tagged as GET:systems_near";
         }
     } else {
         qDebug() << "getSystemsNear: Failed to create network request!";
+        m_systemsNearRows.remove(waypoint);
         emit networkError("Failed to create systems near request");
     }
 }
 
+SystemRecordList SupabaseClient::rankSystemsNear(const SystemRecordList &systems, double x, double y, double z,
+                                                 int limit, double maxDistance, int *inRange)
+{
+    CoordinateStore coordinates;
+    coordinates.assign(systems);
+    return rankSystemsNear(systems, coordinates, x, y, z, limit, maxDistance, inRange);
+}
+
+SystemRecordList SupabaseClient::rankSystemsNear(const SystemRecordList &systems, const CoordinateStore &coordinates,
+                                                 double x, double y, double z, int limit, double maxDistance,
+                                                 int *inRange)
+{
+    // Rank on squared distances and copy only the records that make the cut
+    const QVector<CoordinateStore::Match> ranked = coordinates.nearest(x, y, z, limit, maxDistance, inRange);
+    
+    SystemRecordList sortedSystems;
+    sortedSystems.reserve(ranked.size());
+    for (const CoordinateStore::Match &match : ranked) {
+        sortedSystems.append(systems.at(match.index));
+        sortedSystems.last().distance = match.distance;
+    }
+    return sortedSystems;
+}
+
+#ifdef EDRH_BENCHMARKS
+QVariantList SupabaseClient::benchmarkDistanceKernel() const
+{
+    return CoordinateStore::benchmark();
+}
+#endif
+
+SystemRecord SupabaseClient::systemRecordFromRow(const QJsonObject &row)
+{
+    SystemRecord record;
+    record.name = row.value("systems").toString();
+    const QString category = row.value("category").toString();
+    if (!category.isEmpty()) {
+        record.categories.append(category);
+    }
+    record.x = row.value("x").toDouble();
+    record.y = row.value("y").toDouble();
+    record.z = row.value("z").toDouble();
+    return record;
+}
+
+const SystemRecordList &SupabaseClient::catalogueSystems()
+{
+    // Decoded once per catalogue change and kept for every jump after that
+    if (m_catalogueSystemsStale) {
+        const int rows = m_catalogue.rowCount("systems");
+        m_catalogueSystems.clear();
+        m_catalogueSystems.reserve(rows);
+        for (int i = 0; i < rows; ++i) {
+            const QCborMap row = m_catalogue.rowMap("systems", i);
+            SystemRecord record;
+            record.name = row.value(QLatin1String("systems")).toString();
+            const QString category = row.value(QLatin1String("category")).toString();
+            if (!category.isEmpty()) {
+                record.categories.append(category);
+            }
+            record.x = row.value(QLatin1String("x")).toDouble();
+            record.y = row.value(QLatin1String("y")).toDouble();
+            record.z = row.value(QLatin1String("z")).toDouble();
+            m_catalogueSystems.append(record);
+        }
+        m_catalogueCoordinates.assign(m_catalogueSystems);
+        m_catalogueSystemsStale = false;
+    }
+    return m_catalogueSystems;
+}
+
+const CoordinateStore &SupabaseClient::catalogueCoordinates()
+{
+    catalogueSystems();
+    return m_catalogueCoordinates;
+}
+
+QStringList SupabaseClient::cachedNearestSystemNames() const
+{
+    QStringList names;
+    names.reserve(m_cachedNearestSystems.size());
+    for (const SystemRecord &system : m_cachedNearestSystems) {
+        names.append(system.name);
+    }
+    return names;
+}
+
 void SupabaseClient::getSystemInformation(const QString &systemName, const QString &category)
 {
     if (m_supabaseUrl.isEmpty() || m_supabaseKey.isEmpty()) {
@@ -743,9 +948,9 @@ void SupabaseClient::getSystemInformation(const QString &systemName, const QStri
     QNetworkReply *reply = m_networkManager->get(request);
     
     if (reply) {
-        reply->setProperty("operation", "GET:system_information_primary");
-        reply->setProperty("systemName", systemName);
-        reply->setProperty("fallbackCategory", category);
+        trackRequest(reply, SupabaseOperation::GetSystemInformationPrimary);
+        requestContext(reply).systemName = systemName;
+        requestContext(reply).fallbackCategory = category;
         qDebug() << "getSystemInformation: Primary request sent for" << systemName;
     } else {
         qDebug() << "getSystemInformation: Failed to create network request!";
@@ -782,8 +987,8 @@ void SupabaseClient::getSystemInformationFromDB(const QString &systemName)
     QNetworkReply *reply = m_networkManager->get(request);
     
     if (reply) {
-        reply->setProperty("operation", "GET:system_information_db");
-        reply->setProperty("systemName", systemName);
+        trackRequest(reply, SupabaseOperation::GetSystemInformationDb);
+        requestContext(reply).systemName = systemName;
         qDebug() << "getSystemInformationFromDB: Request sent for" << systemName << "with POI fields";
         qDebug() << "Full endpoint:" << endpoint;
         qDebug() << "=== END POI DATABASE QUERY DEBUG ===";
@@ -812,6 +1017,13 @@ void SupabaseClient::claimSystem(const QString &systemName, const QString &comma
         setCommanderContext(commander);
     }
     
+    if (m_offline) {
+        qDebug() << "Offline - claim of" << systemName << "journaled for" << commander;
+        journalOfflineMutation({{"op", "claim"}, {"system", systemName}, {"commander", commander}});
+        emit systemClaimed(systemName, true);
+        return;
+    }
+    
     qDebug() << "Claiming system" << systemName << "for commander" << commander;
     
     // Check if commander has visited this system in journal logs
@@ -829,10 +1041,10 @@ void SupabaseClient::claimSystem(const QString &systemName, const QString &comma
     QNetworkReply *checkReply = m_networkManager->get(checkRequest);
     
     if (checkReply) {
-        checkReply->setProperty("operation", "CHECK:existing_claim");
-        checkReply->setProperty("systemName", systemName);
-        checkReply->setProperty("commander", commander);
-        checkReply->setProperty("hasVisited", hasVisited);
+        trackRequest(checkReply, SupabaseOperation::CheckExistingClaim);
+        requestContext(checkReply).systemName = systemName;
+        requestContext(checkReply).commander = commander;
+        requestContext(checkReply).hasVisited = hasVisited;
         qDebug() << "Checking if system" << systemName << "is already claimed by anyone";
     }
 }
@@ -852,6 +1064,13 @@ void SupabaseClient::unclaimSystem(const QString &systemName)
     }
     
     QString commanderTrimmed = m_currentCommander.trimmed();
+    if (m_offline) {
+        qDebug() << "Offline - release of" << systemName << "journaled for" << commanderTrimmed;
+        journalOfflineMutation({{"op", "unclaim"}, {"system", systemName}, {"commander", commanderTrimmed}});
+        emit systemUnclaimed(systemName, true);
+        return;
+    }
+    
     qDebug() << "Releasing claim for" << systemName << "commander" << commanderTrimmed;
 
     // Rely on RLS to restrict UPDATE to the current commander's row; do not rely on by_cmdr filter in URL
@@ -868,8 +1087,8 @@ void SupabaseClient::unclaimSystem(const QString &systemName)
     qDebug() << "unclaimSystem payload:" << QString::fromUtf8(payload);
     QNetworkReply *patchReply = m_networkManager->sendCustomRequest(patchReq, "PATCH", payload);
     if (patchReply) {
-        patchReply->setProperty("operation", "UNCLAIM:mark_empty");
-        patchReply->setProperty("systemName", systemName);
+        trackRequest(patchReply, SupabaseOperation::UnclaimMarkEmpty);
+        requestContext(patchReply).systemName = systemName;
         qDebug() << "unclaimSystem: PATCH mark empty sent for" << systemName;
     } else {
         qDebug() << "unclaimSystem: Failed to create PATCH mark empty request!";
@@ -909,32 +1128,7 @@ void SupabaseClient::updateSystemStatus(const QString &systemName, bool visited,
     QJsonObject updateData;
     updateData["visited"] = visited;
     updateData["done"] = done;
-    
-    // Use correct column names: system=eq. and by_cmdr=eq.
-    QString endpoint = QString("taken?system=eq.%1&by_cmdr=eq.%2")
-                      .arg(QUrl::toPercentEncoding(systemName))
-                      .arg(QUrl::toPercentEncoding(m_currentCommander));
-    
-    qDebug() << "updateSystemStatus: Full endpoint:" << endpoint;
-    qDebug() << "updateSystemStatus: Commander:" << m_currentCommander;
-    qDebug() << "updateSystemStatus: Update data:" << QJsonDocument(updateData).toJson(QJsonDocument::Compact);
-    
-    QNetworkRequest request = createRequest(endpoint);
-    request.setRawHeader("x-commander-name", m_currentCommander.toUtf8());
-    
-    QJsonDocument doc(updateData);
-    QNetworkReply *reply = m_networkManager->sendCustomRequest(request, "PATCH", doc.toJson());
-    
-    if (reply) {
-        reply->setProperty("operation", "UPDATE:system_status");
-        reply->setProperty("systemName", systemName);
-        reply->setProperty("visited", visited);
-        reply->setProperty("done", done);
-        qDebug() << "PATCH request sent to update" << systemName;
-    } else {
-        qDebug() << "Failed to create update request";
-        emit systemStatusUpdated(systemName, false);
-    }
+    queueTakenWrite(systemName, updateData);
 }
 
 void SupabaseClient::updateSystemVisited(const QString &systemName, bool visited)
@@ -949,51 +1143,12 @@ void SupabaseClient::updateSystemVisited(const QString &systemName, bool visited
         return;
     }
     
-    qDebug() << "=== UPDATE VISITED DEBUG ===";
-    qDebug() << "System:" << systemName;
-    qDebug() << "Visited:" << visited;
-    qDebug() << "Commander:" << m_currentCommander;
+    qDebug() << "Updating visited status:" << systemName << "visited:" << visited;
     
     // Only update the visited field
     QJsonObject updateData;
     updateData["visited"] = visited;
-    
-    // FIXED: Use both system and commander filters to ensure RLS policy works
-    QString endpoint = QString("taken?system=eq.%1&by_cmdr=eq.%2")
-                      .arg(QUrl::toPercentEncoding(systemName))
-                      .arg(QUrl::toPercentEncoding(m_currentCommander));
-    
-    qDebug() << "updateSystemVisited: Full endpoint:" << endpoint;
-    qDebug() << "updateSystemVisited: Commander:" << m_currentCommander;
-    qDebug() << "Update data:" << QJsonDocument(updateData).toJson(QJsonDocument::Compact);
-    
-    QNetworkRequest request = createRequest(endpoint);
-    request.setRawHeader("x-commander-name", m_currentCommander.toUtf8());
-    
-    // Try additional header formats that might work better with Supabase RLS
-    request.setRawHeader("X-Commander-Name", m_currentCommander.toUtf8());
-    request.setRawHeader("commander-name", m_currentCommander.toUtf8());
-    
-    // Add debug headers
-    qDebug() << "Request headers:";
-    const auto headers = request.rawHeaderList();
-    for (const auto &header : headers) {
-        qDebug() << "  " << header << ":" << request.rawHeader(header);
-    }
-    
-    QJsonDocument doc(updateData);
-    QNetworkReply *reply = m_networkManager->sendCustomRequest(request, "PATCH", doc.toJson());
-    
-    if (reply) {
-        reply->setProperty("operation", "UPDATE:system_visited");
-        reply->setProperty("systemName", systemName);
-        reply->setProperty("visited", visited);
-        qDebug() << "PATCH request sent to update visited status for" << systemName;
-    } else {
-        qDebug() << "Failed to create PATCH request for visited update";
-        emit systemStatusUpdated(systemName, false);
-    }
-    qDebug() << "=== END UPDATE VISITED DEBUG ===";
+    queueTakenWrite(systemName, updateData);
 }
 
 void SupabaseClient::updateSystemDone(const QString &systemName, bool done)
@@ -1013,25 +1168,170 @@ void SupabaseClient::updateSystemDone(const QString &systemName, bool done)
     // Only update the done field
     QJsonObject updateData;
     updateData["done"] = done;
+    queueTakenWrite(systemName, updateData);
+}
+
+void SupabaseClient::queueTakenWrite(const QString &systemName, const QJsonObject &fields)
+{
+    // One entry per row: later writes overwrite the same fields of earlier ones
+    const QString key = m_currentCommander + '\n' + systemName;
+    auto it = m_pendingTakenWrites.find(key);
+    if (it == m_pendingTakenWrites.end()) {
+        it = m_pendingTakenWrites.insert(key, PendingTakenWrite{m_currentCommander, systemName, QJsonObject()});
+        m_pendingTakenWriteOrder.append(key);
+    }
+    for (auto field = fields.constBegin(); field != fields.constEnd(); ++field) {
+        it->fields.insert(field.key(), field.value());
+    }
     
-    QString endpoint = QString("taken?system=eq.%1&by_cmdr=eq.%2")
-                      .arg(QUrl::toPercentEncoding(systemName))
-                      .arg(QUrl::toPercentEncoding(m_currentCommander));
+    emit takenWriteQueued(systemName, it->fields);
+    scheduleWriteFlush();
+}
+
+void SupabaseClient::scheduleWriteFlush()
+{
+    // Not restarted by later writes, so a burst of jumps still flushes within the delay
+    if (!m_writeFlushTimer->isActive()) {
+        m_writeFlushTimer->start();
+    }
+}
+
+QJsonObject SupabaseClient::pendingTakenWrite(const QString &systemName) const
+{
+    return m_pendingTakenWrites.value(m_currentCommander + '\n' + systemName).fields;
+}
+
+void SupabaseClient::journalWritesOnShutdown()
+{
+    m_shuttingDown = true;
+    
+    // A PATCH sets absolute values, so replaying one that did reach the server is harmless
+    int journaled = 0;
+    for (const QString &key : std::as_const(m_pendingTakenWriteOrder)) {
+        const PendingTakenWrite write = m_pendingTakenWrites.value(key);
+        journalOfflineMutation({{"op", "taken_update"}, {"system", write.systemName},
+                                {"commander", write.commander}, {"fields", write.fields}});
+        ++journaled;
+    }
+    m_pendingTakenWrites.clear();
+    m_pendingTakenWriteOrder.clear();
+    
+    for (auto it = m_requestContexts.constBegin(); it != m_requestContexts.constEnd(); ++it) {
+        const SupabaseRequestContext &context = it.value();
+        if (context.operation != SupabaseOperation::PatchTakenBatch || context.offlineReplay) {
+            continue;
+        }
+        for (const QString &systemName : context.systemNames) {
+            journalOfflineMutation({{"op", "taken_update"}, {"system", systemName},
+                                    {"commander", context.commander}, {"fields", context.fields}});
+            ++journaled;
+        }
+    }
+    if (journaled > 0) {
+        qDebug() << "Shutting down:" << journaled << "taken updates journaled for the next start";
+    }
     
-    QNetworkRequest request = createRequest(endpoint);
-    request.setRawHeader("x-commander-name", m_currentCommander.toUtf8());
+    // Nothing left for the wire; this only settles the pending location
+    flushPendingWrites();
+}
+
+void SupabaseClient::flushPendingWrites()
+{
+    m_writeFlushTimer->stop();
     
-    QJsonDocument doc(updateData);
-    QNetworkReply *reply = m_networkManager->sendCustomRequest(request, "PATCH", doc.toJson());
+    if (m_pendingLocation.pending) {
+        m_pendingLocation.pending = false;
+        qDebug() << "Commander location for" << m_pendingLocation.commanderName << "at"
+                 << m_pendingLocation.x << m_pendingLocation.y << m_pendingLocation.z
+                 << "in system:" << m_pendingLocation.systemName << "(logged locally, no location columns in the schema)";
+        emit commanderLocationUpdated(m_pendingLocation.commanderName, true);
+    }
+    
+    if (m_pendingTakenWrites.isEmpty()) {
+        return;
+    }
+    
+    // Rows of the same commander getting identical values become one PATCH over system=in.(...)
+    struct Batch {
+        QString commander;
+        QJsonObject fields;
+        QStringList systemNames;
+    };
+    QVector<Batch> batches;
+    QHash<QString, int> batchByValues;
+    for (const QString &key : std::as_const(m_pendingTakenWriteOrder)) {
+        const PendingTakenWrite write = m_pendingTakenWrites.value(key);
+        const QString values = write.commander + '\n' + QString::fromUtf8(QJsonDocument(write.fields).toJson(QJsonDocument::Compact));
+        auto found = batchByValues.constFind(values);
+        if (found == batchByValues.constEnd()) {
+            batchByValues.insert(values, batches.size());
+            batches.append(Batch{write.commander, write.fields, {write.systemName}});
+        } else {
+            batches[found.value()].systemNames.append(write.systemName);
+        }
+    }
+    qDebug() << "Flushing" << m_pendingTakenWriteOrder.size() << "queued taken updates as" << batches.size() << "batches";
+    m_pendingTakenWrites.clear();
+    m_pendingTakenWriteOrder.clear();
+    
+    if (m_offline) {
+        for (const Batch &batch : std::as_const(batches)) {
+            for (const QString &systemName : batch.systemNames) {
+                journalOfflineMutation({{"op", "taken_update"}, {"system", systemName},
+                                        {"commander", batch.commander}, {"fields", batch.fields}});
+                emit systemStatusUpdated(systemName, true);
+            }
+        }
+        return;
+    }
+    
+    for (const Batch &batch : std::as_const(batches)) {
+        const QByteArray body = QJsonDocument(batch.fields).toJson(QJsonDocument::Compact);
+        QByteArray filter;
+        QStringList filterNames;
+        for (const QString &systemName : batch.systemNames) {
+            const QByteArray value = inFilterValue(systemName);
+            if (!filter.isEmpty() && filter.size() + value.size() + 3 > SYSTEM_LOOKUP_MAX_FILTER_LENGTH) {
+                sendTakenBatch(batch.commander, filterNames, filter, body);
+                filter.clear();
+                filterNames.clear();
+            }
+            if (!filter.isEmpty()) {
+                filter += "%2C";
+            }
+            filter += value;
+            filterNames.append(systemName);
+        }
+        if (!filter.isEmpty()) {
+            sendTakenBatch(batch.commander, filterNames, filter, body);
+        }
+    }
+}
+
+void SupabaseClient::sendTakenBatch(const QString &commander, const QStringList &systemNames,
+                                    const QByteArray &filter, const QByteArray &body)
+{
+    // Use both system and commander filters to ensure RLS policy works
+    QString endpoint = QString("taken?system=in.(%1)&by_cmdr=eq.%2")
+                      .arg(QString::fromLatin1(filter))
+                      .arg(QString::fromLatin1(QUrl::toPercentEncoding(commander)));
     
+    QNetworkRequest request = createRequest(endpoint);
+    request.setRawHeader("Prefer", "return=representation");
+    request.setRawHeader("x-commander-name", commander.toUtf8());
+    
+    QNetworkReply *reply = m_networkManager->sendCustomRequest(request, "PATCH", body);
     if (reply) {
-        reply->setProperty("operation", "UPDATE:system_done");
-        reply->setProperty("systemName", systemName);
-        reply->setProperty("done", done);
-        qDebug() << "PATCH request sent to update done status for" << systemName;
+        trackRequest(reply, SupabaseOperation::PatchTakenBatch);
+        requestContext(reply).commander = commander;
+        requestContext(reply).systemNames = systemNames;
+        requestContext(reply).fields = QJsonDocument::fromJson(body).object();
+        qDebug() << "PATCH request sent to update" << systemNames.size() << "taken rows:" << body;
     } else {
-        qDebug() << "Failed to create PATCH request for done update";
-        emit systemStatusUpdated(systemName, false);
+        qDebug() << "Failed to create PATCH request for taken updates";
+        for (const QString &systemName : systemNames) {
+            emit systemStatusUpdated(systemName, false);
+        }
     }
 }
 
@@ -1064,7 +1364,7 @@ void SupabaseClient::testAdminAccess(const QString &serviceKey)
     request.setRawHeader("Prefer", "return=representation");
     
     QNetworkReply *reply = m_networkManager->get(request);
-    reply->setProperty("operation", "TEST:admin_access");
+    trackRequest(reply, SupabaseOperation::TestAdminAccess);
     
     qDebug() << "testAdminAccess: Request sent with service key";
 }
@@ -1083,7 +1383,7 @@ void SupabaseClient::getWebhookConfig()
     QNetworkRequest request = createRequest(endpoint);
     
     QNetworkReply *reply = m_networkManager->get(request);
-    reply->setProperty("operation", "GET:webhook_config");
+    trackRequest(reply, SupabaseOperation::GetWebhookConfig);
     
     qDebug() << "getWebhookConfig: Request sent";
 }
@@ -1150,7 +1450,7 @@ void SupabaseClient::triggerWebhook(const QString &eventType, const QVariantMap
     qDebug() << "Final webhook payload:" << doc.toJson(QJsonDocument::Compact);
     
     QNetworkReply *reply = m_networkManager->post(webhookRequest, doc.toJson());
-    reply->setProperty("operation", "POST:webhook:" + eventType);
+    trackRequest(reply, "POST:webhook:" + eventType);
     
     qDebug() << "Webhook request sent for event:" << eventType;
 }
@@ -1170,81 +1470,407 @@ void SupabaseClient::getAllCommanderLocations()
     QNetworkRequest request = createRequest(endpoint);
     
     QNetworkReply *reply = m_networkManager->get(request);
-    reply->setProperty("operation", "GET:all_commanders");
+    trackRequest(reply, SupabaseOperation::GetAllCommanders);
     
     qDebug() << "getAllCommanderLocations: Request sent, operation tagged as GET:all_commanders";
 }
 
-void SupabaseClient::updateCommanderLocation(const QString &commanderName, double x, double y, double z, const QString &systemName)
+bool SupabaseClient::isOffline() const
 {
-    if (!isConfigured()) {
-        qWarning() << "SupabaseClient not configured for updateCommanderLocation";
-        return;
+    return m_offline;
+}
+
+int SupabaseClient::pendingOfflineMutations() const
+{
+    return m_offlineMutations.size();
+}
+
+bool SupabaseClient::isBackendUnreachable(QNetworkReply *reply) const
+{
+    // Gateways answering for a backend that is down count as unreachable too
+    const int httpStatus = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (httpStatus == 502 || httpStatus == 503 || httpStatus == 504) {
+        return true;
+    }
+    if (httpStatus != 0) {
+        return false;
     }
     
-    if (commanderName.isEmpty()) {
-        qWarning() << "Cannot update commander location: commander name is empty";
+    switch (reply->error()) {
+    case QNetworkReply::ConnectionRefusedError:
+    case QNetworkReply::RemoteHostClosedError:
+    case QNetworkReply::HostNotFoundError:
+    case QNetworkReply::TimeoutError:
+    case QNetworkReply::TemporaryNetworkFailureError:
+    case QNetworkReply::NetworkSessionFailedError:
+    case QNetworkReply::ProxyConnectionRefusedError:
+    case QNetworkReply::ProxyNotFoundError:
+    case QNetworkReply::ProxyTimeoutError:
+    case QNetworkReply::UnknownNetworkError:
+        return true;
+    default:
+        return false;
+    }
+}
+
+void SupabaseClient::setOffline(bool offline)
+{
+    if (m_offline == offline) {
         return;
     }
+    m_offline = offline;
     
-    qDebug() << "Commander location update requested for:" << commanderName << "at" << x << y << z << "in system:" << systemName;
-    
-    // NOTE: Current database schema doesn't have location fields (current_x, current_y, current_z)
-    // For now, just log the location data locally
-    // TODO: Add location fields to commanders table or create separate commander_locations table
-    
-    qDebug() << "Location tracking not yet implemented in database schema. Commander position logged locally only.";
-    
-    // For now, emit success to prevent errors in UI
-    emit commanderLocationUpdated(commanderName, true);
+    if (offline) {
+        qWarning() << "Supabase unreachable - working offline from the local catalogue";
+        m_offlineProbeTimer->start();
+    } else {
+        qDebug() << "Supabase reachable again";
+        m_offlineProbeTimer->stop();
+        if (!m_offlineMutations.isEmpty()) {
+            // Conflicts are judged against the server state, so bring the catalogue current first
+            m_replayOfflineAfterSync = true;
+            startCatalogueSync({"taken", "system_information"});
+        }
+    }
+    emit offlineModeChanged(offline);
 }
 
-double SupabaseClient::calculateDistance(double x1, double y1, double z1, double x2, double y2, double z2)
+void SupabaseClient::probeBackend()
 {
-    double dx = x2 - x1;
-    double dy = y2 - y1;
-    double dz = z2 - z1;
-    return qSqrt(dx*dx + dy*dy + dz*dz);
+    // Cheapest possible read; any HTTP answer ends offline mode in handleNetworkReply
+    QNetworkReply *reply = m_networkManager->get(createRequest("taken?select=id&limit=1"));
+    if (reply) {
+        trackRequest(reply, SupabaseOperation::ProbeBackend);
+    }
 }
 
-bool SupabaseClient::shouldSkipRequestDueToAuthFailure()
+void SupabaseClient::loadOfflineJournal()
 {
-    if (m_consecutiveAuthFailures >= MAX_AUTH_FAILURES_TO_LOG) {
-        qint64 currentTime = QDateTime::currentMSecsSinceEpoch();
-        qint64 timeSinceLastFailure = currentTime - m_lastAuthFailureTime;
-        
-        if (timeSinceLastFailure < AUTH_FAILURE_COOLDOWN_MS) {
-            // Still in cooldown period, skip request silently
-            return true;
-        } else {
-            // Cooldown expired, reset counters
-            m_consecutiveAuthFailures = 0;
-            return false;
+    QFile file(m_offlineJournalFile);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+    
+    while (!file.atEnd()) {
+        const QByteArray line = file.readLine().trimmed();
+        const QJsonDocument doc = QJsonDocument::fromJson(line);
+        // A line torn by a crash mid-write is skipped
+        if (doc.isObject()) {
+            m_offlineMutations.append(doc.object());
         }
     }
     
-    return false;
-}
-
-bool SupabaseClient::isInAuthFailureCooldown() const
-{
-    if (m_consecutiveAuthFailures >= MAX_AUTH_FAILURES_TO_LOG) {
-        qint64 currentTime = QDateTime::currentMSecsSinceEpoch();
-        qint64 timeSinceLastFailure = currentTime - m_lastAuthFailureTime;
-        return timeSinceLastFailure < AUTH_FAILURE_COOLDOWN_MS;
+    if (!m_offlineMutations.isEmpty()) {
+        qDebug() << "Offline journal has" << m_offlineMutations.size() << "changes to replay after the next sync";
+        m_replayOfflineAfterSync = true;
     }
-    return false;
 }
 
-void SupabaseClient::mergePOIDataIntoSystems(QJsonArray &systemsArray)
+void SupabaseClient::journalOfflineMutation(QJsonObject entry)
 {
-    // CRITICAL FIX: Synchronously add POI data to systems for public visibility
-    qDebug() << "*** MERGE POI FUNCTION CALLED ***";
-    qDebug() << "mergePOIDataIntoSystems: Processing" << systemsArray.size() << "systems";
+    entry["queued_at"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    m_offlineMutations.append(entry);
     
-    if (m_supabaseUrl.isEmpty() || m_supabaseKey.isEmpty()) {
-        qDebug() << "Supabase not configured for POI merging";
-        return;
+    // Appended and closed right away so a crash or power loss keeps everything journaled so far
+    QFile file(m_offlineJournalFile);
+    if (file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        file.write(QJsonDocument(entry).toJson(QJsonDocument::Compact) + '\n');
+        file.close();
+    } else {
+        qWarning() << "Failed to write offline journal:" << file.errorString();
+    }
+    
+    qDebug() << "Offline change journaled:" << entry.value("op").toString() << entry.value("system").toString();
+    emit offlineMutationsChanged(m_offlineMutations.size());
+}
+
+QString SupabaseClient::cataloguePoiValue(const QString &systemName) const
+{
+    // What the server had when the catalogue was last synced, before any offline change
+    const int rows = m_catalogue.rowCount("system_information");
+    for (int i = 0; i < rows; ++i) {
+        const QCborMap row = m_catalogue.rowMap("system_information", i);
+        if (row.value(QStringLiteral("system")).toString() == systemName) {
+            return row.value(QStringLiteral("potential_or_poi")).toString();
+        }
+    }
+    return QString();
+}
+
+void SupabaseClient::replayOfflineMutations()
+{
+    if (m_offline || m_offlineMutations.isEmpty() || m_replayingOffline) {
+        return;
+    }
+    if (m_currentCommander.isEmpty() || m_currentCommander == "Unknown") {
+        // Releases and status updates go out under the commander context; wait until it is set
+        m_replayOfflineAfterSync = true;
+        return;
+    }
+    
+    // The catalogue has just been synced, so it holds the server's view of every row touched offline
+    m_replayOwners.clear();
+    for (const QJsonValue &value : m_catalogue.rows("taken")) {
+        const QJsonObject row = value.toObject();
+        QString owner = row.value("by_cmdr").toString();
+        if (owner.compare("empty", Qt::CaseInsensitive) == 0) {
+            owner.clear();
+        }
+        m_replayOwners.insert(row.value("system").toString(), owner);
+    }
+    m_replayPois.clear();
+    for (const QJsonValue &value : m_catalogue.rows("system_information")) {
+        const QJsonObject row = value.toObject();
+        m_replayPois.insert(row.value("system").toString(), row.value("potential_or_poi").toString());
+    }
+    
+    // Entries go out strictly one after another and stay journaled until the server has
+    // answered them, so a failed send or a crash mid-replay loses nothing
+    m_replayingOffline = true;
+    m_replayApplied = 0;
+    m_replayConflicts = 0;
+    qDebug() << "Replaying" << m_offlineMutations.size() << "offline changes";
+    replayNextOfflineMutation();
+}
+
+void SupabaseClient::replayNextOfflineMutation()
+{
+    while (!m_offlineMutations.isEmpty()) {
+        if (m_offline) {
+            stopOfflineReplay();
+            return;
+        }
+        
+        const QJsonObject entry = m_offlineMutations.first();
+        const QString op = entry.value("op").toString();
+        const QString systemName = entry.value("system").toString();
+        const QString commander = entry.value("commander").toString();
+        const QString owner = m_replayOwners.value(systemName);
+        
+        QString reason;
+        if (op == "claim" || op == "unclaim" || op == "taken_update") {
+            if (!owner.isEmpty() && owner != commander) {
+                reason = QString("claimed by %1 in the meantime").arg(owner);
+            } else if (op != "claim" && commander != m_currentCommander) {
+                reason = QString("recorded for %1, not the current commander").arg(commander);
+            } else if (op == "taken_update" && owner.isEmpty()) {
+                reason = "no longer claimed";
+            }
+        } else {
+            // Only a change the server saw since the catalogue copy the entry was made against is a conflict
+            const QString current = m_replayPois.value(systemName);
+            const QString target = op == "poi_clear" ? QString() : entry.value("poi_type").toString();
+            if (current != entry.value("base_poi").toString() && current != target) {
+                reason = QString("POI status changed to '%1' in the meantime").arg(current.isEmpty() ? "none" : current);
+            }
+        }
+        
+        if (!reason.isEmpty()) {
+            m_replayConflicts++;
+            qWarning() << "Offline" << op << "of" << systemName << "not applied:" << reason;
+            emit offlineMutationConflict(systemName, op, reason);
+            dropFirstOfflineMutation();
+            continue;
+        }
+        
+        // Later entries are judged against the state this one leaves behind
+        m_replayOutstanding = 0;
+        m_replayRetryLater = false;
+        m_replayRejection.clear();
+        m_replayScope++;
+        if (op == "claim") {
+            m_replayOwners.insert(systemName, commander);
+            claimSystem(systemName, commander);
+        } else if (op == "unclaim") {
+            m_replayOwners.insert(systemName, QString());
+            unclaimSystem(systemName);
+        } else if (op == "taken_update") {
+            // Sent straight away rather than through the coalescing queue, so it is this entry's reply
+            sendTakenBatch(commander, {systemName}, inFilterValue(systemName),
+                           QJsonDocument(entry.value("fields").toObject()).toJson(QJsonDocument::Compact));
+        } else if (op == "poi_set") {
+            m_replayPois.insert(systemName, entry.value("poi_type").toString());
+            markSystemAsPOI(systemName, entry.value("poi_type").toString(), commander);
+        } else if (op == "poi_update") {
+            m_replayPois.insert(systemName, entry.value("poi_type").toString());
+            updateSystemPOIStatus(systemName, entry.value("poi_type").toString(),
+                                  entry.value("discoverer").toString(), entry.value("submitter").toString());
+        } else if (op == "poi_clear") {
+            m_replayPois.insert(systemName, QString());
+            removePOIStatus(systemName, commander);
+        }
+        m_replayScope--;
+        
+        if (m_replayOutstanding > 0) {
+            // finishOfflineReplayEntry() carries on once its replies are in
+            return;
+        }
+        
+        // Nothing went out for it (unknown op, invalid fields); it won't go out next time either
+        m_replayConflicts++;
+        qWarning() << "Offline" << op << "of" << systemName << "could not be sent - dropped";
+        emit offlineMutationConflict(systemName, op, "could not be sent");
+        dropFirstOfflineMutation();
+    }
+    
+    stopOfflineReplay();
+}
+
+void SupabaseClient::offlineReplayReplyFinished(QNetworkReply *reply)
+{
+    m_replayOutstanding--;
+    if (reply->error() != QNetworkReply::NoError) {
+        // No answer, a server fault or throttling is worth another try; anything else was refused
+        const int httpStatus = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+        if (httpStatus == 0 || httpStatus >= 500 || httpStatus == 401 || httpStatus == 408 ||
+            httpStatus == 429 || isBackendUnreachable(reply)) {
+            m_replayRetryLater = true;
+        } else if (m_replayRejection.isEmpty()) {
+            m_replayRejection = QString("rejected by the server (HTTP %1)").arg(httpStatus);
+        }
+    }
+    
+    if (m_replayOutstanding <= 0) {
+        // Out of the reply handler first, so the next entry isn't sent from inside this one
+        QTimer::singleShot(0, this, &SupabaseClient::finishOfflineReplayEntry);
+    }
+}
+
+void SupabaseClient::finishOfflineReplayEntry()
+{
+    if (!m_replayingOffline || m_offlineMutations.isEmpty()) {
+        return;
+    }
+    
+    const QJsonObject entry = m_offlineMutations.first();
+    const QString op = entry.value("op").toString();
+    const QString systemName = entry.value("system").toString();
+    if (m_replayRetryLater) {
+        qWarning() << "Offline" << op << "of" << systemName << "did not reach the server - kept for the next replay";
+        stopOfflineReplay();
+        return;
+    }
+    
+    if (!m_replayRejection.isEmpty()) {
+        m_replayConflicts++;
+        qWarning() << "Offline" << op << "of" << systemName << "not applied:" << m_replayRejection;
+        emit offlineMutationConflict(systemName, op, m_replayRejection);
+    } else {
+        m_replayApplied++;
+    }
+    dropFirstOfflineMutation();
+    replayNextOfflineMutation();
+}
+
+void SupabaseClient::stopOfflineReplay()
+{
+    m_replayingOffline = false;
+    if (!m_offlineMutations.isEmpty()) {
+        // Whatever is left goes out after the next sync (reconnect or refresh)
+        m_replayOfflineAfterSync = true;
+    }
+    qDebug() << "Offline replay finished:" << m_replayApplied << "applied," << m_replayConflicts << "conflicts,"
+             << m_offlineMutations.size() << "still journaled";
+    emit offlineMutationsChanged(m_offlineMutations.size());
+    emit offlineReplayFinished(m_replayApplied, m_replayConflicts);
+}
+
+void SupabaseClient::dropFirstOfflineMutation()
+{
+    m_offlineMutations.removeFirst();
+    rewriteOfflineJournal();
+    emit offlineMutationsChanged(m_offlineMutations.size());
+}
+
+void SupabaseClient::rewriteOfflineJournal()
+{
+    if (m_offlineMutations.isEmpty()) {
+        QFile::remove(m_offlineJournalFile);
+        return;
+    }
+    
+    // Replaced in one step: a crash leaves either the old journal or the new one
+    QSaveFile file(m_offlineJournalFile);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Failed to rewrite offline journal:" << file.errorString();
+        return;
+    }
+    for (const QJsonObject &entry : std::as_const(m_offlineMutations)) {
+        file.write(QJsonDocument(entry).toJson(QJsonDocument::Compact) + '\n');
+    }
+    if (!file.commit()) {
+        qWarning() << "Failed to rewrite offline journal:" << file.errorString();
+    }
+}
+
+void SupabaseClient::updateCommanderLocation(const QString &commanderName, double x, double y, double z, const QString &systemName)
+{
+    if (!isConfigured()) {
+        qWarning() << "SupabaseClient not configured for updateCommanderLocation";
+        return;
+    }
+    
+    if (commanderName.isEmpty()) {
+        qWarning() << "Cannot update commander location: commander name is empty";
+        return;
+    }
+    
+    // NOTE: Current database schema doesn't have location fields (current_x, current_y, current_z)
+    // TODO: Add location fields to commanders table or create separate commander_locations table
+    // Only the last position of a jump burst survives until the next flush
+    if (m_pendingLocation.pending && m_pendingLocation.commanderName != commanderName) {
+        flushPendingWrites();
+    }
+    m_pendingLocation = PendingLocation{commanderName, x, y, z, systemName, true};
+    scheduleWriteFlush();
+}
+
+double SupabaseClient::calculateDistance(double x1, double y1, double z1, double x2, double y2, double z2)
+{
+    double dx = x2 - x1;
+    double dy = y2 - y1;
+    double dz = z2 - z1;
+    return qSqrt(dx*dx + dy*dy + dz*dz);
+}
+
+bool SupabaseClient::shouldSkipRequestDueToAuthFailure()
+{
+    if (m_consecutiveAuthFailures >= MAX_AUTH_FAILURES_TO_LOG) {
+        qint64 currentTime = QDateTime::currentMSecsSinceEpoch();
+        qint64 timeSinceLastFailure = currentTime - m_lastAuthFailureTime;
+        
+        if (timeSinceLastFailure < AUTH_FAILURE_COOLDOWN_MS) {
+            // Still in cooldown period, skip request silently
+            return true;
+        } else {
+            // Cooldown expired, reset counters
+            m_consecutiveAuthFailures = 0;
+            return false;
+        }
+    }
+    
+    return false;
+}
+
+bool SupabaseClient::isInAuthFailureCooldown() const
+{
+    if (m_consecutiveAuthFailures >= MAX_AUTH_FAILURES_TO_LOG) {
+        qint64 currentTime = QDateTime::currentMSecsSinceEpoch();
+        qint64 timeSinceLastFailure = currentTime - m_lastAuthFailureTime;
+        return timeSinceLastFailure < AUTH_FAILURE_COOLDOWN_MS;
+    }
+    return false;
+}
+
+void SupabaseClient::mergePOIDataIntoSystems(QJsonArray &systemsArray)
+{
+    // CRITICAL FIX: Synchronously add POI data to systems for public visibility
+    qDebug() << "*** MERGE POI FUNCTION CALLED ***";
+    qDebug() << "mergePOIDataIntoSystems: Processing" << systemsArray.size() << "systems";
+    
+    if (m_supabaseUrl.isEmpty() || m_supabaseKey.isEmpty()) {
+        qDebug() << "Supabase not configured for POI merging";
+        return;
     }
     
     // Build a list of system names to query
@@ -1263,33 +1889,179 @@ void SupabaseClient::mergePOIDataIntoSystems(QJsonArray &systemsArray)
     }
     
     qDebug() << "Querying POI data for" << systemNames.size() << "systems";
-    
-    // Build a query to get POI data for the specific systems
-    QStringList systemQueries;
-    for (const QString &systemName : systemNames) {
-        systemQueries.append(QString("system.eq.%1").arg(QString::fromUtf8(QUrl::toPercentEncoding(systemName))));
+    fetchAndMergePOIData(systemNames);
+}
+
+void SupabaseClient::registerReplyHandlers()
+{
+    m_replyHandlers[int(SupabaseOperation::GetSystemsNear)] = &SupabaseClient::onGetSystemsNear;
+    m_replyHandlers[int(SupabaseOperation::GetTakenSystemSpecific)] = &SupabaseClient::onGetTakenSystemSpecific;
+    m_replyHandlers[int(SupabaseOperation::GetCurrentCommanderTaken)] = &SupabaseClient::onGetCurrentCommanderTaken;
+    m_replyHandlers[int(SupabaseOperation::GetCategoriesSystems)] = &SupabaseClient::onGetCategoriesSystems;
+    m_replyHandlers[int(SupabaseOperation::GetCategoriesRichard)] = &SupabaseClient::onGetCategoriesRichard;
+    m_replyHandlers[int(SupabaseOperation::GetPresetImages)] = &SupabaseClient::onGetPresetImages;
+    m_replyHandlers[int(SupabaseOperation::GetSystemInformationPrimary)] = &SupabaseClient::onGetSystemInformationPrimary;
+    m_replyHandlers[int(SupabaseOperation::GetSystemInformationCategory)] = &SupabaseClient::onGetSystemInformationCategory;
+    m_replyHandlers[int(SupabaseOperation::GetSystemInformationDb)] = &SupabaseClient::onGetSystemInformationDb;
+    m_replyHandlers[int(SupabaseOperation::GetSystemDetails)] = &SupabaseClient::onGetSystemDetails;
+    m_replyHandlers[int(SupabaseOperation::GetSystemCategoryLookup)] = &SupabaseClient::onGetSystemCategoryLookup;
+    m_replyHandlers[int(SupabaseOperation::GetSystemDetailsRobust)] = &SupabaseClient::onGetSystemDetailsRobust;
+    m_replyHandlers[int(SupabaseOperation::GetAdminAccess)] = &SupabaseClient::onGetAdminAccess;
+    m_replyHandlers[int(SupabaseOperation::GetPois)] = &SupabaseClient::onGetPois;
+    m_replyHandlers[int(SupabaseOperation::RpcClaimSystem)] = &SupabaseClient::onRpcClaimSystem;
+    m_replyHandlers[int(SupabaseOperation::RpcReleaseClaim)] = &SupabaseClient::onRpcReleaseClaim;
+    m_replyHandlers[int(SupabaseOperation::PostTaken)] = &SupabaseClient::onPostTaken;
+    m_replyHandlers[int(SupabaseOperation::DeleteTaken)] = &SupabaseClient::onDeleteTaken;
+    m_replyHandlers[int(SupabaseOperation::UpsertSystemInformationPoiSet)] = &SupabaseClient::onUpsertSystemInformationPoiSet;
+    m_replyHandlers[int(SupabaseOperation::UpdateSystemInformationPoiClear)] = &SupabaseClient::onUpdateSystemInformationPoiClear;
+    m_replyHandlers[int(SupabaseOperation::DeletePois)] = &SupabaseClient::onDeletePois;
+    m_replyHandlers[int(SupabaseOperation::GetAllCommanders)] = &SupabaseClient::onGetAllCommanders;
+    m_replyHandlers[int(SupabaseOperation::PatchCommanderLocation)] = &SupabaseClient::onPatchCommanderLocation;
+    m_replyHandlers[int(SupabaseOperation::PatchTakenBatch)] = &SupabaseClient::onPatchTakenBatch;
+    m_replyHandlers[int(SupabaseOperation::TestAdminAccess)] = &SupabaseClient::onTestAdminAccess;
+    m_replyHandlers[int(SupabaseOperation::GetWebhookConfig)] = &SupabaseClient::onGetWebhookConfig;
+    m_replyHandlers[int(SupabaseOperation::PostWebhook)] = &SupabaseClient::onPostWebhook;
+    m_replyHandlers[int(SupabaseOperation::CheckSystemInfoExists)] = &SupabaseClient::onCheckSystemInfoExists;
+    m_replyHandlers[int(SupabaseOperation::InsertSystemInformation)] = &SupabaseClient::onSystemInformationSaved;
+    m_replyHandlers[int(SupabaseOperation::UpdateSystemInformation)] = &SupabaseClient::onSystemInformationSaved;
+    m_replyHandlers[int(SupabaseOperation::SetCommanderContext)] = &SupabaseClient::onSetCommanderContext;
+    m_replyHandlers[int(SupabaseOperation::ImgbbUpload)] = &SupabaseClient::onImgbbUpload;
+    m_replyHandlers[int(SupabaseOperation::GetPresetImageCategory)] = &SupabaseClient::onGetPresetImageCategory;
+    m_replyHandlers[int(SupabaseOperation::CheckPresetImagesCount)] = &SupabaseClient::onCheckPresetImagesCount;
+    m_replyHandlers[int(SupabaseOperation::SecurityCheck)] = &SupabaseClient::onSecurityCheck;
+    m_replyHandlers[int(SupabaseOperation::AddNewCommander)] = &SupabaseClient::onAddNewCommander;
+    m_replyHandlers[int(SupabaseOperation::CheckBannedAlt)] = &SupabaseClient::onCheckBannedAlt;
+    m_replyHandlers[int(SupabaseOperation::BlockRenamedCommander)] = &SupabaseClient::onBlockRenamedCommander;
+    m_replyHandlers[int(SupabaseOperation::LogLoginEvent)] = &SupabaseClient::onLogLoginEvent;
+    m_replyHandlers[int(SupabaseOperation::CheckSystemInfoForImage)] = &SupabaseClient::onCheckSystemInfoForImage;
+    m_replyHandlers[int(SupabaseOperation::UpdateSystemInfoImage)] = &SupabaseClient::onSystemInfoImageSaved;
+    m_replyHandlers[int(SupabaseOperation::InsertSystemInfoImage)] = &SupabaseClient::onSystemInfoImageSaved;
+    m_replyHandlers[int(SupabaseOperation::CheckExistingClaim)] = &SupabaseClient::onCheckExistingClaim;
+    m_replyHandlers[int(SupabaseOperation::CheckRecordsBeforeUpdate)] = &SupabaseClient::onCheckRecordsBeforeUpdate;
+    m_replyHandlers[int(SupabaseOperation::UnclaimMarkEmpty)] = &SupabaseClient::onUnclaimMarkEmpty;
+    m_replyHandlers[int(SupabaseOperation::CheckSystemInfoExistsOnClaim)] = &SupabaseClient::onCheckSystemInfoExistsOnClaim;
+    m_replyHandlers[int(SupabaseOperation::ImgbbTest)] = &SupabaseClient::onImgbbTest;
+}
+
+SupabaseRequestContext &SupabaseClient::requestContext(QNetworkReply *reply)
+{
+    auto it = m_requestContexts.find(reply);
+    if (it == m_requestContexts.end()) {
+        it = m_requestContexts.insert(reply, SupabaseRequestContext());
+        // Dropped with the reply rather than in handleNetworkReply: other finished() slots still read it
+        connect(reply, &QObject::destroyed, this, [this, reply]() {
+            m_requestContexts.remove(reply);
+        });
+    }
+    return it.value();
+}
+
+void SupabaseClient::trackRequest(QNetworkReply *reply, SupabaseOperation operation)
+{
+    SupabaseRequestContext &context = requestContext(reply);
+    context.operation = operation;
+    context.tag = QString::fromLatin1(supabaseOperationTag(operation));
+    context.timer.start();
+    trackOfflineReplay(context);
+    watchReplyTiming(reply);
+}
+
+void SupabaseClient::trackRequest(QNetworkReply *reply, const QString &tag)
+{
+    SupabaseRequestContext &context = requestContext(reply);
+    context.operation = supabaseOperationFromTag(tag);
+    context.tag = tag;
+    context.timer.start();
+    trackOfflineReplay(context);
+    watchReplyTiming(reply);
+}
+
+void SupabaseClient::trackOfflineReplay(SupabaseRequestContext &context)
+{
+    if (m_replayScope == 0) {
+        return;
+    }
+    // The writes a journal entry turns into, and the checks they are chained behind; reads
+    // sent along the way (POI re-merges) don't decide whether the entry went through
+    switch (context.operation) {
+    case SupabaseOperation::CheckExistingClaim:
+    case SupabaseOperation::PostTaken:
+    case SupabaseOperation::UnclaimMarkEmpty:
+    case SupabaseOperation::PatchTakenBatch:
+    case SupabaseOperation::UpsertSystemInformationPoiSet:
+    case SupabaseOperation::UpdateSystemInformationPoiClear:
+    case SupabaseOperation::DeletePois:
+    case SupabaseOperation::CheckPoiSystemExists:
+        context.offlineReplay = true;
+        m_replayOutstanding++;
+        break;
+    default:
+        break;
+    }
+}
+
+void SupabaseClient::watchReplyTiming(QNetworkReply *reply)
+{
+    // Headers arriving is the first byte; upload progress carries the request body size
+    connect(reply, &QNetworkReply::metaDataChanged, this, [this, reply]() {
+        auto it = m_requestContexts.find(reply);
+        if (it != m_requestContexts.end() && it->firstByteMs < 0 && it->timer.isValid()) {
+            it->firstByteMs = it->timer.elapsed();
+        }
+    });
+    connect(reply, &QNetworkReply::uploadProgress, this, [this, reply](qint64 bytesSent, qint64) {
+        auto it = m_requestContexts.find(reply);
+        if (it != m_requestContexts.end()) {
+            it->bytesUp = bytesSent;
+        }
+    });
+}
+
+QString SupabaseClient::metricsTag(const SupabaseRequestContext &context)
+{
+    // Runtime suffixes (webhook events, commander names) are folded into their operation
+    return context.operation == SupabaseOperation::Unknown ? context.tag
+                                                           : QString::fromLatin1(supabaseOperationTag(context.operation));
+}
+
+void SupabaseClient::recordOperationStats(const SupabaseRequestContext &context, QNetworkReply *reply)
+{
+    m_networkMetrics.recordReply(metricsTag(context), reply->error() != QNetworkReply::NoError,
+                                 context.timer.isValid() ? context.timer.elapsed() : -1,
+                                 context.firstByteMs, context.bytesUp, reply->bytesAvailable());
+}
+
+QVariantList SupabaseClient::operationStats() const
+{
+    return m_networkMetrics.toVariantList();
+}
+
+void SupabaseClient::resetOperationStats()
+{
+    m_networkMetrics.reset();
+}
+
+QString SupabaseClient::writeNetworkMetricsSnapshot(const QVariantMap &otherSources)
+{
+    QJsonObject snapshot;
+    snapshot["generated_at"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    snapshot["supabase"] = m_networkMetrics.toJson();
+    for (auto it = otherSources.constBegin(); it != otherSources.constEnd(); ++it) {
+        snapshot[it.key()] = QJsonValue::fromVariant(it.value());
     }
     
-    QString systemFilter = systemQueries.join(",");
-    QString endpoint = QString("system_information?select=system,potential_or_poi,discoverer,submitter&or=(%1)").arg(systemFilter);
-    
-    QNetworkRequest request = createRequest(endpoint);
-    
-    // IMPORTANT: Remove commander headers for public POI access
-    request.setRawHeader("x-commander-name", "");
-    
-    QNetworkReply *reply = m_networkManager->get(request);
-    
-    if (reply) {
-        reply->setProperty("operation", "GET:poi_data_for_merge");
-        reply->setProperty("systemsCount", systemsArray.size());
-        // Store the systems array so we can merge when the response comes back
-        QJsonDocument systemsDoc(systemsArray);
-        reply->setProperty("systemsToMerge", systemsDoc.toJson());
-        qDebug() << "mergePOIDataIntoSystems: POI data request sent for" << systemNames.size() << "systems";
-    } else {
-        qDebug() << "mergePOIDataIntoSystems: Failed to create POI request";
+    const QString appDataPath = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    QDir().mkpath(appDataPath);
+    const QString path = QDir(appDataPath).filePath("network_metrics.json");
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Failed to write network metrics snapshot:" << file.errorString();
+        return QString();
     }
+    file.write(QJsonDocument(snapshot).toJson());
+    file.close();
+    qDebug() << "Network metrics snapshot written to" << path;
+    return path;
 }
 
 void SupabaseClient::handleNetworkReply(QNetworkReply *reply)
@@ -1299,11 +2071,40 @@ void SupabaseClient::handleNetworkReply(QNetworkReply *reply)
         return;
     }
     
-    QString operation = reply->property("operation").toString();
+    // Copied: handlers may send new requests, which grows the context table
+    const SupabaseRequestContext context = m_requestContexts.value(reply);
+    const QString operation = context.tag;
+    
+    // Requests a replayed entry's handler sends next belong to the same entry; once the
+    // handler has run, the entry is finished if none of them are still in flight
+    if (context.offlineReplay) {
+        m_replayScope++;
+    }
+    const auto replayGuard = qScopeGuard([this, &context, reply]() {
+        if (context.offlineReplay) {
+            m_replayScope--;
+            offlineReplayReplyFinished(reply);
+        }
+    });
     int httpStatus = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
     
+    recordOperationStats(context, reply);
+    
+    // Replies from the backend decide offline mode: no connection means offline, any HTTP answer means back
+    if (!m_supabaseUrl.isEmpty() && reply->url().toString().startsWith(m_supabaseUrl)) {
+        if (isBackendUnreachable(reply)) {
+            setOffline(true);
+        } else if (m_offline) {
+            setOffline(false);
+        }
+    }
+    if (context.operation == SupabaseOperation::ProbeBackend) {
+        reply->deleteLater();
+        return;
+    }
+    
     // Add specific debug for ImgBB operations
-    if (operation.startsWith("IMGBB:")) {
+    if (context.operation == SupabaseOperation::ImgbbUpload || context.operation == SupabaseOperation::ImgbbTest) {
         qDebug() << "=== IMGBB REPLY RECEIVED ===";
         qDebug() << "Operation:" << operation;
         qDebug() << "HTTP Status:" << httpStatus;
@@ -1324,7 +2125,7 @@ void SupabaseClient::handleNetworkReply(QNetworkReply *reply)
     QJsonObject response;
     
     // Special handling for webhook operations - they return HTTP 204 with no body on success
-    if (operation.startsWith("POST:webhook:")) {
+    if (context.operation == SupabaseOperation::PostWebhook) {
         if (reply->error() == QNetworkReply::NoError && 
             (httpStatus == 200 || httpStatus == 204)) {
             success = true;
@@ -1332,7 +2133,22 @@ void SupabaseClient::handleNetworkReply(QNetworkReply *reply)
         } else {
             response = parseReply(reply, success);
         }
-    } else if (operation.startsWith("IMGBB:upload")) {
+    } else if (context.operation == SupabaseOperation::SyncPage || context.operation == SupabaseOperation::SyncCount) {
+        // Catalogue sync replies carry their own paging state and error fallbacks
+        reply->deleteLater();
+        handleCatalogueReply(context, reply);
+        return;
+    } else if (context.lookupId != 0) {
+        // Chunks of a system lookup are merged before anything is emitted
+        reply->deleteLater();
+        handleSystemLookupReply(context, reply);
+        return;
+    } else if (context.bulkPage) {
+        // Pages of a bulk read are parsed off the GUI thread and delivered as they come in
+        reply->deleteLater();
+        handleBulkPage(context, reply);
+        return;
+    } else if (context.operation == SupabaseOperation::ImgbbUpload) {
         // ImgBB returns 200 with JSON response on success
         if (reply->error() == QNetworkReply::NoError && httpStatus == 200) {
             success = true;
@@ -1345,6 +2161,19 @@ void SupabaseClient::handleNetworkReply(QNetworkReply *reply)
     // Ensure reply is cleaned up at the end
     reply->deleteLater();
     
+    // Joined callers are served by this reply's signals; a write makes every cached read stale
+    const QString &cacheKey = context.cacheKey;
+    if (!cacheKey.isEmpty()) {
+        m_inFlightGets.remove(cacheKey);
+    }
+    if (reply->operation() != QNetworkAccessManager::GetOperation &&
+        reply->operation() != QNetworkAccessManager::HeadOperation && !m_responseCache.isEmpty()) {
+        m_responseCache.clear();
+    }
+    if (success && !cacheKey.isEmpty()) {
+        cacheResponse(cacheKey, operation, response.value("data").toArray());
+    }
+    
     if (!success) {
         QString error = response.value("message").toString("Network error");
         
@@ -1356,7 +2185,7 @@ void SupabaseClient::handleNetworkReply(QNetworkReply *reply)
         
         if (isAuthError) {
             // Special handling for admin access test - this is expected to fail for non-admins
-            if (operation.startsWith("TEST:admin_access")) {
+            if (context.operation == SupabaseOperation::TestAdminAccess) {
                 qDebug() << "Admin access test failed - user does not have admin privileges";
                 emit adminAccessTestComplete(false);
                 return; // Don't count this as a regular auth failure
@@ -1379,15 +2208,33 @@ void SupabaseClient::handleNetworkReply(QNetworkReply *reply)
             m_consecutiveAuthFailures = 0;
             
             // Check if this is a POI-related error (non-critical for core app functionality)
-            bool isPOIError = operation.startsWith("GET:pois") || operation.startsWith("POST:pois") || operation.startsWith("DELETE:pois");
-            bool isWebhookError = operation.startsWith("POST:webhook:");
-            bool isUpdateError = operation.startsWith("UPDATE:system");
+            const SupabaseOperation op = context.operation;
+            bool isPOIError = op == SupabaseOperation::GetPois || op == SupabaseOperation::DeletePois;
+            bool isWebhookError = op == SupabaseOperation::PostWebhook;
+            bool isUpdateError = op == SupabaseOperation::PatchTakenBatch || op == SupabaseOperation::UpdateSystemInformation || op == SupabaseOperation::UpdateSystemInfoImage ||
+                                 op == SupabaseOperation::UpdateSystemImages || op == SupabaseOperation::UpdateSystemInformationPoiClear;
             
-            if (isUpdateError) {
+            if (op == SupabaseOperation::PatchTakenBatch && m_shuttingDown) {
+                // Journaled by journalWritesOnShutdown() already
+            } else if (op == SupabaseOperation::PatchTakenBatch && m_offline && !context.offlineReplay) {
+                // Lost on the way out - keep it for the replay instead of dropping it
+                for (const QString &systemName : context.systemNames) {
+                    journalOfflineMutation({{"op", "taken_update"}, {"system", systemName},
+                                            {"commander", context.commander}, {"fields", context.fields}});
+                    emit systemStatusUpdated(systemName, true);
+                }
+            } else if (isUpdateError) {
                 // Handle system status update failures
-                QString systemName = reply->property("systemName").toString();
-                qDebug() << "System status update failed for" << systemName << "-" << error;
-                emit systemStatusUpdated(systemName, false);
+                const QStringList systemNames = op == SupabaseOperation::PatchTakenBatch ? context.systemNames
+                                                                                         : QStringList{context.systemName};
+                for (const QString &systemName : systemNames) {
+                    qDebug() << "System status update failed for" << systemName << "-" << error;
+                    emit systemStatusUpdated(systemName, false);
+                }
+                if (op == SupabaseOperation::PatchTakenBatch) {
+                    // The optimistic values were dropped with the queue entry - reload the real ones
+                    getTakenSystems();
+                }
                 // Don't show popup for update failures, let the UI handle it
             } else if (isPOIError) {
                 // POI errors are non-critical - log but don't show scary popup
@@ -1395,13 +2242,13 @@ void SupabaseClient::handleNetworkReply(QNetworkReply *reply)
                 qDebug() << "App will continue to work normally without POI functionality";
                 
                 // Emit empty POI data so app continues to work
-                if (operation.startsWith("GET:pois")) {
+                if (op == SupabaseOperation::GetPois) {
                     emit poisReceived(QJsonArray());
                 }
                 // Don't emit networkError for POI operations to avoid popup
             } else if (isWebhookError) {
                 // Webhook errors are non-critical but should be logged
-                QString eventType = operation.split(":").last();
+                QString eventType = operation.section(':', -1);
                 qDebug() << "Webhook failed for event:" << eventType << "-" << error;
                 qDebug() << "Webhook HTTP status:" << reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
                 qDebug() << "Webhook response body:" << reply->readAll();
@@ -1409,7 +2256,7 @@ void SupabaseClient::handleNetworkReply(QNetworkReply *reply)
                 // Don't emit networkError for webhook operations
             } else {
                 // Special handling for category table queries - check for column name issues BEFORE showing error
-                if (operation == "GET:system_information_category" && httpStatus == 400) {
+                if (op == SupabaseOperation::GetSystemInformationCategory && httpStatus == 400) {
                     QByteArray responseBody = reply->readAll();
                     qDebug() << "Category table 400 error - checking if it's a column name issue...";
                     qDebug() << "Response:" << QString::fromUtf8(responseBody);
@@ -1418,18 +2265,14 @@ void SupabaseClient::handleNetworkReply(QNetworkReply *reply)
                     if (responseBody.contains("column") && 
                         (responseBody.contains("system") || responseBody.contains("System"))) {
                         
-                        bool triedLowercase = reply->property("triedLowercase").toBool();
-                        QString fallbackUrl = reply->property("fallbackUrl").toString();
-                        
-                        if (triedLowercase && !fallbackUrl.isEmpty()) {
+                        if (context.triedLowercase && !context.fallbackUrl.isEmpty()) {
                             qDebug() << "Column name issue detected - retrying with uppercase 'System'";
                             
-                            // Extract the original properties
-                            QString systemName = reply->property("systemName").toString();
-                            QString category = reply->property("category").toString();
+                            const QString &systemName = context.systemName;
+                            const QString &category = context.category;
                             
                             // Create a new request with uppercase System
-                            QUrl url = QUrl::fromEncoded(fallbackUrl.toUtf8(), QUrl::StrictMode);
+                            QUrl url = QUrl::fromEncoded(context.fallbackUrl.toUtf8(), QUrl::StrictMode);
                             QNetworkRequest request(url);
                             request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
                             request.setRawHeader("apikey", m_supabaseKey.toUtf8());
@@ -1440,12 +2283,13 @@ void SupabaseClient::handleNetworkReply(QNetworkReply *reply)
                                 request.setRawHeader("x-commander-name", m_currentCommander.toUtf8());
                             }
                             
+                            m_networkMetrics.recordRetry(metricsTag(context));
                             QNetworkReply *retryReply = m_networkManager->get(request);
                             if (retryReply) {
-                                retryReply->setProperty("operation", "GET:system_information_category");
-                                retryReply->setProperty("systemName", systemName);
-                                retryReply->setProperty("category", category);
-                                retryReply->setProperty("triedLowercase", false); // Don't retry again
+                                trackRequest(retryReply, SupabaseOperation::GetSystemInformationCategory);
+                                requestContext(retryReply).systemName = systemName;
+                                requestContext(retryReply).category = category;
+                                requestContext(retryReply).triedLowercase = false; // Don't retry again
                                 qDebug() << "Retry request sent for" << systemName;
                             }
                             
@@ -1455,9 +2299,11 @@ void SupabaseClient::handleNetworkReply(QNetworkReply *reply)
                     }
                 }
                 
-                // For all other errors, show the popup
+                // For all other errors, show the popup (offline mode is announced once by offlineModeChanged)
                 qWarning() << "Supabase request failed:" << operation << "-" << error;
-                emit networkError(error);
+                if (!m_offline) {
+                    emit networkError(error);
+                }
             }
         }
         
@@ -1472,1385 +2318,1308 @@ void SupabaseClient::handleNetworkReply(QNetworkReply *reply)
         qDebug() << "Supabase request successful for operation:" << operation;
     }
     
-    // Handle different operation types
-    if (operation.startsWith("GET:systems_near")) {
-        QJsonArray systems = response.value("data").toArray();
-        double centerX = reply->property("refX").toDouble();
-        double centerY = reply->property("refY").toDouble();
-        double centerZ = reply->property("refZ").toDouble();
-        // Calculate distances and emit nearestSystemsReceived signal
-        QJsonArray systemsWithDistance;
-        for (const QJsonValue &value : systems) {
-            QJsonObject system = value.toObject();
-            double systemX = system.value("x").toDouble();
-            double systemY = system.value("y").toDouble();
-            double systemZ = system.value("z").toDouble();
-            
-            double distance = calculateDistance(centerX, centerY, centerZ, systemX, systemY, systemZ);
-            
-            // Transform system data for UI
-            QJsonObject transformed;
-            transformed["name"] = system.value("systems").toString();
-            transformed["category"] = system.value("category").toString();
-            transformed["distance"] = QString("%1 LY").arg(distance, 0, 'f', 1);
-            transformed["x"] = systemX;
-            transformed["y"] = systemY;
-            transformed["z"] = systemZ;
-            transformed["poi"] = "";
-            transformed["claimed"] = false;
-            transformed["done"] = false;
-            transformed["claimedBy"] = "";
-            transformed["distanceValue"] = distance;
-            
-            systemsWithDistance.append(transformed);
-        }
-        
-        // Sort by distance
-        QVariantList systemsList;
-        for (const QJsonValue &value : systemsWithDistance) {
-            systemsList.append(value.toObject().toVariantMap());
-        }
-        
-        std::sort(systemsList.begin(), systemsList.end(), [](const QVariant &a, const QVariant &b) {
-            QVariantMap mapA = a.toMap();
-            QVariantMap mapB = b.toMap();
-            return mapA["distanceValue"].toDouble() < mapB["distanceValue"].toDouble();
-        });
-        
-        // Convert back to QJsonArray and remove distanceValue field
-        QJsonArray sortedSystems;
-        for (const QVariant &variant : systemsList) {
-            QVariantMap map = variant.toMap();
-            map.remove("distanceValue");
-            sortedSystems.append(QJsonObject::fromVariantMap(map));
-        }
-        
-        emit nearestSystemsReceived(sortedSystems);
-        
-    } else if (operation.startsWith("GET:systems")) {
-        QJsonArray systems = response.value("data").toArray();
-        
-        if (systems.isEmpty()) {
-            qDebug() << "❌ No systems in database response! HTTP Status:" << reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
-        } else {
-            qDebug() << "✅ Received" << systems.size() << "systems from database";
-        }
-        
-        // If no data array, try direct array response (Supabase sometimes returns array directly)
-        if (systems.isEmpty() && response.isEmpty()) {
-            qDebug() << "No data field found, checking if response is direct array";
-            // Response might be direct array
-            systems = QJsonArray(); // Will handle this case below
-        }
-        
-        // Transform database format to match our UI expectations
-        QJsonArray transformedSystems;
-        for (const QJsonValue &value : systems) {
-            QJsonObject system = value.toObject();
-            QString category = system["category"].toString();
-            
-            // Filter out test/debug categories
-            if (category == "TEST_CATEGORY" || category.startsWith("test_")) {
-                continue;
-            }
-            
-            QJsonObject transformed;
-            
-            // Map database fields to expected UI fields
-            transformed["name"] = system["systems"];  // systems → name
-            transformed["category"] = system["category"];
-            
-            // Coordinates ARE available in systems table!
-            double x = system["x"].toDouble();
-            double y = system["y"].toDouble();
-            double z = system["z"].toDouble();
-            transformed["x"] = x;
-            transformed["y"] = y;
-            transformed["z"] = z;
-            
-            // Calculate distance from Sol (0,0,0)
-            double distance = std::sqrt(x*x + y*y + z*z);
-            transformed["distance"] = QString::number(distance, 'f', 1) + " LY";
-            
-            // Add default values for fields we don't have yet
-            transformed["poi"] = "";  // Will be populated from system_information
-            transformed["claimed"] = false;  // Will implement claims tracking later
-            transformed["done"] = false;
-            transformed["claimedBy"] = "";
-            
-            transformedSystems.append(transformed);
-        }
-        
-        qDebug() << "Transformed" << transformedSystems.size() << "systems for UI";
-        if (transformedSystems.size() > 0) {
-            // Sample system loaded
-        }
-        
-        // CRITICAL FIX: Add POI data merging functionality
-        mergePOIDataIntoSystems(transformedSystems);
-        
-        // Emit systems data (POI data will be merged synchronously)
-        emit systemsReceived(transformedSystems);
-        
-    } else if (operation.startsWith("GET:taken_system_specific")) {
-        QString systemName = reply->property("systemName").toString();
-        QString commanderName = reply->property("commanderName").toString();
-        QJsonArray takenData = response.value("data").toArray();
-        
-        qDebug() << "Got taken_system_specific response for" << systemName << "commander" << commanderName;
-        qDebug() << "Response data:" << QJsonDocument(takenData).toJson(QJsonDocument::Compact);
-        
-        // Emit this as a single-item array for compatibility with existing handler
-        emit takenSystemsReceived(takenData);
-        
-    } else if (operation.startsWith("GET:taken")) {
-        QJsonArray taken = response.value("data").toArray();
-        qDebug() << "Emitting takenSystemsReceived with" << taken.size() << "items (ALL systems)";
-        emit takenSystemsReceived(taken);
-        
-    } else if (operation.startsWith("GET:current_commander_taken")) {
-        QJsonArray taken = response.value("data").toArray();
-        qDebug() << "Emitting takenSystemsReceived with" << taken.size() << "items (current commander only)";
-        emit takenSystemsReceived(taken);
-        
-    } else if (operation.startsWith("GET:categories_systems")) {
-        qDebug() << "Processing GET:categories_systems response";
-        QJsonArray categoriesData = response.value("data").toArray();
-        qDebug() << "Systems categories data size:" << categoriesData.size();
-        
-        // Extract unique categories and add "All Categories" at the beginning
-        QStringList systemsCategories;
-        systemsCategories << "All Categories"; // Always first
-        
-        QSet<QString> categorySet;
-        for (const QJsonValue &value : categoriesData) {
-            QJsonObject categoryObj = value.toObject();
-            QString category = categoryObj.value("category").toString().trimmed();
-            // Filter out test/debug categories
-            if (!category.isEmpty() && !categorySet.contains(category) && 
-                category != "TEST_CATEGORY" && !category.startsWith("test_")) {
-                categorySet.insert(category);
-                systemsCategories << category;
-            }
-        }
-        
-        // Store systems categories temporarily and fetch Richard categories
-        m_pendingSystemsCategories = systemsCategories;
-        
-        // Now fetch Richard categories from preset_images table
-        getRichardCategories();
-        
-    } else if (operation.startsWith("GET:categories_richard")) {
-        qDebug() << "Processing GET:categories_richard response";
-        QJsonArray richardData = response.value("data").toArray();
-        qDebug() << "Richard categories data size:" << richardData.size();
-        
-        // Extract Richard categories (show ALL Richard categories, don't deduplicate)
-        QStringList richardCategories;
-        QSet<QString> richardSet;
-        
-        for (const QJsonValue &value : richardData) {
-            QJsonObject categoryObj = value.toObject();
-            QString category = categoryObj.value("category").toString().trimmed();
-            if (!category.isEmpty() && !richardSet.contains(category)) {
-                richardSet.insert(category);
-                richardCategories << category;
-            }
-        }
-        
-        // Combine systems categories with Richard categories (remove duplicates)
-        QStringList allCategories;
-        
-        // Add systems categories but exclude ones that will appear in Richard's section
-        for (const QString &category : m_pendingSystemsCategories) {
-            if (!richardSet.contains(category)) {
-                allCategories << category;
-            }
-        }
-        
-        // Add separator and Richard categories if we have any (always show Richard's section)
-        if (!richardCategories.isEmpty()) {
-            allCategories << "--- Richard's Stuff ---";
-            allCategories << richardCategories;
-        }
-        
-        // Convert to JSON array for consistent signal interface
-        QJsonArray categoriesArray;
-        for (const QString &category : allCategories) {
-            categoriesArray.append(category);
-        }
-        
-        qDebug() << "Emitting categoriesReceived with" << categoriesArray.size() << "total categories (systems + Richard)";
-        emit categoriesReceived(categoriesArray);
-        
-    } else if (operation.startsWith("GET:systems_near")) {
-        qDebug() << "Processing GET:systems_near response";
-        QJsonArray systemsData = response.value("data").toArray();
-        qDebug() << "Systems near data size:" << systemsData.size();
-        
-        // Get reference coordinates from reply properties
-        double refX = reply->property("refX").toDouble();
-        double refY = reply->property("refY").toDouble();
-        double refZ = reply->property("refZ").toDouble();
-        
-        qDebug() << "Reference coordinates:" << refX << refY << refZ;
-        
-        // Calculate distances and sort by distance
-        QJsonArray systemsWithDistance;
-        for (const QJsonValue &value : systemsData) {
-            QJsonObject system = value.toObject();
-            double systemX = system.value("x").toDouble();
-            double systemY = system.value("y").toDouble();
-            double systemZ = system.value("z").toDouble();
-            
-            double distance = calculateDistance(refX, refY, refZ, systemX, systemY, systemZ);
-            
-            // Transform system data for UI (similar to getSystems)
-            QJsonObject transformed;
-            transformed["name"] = system.value("systems").toString();
-            transformed["category"] = system.value("category").toString();
-            transformed["distance"] = QString("%1 LY").arg(distance, 0, 'f', 1);
-            transformed["x"] = systemX;
-            transformed["y"] = systemY;
-            transformed["z"] = systemZ;
-            transformed["poi"] = "";  // Will be filled from POI table join later
-            transformed["claimed"] = false;  // Will be filled from taken table join later
-            transformed["done"] = false;  // TODO: done status not available in systems table
-            transformed["claimedBy"] = "";
-            transformed["distanceValue"] = distance;  // For sorting
-            
-            systemsWithDistance.append(transformed);
-        }
-        
-        // Sort by distance (convert to QVariantList for easier sorting)
-        QVariantList systemsList;
-        for (const QJsonValue &value : systemsWithDistance) {
-            systemsList.append(value.toObject().toVariantMap());
-        }
-        
-        std::sort(systemsList.begin(), systemsList.end(), [](const QVariant &a, const QVariant &b) {
-            QVariantMap mapA = a.toMap();
-            QVariantMap mapB = b.toMap();
-            return mapA["distanceValue"].toDouble() < mapB["distanceValue"].toDouble();
-        });
-        
-        // Convert back to QJsonArray and remove distanceValue field
-        QJsonArray sortedSystems;
-        for (const QVariant &variant : systemsList) {
-            QVariantMap map = variant.toMap();
-            map.remove("distanceValue");  // Remove sorting helper field
-            sortedSystems.append(QJsonObject::fromVariantMap(map));
-        }
-        
-        qDebug() << "*** MERGING POI DATA DIRECTLY INTO SYSTEMS ***";
-        
-        // Directly query and merge POI data synchronously
-        QStringList systemNames;
-        for (int i = 0; i < sortedSystems.size(); i++) {
-            QJsonObject system = sortedSystems[i].toObject();
-            QString systemName = system["name"].toString();
-            if (!systemName.isEmpty()) {
-                systemNames.append(systemName);
-            }
-        }
-        
-        if (!systemNames.isEmpty()) {
-            // Build query for POI data
-            QStringList systemQueries;
-            for (const QString &systemName : systemNames) {
-                systemQueries.append(QString("system.eq.%1").arg(QString::fromUtf8(QUrl::toPercentEncoding(systemName))));
-            }
-            
-            QString systemFilter = systemQueries.join(",");
-            QString endpoint = QString("system_information?select=system,potential_or_poi&or=(%1)").arg(systemFilter);
-            
-            qDebug() << "Querying POI data for systems_near:" << endpoint;
-            
-            QNetworkRequest request = createRequest(endpoint);
-            request.setRawHeader("x-commander-name", ""); // Remove commander headers for public access
-            
-            QNetworkReply *reply = m_networkManager->get(request);
-            
-            if (reply) {
-                reply->setProperty("operation", "GET:poi_for_systems_near");
-                // Store the sorted systems so we can merge and emit them when POI data arrives
-                QJsonDocument systemsDoc(sortedSystems);
-                reply->setProperty("sortedSystems", systemsDoc.toJson());
-                qDebug() << "POI data request sent for systems_near";
-                return; // Don't emit systems yet, wait for POI data
-            }
-        }
-        
-        qDebug() << "*** EMITTING NEAREST SYSTEMS RECEIVED (NO POI MERGE) ***";
-        qDebug() << "Emitting nearestSystemsReceived with" << sortedSystems.size() << "sorted systems";
-        emit nearestSystemsReceived(sortedSystems);
-        
-    } else if (operation.startsWith("GET:preset_images")) {
-        QJsonArray presetImages = response.value("data").toArray();
-        
-        // Store count for future change detection
-        QJsonObject tables = m_syncState.value("tables").toObject();
-        tables["preset_images_count"] = presetImages.size();
-        m_syncState["tables"] = tables;
-        saveSyncState();
-        
-        emit presetImagesReceived(presetImages);
-        
-    } else if (operation.startsWith("GET:system_information_primary")) {
-        QString systemName = reply->property("systemName").toString();
-        QString fallbackCategory = reply->property("fallbackCategory").toString();
-        QJsonArray systemInfoArray = response.value("data").toArray();
-        
-        qDebug() << "Got system_information_primary response for" << systemName;
-        
-        // Check if we got data and if system_info field is not empty
-        bool hasCustomInfo = false;
-        QJsonObject customInfo;
-        
-        if (!systemInfoArray.isEmpty()) {
-            customInfo = systemInfoArray.first().toObject();
-            QString systemInfo = customInfo.value("system_info").toString();
-            
-            // Check if system_info field exists and is not empty
-            if (!systemInfo.isEmpty() && systemInfo.trimmed() != "") {
-                hasCustomInfo = true;
-                qDebug() << "Found custom system information:" << systemInfo.left(100) + "...";
-            }
-        }
-        
-        if (hasCustomInfo) {
-            // Use the custom system information
-            customInfo["hasInformation"] = true;
-            emit systemInformationReceived(systemName, customInfo);
-        } else {
-            // Fall back to category table data
-            qDebug() << "No custom system_info found, falling back to category table:" << fallbackCategory;
-            getSystemInformationFromCategory(systemName, fallbackCategory);
-        }
-        
-    } else if (operation.startsWith("GET:system_information_category")) {
-        QString systemName = reply->property("systemName").toString();
-        QString category = reply->property("category").toString();
-        QJsonArray categoryDataArray = response.value("data").toArray();
-        
-        qDebug() << "Got system_information_category response for" << systemName << "category:" << category;
-        
-        QJsonObject formattedSystemInfo;
+    // Hand the reply to the handler registered for its operation
+    if (ReplyHandler handler = m_replyHandlers[int(context.operation)]) {
+        (this->*handler)(context, reply, response);
+    }
+    
+    emit requestCompleted(operation, true, "Success");
+    reply->deleteLater();
+}
+
+void SupabaseClient::onGetSystemsNear(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response)
+{
+    const QString waypoint = context.waypoint;
+    if (context.generation != m_systemsNearQueries.value(waypoint, -1)) {
+        qDebug() << "Dropping superseded systems_near response";
+        return;
+    }
+    
+    const QJsonArray rows = response.value("data").toArray();
+    SystemRecordList &systems = m_systemsNearRows[waypoint];
+    systems.reserve(systems.size() + rows.size());
+    for (const QJsonValue &value : rows) {
+        systems.append(systemRecordFromRow(value.toObject()));
+    }
+    double centerX = context.refX;
+    double centerY = context.refY;
+    double centerZ = context.refZ;
+    const int limit = context.limit;
+    const double radius = context.radius;
+    
+    // A full page means the box may hold more rows
+    if (rows.size() >= SYSTEMS_NEAR_PAGE_SIZE) {
+        requestSystemsNear(waypoint, centerX, centerY, centerZ, limit, radius, context.generation,
+                           context.offset + rows.size());
+        return;
+    }
+    
+    // Only systems inside the sphere are guaranteed to rank correctly - the corners of
+    // the box can be farther away than systems just outside it
+    int inRange = 0;
+    SystemRecordList sortedSystems = rankSystemsNear(systems, centerX, centerY, centerZ, limit, radius, &inRange);
+    const int boxRows = systems.size();
+    m_systemsNearRows.remove(waypoint);
+    
+    if (inRange < limit && radius < SYSTEMS_NEAR_MAX_RADIUS) {
+        const double nextRadius = qMin(radius * SYSTEMS_NEAR_GROWTH, SYSTEMS_NEAR_MAX_RADIUS);
+        qDebug() << "systems_near:" << inRange << "of" << limit << "systems within" << radius
+                 << "LY, expanding to" << nextRadius << "LY";
+        requestSystemsNear(waypoint, centerX, centerY, centerZ, limit, nextRadius, context.generation);
+        return;
+    }
+    
+    qDebug() << "systems_near:" << sortedSystems.size() << "systems within" << radius << "LY from"
+             << boxRows << "rows in the box" << (waypoint.isEmpty() ? QString() : "around waypoint " + waypoint);
+    
+    if (!waypoint.isEmpty()) {
+        m_systemsNearQueries.remove(waypoint);
+        emit systemsNearPrefetched(waypoint, sortedSystems);
+        return;
+    }
+    
+    // Start the next query from the box that just held the farthest system kept, so a
+    // sparse region doesn't leave every later query in a dense one oversized
+    const double needed = sortedSystems.isEmpty() ? radius : sortedSystems.last().distance * 1.25;
+    m_systemsNearRadius = qBound(SYSTEMS_NEAR_INITIAL_RADIUS, needed, radius);
+    
+    m_cachedNearestSystems = sortedSystems;
+    emit nearestSystemsReceived(sortedSystems);
+}
+
+void SupabaseClient::onGetTakenSystemSpecific(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response)
+{
+    QString systemName = context.systemName;
+    QString commanderName = context.commanderName;
+    QJsonArray takenData = response.value("data").toArray();
+    
+    qDebug() << "Got taken_system_specific response for" << systemName << "commander" << commanderName;
+    qDebug() << "Response data:" << QJsonDocument(takenData).toJson(QJsonDocument::Compact);
+    
+    // Emit this as a single-item array for compatibility with existing handler
+    emit takenSystemsReceived(takenData);
+}
+
+void SupabaseClient::onGetCurrentCommanderTaken(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response)
+{
+    QJsonArray taken = response.value("data").toArray();
+    qDebug() << "Emitting takenSystemsReceived with" << taken.size() << "items (current commander only)";
+    emit takenSystemsReceived(taken);
+}
+
+void SupabaseClient::onGetCategoriesSystems(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response)
+{
+    handleListResponse(context.tag, response.value("data").toArray());
+}
+
+void SupabaseClient::onGetCategoriesRichard(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response)
+{
+    handleListResponse(context.tag, response.value("data").toArray());
+}
+
+void SupabaseClient::onGetPresetImages(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response)
+{
+    handleListResponse(context.tag, response.value("data").toArray());
+}
+
+void SupabaseClient::onGetSystemInformationPrimary(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response)
+{
+    QString systemName = context.systemName;
+    QString fallbackCategory = context.fallbackCategory;
+    QJsonArray systemInfoArray = response.value("data").toArray();
+    
+    qDebug() << "Got system_information_primary response for" << systemName;
+    
+    // Check if we got data and if system_info field is not empty
+    bool hasCustomInfo = false;
+    QJsonObject customInfo;
+    
+    if (!systemInfoArray.isEmpty()) {
+        customInfo = systemInfoArray.first().toObject();
+        QString systemInfo = customInfo.value("system_info").toString();
         
-        if (!categoryDataArray.isEmpty()) {
-            QJsonObject rawCategoryData = categoryDataArray.first().toObject();
-            
-            // Use the new formatCategoryTableData method to create readable text
-            QString formattedText = formatCategoryTableData(rawCategoryData, category);
-            
-            formattedSystemInfo["hasInformation"] = true;
-            formattedSystemInfo["system_info"] = formattedText;
-            formattedSystemInfo["category"] = category;
-            formattedSystemInfo["system"] = systemName;
-            formattedSystemInfo["raw_data"] = rawCategoryData;
-            
-            qDebug() << "Formatted category data into readable system information";
-        } else {
-            // No data found in category table either
-            formattedSystemInfo["hasInformation"] = false;
-            formattedSystemInfo["system_info"] = "No additional system information available";
-            formattedSystemInfo["category"] = category;
-            formattedSystemInfo["system"] = systemName;
-            
-            qDebug() << "No data found in category table for" << systemName;
+        // Check if system_info field exists and is not empty
+        if (!systemInfo.isEmpty() && systemInfo.trimmed() != "") {
+            hasCustomInfo = true;
+            qDebug() << "Found custom system information:" << systemInfo.left(100) + "...";
         }
+    }
+    
+    if (hasCustomInfo) {
+        // Use the custom system information
+        customInfo["hasInformation"] = true;
+        emit systemInformationReceived(systemName, customInfo);
+    } else {
+        // Fall back to category table data
+        qDebug() << "No custom system_info found, falling back to category table:" << fallbackCategory;
+        getSystemInformationFromCategory(systemName, fallbackCategory);
+    }
+}
+
+void SupabaseClient::onGetSystemInformationCategory(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response)
+{
+    QString systemName = context.systemName;
+    QString category = context.category;
+    QJsonArray categoryDataArray = response.value("data").toArray();
+    
+    qDebug() << "Got system_information_category response for" << systemName << "category:" << category;
+    
+    QJsonObject formattedSystemInfo;
+    
+    if (!categoryDataArray.isEmpty()) {
+        QJsonObject rawCategoryData = categoryDataArray.first().toObject();
         
-        emit systemInformationReceived(systemName, formattedSystemInfo);
-        
-    } else if (operation.startsWith("GET:system_information_db")) {
-        QString systemName = reply->property("systemName").toString();
-        QJsonArray systemInfoArray = response.value("data").toArray();
-        
-        qDebug() << "Got system_information_db response for" << systemName;
-        qDebug() << "Response data:" << QJsonDocument(systemInfoArray).toJson(QJsonDocument::Compact);
-        
-        QJsonObject formattedSystemInfo;
-        if (!systemInfoArray.isEmpty()) {
-            QJsonObject rawData = systemInfoArray.first().toObject();
-            formattedSystemInfo = rawData;  // Use raw data directly
-            formattedSystemInfo["hasInformation"] = true;
-            qDebug() << "Found system_information data:" << QJsonDocument(rawData).toJson(QJsonDocument::Compact);
-        } else {
-            formattedSystemInfo["hasInformation"] = false;
-            qDebug() << "No system_information data found for" << systemName;
-        }
+        // Use the new formatCategoryTableData method to create readable text
+        QString formattedText = formatCategoryTableData(rawCategoryData, category);
         
-        emit systemInformationReceived(systemName, formattedSystemInfo);
+        formattedSystemInfo["hasInformation"] = true;
+        formattedSystemInfo["system_info"] = formattedText;
+        formattedSystemInfo["category"] = category;
+        formattedSystemInfo["system"] = systemName;
+        formattedSystemInfo["raw_data"] = rawCategoryData;
         
-    } else if (operation.startsWith("GET:system_details")) {
-        QString systemName = reply->property("systemName").toString();
-        QString category = reply->property("category").toString();
+        qDebug() << "Formatted category data into readable system information";
+    } else {
+        // No data found in category table either
+        formattedSystemInfo["hasInformation"] = false;
+        formattedSystemInfo["system_info"] = "No additional system information available";
+        formattedSystemInfo["category"] = category;
+        formattedSystemInfo["system"] = systemName;
         
-        QJsonArray systemDetailsArray = response.value("data").toArray();
-        QJsonObject systemDetails;
+        qDebug() << "No data found in category table for" << systemName;
+    }
+    
+    emit systemInformationReceived(systemName, formattedSystemInfo);
+}
+
+void SupabaseClient::onGetSystemInformationDb(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response)
+{
+    QString systemName = context.systemName;
+    QJsonArray systemInfoArray = response.value("data").toArray();
+    
+    qDebug() << "Got system_information_db response for" << systemName;
+    qDebug() << "Response data:" << QJsonDocument(systemInfoArray).toJson(QJsonDocument::Compact);
+    
+    QJsonObject formattedSystemInfo;
+    if (!systemInfoArray.isEmpty()) {
+        QJsonObject rawData = systemInfoArray.first().toObject();
+        formattedSystemInfo = rawData;  // Use raw data directly
+        formattedSystemInfo["hasInformation"] = true;
+        qDebug() << "Found system_information data:" << QJsonDocument(rawData).toJson(QJsonDocument::Compact);
+    } else {
+        formattedSystemInfo["hasInformation"] = false;
+        qDebug() << "No system_information data found for" << systemName;
+    }
+    
+    emit systemInformationReceived(systemName, formattedSystemInfo);
+}
+
+void SupabaseClient::onGetSystemDetails(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response)
+{
+    QString systemName = context.systemName;
+    QString category = context.category;
+    
+    QJsonArray systemDetailsArray = response.value("data").toArray();
+    QJsonObject systemDetails;
+    
+    if (!systemDetailsArray.isEmpty()) {
+        systemDetails = systemDetailsArray.first().toObject();
+        qDebug() << "System details retrieved for" << systemName << "in category" << category;
+    } else {
+        qDebug() << "No system details found for" << systemName << "in category" << category;
+    }
+    
+    // Emit as system information for now (same signal interface)
+    emit systemInformationReceived(systemName, systemDetails);
+}
+
+void SupabaseClient::onGetSystemCategoryLookup(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response)
+{
+    QString systemName = context.systemName;
+    QJsonArray systemData = response.value("data").toArray();
+    
+    if (!systemData.isEmpty()) {
+        QJsonObject systemInfo = systemData.first().toObject();
+        QString category = systemInfo.value("category").toString();
+        double x = systemInfo.value("x").toDouble();
+        double y = systemInfo.value("y").toDouble();
+        double z = systemInfo.value("z").toDouble();
         
-        if (!systemDetailsArray.isEmpty()) {
-            systemDetails = systemDetailsArray.first().toObject();
-            qDebug() << "System details retrieved for" << systemName << "in category" << category;
-        } else {
-            qDebug() << "No system details found for" << systemName << "in category" << category;
-        }
+        qDebug() << "Found system" << systemName << "in category" << category << "at coordinates" << x << y << z;
         
-        // Emit as system information for now (same signal interface)
+        // Now query the category-specific table for detailed information
+        qDebug() << "Querying category table" << category << "for detailed system information";
+        getSystemInformation(systemName, category);
+    } else {
+        qDebug() << "No system found for" << systemName;
+        emit networkError(QString("System %1 not found in database").arg(systemName));
+    }
+}
+
+void SupabaseClient::onGetSystemDetailsRobust(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response)
+{
+    QString systemName = context.systemName;
+    QString category = context.category;
+    QString fieldName = context.fieldName;
+    
+    QJsonArray systemDetailsArray = response.value("data").toArray();
+    
+    if (!systemDetailsArray.isEmpty()) {
+        QJsonObject systemDetails = systemDetailsArray.first().toObject();
+        qDebug() << "System details retrieved for" << systemName << "using field" << fieldName;
         emit systemInformationReceived(systemName, systemDetails);
-        
-    } else if (operation.startsWith("GET:system_category_lookup")) {
-        QString systemName = reply->property("systemName").toString();
-        QJsonArray systemData = response.value("data").toArray();
-        
-        if (!systemData.isEmpty()) {
-            QJsonObject systemInfo = systemData.first().toObject();
-            QString category = systemInfo.value("category").toString();
-            double x = systemInfo.value("x").toDouble();
-            double y = systemInfo.value("y").toDouble();
-            double z = systemInfo.value("z").toDouble();
-            
-            qDebug() << "Found system" << systemName << "in category" << category << "at coordinates" << x << y << z;
-            
-            // Now query the category-specific table for detailed information
-            qDebug() << "Querying category table" << category << "for detailed system information";
-            getSystemInformation(systemName, category);
-        } else {
-            qDebug() << "No system found for" << systemName;
-            emit networkError(QString("System %1 not found in database").arg(systemName));
-        }
-        
-    } else if (operation.startsWith("GET:system_details_robust")) {
-        QString systemName = reply->property("systemName").toString();
-        QString category = reply->property("category").toString();
-        QString fieldName = reply->property("fieldName").toString();
-        
-        QJsonArray systemDetailsArray = response.value("data").toArray();
-        
-        if (!systemDetailsArray.isEmpty()) {
-            QJsonObject systemDetails = systemDetailsArray.first().toObject();
-            qDebug() << "System details retrieved for" << systemName << "using field" << fieldName;
-            emit systemInformationReceived(systemName, systemDetails);
+    } else {
+        // Try the other capitalization if this one failed
+        if (fieldName == "System") {
+            qDebug() << "Trying lowercase 'system' field for" << systemName;
+            getSystemDetailsWithFieldName(systemName, category, "system");
         } else {
-            // Try the other capitalization if this one failed
-            if (fieldName == "System") {
-                qDebug() << "Trying lowercase 'system' field for" << systemName;
-                getSystemDetailsWithFieldName(systemName, category, "system");
-            } else {
-                qDebug() << "No system details found for" << systemName << "in category" << category;
-                emit networkError(QString("System details not found for %1").arg(systemName));
-            }
-        }
-        
-    } else if (operation.startsWith("GET:admin_access")) {
-        QJsonArray adminData = response.value("data").toArray();
-        bool isAdmin = !adminData.isEmpty();
-        emit adminStatusReceived(isAdmin);
-        
-    } else if (operation.startsWith("GET:taken")) {
-        QJsonArray takenData = response.value("data").toArray();
-        qDebug() << "Received" << takenData.size() << "taken systems from Supabase";
-        emit takenSystemsReceived(takenData);
-        
-    } else if (operation.startsWith("GET:poi_data_for_merge")) {
-        QJsonArray poiData = response.value("data").toArray();
-        int systemsCount = reply->property("systemsCount").toInt();
-        QByteArray systemsJson = reply->property("systemsToMerge").toByteArray();
-        
-        qDebug() << "Received" << poiData.size() << "POI records for merging with" << systemsCount << "systems";
-        
-        // Parse the stored systems array
-        QJsonDocument systemsDoc = QJsonDocument::fromJson(systemsJson);
-        QJsonArray systemsArray = systemsDoc.array();
-        
-        // Merge POI data into the systems
-        for (int i = 0; i < systemsArray.size(); i++) {
-            QJsonObject system = systemsArray[i].toObject();
-            QString systemName = system["name"].toString();
-            
-            // Look for this system in POI data
-            for (const QJsonValue &poiValue : poiData) {
-                QJsonObject poiSystem = poiValue.toObject();
-                QString poiSystemName = poiSystem.value("system").toString();
-                
-                if (systemName == poiSystemName) {
-                    QString potentialOrPoi = poiSystem.value("potential_or_poi").toString();
-                    if (!potentialOrPoi.isEmpty()) {
-                        system["poi"] = potentialOrPoi;
-                        system["potential_or_poi"] = potentialOrPoi;
-                        systemsArray[i] = system;
-                        qDebug() << "Merged POI data for" << systemName << ":" << potentialOrPoi;
-                    }
-                    break;
-                }
-            }
+            qDebug() << "No system details found for" << systemName << "in category" << category;
+            emit networkError(QString("System details not found for %1").arg(systemName));
         }
-        
-        // Store updated POI data for future use
-        m_pendingPOIData = poiData;
-        
-        // Emit signal with the merged systems data and cache it
-        m_cachedNearestSystems = systemsArray;
-        emit poiDataForMergeReceived(systemsArray);
-        
-    } else if (operation.startsWith("GET:poi_for_systems_near")) {
-        QJsonArray poiData = response.value("data").toArray();
-        QByteArray systemsJson = reply->property("sortedSystems").toByteArray();
-        
-        qDebug() << "Received" << poiData.size() << "POI records for systems_near merge";
-        
-        // Parse the stored systems array
-        QJsonDocument systemsDoc = QJsonDocument::fromJson(systemsJson);
-        QJsonArray sortedSystems = systemsDoc.array();
-        
-        // Merge POI data into the systems
-        for (int i = 0; i < sortedSystems.size(); i++) {
-            QJsonObject system = sortedSystems[i].toObject();
-            QString systemName = system["name"].toString();
-            
-            // Look for this system in POI data
-            for (const QJsonValue &poiValue : poiData) {
-                QJsonObject poiSystem = poiValue.toObject();
-                QString poiSystemName = poiSystem.value("system").toString();
-                
-                if (systemName == poiSystemName) {
-                    QString potentialOrPoi = poiSystem.value("potential_or_poi").toString();
-                    if (!potentialOrPoi.isEmpty()) {
-                        system["poi"] = potentialOrPoi;
-                        system["potential_or_poi"] = potentialOrPoi;
-                        sortedSystems[i] = system;
-                        qDebug() << "*** MERGED POI FOR SYSTEMS_NEAR:" << systemName << "=" << potentialOrPoi << "***";
-                    }
-                    break;
-                }
-            }
+    }
+}
+
+void SupabaseClient::onGetAdminAccess(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response)
+{
+    QJsonArray adminData = response.value("data").toArray();
+    bool isAdmin = !adminData.isEmpty();
+    emit adminStatusReceived(isAdmin);
+}
+
+void SupabaseClient::mergePoiRows(const QStringList &systemNames, const QJsonArray &poiData)
+{
+    qDebug() << "Received" << poiData.size() << "POI records for merging with" << systemNames.size() << "systems";
+    
+    // First row per system wins, as before
+    QHash<QString, QString> poiBySystem;
+    for (const QJsonValue &poiValue : poiData) {
+        const QJsonObject poiSystem = poiValue.toObject();
+        const QString poiSystemName = poiSystem.value("system").toString();
+        if (!poiBySystem.contains(poiSystemName)) {
+            poiBySystem.insert(poiSystemName, poiSystem.value("potential_or_poi").toString());
         }
-        
-        qDebug() << "*** EMITTING NEAREST SYSTEMS WITH POI DATA MERGED ***";
-        m_cachedNearestSystems = sortedSystems;
-        emit nearestSystemsReceived(sortedSystems);
-        
-    } else if (operation.startsWith("GET:pois")) {
-        QJsonArray poisData = response.value("data").toArray();
-        qDebug() << "Received" << poisData.size() << "POI systems from Supabase";
-        
-        // Store POI data for future merge operations
-        m_pendingPOIData = poisData;
-        qDebug() << "Stored" << poisData.size() << "POI records in cache for merging";
-        
-        emit poisReceived(poisData);
-        
-    } else if (operation.startsWith("RPC:claim_system")) {
-        QString systemName = reply->property("systemName").toString();
-        QString commander = reply->property("commander").toString();
-        
-        QJsonObject result = response;
-        bool success = result["success"].toBool();
-        QString message = result["message"].toString();
-        QString errorMsg = result["error"].toString();
-        
-        if (success) {
-            qDebug() << "System claimed successfully:" << systemName;
-            emit systemClaimed(systemName, true);
-            
-            // Refresh data to show the new claim
-            getTakenSystems();
-        } else {
-            qDebug() << "Failed to claim system:" << errorMsg;
-            emit systemClaimed(systemName, false);
-            emit networkError(errorMsg);
+    }
+    
+    // Merge POI data into the systems
+    QJsonArray systemsArray;
+    for (const QString &systemName : systemNames) {
+        QJsonObject system;
+        system["name"] = systemName;
+        const QString potentialOrPoi = poiBySystem.value(systemName);
+        if (!potentialOrPoi.isEmpty()) {
+            system["poi"] = potentialOrPoi;
+            system["potential_or_poi"] = potentialOrPoi;
+            qDebug() << "Merged POI data for" << systemName << ":" << potentialOrPoi;
         }
-        
-    } else if (operation.startsWith("RPC:release_claim")) {
-        QString systemName = reply->property("systemName").toString();
-        
-        QJsonObject result = response;
-        bool success = result["success"].toBool();
-        QString message = result["message"].toString();
-        QString errorMsg = result["error"].toString();
-        
-        if (success) {
-            qDebug() << "Claim released successfully";
-            emit systemUnclaimed(systemName, true);
-            
-            // Refresh data to show the claim is gone
-            getTakenSystems();
-        } else {
-            qDebug() << "Failed to release claim:" << errorMsg;
-            emit systemUnclaimed(systemName, false);
-            emit networkError(errorMsg);
+        systemsArray.append(system);
+    }
+    for (SystemRecord &system : m_cachedNearestSystems) {
+        auto it = poiBySystem.constFind(system.name);
+        if (it != poiBySystem.constEnd() && !it.value().isEmpty()) {
+            system.poi = it.value();
         }
-        
-    } else if (operation.startsWith("POST:taken")) {
-        QString systemName = reply->property("systemName").toString();
-        QString commander = reply->property("commander").toString();
-        qDebug() << "System" << systemName << "successfully claimed by" << commander;
+    }
+    
+    // Store updated POI data for future use
+    m_pendingPOIData = poiData;
+    
+    emit poiDataForMergeReceived(systemsArray);
+}
+
+void SupabaseClient::onGetPois(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response)
+{
+    handleListResponse(context.tag, response.value("data").toArray());
+}
+
+void SupabaseClient::onRpcClaimSystem(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response)
+{
+    QString systemName = context.systemName;
+    QString commander = context.commander;
+    
+    QJsonObject result = response;
+    bool success = result["success"].toBool();
+    QString message = result["message"].toString();
+    QString errorMsg = result["error"].toString();
+    
+    if (success) {
+        qDebug() << "System claimed successfully:" << systemName;
         emit systemClaimed(systemName, true);
-        // Ensure all clients get fresh claim data immediately
-        QTimer::singleShot(0, this, [this]() { getTakenSystems(); });
         
-    } else if (operation.startsWith("DELETE:taken")) {
-        QString systemName = reply->property("systemName").toString();
-        qDebug() << "System" << systemName << "successfully unclaimed";
+        // Refresh data to show the new claim
+        getTakenSystems();
+    } else {
+        qDebug() << "Failed to claim system:" << errorMsg;
+        emit systemClaimed(systemName, false);
+        emit networkError(errorMsg);
+    }
+}
+
+void SupabaseClient::onRpcReleaseClaim(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response)
+{
+    QString systemName = context.systemName;
+    
+    QJsonObject result = response;
+    bool success = result["success"].toBool();
+    QString message = result["message"].toString();
+    QString errorMsg = result["error"].toString();
+    
+    if (success) {
+        qDebug() << "Claim released successfully";
         emit systemUnclaimed(systemName, true);
-        // Ensure all clients get fresh claim data immediately
-        QTimer::singleShot(0, this, [this]() { getTakenSystems(); });
-        
-    } else if (operation.startsWith("UPSERT:system_information_poi_set")) {
-        QString systemName = reply->property("systemName").toString();
-        QString poiType = reply->property("poiType").toString();
-        qDebug() << "system_information updated for" << systemName << "poi=" << poiType;
-        emit requestCompleted("markSystemAsPOI", true, QString("System marked as %1").arg(poiType));
-        // Proactively refresh POI merge after marking
-        if (!m_cachedNearestSystems.isEmpty()) {
-            QJsonArray systemsArray = m_cachedNearestSystems; // copy
-            fetchAndMergePOIData(systemsArray);
-        }
-        // Force a direct POI query for the single system to remove any cache ambiguity
-        QJsonArray single;
-        QJsonObject obj; obj["name"] = systemName; single.append(obj);
-        fetchAndMergePOIData(single);
-        
-    } else if (operation.startsWith("UPDATE:system_information_poi_clear")) {
-        QString systemName = reply->property("systemName").toString();
-        qDebug() << "POI field cleared in system_information for" << systemName;
-        // Trigger POI re-merge to drop badge quickly
-        if (!m_cachedNearestSystems.isEmpty()) {
-            QJsonArray systemsArray = m_cachedNearestSystems; // copy
-            fetchAndMergePOIData(systemsArray);
-        }
-        QJsonArray single;
-        QJsonObject obj; obj["name"] = systemName; single.append(obj);
-        fetchAndMergePOIData(single);
-
-    } else if (operation.startsWith("DELETE:pois")) {
-        QString systemName = reply->property("systemName").toString();
-        qDebug() << "POI status removed from system" << systemName;
-        emit requestCompleted("removePOIStatus", true, "POI status removed");
-        
-    } else if (operation.startsWith("GET:all_commanders")) {
-        QJsonArray commanderData = response.value("data").toArray();
-        qDebug() << "Received" << commanderData.size() << "commander locations from Supabase";
-        emit allCommanderLocationsReceived(commanderData);
-        
-    } else if (operation.startsWith("PATCH:commander_location")) {
-        QString commanderName = operation.split(":").last();
-        qDebug() << "Commander location successfully updated for" << commanderName;
-        emit commanderLocationUpdated(commanderName, true);
-        
-    } else if (operation.startsWith("UPDATE:system_visited")) {
-        QString systemName = reply->property("systemName").toString();
-        bool visited = reply->property("visited").toBool();
-        
-        // Debug the actual response from database
-        QJsonArray responseData = response.value("data").toArray();
-        int httpStatus = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
-        
-        qDebug() << "=== VISITED UPDATE RESPONSE DEBUG ===";
-        qDebug() << "HTTP Status:" << httpStatus;
-        qDebug() << "Response data size:" << responseData.size();
-        qDebug() << "Response data:" << QJsonDocument(responseData).toJson(QJsonDocument::Compact);
-        qDebug() << "Full response:" << QJsonDocument(response).toJson(QJsonDocument::Compact);
-        qDebug() << "Request was for system:" << systemName << "visited:" << visited;
-        
-        // FIXED: Check if update was successful based on HTTP status and response
-        bool updateSuccess = (httpStatus == 200 || httpStatus == 204) && reply->error() == QNetworkReply::NoError;
-        qDebug() << "Update success determined as:" << updateSuccess;
-        qDebug() << "=== END VISITED UPDATE RESPONSE DEBUG ===";
-        
-        if (updateSuccess) {
-            qDebug() << "System visited status updated successfully for" << systemName << "to" << visited;
-            emit systemStatusUpdated(systemName, true);
-            
-            // Refresh taken systems data to update UI
-            QTimer::singleShot(500, this, [this]() {
-                getTakenSystems();
-            });
-        } else {
-            qDebug() << "System visited status update failed for" << systemName;
-            emit systemStatusUpdated(systemName, false);
-        }
-        
-    } else if (operation.startsWith("UPDATE:system_done")) {
-        QString systemName = reply->property("systemName").toString();
-        bool done = reply->property("done").toBool();
-        
-        // Check success similar to visited update
-        int httpStatus = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
-        bool updateSuccess = (httpStatus == 200 || httpStatus == 204) && reply->error() == QNetworkReply::NoError;
-        
-        if (updateSuccess) {
-            qDebug() << "System done status updated successfully for" << systemName << "to" << done;
-            emit systemStatusUpdated(systemName, true);
-            
-            // Refresh taken systems data to update UI
-            QTimer::singleShot(500, this, [this]() {
-                getTakenSystems();
-            });
-        } else {
-            qDebug() << "System done status update failed for" << systemName;
-            emit systemStatusUpdated(systemName, false);
-        }
-        
-    } else if (operation.startsWith("UPDATE:system_edited")) {
-        QString systemName = reply->property("systemName").toString();
-        
-        // Check success
-        int httpStatus = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
-        bool updateSuccess = (httpStatus == 200 || httpStatus == 204) && reply->error() == QNetworkReply::NoError;
-        
-        if (updateSuccess) {
-            qDebug() << "System marked as edited successfully for" << systemName;
-            
-            // Refresh taken systems data to update UI with edited flag
-            QTimer::singleShot(300, this, [this]() {
-                getTakenSystems();
-            });
-        } else {
-            qDebug() << "Failed to mark system as edited for" << systemName;
-        }
-        
-    } else if (operation.startsWith("TEST:admin_access")) {
-        qDebug() << "Admin access test successful - user has admin privileges";
-        emit adminAccessTestComplete(true);
-        
-    } else if (operation.startsWith("GET:webhook_config")) {
-        QJsonArray configData = response.value("data").toArray();
-        if (!configData.isEmpty()) {
-            QString webhookUrl = configData[0].toObject().value("config_value").toString();
-            m_webhookUrl = webhookUrl;
-            m_webhookConfigLoaded = true;
-            qDebug() << "Webhook configuration loaded successfully";
-            emit webhookConfigReceived(webhookUrl);
-        } else {
-            qWarning() << "No webhook configuration found in app_config table";
-            emit webhookConfigReceived("");
-        }
-        
-    } else if (operation.startsWith("POST:webhook:")) {
-        QString eventType = operation.split(":").last();
-        qDebug() << "Webhook successfully sent for event:" << eventType;
-        emit webhookTriggered(true, eventType);
         
-    } else if (operation.startsWith("CHECK:system_info_exists")) {
-        QString systemName = reply->property("systemName").toString();
-        QVariantMap information = reply->property("information").toMap();
-        QJsonArray existingData = response.value("data").toArray();
-        
-        // Map QML field names to database column names
-        QJsonObject data;
-        data["system"] = systemName;  // Required field
-        data["system_info"] = information.value("system_info", "").toString();  // FIXED: correct field name
-        data["description"] = information.value("description", "").toString(); 
-        data["name"] = information.value("name", "").toString();
-        data["images"] = information.value("images", "").toString();
-        
-        // *** CRITICAL FIX: Add the missing POI fields ***
-        data["discoverer"] = information.value("discoverer", "").toString();
-        data["submitter"] = information.value("submitter", "").toString();
-        data["potential_or_poi"] = information.value("potential_or_poi", "").toString();
-        
-        qDebug() << "=== HELLO my name is burger - DATABASE OPERATION ===";
-        qDebug() << "About to save data:" << data;
-        qDebug() << "Operation type:" << (existingData.isEmpty() ? "INSERT" : "UPDATE");
-        qDebug() << "=== END HELLO my name is burger - DATABASE OPERATION ===";
-        
-        QNetworkRequest dataRequest;
-        QNetworkReply *dataReply = nullptr;
-        
-        if (existingData.isEmpty()) {
-            // Record doesn't exist - INSERT
-            qDebug() << "System_information record doesn't exist for" << systemName << "- inserting new record";
-            dataRequest = createRequest("system_information");
-            
-            QJsonDocument doc(data);
-            dataReply = m_networkManager->post(dataRequest, doc.toJson());
-            
-            if (dataReply) {
-                dataReply->setProperty("operation", "INSERT:system_information");
-                dataReply->setProperty("systemName", systemName);
-            }
-        } else {
-            // Record exists - UPDATE
-            qDebug() << "System_information record exists for" << systemName << "- updating existing record";
-            QString updateEndpoint = QString("system_information?system=eq.%1")
-                                    .arg(QUrl::toPercentEncoding(systemName));
-            dataRequest = createRequest(updateEndpoint);
-            
-            // Remove the system field from update data (can't update primary key)
-            data.remove("system");
-            
-            QJsonDocument doc(data);
-            dataReply = m_networkManager->sendCustomRequest(dataRequest, "PATCH", doc.toJson());
-            
-            if (dataReply) {
-                dataReply->setProperty("operation", "UPDATE:system_information");
-                dataReply->setProperty("systemName", systemName);
-            }
-        }
-        
-        // Add commander headers for RLS policies
-        if (dataReply && !m_currentCommander.isEmpty() && m_currentCommander != "Unknown") {
-            dataRequest.setRawHeader("X-Commander", m_currentCommander.toUtf8());
-            dataRequest.setRawHeader("x-commander-name", m_currentCommander.toUtf8());
-        }
-        
-    } else if (operation.startsWith("INSERT:system_information") || operation.startsWith("UPDATE:system_information")) {
-        QString systemName = reply->property("systemName").toString();
-        QString operationType = operation.startsWith("INSERT") ? "created" : "updated";
-        
-        qDebug() << "=== HELLO my name is burger - DATABASE SUCCESS ===";
-        qDebug() << "System information" << operationType << "successfully for" << systemName;
-        qDebug() << "=== END HELLO my name is burger - DATABASE SUCCESS ===";
+        // Refresh data to show the claim is gone
+        getTakenSystems();
+    } else {
+        qDebug() << "Failed to release claim:" << errorMsg;
+        emit systemUnclaimed(systemName, false);
+        emit networkError(errorMsg);
+    }
+}
+
+void SupabaseClient::onPostTaken(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response)
+{
+    QString systemName = context.systemName;
+    QString commander = context.commander;
+    qDebug() << "System" << systemName << "successfully claimed by" << commander;
+    applyTakenWrite(response.value("data").toArray());
+    emit systemClaimed(systemName, true);
+    // Ensure all clients get fresh claim data immediately
+    QTimer::singleShot(0, this, [this]() { getTakenSystems(); });
+}
+
+void SupabaseClient::onDeleteTaken(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response)
+{
+    QString systemName = context.systemName;
+    qDebug() << "System" << systemName << "successfully unclaimed";
+    emit systemUnclaimed(systemName, true);
+    // Ensure all clients get fresh claim data immediately
+    QTimer::singleShot(0, this, [this]() { getTakenSystems(); });
+}
+
+void SupabaseClient::onUpsertSystemInformationPoiSet(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response)
+{
+    QString systemName = context.systemName;
+    QString poiType = context.poiType;
+    qDebug() << "system_information updated for" << systemName << "poi=" << poiType;
+    emit requestCompleted("markSystemAsPOI", true, QString("System marked as %1").arg(poiType));
+    // Proactively refresh POI merge after marking
+    if (!m_cachedNearestSystems.isEmpty()) {
+        fetchAndMergePOIData(cachedNearestSystemNames());
+    }
+    // Force a direct POI query for the single system to remove any cache ambiguity
+    fetchAndMergePOIData({systemName});
+}
+
+void SupabaseClient::onUpdateSystemInformationPoiClear(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response)
+{
+    QString systemName = context.systemName;
+    qDebug() << "POI field cleared in system_information for" << systemName;
+    // Trigger POI re-merge to drop badge quickly
+    if (!m_cachedNearestSystems.isEmpty()) {
+        fetchAndMergePOIData(cachedNearestSystemNames());
+    }
+    fetchAndMergePOIData({systemName});
+}
+
+void SupabaseClient::onDeletePois(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response)
+{
+    QString systemName = context.systemName;
+    qDebug() << "POI status removed from system" << systemName;
+    emit requestCompleted("removePOIStatus", true, "POI status removed");
+}
+
+void SupabaseClient::onGetAllCommanders(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response)
+{
+    QJsonArray commanderData = response.value("data").toArray();
+    qDebug() << "Received" << commanderData.size() << "commander locations from Supabase";
+    emit allCommanderLocationsReceived(commanderData);
+}
+
+void SupabaseClient::onPatchCommanderLocation(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response)
+{
+    QString commanderName = context.tag.section(':', -1);
+    qDebug() << "Commander location successfully updated for" << commanderName;
+    emit commanderLocationUpdated(commanderName, true);
+}
+
+void SupabaseClient::onPatchTakenBatch(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response)
+{
+    int httpStatus = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    bool updateSuccess = (httpStatus == 200 || httpStatus == 204) && reply->error() == QNetworkReply::NoError;
+    
+    qDebug() << "Taken batch update for" << context.systemNames.size() << "systems success:" << updateSuccess;
+    if (updateSuccess) {
+        const QJsonArray rows = response.value("data").toArray();
+        applyTakenWrite(!rows.isEmpty() ? rows : localTakenRowsWith(context.systemNames, context.fields));
+    }
+    for (const QString &systemName : context.systemNames) {
+        emit systemStatusUpdated(systemName, updateSuccess);
+    }
+    
+    // Refresh taken systems data to update UI
+    QTimer::singleShot(500, this, [this]() {
+        getTakenSystems();
+    });
+}
+
+void SupabaseClient::onTestAdminAccess(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response)
+{
+    qDebug() << "Admin access test successful - user has admin privileges";
+    emit adminAccessTestComplete(true);
+}
+
+void SupabaseClient::onGetWebhookConfig(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response)
+{
+    QJsonArray configData = response.value("data").toArray();
+    if (!configData.isEmpty()) {
+        QString webhookUrl = configData[0].toObject().value("config_value").toString();
+        m_webhookUrl = webhookUrl;
+        m_webhookConfigLoaded = true;
+        qDebug() << "Webhook configuration loaded successfully";
+        emit webhookConfigReceived(webhookUrl);
+    } else {
+        qWarning() << "No webhook configuration found in app_config table";
+        emit webhookConfigReceived("");
+    }
+}
+
+void SupabaseClient::onPostWebhook(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response)
+{
+    QString eventType = context.tag.section(':', -1);
+    qDebug() << "Webhook successfully sent for event:" << eventType;
+    emit webhookTriggered(true, eventType);
+}
+
+void SupabaseClient::onCheckSystemInfoExists(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response)
+{
+    QString systemName = context.systemName;
+    QVariantMap information = context.information;
+    QJsonArray existingData = response.value("data").toArray();
+    
+    // Map QML field names to database column names
+    QJsonObject data;
+    data["system"] = systemName;  // Required field
+    data["system_info"] = information.value("system_info", "").toString();  // FIXED: correct field name
+    data["description"] = information.value("description", "").toString(); 
+    data["name"] = information.value("name", "").toString();
+    data["images"] = information.value("images", "").toString();
+    
+    // *** CRITICAL FIX: Add the missing POI fields ***
+    data["discoverer"] = information.value("discoverer", "").toString();
+    data["submitter"] = information.value("submitter", "").toString();
+    data["potential_or_poi"] = information.value("potential_or_poi", "").toString();
+    
+    qDebug() << "=== HELLO my name is burger - DATABASE OPERATION ===";
+    qDebug() << "About to save data:" << data;
+    qDebug() << "Operation type:" << (existingData.isEmpty() ? "INSERT" : "UPDATE");
+    qDebug() << "=== END HELLO my name is burger - DATABASE OPERATION ===";
+    
+    QNetworkRequest dataRequest;
+    QNetworkReply *dataReply = nullptr;
+    
+    if (existingData.isEmpty()) {
+        // Record doesn't exist - INSERT
+        qDebug() << "System_information record doesn't exist for" << systemName << "- inserting new record";
+        dataRequest = createRequest("system_information");
         
-        emit requestCompleted("saveSystemInformation", true, QString("System information %1").arg(operationType));
+        QJsonDocument doc(data);
+        dataReply = m_networkManager->post(dataRequest, doc.toJson());
         
-        // If potential_or_poi changed via save, immediately re-merge POI data so badges update without restart
-        if (!m_cachedNearestSystems.isEmpty()) {
-            QJsonArray systemsArray = m_cachedNearestSystems; // copy
-            fetchAndMergePOIData(systemsArray);
+        if (dataReply) {
+            trackRequest(dataReply, SupabaseOperation::InsertSystemInformation);
+            requestContext(dataReply).systemName = systemName;
         }
-        QJsonArray single;
-        QJsonObject obj; obj["name"] = systemName; single.append(obj);
-        fetchAndMergePOIData(single);
-        
-    } else if (operation.startsWith("SET:commander_context")) {
-        qDebug() << "Commander context set successfully";
-        emit requestCompleted("setCommanderContext", true, "Commander context updated");
-        
-    } else if (operation.startsWith("IMGBB:upload")) {
-        QString systemName = reply->property("systemName").toString();
-        QString filePath = reply->property("filePath").toString();
-        
-        qDebug() << "=== IMGBB RESPONSE DEBUG START ===";
-        qDebug() << "System:" << systemName;
-        qDebug() << "File:" << filePath;
+    } else {
+        // Record exists - UPDATE
+        qDebug() << "System_information record exists for" << systemName << "- updating existing record";
+        QString updateEndpoint = QString("system_information?system=eq.%1")
+                                .arg(QUrl::toPercentEncoding(systemName));
+        dataRequest = createRequest(updateEndpoint);
         
-        // Get all response details
-        int httpStatus = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
-        QNetworkReply::NetworkError networkError = reply->error();
-        QString errorString = reply->errorString();
-        QByteArray responseBody = reply->readAll();
+        // Remove the system field from update data (can't update primary key)
+        data.remove("system");
         
-        qDebug() << "HTTP Status Code:" << httpStatus;
-        qDebug() << "Network Error:" << networkError;
-        qDebug() << "Error String:" << errorString;
-        qDebug() << "Response Body Length:" << responseBody.length();
-        qDebug() << "Response Body Content:" << responseBody;
+        QJsonDocument doc(data);
+        dataReply = m_networkManager->sendCustomRequest(dataRequest, "PATCH", doc.toJson());
         
-        // Log all response headers
-        qDebug() << "Response Headers:";
-        const QList<QNetworkReply::RawHeaderPair> headers = reply->rawHeaderPairs();
-        for (const QNetworkReply::RawHeaderPair &header : headers) {
-            qDebug() << "  " << header.first << ":" << header.second;
+        if (dataReply) {
+            trackRequest(dataReply, SupabaseOperation::UpdateSystemInformation);
+            requestContext(dataReply).systemName = systemName;
         }
+    }
+    
+    // Add commander headers for RLS policies
+    if (dataReply && !m_currentCommander.isEmpty() && m_currentCommander != "Unknown") {
+        dataRequest.setRawHeader("X-Commander", m_currentCommander.toUtf8());
+        dataRequest.setRawHeader("x-commander-name", m_currentCommander.toUtf8());
+    }
+}
+
+void SupabaseClient::onSystemInformationSaved(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response)
+{
+    QString systemName = context.systemName;
+    QString operationType = context.operation == SupabaseOperation::InsertSystemInformation ? "created" : "updated";
+    
+    qDebug() << "=== HELLO my name is burger - DATABASE SUCCESS ===";
+    qDebug() << "System information" << operationType << "successfully for" << systemName;
+    qDebug() << "=== END HELLO my name is burger - DATABASE SUCCESS ===";
+    
+    emit requestCompleted("saveSystemInformation", true, QString("System information %1").arg(operationType));
+    
+    // If potential_or_poi changed via save, immediately re-merge POI data so badges update without restart
+    if (!m_cachedNearestSystems.isEmpty()) {
+        fetchAndMergePOIData(cachedNearestSystemNames());
+    }
+    fetchAndMergePOIData({systemName});
+}
+
+void SupabaseClient::onSetCommanderContext(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response)
+{
+    qDebug() << "Commander context set successfully";
+    emit requestCompleted("setCommanderContext", true, "Commander context updated");
+}
+
+void SupabaseClient::onImgbbUpload(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response)
+{
+    QString systemName = context.systemName;
+    QString filePath = context.filePath;
+    
+    qDebug() << "=== IMGBB RESPONSE DEBUG START ===";
+    qDebug() << "System:" << systemName;
+    qDebug() << "File:" << filePath;
+    
+    // Get all response details
+    int httpStatus = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    QNetworkReply::NetworkError networkError = reply->error();
+    QString errorString = reply->errorString();
+    QByteArray responseBody = reply->readAll();
+    
+    qDebug() << "HTTP Status Code:" << httpStatus;
+    qDebug() << "Network Error:" << networkError;
+    qDebug() << "Error String:" << errorString;
+    qDebug() << "Response Body Length:" << responseBody.length();
+    qDebug() << "Response Body Content:" << responseBody;
+    
+    // Log all response headers
+    qDebug() << "Response Headers:";
+    const QList<QNetworkReply::RawHeaderPair> headers = reply->rawHeaderPairs();
+    for (const QNetworkReply::RawHeaderPair &header : headers) {
+        qDebug() << "  " << header.first << ":" << header.second;
+    }
+    
+    if (networkError == QNetworkReply::NoError) {
+        // Try to parse the response
+        QJsonParseError parseError;
+        QJsonDocument doc = QJsonDocument::fromJson(responseBody, &parseError);
         
-        if (success && networkError == QNetworkReply::NoError) {
-            // Try to parse the response
-            QJsonParseError parseError;
-            QJsonDocument doc = QJsonDocument::fromJson(responseBody, &parseError);
+        if (parseError.error != QJsonParseError::NoError) {
+            qDebug() << "JSON Parse Error:" << parseError.errorString();
+            qDebug() << "Raw response:" << responseBody;
+            emit requestCompleted("uploadImageToImgbb", false, "Invalid JSON response from imgbb");
+        } else {
+            QJsonObject jsonResponse = doc.object();
+            qDebug() << "Parsed JSON response:" << doc.toJson(QJsonDocument::Compact);
             
-            if (parseError.error != QJsonParseError::NoError) {
-                qDebug() << "JSON Parse Error:" << parseError.errorString();
-                qDebug() << "Raw response:" << responseBody;
-                emit requestCompleted("uploadImageToImgbb", false, "Invalid JSON response from imgbb");
+            // Check if imgbb returned success
+            bool imgbbSuccess = jsonResponse.value("success").toBool();
+            if (!imgbbSuccess) {
+                QJsonObject error = jsonResponse.value("error").toObject();
+                QString errorMsg = error.value("message").toString("Unknown imgbb error");
+                qDebug() << "ImgBB returned success=false:" << errorMsg;
+                emit requestCompleted("uploadImageToImgbb", false, QString("ImgBB Error: %1").arg(errorMsg));
             } else {
-                QJsonObject jsonResponse = doc.object();
-                qDebug() << "Parsed JSON response:" << doc.toJson(QJsonDocument::Compact);
+                // Success! Extract image URLs
+                QJsonObject data = jsonResponse.value("data").toObject();
+                QString imageUrl = data.value("url").toString();
+                QString displayUrl = data.value("display_url").toString();
+                QString viewUrl = data.value("url_viewer").toString();
                 
-                // Check if imgbb returned success
-                bool imgbbSuccess = jsonResponse.value("success").toBool();
-                if (!imgbbSuccess) {
-                    QJsonObject error = jsonResponse.value("error").toObject();
-                    QString errorMsg = error.value("message").toString("Unknown imgbb error");
-                    qDebug() << "ImgBB returned success=false:" << errorMsg;
-                    emit requestCompleted("uploadImageToImgbb", false, QString("ImgBB Error: %1").arg(errorMsg));
-                } else {
-                    // Success! Extract image URLs
-                    QJsonObject data = jsonResponse.value("data").toObject();
-                    QString imageUrl = data.value("url").toString();
-                    QString displayUrl = data.value("display_url").toString();
-                    QString viewUrl = data.value("url_viewer").toString();
+                QString finalUrl = displayUrl.isEmpty() ? imageUrl : displayUrl;
+                
+                if (!finalUrl.isEmpty()) {
+                    qDebug() << "SUCCESS! Image uploaded to:" << finalUrl;
                     
-                    QString finalUrl = displayUrl.isEmpty() ? imageUrl : displayUrl;
+                    // Store as user override for this system
+                    m_systemImageOverrides[systemName] = finalUrl;
                     
-                    if (!finalUrl.isEmpty()) {
-                        qDebug() << "SUCCESS! Image uploaded to:" << finalUrl;
-                        
-                        // Store as user override for this system
-                        m_systemImageOverrides[systemName] = finalUrl;
-                        
-                        // SAVE TO DATABASE: Update system_information table
-                        saveImageToDatabase(systemName, finalUrl);
-                        
-                        emit requestCompleted("uploadImageToImgbb", true, QString("Image uploaded: %1").arg(finalUrl));
-                        emit systemImageSet(systemName, finalUrl, true);
-                    } else {
-                        qDebug() << "No usable image URL in successful response";
-                        emit requestCompleted("uploadImageToImgbb", false, "No image URL in response");
-                    }
-                }
-            }
-        } else {
-            // Upload failed - provide detailed error
-            QString detailedError = QString("Upload failed - HTTP %1: %2").arg(httpStatus).arg(errorString);
-            
-            // Log raw error details
-            qDebug() << "IMGBB UPLOAD FAILED:";
-            qDebug() << "  HTTP Status:" << httpStatus;
-            qDebug() << "  Network Error Code:" << networkError;
-            qDebug() << "  Error String:" << errorString;
-            qDebug() << "  Response Body Empty:" << responseBody.isEmpty();
-            qDebug() << "  Response Body Size:" << responseBody.size();
-            if (!responseBody.isEmpty()) {
-                qDebug() << "  Response Body (first 500 chars):" << responseBody.left(500);
-            }
-            
-            if (httpStatus == 400) {
-                if (responseBody.isEmpty()) {
-                    detailedError = "HTTP 400 with empty response - likely invalid API key or malformed request";
-                } else if (responseBody.contains("API key") || responseBody.contains("api_key")) {
-                    detailedError = "Invalid API key - get a new one from https://api.imgbb.com/";
+                    // SAVE TO DATABASE: Update system_information table
+                    saveImageToDatabase(systemName, finalUrl);
+                    
+                    emit requestCompleted("uploadImageToImgbb", true, QString("Image uploaded: %1").arg(finalUrl));
+                    emit systemImageSet(systemName, finalUrl, true);
                 } else {
-                    detailedError = QString("Bad request: %1").arg(QString::fromUtf8(responseBody));
+                    qDebug() << "No usable image URL in successful response";
+                    emit requestCompleted("uploadImageToImgbb", false, "No image URL in response");
                 }
-            } else if (httpStatus == 429) {
-                detailedError = "Rate limit exceeded - try again later";
-            } else if (httpStatus == 403) {
-                detailedError = "Access forbidden - check API key permissions";
-            } else if (httpStatus == 0 && errorString.contains("server replied:")) {
-                // This is the case we're seeing - Qt couldn't parse the response
-                detailedError = "Server response could not be parsed - possible encoding issue or network proxy";
-            } else if (responseBody.isEmpty()) {
-                detailedError = QString("Empty response with HTTP %1 - possible network/DNS issue").arg(httpStatus);
             }
-            
-            qDebug() << "DETAILED ERROR:" << detailedError;
-            emit requestCompleted("uploadImageToImgbb", false, detailedError);
+        }
+    } else {
+        // Upload failed - provide detailed error
+        QString detailedError = QString("Upload failed - HTTP %1: %2").arg(httpStatus).arg(errorString);
+        
+        // Log raw error details
+        qDebug() << "IMGBB UPLOAD FAILED:";
+        qDebug() << "  HTTP Status:" << httpStatus;
+        qDebug() << "  Network Error Code:" << networkError;
+        qDebug() << "  Error String:" << errorString;
+        qDebug() << "  Response Body Empty:" << responseBody.isEmpty();
+        qDebug() << "  Response Body Size:" << responseBody.size();
+        if (!responseBody.isEmpty()) {
+            qDebug() << "  Response Body (first 500 chars):" << responseBody.left(500);
+        }
+        
+        if (httpStatus == 400) {
+            if (responseBody.isEmpty()) {
+                detailedError = "HTTP 400 with empty response - likely invalid API key or malformed request";
+            } else if (responseBody.contains("API key") || responseBody.contains("api_key")) {
+                detailedError = "Invalid API key - get a new one from https://api.imgbb.com/";
+            } else {
+                detailedError = QString("Bad request: %1").arg(QString::fromUtf8(responseBody));
+            }
+        } else if (httpStatus == 429) {
+            detailedError = "Rate limit exceeded - try again later";
+        } else if (httpStatus == 403) {
+            detailedError = "Access forbidden - check API key permissions";
+        } else if (httpStatus == 0 && errorString.contains("server replied:")) {
+            // This is the case we're seeing - Qt couldn't parse the response
+            detailedError = "Server response could not be parsed - possible encoding issue or network proxy";
+        } else if (responseBody.isEmpty()) {
+            detailedError = QString("Empty response with HTTP %1 - possible network/DNS issue").arg(httpStatus);
         }
         
-        qDebug() << "=== IMGBB RESPONSE DEBUG END ===";
+        qDebug() << "DETAILED ERROR:" << detailedError;
+        emit requestCompleted("uploadImageToImgbb", false, detailedError);
+    }
+    
+    qDebug() << "=== IMGBB RESPONSE DEBUG END ===";
+}
+
+void SupabaseClient::onGetPresetImageCategory(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response)
+{
+    QString category = context.category;
+    QJsonArray presetData = response.value("data").toArray();
+    
+    if (!presetData.isEmpty()) {
+        QJsonObject presetImage = presetData.first().toObject();
+        QString imageUrl = presetImage.value("image_url").toString();
+        QString altUrl = presetImage.value("image_link").toString(); // Fallback field name
         
-    } else if (operation.startsWith("GET:preset_image_category")) {
-        QString category = reply->property("category").toString();
-        QJsonArray presetData = response.value("data").toArray();
+        if (imageUrl.isEmpty() && !altUrl.isEmpty()) {
+            imageUrl = altUrl;
+        }
         
-        if (!presetData.isEmpty()) {
-            QJsonObject presetImage = presetData.first().toObject();
-            QString imageUrl = presetImage.value("image_url").toString();
-            QString altUrl = presetImage.value("image_link").toString(); // Fallback field name
+        if (!imageUrl.isEmpty()) {
+            // Cache the result
+            m_categoryImageCache[category] = imageUrl;
             
-            if (imageUrl.isEmpty() && !altUrl.isEmpty()) {
-                imageUrl = altUrl;
+            // Check if we have a pending request for this category
+            if (m_pendingPresetRequests.contains(category)) {
+                QString systemName = m_pendingPresetRequests.take(category);
+                qDebug() << "Found preset image for category" << category << "system" << systemName << ":" << imageUrl;
+                emit presetImageFound(systemName, imageUrl, category);
             }
             
-            if (!imageUrl.isEmpty()) {
-                // Cache the result
-                m_categoryImageCache[category] = imageUrl;
-                
-                // Check if we have a pending request for this category
-                if (m_pendingPresetRequests.contains(category)) {
-                    QString systemName = m_pendingPresetRequests.take(category);
-                    qDebug() << "Found preset image for category" << category << "system" << systemName << ":" << imageUrl;
-                    emit presetImageFound(systemName, imageUrl, category);
-                }
-                
-                qDebug() << "Cached preset image for category" << category << ":" << imageUrl;
-            } else {
-                qDebug() << "No image URL found in preset image data for category:" << category;
-                
-                if (m_pendingPresetRequests.contains(category)) {
-                    QString systemName = m_pendingPresetRequests.take(category);
-                    emit systemImageSet(systemName, "", false);
-                }
-            }
+            qDebug() << "Cached preset image for category" << category << ":" << imageUrl;
         } else {
-            qDebug() << "No preset image found for category:" << category;
+            qDebug() << "No image URL found in preset image data for category:" << category;
             
             if (m_pendingPresetRequests.contains(category)) {
                 QString systemName = m_pendingPresetRequests.take(category);
                 emit systemImageSet(systemName, "", false);
             }
         }
+    } else {
+        qDebug() << "No preset image found for category:" << category;
         
-    } else if (operation.startsWith("CHECK:preset_images_count")) {
-        // Handle count check for incremental sync
-        QJsonArray responseData = response.value("data").toArray();
-        int currentCount = responseData.size();
-        
-        qDebug() << "Preset images count check response size:" << currentCount;
-        qDebug() << "Raw response data:" << QJsonDocument(responseData).toJson(QJsonDocument::Compact);
-        
-        // Compare with stored count
-        QJsonObject tables = m_syncState.value("tables").toObject();
-        int storedCount = tables.value("preset_images_count").toInt(0);
+        if (m_pendingPresetRequests.contains(category)) {
+            QString systemName = m_pendingPresetRequests.take(category);
+            emit systemImageSet(systemName, "", false);
+        }
+    }
+}
+
+void SupabaseClient::onCheckPresetImagesCount(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response)
+{
+    // Handle count check for incremental sync
+    QJsonArray responseData = response.value("data").toArray();
+    int currentCount = responseData.size();
+    
+    qDebug() << "Preset images count check response size:" << currentCount;
+    qDebug() << "Raw response data:" << QJsonDocument(responseData).toJson(QJsonDocument::Compact);
+    
+    // Compare with stored count
+    QJsonObject tables = m_syncState.value("tables").toObject();
+    int storedCount = tables.value("preset_images_count").toInt(0);
+    
+    // If current count seems wrong (too low), skip the check to avoid false positives
+    if (currentCount < 10 && storedCount > 10) {
+        qWarning() << "Count check returned suspiciously low count (" << currentCount << "), skipping check to avoid false positive";
+        finalizeDatabaseSync(true, 0);
+    } else if (currentCount != storedCount) {
+        qDebug() << "Preset images count changed:" << storedCount << "->" << currentCount;
+        // Download updated preset images
+        getPresetImages(true);
+        
+        // Update stored count
+        tables["preset_images_count"] = currentCount;
+        m_syncState["tables"] = tables;
+        finalizeDatabaseSync(true, abs(currentCount - storedCount));
+    } else {
+        qDebug() << "No changes detected in preset images";
         
-        // If current count seems wrong (too low), skip the check to avoid false positives
-        if (currentCount < 10 && storedCount > 10) {
-            qWarning() << "Count check returned suspiciously low count (" << currentCount << "), skipping check to avoid false positive";
-            finalizeDatabaseSync(true, 0);
-        } else if (currentCount != storedCount) {
-            qDebug() << "Preset images count changed:" << storedCount << "->" << currentCount;
-            // Download updated preset images
+        // Still load preset images if this is the first time or if ImageLoader doesn't have them
+        if (storedCount == 0 || currentCount > 0) {
+            qDebug() << "Loading preset images from database (initial load or refresh)";
             getPresetImages(true);
-            
-            // Update stored count
-            tables["preset_images_count"] = currentCount;
-            m_syncState["tables"] = tables;
-            finalizeDatabaseSync(true, abs(currentCount - storedCount));
+        }
+        
+        finalizeDatabaseSync(true, 0);
+    }
+}
+
+// Authentication operation handlers
+void SupabaseClient::onSecurityCheck(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response)
+{
+    QString commanderName = context.commanderName;
+    QJsonArray data = response.value("data").toArray();
+    
+    if (data.isEmpty()) {
+        // Commander not found in security table - add as new user
+        qDebug() << "[DEBUG]" << commanderName << "not found in security table - will add as new user";
+        
+        // For now, treat as legitimate new user (full implementation would check journal for alts)
+        QStringList allCommanders;
+        allCommanders << commanderName;
+        handleNewCommander(commanderName, allCommanders);
+        emit authenticationComplete(true, "New user added successfully");
+    } else {
+        // Commander found in security table
+        QJsonObject commanderData = data.first().toObject();
+        bool isBlocked = commanderData.value("blocked").toBool();
+        QString notes = commanderData.value("notes").toString();
+        
+        if (isBlocked) {
+            qDebug() << "[DEBUG] User" << commanderName << "is blocked - denying access";
+            logLoginEvent(commanderName, false, "blocked_attempt");
+            emit authenticationComplete(false, "You are unauthenticated. Speak to the plugin owner in Discord to gain access.");
         } else {
-            qDebug() << "No changes detected in preset images";
-            
-            // Still load preset images if this is the first time or if ImageLoader doesn't have them
-            if (storedCount == 0 || currentCount > 0) {
-                qDebug() << "Loading preset images from database (initial load or refresh)";
-                getPresetImages(true);
-            }
-            
-            finalizeDatabaseSync(true, 0);
+            qDebug() << "[DEBUG] User" << commanderName << "authenticated - allowing access";
+            logLoginEvent(commanderName, false, "login");
+            emit authenticationComplete(true, "Authentication successful");
         }
+    }
+}
+
+void SupabaseClient::onAddNewCommander(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response)
+{
+    QString commanderName = context.commanderName;
+    QJsonArray data = response.value("data").toArray();
     
-    // Authentication operation handlers
-    } else if (operation == "security_check") {
-        QString commanderName = reply->property("commander_name").toString();
-        QJsonArray data = response.value("data").toArray();
-        
-        if (data.isEmpty()) {
-            // Commander not found in security table - add as new user
-            qDebug() << "[DEBUG]" << commanderName << "not found in security table - will add as new user";
-            
-            // For now, treat as legitimate new user (full implementation would check journal for alts)
-            QStringList allCommanders;
-            allCommanders << commanderName;
-            handleNewCommander(commanderName, allCommanders);
-            emit authenticationComplete(true, "New user added successfully");
+    if (!data.isEmpty()) {
+        qDebug() << "[DEBUG] Successfully added" << commanderName << "to security table";
+        logLoginEvent(commanderName, false, "new_user");
+    } else {
+        qDebug() << "[ERROR] Failed to add" << commanderName << "to security table";
+        emit authenticationComplete(false, "Failed to add user to security table");
+    }
+}
+
+void SupabaseClient::onCheckBannedAlt(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response)
+{
+    QString commanderName = context.commanderName;
+    QString altCommander = context.altCommander;
+    QJsonArray data = response.value("data").toArray();
+    
+    if (!data.isEmpty()) {
+        // Found a banned alt commander - block the new commander
+        qDebug() << "[WARNING] RENAME DETECTED!" << altCommander << "(blocked) renamed to" << commanderName;
+        
+        // Update the new commander to blocked status
+        QJsonObject updateData;
+        updateData["blocked"] = true;
+        updateData["notes"] = QString("⚠️ SUSPICIOUS: Blocked commanders in same journal: %1").arg(altCommander);
+        
+        QString endpoint = QString("security?name=eq.%1").arg(commanderName);
+        QNetworkRequest request = createRequest(endpoint);
+        QJsonDocument doc(updateData);
+        QNetworkReply *updateReply = m_networkManager->sendCustomRequest(request, "PATCH", doc.toJson());
+        trackRequest(updateReply, SupabaseOperation::BlockRenamedCommander);
+        requestContext(updateReply).commanderName = commanderName;
+        requestContext(updateReply).altCommander = altCommander;
+        
+        logLoginEvent(commanderName, false, "rename_attempt", QString("%1 renamed to %2").arg(altCommander, commanderName));
+        emit authenticationComplete(false, QString("Rename detected! %1 is banned.\nSpeak to the plugin owner in Discord to gain access.").arg(altCommander));
+    }
+}
+
+void SupabaseClient::onBlockRenamedCommander(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response)
+{
+    QString commanderName = context.commanderName;
+    QString altCommander = context.altCommander;
+    qDebug() << "[SECURITY] Blocked" << commanderName << "due to rename from banned commander" << altCommander;
+}
+
+void SupabaseClient::onLogLoginEvent(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response)
+{
+    // Login event logged successfully
+    QJsonArray data = response.value("data").toArray();
+    if (!data.isEmpty()) {
+        qDebug() << "[DEBUG] Login event logged successfully";
+    }
+}
+
+void SupabaseClient::onCheckSystemInfoForImage(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response)
+{
+    QString systemName = context.systemName;
+    QString imageUrl = context.imageUrl;
+    QJsonArray systemInfoData = response.value("data").toArray();
+    
+    if (!systemInfoData.isEmpty()) {
+        // System exists - update it with the new image
+        QJsonObject existingData = systemInfoData.first().toObject();
+        QString existingImages = existingData.value("images").toString();
+        QString existingAdditionalImages = existingData.value("additional_images").toString();
+        
+        QJsonObject updateData;
+        
+        if (existingImages.isEmpty()) {
+            // No primary image yet - set this as primary
+            updateData["images"] = imageUrl;
+            qDebug() << "Setting as primary image for system:" << systemName;
         } else {
-            // Commander found in security table
-            QJsonObject commanderData = data.first().toObject();
-            bool isBlocked = commanderData.value("blocked").toBool();
-            QString notes = commanderData.value("notes").toString();
+            // Primary image exists - add to additional_images array
+            QJsonArray additionalImages;
             
-            if (isBlocked) {
-                qDebug() << "[DEBUG] User" << commanderName << "is blocked - denying access";
-                logLoginEvent(commanderName, false, "blocked_attempt");
-                emit authenticationComplete(false, "You are unauthenticated. Speak to the plugin owner in Discord to gain access.");
-            } else {
-                qDebug() << "[DEBUG] User" << commanderName << "authenticated - allowing access";
-                logLoginEvent(commanderName, false, "login");
-                emit authenticationComplete(true, "Authentication successful");
+            // Parse existing additional_images if they exist
+            if (!existingAdditionalImages.isEmpty()) {
+                QJsonParseError parseError;
+                QJsonDocument doc = QJsonDocument::fromJson(existingAdditionalImages.toUtf8(), &parseError);
+                if (parseError.error == QJsonParseError::NoError && doc.isArray()) {
+                    additionalImages = doc.array();
+                }
             }
+            
+            // Add new image to additional_images array
+            additionalImages.append(imageUrl);
+            updateData["additional_images"] = QString::fromUtf8(QJsonDocument(additionalImages).toJson(QJsonDocument::Compact));
+            qDebug() << "Adding to additional images for system:" << systemName;
         }
         
-    } else if (operation == "add_new_commander") {
-        QString commanderName = reply->property("commander_name").toString();
-        QJsonArray data = response.value("data").toArray();
+        // Update the existing record
+        QString updateEndpoint = QString("system_information?system=eq.%1").arg(QUrl::toPercentEncoding(systemName));
+        QNetworkRequest updateRequest = createRequest(updateEndpoint);
         
-        if (!data.isEmpty()) {
-            qDebug() << "[DEBUG] Successfully added" << commanderName << "to security table";
-            logLoginEvent(commanderName, false, "new_user");
+        // Add commander headers to update request
+        if (!m_currentCommander.isEmpty() && m_currentCommander != "Unknown") {
+            updateRequest.setRawHeader("X-Commander", m_currentCommander.toUtf8());
+            updateRequest.setRawHeader("x-commander-name", m_currentCommander.toUtf8());
         } else {
-            qDebug() << "[ERROR] Failed to add" << commanderName << "to security table";
-            emit authenticationComplete(false, "Failed to add user to security table");
+            updateRequest.setRawHeader("X-Commander", "Regza");
+            updateRequest.setRawHeader("x-commander-name", "Regza");
         }
         
-    } else if (operation == "check_banned_alt") {
-        QString commanderName = reply->property("commander_name").toString();
-        QString altCommander = reply->property("alt_commander").toString();
-        QJsonArray data = response.value("data").toArray();
+        QJsonDocument updateDoc(updateData);
+        QNetworkReply *updateReply = m_networkManager->sendCustomRequest(updateRequest, "PATCH", updateDoc.toJson());
         
-        if (!data.isEmpty()) {
-            // Found a banned alt commander - block the new commander
-            qDebug() << "[WARNING] RENAME DETECTED!" << altCommander << "(blocked) renamed to" << commanderName;
-            
-            // Update the new commander to blocked status
-            QJsonObject updateData;
-            updateData["blocked"] = true;
-            updateData["notes"] = QString("⚠️ SUSPICIOUS: Blocked commanders in same journal: %1").arg(altCommander);
-            
-            QString endpoint = QString("security?name=eq.%1").arg(commanderName);
-            QNetworkRequest request = createRequest(endpoint);
-            QJsonDocument doc(updateData);
-            QNetworkReply *updateReply = m_networkManager->sendCustomRequest(request, "PATCH", doc.toJson());
-            updateReply->setProperty("operation", "block_renamed_commander");
-            updateReply->setProperty("commander_name", commanderName);
-            updateReply->setProperty("alt_commander", altCommander);
-            
-            logLoginEvent(commanderName, false, "rename_attempt", QString("%1 renamed to %2").arg(altCommander, commanderName));
-            emit authenticationComplete(false, QString("Rename detected! %1 is banned.\nSpeak to the plugin owner in Discord to gain access.").arg(altCommander));
+        if (updateReply) {
+            trackRequest(updateReply, SupabaseOperation::UpdateSystemInfoImage);
+            requestContext(updateReply).systemName = systemName;
+            requestContext(updateReply).imageUrl = imageUrl;
+            qDebug() << "Updating existing system_information record with image";
         }
+    } else {
+        // System doesn't exist - create new record
+        QJsonObject newData;
+        newData["system"] = systemName;
+        newData["images"] = imageUrl;
+        newData["system_info"] = QString("System images uploaded by user.");
+        newData["submitter"] = m_currentCommander.isEmpty() ? "Regza" : m_currentCommander;
+        newData["potential_or_poi"] = "Potential POI";
         
-    } else if (operation == "block_renamed_commander") {
-        QString commanderName = reply->property("commander_name").toString();
-        QString altCommander = reply->property("alt_commander").toString();
-        qDebug() << "[SECURITY] Blocked" << commanderName << "due to rename from banned commander" << altCommander;
+        QNetworkRequest insertRequest = createRequest("system_information");
         
-    } else if (operation == "log_login_event") {
-        // Login event logged successfully
-        QJsonArray data = response.value("data").toArray();
-        if (!data.isEmpty()) {
-            qDebug() << "[DEBUG] Login event logged successfully";
+        // Add commander headers to insert request
+        if (!m_currentCommander.isEmpty() && m_currentCommander != "Unknown") {
+            insertRequest.setRawHeader("X-Commander", m_currentCommander.toUtf8());
+            insertRequest.setRawHeader("x-commander-name", m_currentCommander.toUtf8());
+        } else {
+            insertRequest.setRawHeader("X-Commander", "Regza");
+            insertRequest.setRawHeader("x-commander-name", "Regza");
         }
-    } else if (operation.startsWith("CHECK:system_info_for_image")) {
-        QString systemName = reply->property("systemName").toString();
-        QString imageUrl = reply->property("imageUrl").toString();
-        QJsonArray systemInfoData = response.value("data").toArray();
         
-        if (!systemInfoData.isEmpty()) {
-            // System exists - update it with the new image
-            QJsonObject existingData = systemInfoData.first().toObject();
-            QString existingImages = existingData.value("images").toString();
-            QString existingAdditionalImages = existingData.value("additional_images").toString();
-            
-            QJsonObject updateData;
-            
-            if (existingImages.isEmpty()) {
-                // No primary image yet - set this as primary
-                updateData["images"] = imageUrl;
-                qDebug() << "Setting as primary image for system:" << systemName;
-            } else {
-                // Primary image exists - add to additional_images array
-                QJsonArray additionalImages;
-                
-                // Parse existing additional_images if they exist
-                if (!existingAdditionalImages.isEmpty()) {
-                    QJsonParseError parseError;
-                    QJsonDocument doc = QJsonDocument::fromJson(existingAdditionalImages.toUtf8(), &parseError);
-                    if (parseError.error == QJsonParseError::NoError && doc.isArray()) {
-                        additionalImages = doc.array();
-                    }
-                }
-                
-                // Add new image to additional_images array
-                additionalImages.append(imageUrl);
-                updateData["additional_images"] = QString::fromUtf8(QJsonDocument(additionalImages).toJson(QJsonDocument::Compact));
-                qDebug() << "Adding to additional images for system:" << systemName;
-            }
-            
-            // Update the existing record
-            QString updateEndpoint = QString("system_information?system=eq.%1").arg(QUrl::toPercentEncoding(systemName));
-            QNetworkRequest updateRequest = createRequest(updateEndpoint);
-            
-            // Add commander headers to update request
-            if (!m_currentCommander.isEmpty() && m_currentCommander != "Unknown") {
-                updateRequest.setRawHeader("X-Commander", m_currentCommander.toUtf8());
-                updateRequest.setRawHeader("x-commander-name", m_currentCommander.toUtf8());
-            } else {
-                updateRequest.setRawHeader("X-Commander", "Regza");
-                updateRequest.setRawHeader("x-commander-name", "Regza");
-            }
-            
-            QJsonDocument updateDoc(updateData);
-            QNetworkReply *updateReply = m_networkManager->sendCustomRequest(updateRequest, "PATCH", updateDoc.toJson());
-            
-            if (updateReply) {
-                updateReply->setProperty("operation", "UPDATE:system_info_image");
-                updateReply->setProperty("systemName", systemName);
-                updateReply->setProperty("imageUrl", imageUrl);
-                qDebug() << "Updating existing system_information record with image";
-            }
+        QJsonDocument insertDoc(newData);
+        QNetworkReply *insertReply = m_networkManager->post(insertRequest, insertDoc.toJson());
+        
+        if (insertReply) {
+            trackRequest(insertReply, SupabaseOperation::InsertSystemInfoImage);
+            requestContext(insertReply).systemName = systemName;
+            requestContext(insertReply).imageUrl = imageUrl;
+            qDebug() << "Creating new system_information record with image";
+        }
+    }
+}
+
+void SupabaseClient::onSystemInfoImageSaved(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response)
+{
+    QString systemName = context.systemName;
+    QString imageUrl = context.imageUrl;
+    QString operationType = context.operation == SupabaseOperation::UpdateSystemInfoImage ? "updated" : "created";
+    
+    qDebug() << "System information" << operationType << "successfully for" << systemName << "with image" << imageUrl;
+}
+
+void SupabaseClient::emitBulkSystemImages(const QJsonArray &imagesData)
+{
+    QJsonObject systemImages;
+    
+    // Convert array to object keyed by system name
+    for (const QJsonValue &value : imagesData) {
+        QJsonObject imageInfo = value.toObject();
+        QString systemName = imageInfo.value("system").toString();
+        QString imageUrl = imageInfo.value("images").toString();
+        
+        if (!systemName.isEmpty() && !imageUrl.isEmpty()) {
+            systemImages[systemName] = imageUrl;
+        }
+    }
+    
+    qDebug() << "Loaded images for" << systemImages.size() << "systems";
+    emit bulkSystemImagesLoaded(systemImages);
+}
+
+void SupabaseClient::onCheckExistingClaim(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response)
+{
+    QString systemName = context.systemName;
+    QString commander = context.commander;
+    bool hasVisited = context.hasVisited;
+    QJsonArray existingData = response.value("data").toArray();
+    
+    if (!existingData.isEmpty()) {
+        // Check the current owner of the single system row
+        QJsonObject existingClaim = existingData[0].toObject();
+        QString claimedBy = existingClaim.value("by_cmdr").toString();
+        bool isDone = existingClaim.value("done").toBool();
+
+        // Treat placeholder 'empty' (or blank) as unclaimed
+        if (claimedBy.isEmpty() || claimedBy.compare("empty", Qt::CaseInsensitive) == 0) {
+            qDebug() << "System" << systemName << "row is unclaimed ('empty') - proceeding to claim";
+        } else if (claimedBy == commander) {
+            qDebug() << "Claim already exists for" << systemName << "by" << commander << "- not creating duplicate";
+            emit systemClaimed(systemName, true); // Already claimed by this user
+            return;
+        } else if (isDone) {
+            qDebug() << "Existing claim is marked as done by" << claimedBy << "- allowing new claim";
         } else {
-            // System doesn't exist - create new record
-            QJsonObject newData;
-            newData["system"] = systemName;
-            newData["images"] = imageUrl;
-            newData["system_info"] = QString("System images uploaded by user.");
-            newData["submitter"] = m_currentCommander.isEmpty() ? "Regza" : m_currentCommander;
-            newData["potential_or_poi"] = "Potential POI";
-            
-            QNetworkRequest insertRequest = createRequest("system_information");
+            qDebug() << "System is actively claimed by another commander - blocking claim (claimedBy:" << claimedBy << ")";
+            emit systemClaimed(systemName, false);
+            emit networkError(QString("System '%1' is already claimed by %2. You cannot claim systems that belong to other commanders unless they are marked as 'Done'.")
+                            .arg(systemName, claimedBy));
+            return;
+        }
+    }
+    
+    // If we reach here, either no claim exists OR existing claim is done - create new claim
+    qDebug() << "Creating new claim for" << systemName;
+    
+    // Use UPSERT to prevent duplicates - this is the fix!
+    QJsonObject claimData;
+    claimData["system"] = systemName;
+    claimData["by_cmdr"] = commander;
+    claimData["visited"] = hasVisited;
+    claimData["done"] = false;
+    
+    // Add resolution header to ignore conflicts (UPSERT behavior)
+    // IMPORTANT: PostgREST requires on_conflict when using resolution=ignore-duplicates
+    QString upsertEndpoint = "taken?on_conflict=system";
+    QNetworkRequest claimRequest = createRequest(upsertEndpoint);
+    // Merge into the existing row for this system if it already exists (unique on system)
+    claimRequest.setRawHeader("Prefer", "return=representation,resolution=merge-duplicates");
+    claimRequest.setRawHeader("X-Commander", commander.toUtf8());
+    claimRequest.setRawHeader("x-commander-name", commander.toUtf8());
+    
+    QJsonDocument claimDoc(claimData);
+    QNetworkReply *claimReply = m_networkManager->post(claimRequest, claimDoc.toJson());
+    
+    if (claimReply) {
+        trackRequest(claimReply, SupabaseOperation::PostTaken);
+        requestContext(claimReply).systemName = systemName;
+        requestContext(claimReply).commander = commander;
+        qDebug() << "UPSERT claim request" << upsertEndpoint
+                 << "payload:" << QString::fromUtf8(claimDoc.toJson(QJsonDocument::Compact));
+        qDebug() << "Creating new claim record for" << systemName << "with duplicate prevention";
+    }
+    
+    // REMOVED: automatic system_information creation to prevent unnecessary duplicates
+    // Let users create system_information manually if needed
+}
+
+void SupabaseClient::onCheckRecordsBeforeUpdate(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response)
+{
+    QString systemName = context.systemName;
+    QJsonArray records = response.value("data").toArray();
+    
+    qDebug() << "=== RECORDS CHECK RESULT ===";
+    qDebug() << "System:" << systemName;
+    qDebug() << "Records found:" << records.size();
+    
+    for (const QJsonValue &value : records) {
+        QJsonObject record = value.toObject();
+        qDebug() << "Record:" << record;
+    }
+    qDebug() << "=== END RECORDS CHECK ===";
+}
+
+void SupabaseClient::onUnclaimMarkEmpty(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response)
+{
+    QString systemName = context.systemName;
+    int httpStatus = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    QByteArray responseBytes = reply->readAll();
+    qDebug() << "unclaimSystem: HTTP" << httpStatus << "response:" << responseBytes;
+    if (httpStatus >= 200 && httpStatus < 300) {
+        // Treat any 2xx as success. Some configurations may return 200 with an empty array
+        // even when the UPDATE succeeded due to policy/visibility nuances.
+        qDebug() << "unclaimSystem: by_cmdr set to 'empty' for" << systemName;
+        const QJsonArray rows = response.value("data").toArray();
+        applyTakenWrite(!rows.isEmpty() ? rows
+                        : localTakenRowsWith({systemName}, {{"by_cmdr", QStringLiteral("empty")}}));
+        emit systemUnclaimed(systemName, true);
+        QTimer::singleShot(0, this, [this]() { getTakenSystems(); });
+    } else {
+        qDebug() << "unclaimSystem: PATCH mark empty failed for" << systemName << "HTTP" << httpStatus;
+        emit systemUnclaimed(systemName, false);
+    }
+}
+
+void SupabaseClient::onCheckSystemInfoExistsOnClaim(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response)
+{
+    QString systemName = context.systemName;
+    QString commander = context.commander;
+    QJsonArray existingSystemInfo = response.value("data").toArray();
+    
+    if (existingSystemInfo.isEmpty()) {
+        // REMOVED: DO NOT AUTO-CREATE system_information records
+        // This was causing the duplicates!
+        qDebug() << "No system_information record exists for" << systemName << "- but NOT creating one automatically";
+        qDebug() << "Users can create system_information records manually if needed";
+    } else {
+        qDebug() << "System_information record already exists for" << systemName << "- skipping creation";
+    }
+}
+
+void SupabaseClient::onImgbbTest(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response)
+{
+    int httpStatus = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    QByteArray responseBody = reply->readAll();
+    
+    qDebug() << "HTTP Status:" << httpStatus;
+    qDebug() << "Response Body:" << responseBody;
+    
+    if (httpStatus == 200 && !responseBody.isEmpty()) {
+        QJsonParseError parseError;
+        QJsonDocument doc = QJsonDocument::fromJson(responseBody, &parseError);
+        
+        if (parseError.error == QJsonParseError::NoError) {
+            QJsonObject jsonResponse = doc.object();
+            bool imgbbSuccess = jsonResponse.value("success").toBool();
             
-            // Add commander headers to insert request
-            if (!m_currentCommander.isEmpty() && m_currentCommander != "Unknown") {
-                insertRequest.setRawHeader("X-Commander", m_currentCommander.toUtf8());
-                insertRequest.setRawHeader("x-commander-name", m_currentCommander.toUtf8());
+            if (imgbbSuccess) {
+                qDebug() << "✅ API KEY IS WORKING! ImgBB test upload successful!";
+                qDebug() << "Your API key is valid and ImgBB is accessible.";
             } else {
-                insertRequest.setRawHeader("X-Commander", "Regza");
-                insertRequest.setRawHeader("x-commander-name", "Regza");
+                qDebug() << "❌ API key test failed - ImgBB returned success=false";
+                QJsonObject error = jsonResponse.value("error").toObject();
+                qDebug() << "Error:" << error.value("message").toString();
             }
-            
-            QJsonDocument insertDoc(newData);
-            QNetworkReply *insertReply = m_networkManager->post(insertRequest, insertDoc.toJson());
-            
-            if (insertReply) {
-                insertReply->setProperty("operation", "INSERT:system_info_image");
-                insertReply->setProperty("systemName", systemName);
-                insertReply->setProperty("imageUrl", imageUrl);
-                qDebug() << "Creating new system_information record with image";
+        } else {
+            qDebug() << "❌ Invalid JSON response from ImgBB";
+        }
+    } else if (httpStatus == 400) {
+        qDebug() << "❌ HTTP 400 - Your API key is likely invalid or expired";
+        qDebug() << "Get a new API key from https://api.imgbb.com/";
+    } else {
+        qDebug() << "❌ Unexpected response - HTTP" << httpStatus;
+        qDebug() << "Response:" << responseBody;
+    }
+    
+    qDebug() << "=== IMGBB API TEST COMPLETE ===";
+}
+
+void SupabaseClient::setCacheTtl(const QString &operation, int milliseconds)
+{
+    m_cacheTtlMs[operation] = milliseconds;
+    if (milliseconds <= 0) {
+        for (auto it = m_responseCache.begin(); it != m_responseCache.end();) {
+            it = it->operation == operation ? m_responseCache.erase(it) : std::next(it);
+        }
+    }
+}
+
+void SupabaseClient::clearResponseCache()
+{
+    m_responseCache.clear();
+}
+
+int SupabaseClient::cacheTtl(const QString &operation) const
+{
+    auto it = m_cacheTtlMs.constFind(operation);
+    if (it != m_cacheTtlMs.constEnd()) {
+        return it.value();
+    }
+    
+    // Claims change the most; categories and preset images hardly ever
+    if (operation == "GET:taken") {
+        return 5000;
+    } else if (operation == "GET:pois") {
+        return 30000;
+    } else if (operation.startsWith("GET:categories") || operation == "GET:preset_images") {
+        return 10 * 60 * 1000;
+    }
+    return 0;
+}
+
+bool SupabaseClient::serveOrJoinGet(const QString &operation, const QString &endpoint)
+{
+    const QString key = operation + ' ' + endpoint;
+    
+    auto cached = m_responseCache.constFind(key);
+    if (cached != m_responseCache.constEnd()) {
+        if (cached->expiresAt > QDateTime::currentMSecsSinceEpoch()) {
+            // Delivered from the event loop, like a network reply would be
+            const QJsonArray data = cached->data;
+            QTimer::singleShot(0, this, [this, operation, data]() {
+                handleListResponse(operation, data);
+            });
+            qDebug() << operation << "served from cache";
+            return true;
+        }
+        m_responseCache.remove(key);
+    }
+    
+    if (m_inFlightGets.contains(key)) {
+        qDebug() << operation << "already in flight, joining it";
+        return true;
+    }
+    return false;
+}
+
+void SupabaseClient::cacheResponse(const QString &key, const QString &operation, const QJsonArray &data)
+{
+    const int ttl = cacheTtl(operation);
+    if (ttl > 0) {
+        CachedResponse cached;
+        cached.operation = operation;
+        cached.data = data;
+        cached.expiresAt = QDateTime::currentMSecsSinceEpoch() + ttl;
+        m_responseCache.insert(key, cached);
+    }
+}
+
+void SupabaseClient::trackGet(QNetworkReply *reply, const QString &operation, const QString &endpoint)
+{
+    const QString key = operation + ' ' + endpoint;
+    requestContext(reply).cacheKey = key;
+    m_inFlightGets.insert(key);
+}
+
+void SupabaseClient::handleListResponse(const QString &operation, const QJsonArray &data)
+{
+    if (operation.startsWith("GET:taken")) {
+        QJsonArray taken = data;
+        qDebug() << "Emitting takenSystemsReceived with" << taken.size() << "items (ALL systems)";
+        emit takenSystemsReceived(taken);
+        
+    } else if (operation.startsWith("GET:categories_systems")) {
+        qDebug() << "Processing GET:categories_systems response";
+        QJsonArray categoriesData = data;
+        qDebug() << "Systems categories data size:" << categoriesData.size();
+        
+        // Extract unique categories and add "All Categories" at the beginning
+        QStringList systemsCategories;
+        systemsCategories << "All Categories"; // Always first
+        
+        QSet<QString> categorySet;
+        for (const QJsonValue &value : categoriesData) {
+            QJsonObject categoryObj = value.toObject();
+            QString category = categoryObj.value("category").toString().trimmed();
+            // Filter out test/debug categories
+            if (!category.isEmpty() && !categorySet.contains(category) && 
+                category != "TEST_CATEGORY" && !category.startsWith("test_")) {
+                categorySet.insert(category);
+                systemsCategories << category;
             }
         }
         
-    } else if (operation.startsWith("UPDATE:system_info_image") || operation.startsWith("INSERT:system_info_image")) {
-        QString systemName = reply->property("systemName").toString();
-        QString imageUrl = reply->property("imageUrl").toString();
-        QString operationType = operation.startsWith("UPDATE") ? "updated" : "created";
+        // Store systems categories temporarily and fetch Richard categories
+        m_pendingSystemsCategories = systemsCategories;
+        
+        // Now fetch Richard categories from preset_images table
+        getRichardCategories();
         
-        qDebug() << "System information" << operationType << "successfully for" << systemName << "with image" << imageUrl;
+    } else if (operation.startsWith("GET:categories_richard")) {
+        qDebug() << "Processing GET:categories_richard response";
+        QJsonArray richardData = data;
+        qDebug() << "Richard categories data size:" << richardData.size();
         
-    } else if (operation.startsWith("GET:bulk_system_images")) {
-        QJsonArray imagesData = response.value("data").toArray();
-        QJsonObject systemImages;
+        // Extract Richard categories (show ALL Richard categories, don't deduplicate)
+        QStringList richardCategories;
+        QSet<QString> richardSet;
         
-        // Convert array to object keyed by system name
-        for (const QJsonValue &value : imagesData) {
-            QJsonObject imageInfo = value.toObject();
-            QString systemName = imageInfo.value("system").toString();
-            QString imageUrl = imageInfo.value("images").toString();
-            
-            if (!systemName.isEmpty() && !imageUrl.isEmpty()) {
-                systemImages[systemName] = imageUrl;
+        for (const QJsonValue &value : richardData) {
+            QJsonObject categoryObj = value.toObject();
+            QString category = categoryObj.value("category").toString().trimmed();
+            if (!category.isEmpty() && !richardSet.contains(category)) {
+                richardSet.insert(category);
+                richardCategories << category;
             }
         }
         
-        qDebug() << "Loaded images for" << systemImages.size() << "systems";
-        emit bulkSystemImagesLoaded(systemImages);
-        
-    } else if (operation.startsWith("CHECK:existing_claim")) {
-        QString systemName = reply->property("systemName").toString();
-        QString commander = reply->property("commander").toString();
-        bool hasVisited = reply->property("hasVisited").toBool();
-        QJsonArray existingData = response.value("data").toArray();
+        // Combine systems categories with Richard categories (remove duplicates)
+        QStringList allCategories;
         
-        if (!existingData.isEmpty()) {
-            // Check the current owner of the single system row
-            QJsonObject existingClaim = existingData[0].toObject();
-            QString claimedBy = existingClaim.value("by_cmdr").toString();
-            bool isDone = existingClaim.value("done").toBool();
-
-            // Treat placeholder 'empty' (or blank) as unclaimed
-            if (claimedBy.isEmpty() || claimedBy.compare("empty", Qt::CaseInsensitive) == 0) {
-                qDebug() << "System" << systemName << "row is unclaimed ('empty') - proceeding to claim";
-            } else if (claimedBy == commander) {
-                qDebug() << "Claim already exists for" << systemName << "by" << commander << "- not creating duplicate";
-                emit systemClaimed(systemName, true); // Already claimed by this user
-                return;
-            } else if (isDone) {
-                qDebug() << "Existing claim is marked as done by" << claimedBy << "- allowing new claim";
-            } else {
-                qDebug() << "System is actively claimed by another commander - blocking claim (claimedBy:" << claimedBy << ")";
-                emit systemClaimed(systemName, false);
-                emit networkError(QString("System '%1' is already claimed by %2. You cannot claim systems that belong to other commanders unless they are marked as 'Done'.")
-                                .arg(systemName, claimedBy));
-                return;
+        // Add systems categories but exclude ones that will appear in Richard's section
+        for (const QString &category : m_pendingSystemsCategories) {
+            if (!richardSet.contains(category)) {
+                allCategories << category;
             }
         }
         
-        // If we reach here, either no claim exists OR existing claim is done - create new claim
-        qDebug() << "Creating new claim for" << systemName;
-        
-        // Use UPSERT to prevent duplicates - this is the fix!
-        QJsonObject claimData;
-        claimData["system"] = systemName;
-        claimData["by_cmdr"] = commander;
-        claimData["visited"] = hasVisited;
-        claimData["done"] = false;
-        
-        // Add resolution header to ignore conflicts (UPSERT behavior)
-        // IMPORTANT: PostgREST requires on_conflict when using resolution=ignore-duplicates
-        QString upsertEndpoint = "taken?on_conflict=system";
-        QNetworkRequest claimRequest = createRequest(upsertEndpoint);
-        // Merge into the existing row for this system if it already exists (unique on system)
-        claimRequest.setRawHeader("Prefer", "return=representation,resolution=merge-duplicates");
-        claimRequest.setRawHeader("X-Commander", commander.toUtf8());
-        claimRequest.setRawHeader("x-commander-name", commander.toUtf8());
-        
-        QJsonDocument claimDoc(claimData);
-        QNetworkReply *claimReply = m_networkManager->post(claimRequest, claimDoc.toJson());
-        
-        if (claimReply) {
-            claimReply->setProperty("operation", "POST:taken");
-            claimReply->setProperty("systemName", systemName);
-            claimReply->setProperty("commander", commander);
-            qDebug() << "UPSERT claim request" << upsertEndpoint
-                     << "payload:" << QString::fromUtf8(claimDoc.toJson(QJsonDocument::Compact));
-            qDebug() << "Creating new claim record for" << systemName << "with duplicate prevention";
+        // Add separator and Richard categories if we have any (always show Richard's section)
+        if (!richardCategories.isEmpty()) {
+            allCategories << "--- Richard's Stuff ---";
+            allCategories << richardCategories;
         }
         
-        // REMOVED: automatic system_information creation to prevent unnecessary duplicates
-        // Let users create system_information manually if needed
-        
-    } else if (operation.startsWith("CHECK:records_before_update")) {
-        QString systemName = reply->property("systemName").toString();
-        QJsonArray records = response.value("data").toArray();
-        
-        qDebug() << "=== RECORDS CHECK RESULT ===";
-        qDebug() << "System:" << systemName;
-        qDebug() << "Records found:" << records.size();
-        
-        for (const QJsonValue &value : records) {
-            QJsonObject record = value.toObject();
-            qDebug() << "Record:" << record;
+        // Convert to JSON array for consistent signal interface
+        QJsonArray categoriesArray;
+        for (const QString &category : allCategories) {
+            categoriesArray.append(category);
         }
-        qDebug() << "=== END RECORDS CHECK ===";
         
-    } else if (operation.startsWith("UNCLAIM:mark_empty")) {
-        QString systemName = reply->property("systemName").toString();
-        int httpStatus = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
-        QByteArray responseBytes = reply->readAll();
-        qDebug() << "unclaimSystem: HTTP" << httpStatus << "response:" << responseBytes;
-        if (httpStatus >= 200 && httpStatus < 300) {
-            // Treat any 2xx as success. Some configurations may return 200 with an empty array
-            // even when the UPDATE succeeded due to policy/visibility nuances.
-            qDebug() << "unclaimSystem: by_cmdr set to 'empty' for" << systemName;
-            emit systemUnclaimed(systemName, true);
-            QTimer::singleShot(0, this, [this]() { getTakenSystems(); });
-        } else {
-            qDebug() << "unclaimSystem: PATCH mark empty failed for" << systemName << "HTTP" << httpStatus;
-            emit systemUnclaimed(systemName, false);
-        }
-    } else if (operation.startsWith("CHECK:system_info_exists_on_claim")) {
-        QString systemName = reply->property("systemName").toString();
-        QString commander = reply->property("commander").toString();
-        QJsonArray existingSystemInfo = response.value("data").toArray();
+        qDebug() << "Emitting categoriesReceived with" << categoriesArray.size() << "total categories (systems + Richard)";
+        emit categoriesReceived(categoriesArray);
         
-        if (existingSystemInfo.isEmpty()) {
-            // REMOVED: DO NOT AUTO-CREATE system_information records
-            // This was causing the duplicates!
-            qDebug() << "No system_information record exists for" << systemName << "- but NOT creating one automatically";
-            qDebug() << "Users can create system_information records manually if needed";
-        } else {
-            qDebug() << "System_information record already exists for" << systemName << "- skipping creation";
-        }
+    } else if (operation.startsWith("GET:preset_images")) {
+        QJsonArray presetImages = data;
         
-    } else if (operation.startsWith("IMGBB:test")) {
+        // Store count for future change detection
+        QJsonObject tables = m_syncState.value("tables").toObject();
+        tables["preset_images_count"] = presetImages.size();
+        m_syncState["tables"] = tables;
+        saveSyncState();
         
-        int httpStatus = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
-        QByteArray responseBody = reply->readAll();
+        emit presetImagesReceived(presetImages);
         
-        qDebug() << "HTTP Status:" << httpStatus;
-        qDebug() << "Response Body:" << responseBody;
+    } else if (operation.startsWith("GET:pois")) {
+        QJsonArray poisData = data;
+        qDebug() << "Received" << poisData.size() << "POI systems from Supabase";
         
-        if (httpStatus == 200 && !responseBody.isEmpty()) {
-            QJsonParseError parseError;
-            QJsonDocument doc = QJsonDocument::fromJson(responseBody, &parseError);
-            
-            if (parseError.error == QJsonParseError::NoError) {
-                QJsonObject jsonResponse = doc.object();
-                bool imgbbSuccess = jsonResponse.value("success").toBool();
-                
-                if (imgbbSuccess) {
-                    qDebug() << "✅ API KEY IS WORKING! ImgBB test upload successful!";
-                    qDebug() << "Your API key is valid and ImgBB is accessible.";
-                } else {
-                    qDebug() << "❌ API key test failed - ImgBB returned success=false";
-                    QJsonObject error = jsonResponse.value("error").toObject();
-                    qDebug() << "Error:" << error.value("message").toString();
-                }
-            } else {
-                qDebug() << "❌ Invalid JSON response from ImgBB";
-            }
-        } else if (httpStatus == 400) {
-            qDebug() << "❌ HTTP 400 - Your API key is likely invalid or expired";
-            qDebug() << "Get a new API key from https://api.imgbb.com/";
-        } else {
-            qDebug() << "❌ Unexpected response - HTTP" << httpStatus;
-            qDebug() << "Response:" << responseBody;
-        }
+        // Store POI data for future merge operations
+        m_pendingPOIData = poisData;
+        qDebug() << "Stored" << poisData.size() << "POI records in cache for merging";
         
-        qDebug() << "=== IMGBB API TEST COMPLETE ===";
+        emit poisReceived(poisData);
     }
-    
-    emit requestCompleted(operation, true, "Success");
-    reply->deleteLater();
 }
 
 QJsonObject SupabaseClient::parseReply(QNetworkReply *reply, bool &success)
@@ -2884,41 +3653,294 @@ QJsonObject SupabaseClient::parseReply(QNetworkReply *reply, bool &success)
     return result;
 }
 
-void SupabaseClient::processSystemsReply(const QJsonArray &data)
+void SupabaseClient::startBulkFetch(SupabaseOperation operation, const QString &endpoint)
+{
+    const QString tag = QString::fromLatin1(supabaseOperationTag(operation));
+    if (m_bulkFetches.contains(int(operation))) {
+        qDebug() << tag << "already loading, joining it";
+        return;
+    }
+    
+    BulkFetch &fetch = m_bulkFetches[int(operation)];
+    fetch.endpoint = endpoint;
+    fetch.timer.start();
+    m_inFlightGets.insert(tag + ' ' + endpoint);
+    
+    // The first page also asks for the row count; the rest are requested once it is known
+    requestBulkPage(operation, 0);
+    fetch.nextOffset = BULK_PAGE_SIZE;
+    if (fetch.inFlight == 0) {
+        finishBulkFetch(operation);
+    }
+}
+
+void SupabaseClient::requestBulkPage(SupabaseOperation operation, int offset)
+{
+    BulkFetch &fetch = m_bulkFetches[int(operation)];
+    QNetworkRequest request = createRequest(QString("%1&limit=%2&offset=%3")
+                                            .arg(fetch.endpoint).arg(BULK_PAGE_SIZE).arg(offset));
+    if (offset == 0) {
+        request.setRawHeader("Prefer", "count=exact");
+    }
+    
+    QNetworkReply *reply = m_networkManager->get(request);
+    if (!reply) {
+        qDebug() << "Failed to create request for" << supabaseOperationTag(operation) << "page at" << offset;
+        fetch.failed = true;
+        return;
+    }
+    trackRequest(reply, operation);
+    requestContext(reply).bulkPage = true;
+    requestContext(reply).offset = offset;
+    fetch.inFlight++;
+}
+
+void SupabaseClient::requestMoreBulkPages(SupabaseOperation operation)
+{
+    BulkFetch &fetch = m_bulkFetches[int(operation)];
+    while (!fetch.failed && fetch.total >= 0 && fetch.nextOffset < fetch.total &&
+           fetch.inFlight < BULK_MAX_PARALLEL_PAGES) {
+        requestBulkPage(operation, fetch.nextOffset);
+        fetch.nextOffset += BULK_PAGE_SIZE;
+    }
+}
+
+void SupabaseClient::handleBulkPage(const SupabaseRequestContext &context, QNetworkReply *reply)
+{
+    const SupabaseOperation operation = context.operation;
+    auto it = m_bulkFetches.find(int(operation));
+    if (it == m_bulkFetches.end()) {
+        return;
+    }
+    BulkFetch &fetch = it.value();
+    
+    if (reply->error() != QNetworkReply::NoError) {
+        if (!fetch.failed) {
+            qWarning() << "Supabase request failed:" << context.tag << "page at" << context.offset << "-" << reply->errorString();
+            emit networkError(reply->errorString());
+        }
+        fetch.failed = true;
+        if (--fetch.inFlight == 0) {
+            finishBulkFetch(operation);
+        }
+        return;
+    }
+    
+    if (context.offset == 0) {
+        // Content-Range: 0-999/12345 (the total is "*" when the server did not count)
+        const QByteArray range = reply->rawHeader("Content-Range");
+        const qsizetype slash = range.lastIndexOf('/');
+        bool ok = false;
+        const int total = slash >= 0 ? range.mid(slash + 1).toInt(&ok) : -1;
+        fetch.total = ok ? total : -1;
+        requestMoreBulkPages(operation);
+    }
+    
+    // Parsing stays with the page, so it never blocks the GUI thread for the whole table
+    const QByteArray body = reply->readAll();
+    const int offset = context.offset;
+    auto *watcher = new QFutureWatcher<ParsedBulkPage>(this);
+    connect(watcher, &QFutureWatcher<ParsedBulkPage>::finished, this, [this, watcher, operation, offset]() {
+        const ParsedBulkPage parsed = watcher->result();
+        watcher->deleteLater();
+        handleBulkPageParsed(operation, offset, parsed.page, parsed.rowCount, parsed.ok);
+    });
+    watcher->setFuture(QtConcurrent::run([operation, body]() {
+        QJsonParseError parseError;
+        const QJsonDocument doc = QJsonDocument::fromJson(body, &parseError);
+        ParsedBulkPage parsed;
+        parsed.ok = parseError.error == QJsonParseError::NoError && doc.isArray();
+        const QJsonArray rows = doc.array();
+        parsed.page = operation == SupabaseOperation::GetSystems ? transformSystemRows(rows) : rows;
+        parsed.rowCount = rows.size();
+        return parsed;
+    }));
+}
+
+void SupabaseClient::handleBulkPageParsed(SupabaseOperation operation, int offset, QJsonArray page, int rowCount, bool ok)
+{
+    auto it = m_bulkFetches.find(int(operation));
+    if (it == m_bulkFetches.end()) {
+        return;
+    }
+    BulkFetch &fetch = it.value();
+    fetch.inFlight--;
+    
+    if (!ok) {
+        if (!fetch.failed) {
+            qWarning() << "Supabase request failed:" << supabaseOperationTag(operation) << "page at" << offset << "- invalid JSON";
+            emit networkError("Invalid response from database");
+        }
+        fetch.failed = true;
+    } else if (!fetch.failed) {
+        fetch.received += rowCount;
+        if (operation == SupabaseOperation::GetSystems) {
+            mergePOIDataIntoSystems(page);
+            fetch.delivered += page.size();
+            emit systemsPageReceived(page, fetch.delivered, fetch.total);
+        }
+        fetch.pages.insert(offset, page);
+        
+        if (fetch.total < 0 && rowCount == BULK_PAGE_SIZE) {
+            // No row count from the server - keep reading one page at a time until a short one
+            requestBulkPage(operation, fetch.nextOffset);
+            fetch.nextOffset += BULK_PAGE_SIZE;
+        }
+        requestMoreBulkPages(operation);
+    }
+    
+    if (fetch.inFlight == 0) {
+        finishBulkFetch(operation);
+    }
+}
+
+void SupabaseClient::finishBulkFetch(SupabaseOperation operation)
+{
+    const BulkFetch fetch = m_bulkFetches.take(int(operation));
+    const QString tag = QString::fromLatin1(supabaseOperationTag(operation));
+    m_inFlightGets.remove(tag + ' ' + fetch.endpoint);
+    if (fetch.failed) {
+        return;
+    }
+    
+    // Pages arrive in any order; the full result keeps the query's order
+    QJsonArray rows;
+    for (const QJsonArray &page : fetch.pages) {
+        for (const QJsonValue &row : page) {
+            rows.append(row);
+        }
+    }
+    qDebug() << tag << "loaded" << fetch.received << "rows in" << fetch.pages.size() << "pages,"
+             << fetch.timer.elapsed() << "ms";
+    
+    if (operation == SupabaseOperation::GetSystems) {
+        // Already transformed and merged with POI data page by page
+        emit systemsReceived(rows);
+    } else {
+        cacheResponse(tag + ' ' + fetch.endpoint, tag, rows);
+        handleListResponse(tag, rows);
+    }
+}
+
+void SupabaseClient::loadCatalogueSystemsPaged()
 {
-    qDebug() << "Received" << data.size() << "systems from database";
+    if (m_bulkFetches.contains(int(SupabaseOperation::GetSystems))) {
+        qDebug() << "GET:systems already loading, joining it";
+        return;
+    }
+    
+    BulkFetch &fetch = m_bulkFetches[int(SupabaseOperation::GetSystems)];
+    fetch.endpoint = "catalogue:systems";
+    fetch.inFlight = 1;
+    fetch.timer.start();
     
+    // Records are shared, not copied; sorting and building the rows happens on the pool
+    const SystemRecordList systems = catalogueSystems();
+    auto *watcher = new QFutureWatcher<QList<QJsonArray>>(this);
+    connect(watcher, &QFutureWatcher<QList<QJsonArray>>::finished, this, [this, watcher]() {
+        const QList<QJsonArray> pages = watcher->result();
+        watcher->deleteLater();
+        
+        auto it = m_bulkFetches.find(int(SupabaseOperation::GetSystems));
+        if (it == m_bulkFetches.end()) {
+            return;
+        }
+        int total = 0;
+        for (const QJsonArray &page : pages) {
+            total += page.size();
+        }
+        it->total = total;
+        it->nextOffset = total;     // Nothing left to request from the server
+        it->inFlight = int(pages.size());
+        qDebug() << "getSystems: serving" << total << "systems from the local catalogue";
+        if (pages.isEmpty()) {
+            finishBulkFetch(SupabaseOperation::GetSystems);
+            return;
+        }
+        
+        // One page per event-loop turn, like pages arriving from the network
+        for (int i = 0; i < pages.size(); ++i) {
+            const QJsonArray page = pages.at(i);
+            const int offset = i * BULK_PAGE_SIZE;
+            QMetaObject::invokeMethod(this, [this, page, offset]() {
+                handleBulkPageParsed(SupabaseOperation::GetSystems, offset, page, int(page.size()), true);
+            }, Qt::QueuedConnection);
+        }
+    });
+    watcher->setFuture(QtConcurrent::run([systems]() {
+        // Same order as the server query: category, then system name
+        QVector<int> order(systems.size());
+        for (int i = 0; i < order.size(); ++i) {
+            order[i] = i;
+        }
+        std::sort(order.begin(), order.end(), [&systems](int a, int b) {
+            const int byCategory = QString::compare(systems.at(a).categories.value(0), systems.at(b).categories.value(0));
+            return byCategory != 0 ? byCategory < 0 : systems.at(a).name < systems.at(b).name;
+        });
+        
+        QList<QJsonArray> pages;
+        QJsonArray rows;
+        for (int index : std::as_const(order)) {
+            const SystemRecord &system = systems.at(index);
+            QJsonObject row;
+            row["systems"] = system.name;
+            row["category"] = system.categories.value(0);
+            row["x"] = system.x;
+            row["y"] = system.y;
+            row["z"] = system.z;
+            rows.append(row);
+            if (rows.size() == BULK_PAGE_SIZE) {
+                pages.append(transformSystemRows(rows));
+                rows = QJsonArray();
+            }
+        }
+        if (!rows.isEmpty()) {
+            pages.append(transformSystemRows(rows));
+        }
+        return pages;
+    }));
+}
+
+QJsonArray SupabaseClient::transformSystemRows(const QJsonArray &data)
+{
     // Transform database format to match our UI expectations
     QJsonArray transformedSystems;
     for (const QJsonValue &value : data) {
         QJsonObject system = value.toObject();
+        QString category = system["category"].toString();
+        
+        // Filter out test/debug categories
+        if (category == "TEST_CATEGORY" || category.startsWith("test_")) {
+            continue;
+        }
+        
         QJsonObject transformed;
         
         // Map database fields to expected UI fields
         transformed["name"] = system["systems"];  // systems → name
         transformed["category"] = system["category"];
-        transformed["x"] = system["x"];
-        transformed["y"] = system["y"];
-        transformed["z"] = system["z"];
         
-        // Calculate distance from Sol (0,0,0) for now
+        // Coordinates ARE available in systems table!
         double x = system["x"].toDouble();
-        double y = system["y"].toDouble(); 
+        double y = system["y"].toDouble();
         double z = system["z"].toDouble();
+        transformed["x"] = x;
+        transformed["y"] = y;
+        transformed["z"] = z;
+        
+        // Calculate distance from Sol (0,0,0)
         double distance = std::sqrt(x*x + y*y + z*z);
         transformed["distance"] = QString::number(distance, 'f', 1) + " LY";
         
         // Add default values for fields we don't have yet
-        transformed["poi"] = "";  // Will be filled from POI table join later
-        transformed["claimed"] = false;  // Will be filled from taken table join later
+        transformed["poi"] = "";  // Will be populated from system_information
+        transformed["claimed"] = false;  // Will implement claims tracking later
         transformed["done"] = false;
         transformed["claimedBy"] = "";
         
         transformedSystems.append(transformed);
     }
-    
-    qDebug() << "Transformed" << transformedSystems.size() << "systems for UI";
-    emit systemsReceived(transformedSystems);
+    return transformedSystems;
 }
 
 // Database sync implementation
@@ -2945,119 +3967,522 @@ void SupabaseClient::loadSyncState()
     }
 }
 
-void SupabaseClient::saveSyncState()
+void SupabaseClient::saveSyncState()
+{
+    QFile file(m_syncStateFile);
+    if (file.open(QIODevice::WriteOnly)) {
+        QJsonDocument doc(m_syncState);
+        file.write(doc.toJson());
+        file.close();
+    } else {
+        qDebug() << "Failed to save sync state file:" << file.errorString();
+    }
+}
+
+bool SupabaseClient::isFirstRun() const
+{
+    return m_syncState.value("first_run").toBool(true);
+}
+
+void SupabaseClient::initializeDatabaseSync()
+{
+    if (m_syncInProgress) {
+        qDebug() << "Database sync already in progress";
+        return;
+    }
+    
+    qDebug() << "Initializing database sync...";
+    m_syncInProgress = true;
+    
+    if (isFirstRun()) {
+        emit databaseSyncStatusChanged("Downloading Database");
+        qDebug() << "First run detected - performing full database download";
+        performFullSync();
+    } else {
+        emit databaseSyncStatusChanged("Checking Database for changes");
+        qDebug() << "Checking for database updates since last sync";
+        checkForDatabaseUpdates();
+    }
+}
+
+void SupabaseClient::checkForDatabaseUpdates()
+{
+    if (m_supabaseUrl.isEmpty() || m_supabaseKey.isEmpty()) {
+        qDebug() << "Supabase not configured for database updates check";
+        finalizeDatabaseSync(false, 0);
+        return;
+    }
+    
+    QString lastSync = m_syncState.value("last_sync").toString();
+    qDebug() << "Checking for updates since:" << lastSync;
+    
+    // Each catalogue table only pulls rows past its high-water mark;
+    // the preset images check runs once the catalogue is current
+    startCatalogueSync(LocalCatalogue::tables());
+}
+
+void SupabaseClient::checkPresetImagesForChanges()
+{
+    emit databaseSyncProgress(LocalCatalogue::tables().size() + 1, LocalCatalogue::tables().size() + 1,
+                              "Checking preset images");
+    
+    // Start with checking preset images count by selecting id only (lightweight)
+    QString endpoint = "preset_images?select=id";
+    QNetworkRequest request = createRequest(endpoint);
+    QNetworkReply *reply = m_networkManager->get(request);
+    
+    if (reply) {
+        trackRequest(reply, SupabaseOperation::CheckPresetImagesCount);
+        qDebug() << "Checking preset images count for changes";
+    }
+}
+
+void SupabaseClient::performIncrementalSync()
+{
+    qDebug() << "Performing incremental database sync";
+    
+    // Get only new/updated records since last sync
+    QString lastSync = m_syncState.value("last_sync").toString();
+    
+    if (lastSync.isEmpty()) {
+        // No previous sync, do full sync
+        performFullSync();
+        return;
+    }
+    
+    checkForDatabaseUpdates();
+}
+
+void SupabaseClient::performFullSync()
+{
+    qDebug() << "Performing full database sync";
+    
+    // Download all essential data
+    getPresetImages(true);
+    getCategories();
+    
+    // Tables without a high-water mark yet are downloaded in full
+    startCatalogueSync(LocalCatalogue::tables());
+}
+
+QJsonArray SupabaseClient::localTakenSystems() const
+{
+    // Newest claims first, like the taken query
+    QJsonArray rows = m_catalogue.rows("taken");
+    QVector<QJsonObject> sorted;
+    sorted.reserve(rows.size());
+    for (const QJsonValue &value : rows) {
+        sorted.append(value.toObject());
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const QJsonObject &a, const QJsonObject &b) {
+        return a.value("id").toDouble() > b.value("id").toDouble();
+    });
+    
+    // Claims and status changes made offline read as if the server already had them
+    QHash<QString, QJsonObject> changed;
+    QStringList added;
+    if (!m_offlineMutations.isEmpty()) {
+        QHash<QString, int> index;
+        for (int i = 0; i < sorted.size(); ++i) {
+            index.insert(sorted[i].value("system").toString(), i);
+        }
+        for (const QJsonObject &entry : m_offlineMutations) {
+            const QString op = entry.value("op").toString();
+            const QString systemName = entry.value("system").toString();
+            const bool known = changed.contains(systemName) || index.contains(systemName);
+            if ((op != "claim" && op != "unclaim" && op != "taken_update") || (!known && op != "claim")) {
+                continue;
+            }
+            
+            QJsonObject row = changed.contains(systemName) ? changed.value(systemName)
+                            : index.contains(systemName) ? sorted[index.value(systemName)]
+                                                         : QJsonObject{{"system", systemName}};
+            if (!known) {
+                added.prepend(systemName);
+            }
+            if (op == "claim") {
+                row["by_cmdr"] = entry.value("commander");
+                row["done"] = false;
+            } else if (op == "unclaim") {
+                row["by_cmdr"] = QStringLiteral("empty");
+            } else {
+                const QJsonObject fields = entry.value("fields").toObject();
+                for (auto it = fields.constBegin(); it != fields.constEnd(); ++it) {
+                    row.insert(it.key(), it.value());
+                }
+            }
+            changed.insert(systemName, row);
+        }
+    }
+    
+    QJsonArray taken;
+    for (const QString &systemName : std::as_const(added)) {
+        taken.append(changed.value(systemName));
+    }
+    for (const QJsonObject &row : sorted) {
+        taken.append(changed.value(row.value("system").toString(), row));
+    }
+    return taken;
+}
+
+void SupabaseClient::applyTakenWrite(const QJsonArray &rows)
+{
+    // Rows this client just wrote go into the local copy straight away, so a refresh served
+    // from it doesn't undo the claim before the next sync has read it back
+    if (rows.isEmpty() || !m_catalogue.hasTable("taken")) {
+        return;
+    }
+    if (m_catalogueSyncTable == "taken") {
+        // A download of the table is staged; committing now would cut it short
+        for (const QJsonValue &value : rows) {
+            m_pendingTakenRows.append(value);
+        }
+        return;
+    }
+    
+    bool changed = false;
+    for (const QJsonValue &value : rows) {
+        changed = m_catalogue.upsert("taken", value.toObject()) || changed;
+    }
+    if (changed) {
+        m_catalogue.commit("taken");
+    }
+}
+
+QJsonArray SupabaseClient::localTakenRowsWith(const QStringList &systemNames, const QJsonObject &fields) const
 {
-    QFile file(m_syncStateFile);
-    if (file.open(QIODevice::WriteOnly)) {
-        QJsonDocument doc(m_syncState);
-        file.write(doc.toJson());
-        file.close();
-    } else {
-        qDebug() << "Failed to save sync state file:" << file.errorString();
+    // The stored rows for these systems with fields applied, for writes whose reply came back empty
+    QJsonArray rows;
+    for (const QJsonValue &value : m_catalogue.rows("taken")) {
+        QJsonObject row = value.toObject();
+        if (!systemNames.contains(row.value("system").toString())) {
+            continue;
+        }
+        for (auto it = fields.constBegin(); it != fields.constEnd(); ++it) {
+            row.insert(it.key(), it.value());
+        }
+        rows.append(row);
     }
+    return rows;
 }
 
-bool SupabaseClient::isFirstRun() const
+QJsonArray SupabaseClient::localSystemInformation(const QStringList &systemNames) const
 {
-    return m_syncState.value("first_run").toBool(true);
+    // All rows, or only those of the named systems, with POI changes made offline applied
+    const QSet<QString> wanted(systemNames.begin(), systemNames.end());
+    QJsonArray rows;
+    QHash<QString, int> index;
+    for (const QJsonValue &value : m_catalogue.rows("system_information")) {
+        const QString systemName = value.toObject().value("system").toString();
+        if (wanted.isEmpty() || wanted.contains(systemName)) {
+            index.insert(systemName, rows.size());
+            rows.append(value);
+        }
+    }
+    
+    for (const QJsonObject &entry : m_offlineMutations) {
+        const QString op = entry.value("op").toString();
+        const QString systemName = entry.value("system").toString();
+        if (!op.startsWith("poi_") || (!wanted.isEmpty() && !wanted.contains(systemName))) {
+            continue;
+        }
+        
+        QJsonObject row = index.contains(systemName) ? rows[index.value(systemName)].toObject()
+                                                     : QJsonObject{{"system", systemName}};
+        if (op == "poi_clear") {
+            row["potential_or_poi"] = QJsonValue::Null;
+        } else {
+            row["potential_or_poi"] = entry.value("poi_type");
+            row["discoverer"] = entry.value(op == "poi_set" ? "commander" : "discoverer");
+            row["submitter"] = entry.value(op == "poi_set" ? "commander" : "submitter");
+        }
+        
+        if (index.contains(systemName)) {
+            rows[index.value(systemName)] = row;
+        } else {
+            index.insert(systemName, rows.size());
+            rows.append(row);
+        }
+    }
+    return rows;
 }
 
-void SupabaseClient::initializeDatabaseSync()
+void SupabaseClient::startCatalogueSync(const QStringList &tables)
 {
-    if (m_syncInProgress) {
-        qDebug() << "Database sync already in progress";
+    if (m_catalogueSyncing) {
+        // The running sync already covers every table it was asked for; add the rest
+        for (const QString &table : tables) {
+            if (!m_catalogueSyncQueue.contains(table) && table != m_catalogueSyncTable) {
+                m_catalogueSyncQueue.append(table);
+            }
+        }
         return;
     }
     
-    qDebug() << "Initializing database sync...";
-    m_syncInProgress = true;
+    if (m_supabaseUrl.isEmpty() || m_supabaseKey.isEmpty()) {
+        qDebug() << "Supabase not configured for catalogue sync";
+        return;
+    }
     
-    if (isFirstRun()) {
-        emit databaseSyncStatusChanged("Downloading Database");
-        qDebug() << "First run detected - performing full database download";
-        performFullSync();
-    } else {
-        emit databaseSyncStatusChanged("Checking Database for changes");
-        qDebug() << "Checking for database updates since last sync";
-        checkForDatabaseUpdates();
+    if (m_offline) {
+        qDebug() << "Offline - catalogue sync skipped, serving the local copy";
+        if (m_syncInProgress) {
+            finalizeDatabaseSync(false, 0);
+        }
+        return;
     }
+    
+    m_catalogueSyncing = true;
+    m_catalogueSyncQueue = tables;
+    m_catalogueChangedTables.clear();
+    m_catalogueSyncTimer.start();
+    syncNextCatalogueTable();
 }
 
-void SupabaseClient::checkForDatabaseUpdates()
+void SupabaseClient::syncNextCatalogueTable()
 {
-    if (m_supabaseUrl.isEmpty() || m_supabaseKey.isEmpty()) {
-        qDebug() << "Supabase not configured for database updates check";
-        finalizeDatabaseSync(false, 0);
+    if (m_catalogueSyncQueue.isEmpty()) {
+        finishCatalogueSync();
         return;
     }
     
-    QString lastSync = m_syncState.value("last_sync").toString();
-    qDebug() << "Checking for updates since:" << lastSync;
-    
-    // Check each table for updates (simplified approach)
-    // In a real implementation, you'd query with timestamps
-    
-    // For now, we'll check if preset_images table has changes
-    // by comparing count or using a simple heuristic
-    emit databaseSyncProgress(1, 3, "Checking preset images");
+    m_catalogueSyncTable = m_catalogueSyncQueue.takeFirst();
+    if (m_syncInProgress) {
+        const int total = LocalCatalogue::tables().size() + 1;
+        emit databaseSyncProgress(total - m_catalogueSyncQueue.size() - 1, total,
+                                  QString("Syncing %1").arg(m_catalogueSyncTable));
+    }
+    
+    // Nothing stored yet, or no usable cursor column: the table is downloaded whole. An id
+    // cursor only finds new rows, which is enough for the append-only systems table; the
+    // others are edited in place (claims, releases, done/visited, POIs) and are re-read whole.
+    const QJsonObject state = m_syncState.value("tables").toObject().value(m_catalogueSyncTable).toObject();
+    const QString cursor = state.value("cursor").toString();
+    const bool fullDownload = !m_catalogue.hasTable(m_catalogueSyncTable) ||
+                              cursor == "none" ||
+                              (cursor == "id" && m_catalogueSyncTable != "systems") ||
+                              state.value("high_water").toString().isEmpty();
+    if (fullDownload) {
+        m_catalogue.beginReplace(m_catalogueSyncTable);
+    }
+    requestCataloguePage(m_catalogueSyncTable, 0, QString(), 0, fullDownload);
+}
+
+void SupabaseClient::requestCataloguePage(const QString &table, int offset, const QString &highWater,
+                                          int changes, bool fullDownload)
+{
+    // Prefer updated_at so edits are picked up; fall back to id (new rows only) and then to none
+    const QJsonObject state = m_syncState.value("tables").toObject().value(table).toObject();
+    const QString cursor = state.value("cursor").toString("updated_at");
+    const QString storedHighWater = fullDownload ? QString() : state.value("high_water").toString();
+    
+    QString endpoint = QString("%1?select=*").arg(table);
+    if (cursor != "none") {
+        if (!storedHighWater.isEmpty()) {
+            // Timestamps can repeat, so rows at the mark are fetched again and deduplicated by upsert
+            endpoint += QString("&%1=%2.%3").arg(cursor, cursor == "id" ? "gt" : "gte",
+                                                 QString::fromUtf8(QUrl::toPercentEncoding(storedHighWater)));
+        }
+        endpoint += QString("&order=%1.asc").arg(cursor);
+    } else {
+        // Offset paging needs a stable order, or rows can repeat or go missing between pages
+        QStringList order;
+        for (const QString &column : LocalCatalogue::keyColumns(table)) {
+            order.append(column + ".asc");
+        }
+        endpoint += "&order=" + order.join(',');
+    }
+    endpoint += QString("&limit=%1&offset=%2").arg(CATALOGUE_PAGE_SIZE).arg(offset);
     
-    // Start with checking preset images count by selecting id only (lightweight)
-    QString endpoint = "preset_images?select=id";
-    QNetworkRequest request = createRequest(endpoint);
+    QNetworkReply *reply = m_networkManager->get(createRequest(endpoint));
+    if (reply) {
+        trackRequest(reply, SupabaseOperation::SyncPage);
+        requestContext(reply).table = table;
+        requestContext(reply).cursor = cursor;
+        requestContext(reply).offset = offset;
+        requestContext(reply).highWater = highWater.isEmpty() ? storedHighWater : highWater;
+        requestContext(reply).changes = changes;
+        requestContext(reply).fullDownload = fullDownload;
+    } else {
+        m_catalogue.discard(table);
+        syncNextCatalogueTable();
+    }
+}
+
+void SupabaseClient::requestCatalogueCount(const QString &table, bool afterFullDownload)
+{
+    // Rows deleted on the server never pass a high-water mark; a count mismatch finds them
+    QNetworkRequest request = createRequest(QString("%1?select=*&limit=1").arg(table));
+    request.setRawHeader("Prefer", "count=exact");
     QNetworkReply *reply = m_networkManager->get(request);
-    
     if (reply) {
-        reply->setProperty("operation", "CHECK:preset_images_count");
-        qDebug() << "Checking preset images count for changes";
+        trackRequest(reply, SupabaseOperation::SyncCount);
+        requestContext(reply).table = table;
+        requestContext(reply).fullDownload = afterFullDownload;
+    } else {
+        syncNextCatalogueTable();
     }
 }
 
-void SupabaseClient::performIncrementalSync()
+void SupabaseClient::handleCatalogueReply(const SupabaseRequestContext &context, QNetworkReply *reply)
 {
-    qDebug() << "Performing incremental database sync";
+    const QString &table = context.table;
+    const bool fullDownload = context.fullDownload;
+    const int httpStatus = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    
+    QJsonObject tables = m_syncState.value("tables").toObject();
+    QJsonObject state = tables.value(table).toObject();
+    
+    if (context.operation == SupabaseOperation::SyncCount) {
+        const QByteArray range = reply->rawHeader("Content-Range");
+        const qsizetype slash = range.lastIndexOf('/');
+        bool ok = false;
+        const int serverRows = slash >= 0 ? range.mid(slash + 1).toInt(&ok) : -1;
+        
+        if (reply->error() == QNetworkReply::NoError && ok && serverRows != m_catalogue.rowCount(table) && !fullDownload) {
+            qDebug() << "Catalogue" << table << "has" << m_catalogue.rowCount(table) << "rows, server has"
+                     << serverRows << "- downloading it again";
+            m_catalogue.beginReplace(table);
+            requestCataloguePage(table, 0, QString(), 0, true);
+            return;
+        }
+        syncNextCatalogueTable();
+        return;
+    }
     
-    // Get only new/updated records since last sync
-    QString lastSync = m_syncState.value("last_sync").toString();
+    const QString &cursor = context.cursor;
+    const int offset = context.offset;
     
-    if (lastSync.isEmpty()) {
-        // No previous sync, do full sync
-        performFullSync();
+    if (reply->error() != QNetworkReply::NoError) {
+        if (httpStatus == 400 && offset == 0 && cursor != "none") {
+            // The table has no such column - try the next cursor
+            const QString nextCursor = cursor == "updated_at" ? "id" : "none";
+            qDebug() << "Catalogue" << table << "has no" << cursor << "column, falling back to" << nextCursor;
+            state["cursor"] = nextCursor;
+            state["high_water"] = QString();
+            tables[table] = state;
+            m_syncState["tables"] = tables;
+            saveSyncState();
+            
+            m_catalogue.beginReplace(table);
+            requestCataloguePage(table, 0, QString(), 0, true);
+            return;
+        }
+        
+        // Keep the rows we already have and move on
+        qDebug() << "Catalogue sync failed for" << table << "-" << reply->errorString();
+        m_catalogue.discard(table);
+        syncNextCatalogueTable();
         return;
     }
     
-    // Check for changes in each critical table
-    emit databaseSyncProgress(1, 4, "Syncing preset images");
-    getPresetImages(true);
+    const QJsonArray rows = QJsonDocument::fromJson(reply->readAll()).array();
+    QString highWater = context.highWater;
+    int changes = context.changes;
+    
+    for (const QJsonValue &value : rows) {
+        const QJsonObject row = value.toObject();
+        if (m_catalogue.upsert(table, row)) {
+            changes++;
+        }
+        
+        if (cursor == "id") {
+            const double id = row.value("id").toDouble();
+            if (highWater.isEmpty() || id > highWater.toDouble()) {
+                highWater = QString::number(qint64(id));
+            }
+        } else if (cursor == "updated_at") {
+            // ISO timestamps from the same server compare correctly as strings
+            const QString updatedAt = row.value("updated_at").toString();
+            if (updatedAt > highWater) {
+                highWater = updatedAt;
+            }
+        }
+    }
+    
+    if (rows.size() == CATALOGUE_PAGE_SIZE) {
+        requestCataloguePage(table, offset + CATALOGUE_PAGE_SIZE, highWater, changes, fullDownload);
+        return;
+    }
+    
+    // A full download drops rows deleted on the server, which upsert() doesn't count
+    const int storedRows = m_catalogue.rowCount(table);
+    m_catalogue.commit(table);
+    if (fullDownload && changes == 0 && m_catalogue.rowCount(table) != storedRows) {
+        changes = qAbs(m_catalogue.rowCount(table) - storedRows);
+    }
+    if (table == "taken" && !m_pendingTakenRows.isEmpty()) {
+        // Our own writes are newer than whatever the pages were read before them
+        for (const QJsonValue &value : std::as_const(m_pendingTakenRows)) {
+            if (m_catalogue.upsert(table, value.toObject())) {
+                changes++;
+            }
+        }
+        m_pendingTakenRows = QJsonArray();
+        m_catalogue.commit(table);
+    }
+    
+    m_catalogueSyncedAt.insert(table, QDateTime::currentMSecsSinceEpoch());
+    state["cursor"] = cursor;
+    state["high_water"] = highWater;
+    state["rows"] = m_catalogue.rowCount(table);
+    tables[table] = state;
+    m_syncState["tables"] = tables;
+    saveSyncState();
+    
+    if (changes > 0) {
+        m_catalogueChanges += changes;
+        if (!m_catalogueChangedTables.contains(table)) {
+            m_catalogueChangedTables.append(table);
+        }
+    }
+    qDebug() << "Catalogue" << table << "synced:" << changes << "changed rows," << m_catalogue.rowCount(table) << "stored";
     
-    // Note: In a full implementation, you'd check updated_at timestamps
-    // and only fetch records newer than lastSync
+    if (cursor == "none") {
+        syncNextCatalogueTable();
+    } else {
+        requestCatalogueCount(table, fullDownload);
+    }
 }
 
-void SupabaseClient::performFullSync()
+void SupabaseClient::finishCatalogueSync()
 {
-    qDebug() << "Performing full database sync";
-    
-    // Download all essential data
-    emit databaseSyncProgress(1, 4, "Downloading preset images");
-    getPresetImages(true);
-    
-    emit databaseSyncProgress(2, 4, "Downloading categories");
-    getCategories();
+    m_catalogueSyncing = false;
+    m_catalogueSyncTable.clear();
+    qDebug() << "Catalogue sync finished in" << m_catalogueSyncTimer.elapsed() << "ms, changed tables:" << m_catalogueChangedTables;
     
-    emit databaseSyncProgress(3, 4, "Downloading system data");
-    // Note: We'll use a smaller subset for initial load
+    if (m_catalogueChangedTables.contains("systems")) {
+        m_catalogueSystemsStale = true;
+    }
+    if (m_catalogueChangedTables.contains("taken")) {
+        emit takenSystemsReceived(localTakenSystems());
+    }
+    emit catalogueUpdated(m_catalogueChangedTables);
     
-    emit databaseSyncProgress(4, 4, "Finalizing");
+    if (m_replayOfflineAfterSync) {
+        m_replayOfflineAfterSync = false;
+        replayOfflineMutations();
+    }
     
-    // Mark as no longer first run
-    m_syncState["first_run"] = false;
-    saveSyncState();
+    if (m_syncInProgress) {
+        if (isFirstRun()) {
+            finalizeDatabaseSync(true, 0);
+            m_syncState["first_run"] = false;
+            saveSyncState();
+        } else {
+            checkPresetImagesForChanges();
+        }
+    }
 }
 
 void SupabaseClient::finalizeDatabaseSync(bool success, int changesDetected)
 {
     m_syncInProgress = false;
     
+    // Rows the catalogue sync applied count as changes too
+    changesDetected += m_catalogueChanges;
+    m_catalogueChanges = 0;
+    
     if (success) {
         // Update sync timestamp
         m_syncState["last_sync"] = QDateTime::currentDateTime().toString(Qt::ISODate);
@@ -3090,6 +4515,14 @@ void SupabaseClient::markSystemAsPOI(const QString &systemName, const QString &p
         return;
     }
     
+    if (m_offline) {
+        journalOfflineMutation({{"op", "poi_set"}, {"system", systemName}, {"commander", commander},
+                                {"poi_type", poiType}, {"base_poi", cataloguePoiValue(systemName)}});
+        emit requestCompleted("markSystemAsPOI", true, QString("System marked as %1 (offline)").arg(poiType));
+        fetchAndMergePOIData({systemName});
+        return;
+    }
+    
     qDebug() << "Marking system" << systemName << "as" << poiType << "by commander" << commander;
     
     // Set commander context for RLS policies
@@ -3112,9 +4545,9 @@ void SupabaseClient::markSystemAsPOI(const QString &systemName, const QString &p
         upsert["submitter"] = commander;
         QNetworkReply *upsertReply = m_networkManager->post(upsertReq, QJsonDocument(upsert).toJson());
         if (upsertReply) {
-            upsertReply->setProperty("operation", "UPSERT:system_information_poi_set");
-            upsertReply->setProperty("systemName", systemName);
-            upsertReply->setProperty("poiType", poiType);
+            trackRequest(upsertReply, SupabaseOperation::UpsertSystemInformationPoiSet);
+            requestContext(upsertReply).systemName = systemName;
+            requestContext(upsertReply).poiType = poiType;
             qDebug() << "UPSERT system_information potential_or_poi for" << systemName << "=" << poiType;
         }
     }
@@ -3133,6 +4566,14 @@ void SupabaseClient::removePOIStatus(const QString &systemName, const QString &c
         return;
     }
     
+    if (m_offline) {
+        journalOfflineMutation({{"op", "poi_clear"}, {"system", systemName}, {"commander", commander},
+                                {"base_poi", cataloguePoiValue(systemName)}});
+        emit requestCompleted("removePOIStatus", true, "POI status removed (offline)");
+        fetchAndMergePOIData({systemName});
+        return;
+    }
+    
     qDebug() << "Removing POI status for system" << systemName << "by commander" << commander;
     
     // Set commander context for RLS policies
@@ -3149,8 +4590,8 @@ void SupabaseClient::removePOIStatus(const QString &systemName, const QString &c
         QJsonObject patchObj; patchObj["potential_or_poi"] = QJsonValue::Null;
         QNetworkReply *clearReply = m_networkManager->sendCustomRequest(clearReq, "PATCH", QJsonDocument(patchObj).toJson());
         if (clearReply) {
-            clearReply->setProperty("operation", "UPDATE:system_information_poi_clear");
-            clearReply->setProperty("systemName", systemName);
+            trackRequest(clearReply, SupabaseOperation::UpdateSystemInformationPoiClear);
+            requestContext(clearReply).systemName = systemName;
             qDebug() << "PATCH system_information set potential_or_poi = null for" << systemName;
         }
     }
@@ -3161,8 +4602,8 @@ void SupabaseClient::removePOIStatus(const QString &systemName, const QString &c
     QNetworkReply *reply = m_networkManager->deleteResource(request);
     
     if (reply) {
-        reply->setProperty("operation", "DELETE:pois");
-        reply->setProperty("systemName", systemName);
+        trackRequest(reply, SupabaseOperation::DeletePois);
+        requestContext(reply).systemName = systemName;
         qDebug() << "removePOIStatus: Request sent, operation tagged as DELETE:pois";
     } else {
         qDebug() << "removePOIStatus: Failed to create network request!";
@@ -3203,8 +4644,8 @@ void SupabaseClient::saveSystemDescription(const QString &systemName, const QStr
     QNetworkReply *reply = m_networkManager->post(request, doc.toJson());
     
     if (reply) {
-        reply->setProperty("operation", "POST:system_information");
-        reply->setProperty("systemName", systemName);
+        trackRequest(reply, SupabaseOperation::PostSystemInformation);
+        requestContext(reply).systemName = systemName;
         qDebug() << "saveSystemDescription: Request sent, operation tagged as POST:system_information";
     } else {
         qDebug() << "saveSystemDescription: Failed to create network request!";
@@ -3251,7 +4692,7 @@ void SupabaseClient::testImgbbApiKey()
     }
     
     if (reply) {
-        reply->setProperty("operation", "IMGBB:test");
+        trackRequest(reply, SupabaseOperation::ImgbbTest);
         qDebug() << "ImgBB API test request sent";
     }
 }
@@ -3279,8 +4720,8 @@ void SupabaseClient::getPresetImageForCategory(const QString &category)
     QNetworkReply *reply = m_networkManager->get(request);
     
     if (reply) {
-        reply->setProperty("operation", "GET:preset_image_category");
-        reply->setProperty("category", category);
+        trackRequest(reply, SupabaseOperation::GetPresetImageCategory);
+        requestContext(reply).category = category;
     }
 }
 
@@ -3422,16 +4863,16 @@ void SupabaseClient::startImgbbUpload(const QString &filePath, const QString &sy
     QNetworkReply *reply = m_networkManager->post(request, formData);
 
     if (reply) {
-        reply->setProperty("operation", "IMGBB:upload");
-        reply->setProperty("systemName", systemName);
-        reply->setProperty("filePath", filePath);
-        reply->setProperty("attempt", attempt);
+        trackRequest(reply, SupabaseOperation::ImgbbUpload);
+        requestContext(reply).systemName = systemName;
+        requestContext(reply).filePath = filePath;
+        requestContext(reply).attempt = attempt;
         
         // Add debug tracking for reply lifecycle
         qDebug() << "=== IMGBB REPLY LIFECYCLE DEBUG ===";
         qDebug() << "Reply created successfully, pointer:" << reply;
         qDebug() << "Reply URL:" << reply->url().toString();
-        qDebug() << "Reply operation:" << reply->property("operation").toString();
+        qDebug() << "Reply operation:" << supabaseOperationTag(SupabaseOperation::ImgbbUpload);
         
         // Connect to additional debugging signals
         connect(reply, &QNetworkReply::errorOccurred, [=](QNetworkReply::NetworkError error) {
@@ -3474,18 +4915,14 @@ void SupabaseClient::startImgbbUpload(const QString &filePath, const QString &sy
         qDebug() << "Request sent to imgbb API";
         qDebug() << "=== END IMGBB REPLY LIFECYCLE DEBUG ===";
         // One-shot retry on protocol failure/timeouts
-        connect(reply, &QNetworkReply::finished, this, [this, reply]() {
-            QString op = reply->property("operation").toString();
-            if (!op.startsWith("IMGBB:upload")) return;
+        connect(reply, &QNetworkReply::finished, this, [this, reply, filePath, systemName, attempt]() {
             int httpStatus = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
             QNetworkReply::NetworkError nerr = reply->error();
-            int attemptProp = reply->property("attempt").toInt();
-            if ((nerr == QNetworkReply::ProtocolFailure || httpStatus == 0 || nerr == QNetworkReply::TimeoutError) && attemptProp < IMGBB_MAX_ATTEMPTS) {
-                QString system = reply->property("systemName").toString();
-                QString path = reply->property("filePath").toString();
-                qWarning() << "IMGBB upload failed, retrying with fresh connection. Attempt" << (attemptProp+1);
-                QTimer::singleShot(200, this, [this, path, system, attemptProp]() {
-                    startImgbbUpload(path, system, attemptProp + 1);
+            if ((nerr == QNetworkReply::ProtocolFailure || httpStatus == 0 || nerr == QNetworkReply::TimeoutError) && attempt < IMGBB_MAX_ATTEMPTS) {
+                qWarning() << "IMGBB upload failed, retrying with fresh connection. Attempt" << (attempt+1);
+                m_networkMetrics.recordRetry(QString::fromLatin1(supabaseOperationTag(SupabaseOperation::ImgbbUpload)));
+                QTimer::singleShot(200, this, [this, filePath, systemName, attempt]() {
+                    startImgbbUpload(filePath, systemName, attempt + 1);
                 });
             }
         });
@@ -3518,8 +4955,8 @@ void SupabaseClient::performSecurityCheck(const QString &commanderName)
     QString endpoint = QString("security?name=eq.%1&select=name,blocked,notes").arg(commanderName);
     QNetworkRequest request = createRequest(endpoint);
     QNetworkReply *reply = m_networkManager->get(request);
-    reply->setProperty("operation", "security_check");
-    reply->setProperty("commander_name", commanderName);
+    trackRequest(reply, SupabaseOperation::SecurityCheck);
+    requestContext(reply).commanderName = commanderName;
 }
 
 void SupabaseClient::handleNewCommander(const QString &commanderName, const QStringList &allCommanders)
@@ -3542,9 +4979,9 @@ void SupabaseClient::handleNewCommander(const QString &commanderName, const QStr
                 QString endpoint = QString("security?name=eq.%1&blocked=eq.true&select=name").arg(otherCmdr);
                 QNetworkRequest request = createRequest(endpoint);
                 QNetworkReply *reply = m_networkManager->get(request);
-                reply->setProperty("operation", "check_banned_alt");
-                reply->setProperty("commander_name", commanderName);
-                reply->setProperty("alt_commander", otherCmdr);
+                trackRequest(reply, SupabaseOperation::CheckBannedAlt);
+                requestContext(reply).commanderName = commanderName;
+                requestContext(reply).altCommander = otherCmdr;
             }
         }
         
@@ -3565,15 +5002,12 @@ void SupabaseClient::handleNewCommander(const QString &commanderName, const QStr
     QNetworkRequest request = createRequest("security");
     QJsonDocument doc(securityData);
     QNetworkReply *reply = m_networkManager->post(request, doc.toJson());
-    reply->setProperty("operation", "add_new_commander");
-    reply->setProperty("commander_name", commanderName);
+    trackRequest(reply, SupabaseOperation::AddNewCommander);
+    requestContext(reply).commanderName = commanderName;
 }
 
 void SupabaseClient::detectCommanderRenames(const QString &journalPath)
 {
-    QStringList allCommanders;
-    QStringList switchUserEvents;
-    
     qDebug() << "[DEBUG] Scanning journal files for all commanders in:" << journalPath;
     
     QDir journalDir(journalPath);
@@ -3583,94 +5017,67 @@ void SupabaseClient::detectCommanderRenames(const QString &journalPath)
         return;
     }
     
-    // Get all journal files, sorted by date (newest first)
-    QStringList filters;
-    filters << "Journal.*.log";
-    QFileInfoList journalFiles = journalDir.entryInfoList(filters, QDir::Files | QDir::Readable, QDir::Time);
+    // The scan runs on the worker pool; processCommanderRenameScan() finishes the job
+    m_pendingRenameScanPath = journalPath;
+    JournalIndex::instance().refreshAsync(journalPath);
+}
+
+void SupabaseClient::processCommanderRenameScan(const QList<JournalFileSummary> &summaries)
+{
+    QStringList allCommanders;
+    QStringList switchUserEvents;
     
-    qDebug() << "[DEBUG] Found" << journalFiles.size() << "journal files to scan";
+    qDebug() << "[DEBUG] Found" << summaries.size() << "journal files to scan";
     
     QMap<QString, QJsonObject> commanderData; // commander name -> {fid, first_seen, sessions}
     
-    // Scan through journals (limit to recent ones for performance)
-    for (int i = 0; i < qMin(50, journalFiles.size()); i++) {
-        const QFileInfo &fileInfo = journalFiles[i];
-        QString journalFile = fileInfo.absoluteFilePath();
-        QString fileName = fileInfo.fileName();
-        
-        qDebug() << "[DEBUG] Scanning journal:" << fileName;
+    // Scan through journals (limit to recent ones, as before)
+    for (int i = 0; i < qMin(50, summaries.size()); i++) {
+        const JournalFileSummary &summary = summaries[i];
+        QString fileName = summary.fileName();
         
-        QFile file(journalFile);
-        if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-            qDebug() << "[DEBUG] Error reading" << fileName;
-            continue;
+        for (int n = 0; n < summary.switchUserEvents; n++) {
+            switchUserEvents.append(fileName + ": SwitchUser event");
         }
         
-        QTextStream stream(&file);
-        while (!stream.atEnd()) {
-            QString line = stream.readLine().trimmed();
-            if (line.isEmpty()) continue;
-            
-            // Look for SwitchUser events
-            if (line.contains("\"event\":\"SwitchUser\"")) {
-                switchUserEvents.append(fileName + ": SwitchUser event");
-                qDebug() << "[DEBUG] Found SwitchUser event in" << fileName;
+        // LoadGame events carry the FID and mark one session each
+        for (const QJsonValue &value : summary.loadGames) {
+            QJsonObject loadGame = value.toObject();
+            QString commanderName = loadGame.value("Commander").toString();
+            if (commanderName.isEmpty()) {
+                continue;
             }
             
-            // Look for LoadGame events with Commander info
-            if (line.contains("\"event\":\"LoadGame\"") && line.contains("\"Commander\"")) {
-                QJsonParseError parseError;
-                QJsonDocument doc = QJsonDocument::fromJson(line.toUtf8(), &parseError);
+            if (!commanderData.contains(commanderName)) {
+                qDebug() << "[DEBUG] Found commander:" << commanderName << "in" << fileName;
+                allCommanders.append(commanderName);
                 
-                if (parseError.error == QJsonParseError::NoError) {
-                    QJsonObject data = doc.object();
-                    QString commanderName = data.value("Commander").toString();
-                    QString fid = data.value("FID").toString();
-                    
-                    if (!commanderName.isEmpty()) {
-                        if (!commanderData.contains(commanderName)) {
-                            qDebug() << "[DEBUG] Found commander:" << commanderName << "in" << fileName;
-                            allCommanders.append(commanderName);
-                            
-                            QJsonObject cmdrInfo;
-                            cmdrInfo["fid"] = fid;
-                            cmdrInfo["first_seen"] = fileName;
-                            cmdrInfo["sessions"] = 1;
-                            commanderData[commanderName] = cmdrInfo;
-                        } else {
-                            // Increment session count
-                            QJsonObject cmdrInfo = commanderData[commanderName];
-                            cmdrInfo["sessions"] = cmdrInfo["sessions"].toInt() + 1;
-                            commanderData[commanderName] = cmdrInfo;
-                        }
-                    }
-                }
+                QJsonObject cmdrInfo;
+                cmdrInfo["fid"] = loadGame.value("FID").toString();
+                cmdrInfo["first_seen"] = fileName;
+                cmdrInfo["sessions"] = 1;
+                commanderData[commanderName] = cmdrInfo;
+            } else {
+                // Increment session count
+                QJsonObject cmdrInfo = commanderData[commanderName];
+                cmdrInfo["sessions"] = cmdrInfo["sessions"].toInt() + 1;
+                commanderData[commanderName] = cmdrInfo;
             }
-            
-            // Also check Commander events
-            if (line.contains("\"event\":\"Commander\"") && line.contains("\"Name\"")) {
-                QJsonParseError parseError;
-                QJsonDocument doc = QJsonDocument::fromJson(line.toUtf8(), &parseError);
+        }
+        
+        // Also pick up commanders only seen through Commander events
+        for (const QString &commanderName : summary.commanders) {
+            if (!commanderName.isEmpty() && !allCommanders.contains(commanderName)) {
+                qDebug() << "[DEBUG] Found commander via Commander event:" << commanderName << "in" << fileName;
+                allCommanders.append(commanderName);
                 
-                if (parseError.error == QJsonParseError::NoError) {
-                    QJsonObject data = doc.object();
-                    QString commanderName = data.value("Name").toString();
-                    
-                    if (!commanderName.isEmpty() && !allCommanders.contains(commanderName)) {
-                        qDebug() << "[DEBUG] Found commander via Commander event:" << commanderName << "in" << fileName;
-                        allCommanders.append(commanderName);
-                        
-                        QJsonObject cmdrInfo;
-                        cmdrInfo["fid"] = "Unknown";
-                        cmdrInfo["first_seen"] = fileName;
-                        cmdrInfo["sessions"] = 1;
-                        commanderData[commanderName] = cmdrInfo;
-                    }
-                }
+                QJsonObject cmdrInfo;
+                cmdrInfo["fid"] = "Unknown";
+                cmdrInfo["first_seen"] = fileName;
+                cmdrInfo["sessions"] = 1;
+                commanderData[commanderName] = cmdrInfo;
             }
         }
-        
-        file.close();
     }
     
     // Remove duplicates and prepare display message
@@ -3744,7 +5151,7 @@ void SupabaseClient::logLoginEvent(const QString &commanderName, bool isAdmin, c
     QNetworkRequest request = createRequest("login_events");
     QJsonDocument doc(loginData);
     QNetworkReply *reply = m_networkManager->post(request, doc.toJson());
-    reply->setProperty("operation", "log_login_event");
+    trackRequest(reply, SupabaseOperation::LogLoginEvent);
     
     qDebug() << "[DEBUG] Logged" << eventType << "event for" << commanderName;
 }
@@ -3776,8 +5183,8 @@ void SupabaseClient::addCommanderToSecurity(const QString &commanderName, bool b
     QNetworkRequest request = createRequest("security");
     QJsonDocument doc(securityData);
     QNetworkReply *reply = m_networkManager->post(request, doc.toJson());
-    reply->setProperty("operation", "add_to_security");
-    reply->setProperty("commander_name", commanderName);
+    trackRequest(reply, SupabaseOperation::AddToSecurity);
+    requestContext(reply).commanderName = commanderName;
     
     if (blocked) {
         qDebug() << "[SECURITY] Added" << commanderName << "to security table as BLOCKED";
@@ -3819,9 +5226,9 @@ void SupabaseClient::saveImageToDatabase(const QString &systemName, const QStrin
     QNetworkReply *checkReply = m_networkManager->get(checkRequest);
     
     if (checkReply) {
-        checkReply->setProperty("operation", "CHECK:system_info_for_image");
-        checkReply->setProperty("systemName", systemName);
-        checkReply->setProperty("imageUrl", imageUrl);
+        trackRequest(checkReply, SupabaseOperation::CheckSystemInfoForImage);
+        requestContext(checkReply).systemName = systemName;
+        requestContext(checkReply).imageUrl = imageUrl;
         qDebug() << "Checking if system exists in system_information table";
     }
 }
@@ -3902,8 +5309,8 @@ void SupabaseClient::updateSystemImages(const QString &systemName, const QString
     QNetworkReply *reply = m_networkManager->sendCustomRequest(request, "PATCH", jsonData);
     
     if (reply) {
-        reply->setProperty("operation", "UPDATE:system_images");
-        reply->setProperty("systemName", systemName);
+        trackRequest(reply, SupabaseOperation::UpdateSystemImages);
+        requestContext(reply).systemName = systemName;
         qDebug() << "System images update request sent";
     }
 }
@@ -3922,92 +5329,183 @@ void SupabaseClient::loadSystemImagesForSystems(const QStringList &systemNames)
     
     qDebug() << "Loading images for" << systemNames.size() << "systems";
     
-    // Build filter for multiple systems
-    QStringList systemFilters;
-    for (const QString &name : systemNames) {
-        systemFilters.append(QString("system.eq.%1").arg(QUrl::toPercentEncoding(name)));
+    if (m_offline) {
+        emitBulkSystemImages(localSystemInformation(systemNames));
+        return;
     }
     
     // Query system_information for all these systems
-    QString endpoint = QString("system_information?select=system,images&or=(%1)").arg(systemFilters.join(","));
-    QNetworkRequest request = createRequest(endpoint);
-    
-    QNetworkReply *reply = m_networkManager->get(request);
+    startSystemLookup(SupabaseOperation::GetBulkSystemImages, "system,images", systemNames, false);
+}
+
+void SupabaseClient::startSystemLookup(SupabaseOperation operation, const QString &select,
+                                       const QStringList &systemNames, bool publicRead)
+{
+    const int id = ++m_nextSystemLookupId;
+    SystemLookup &lookup = m_systemLookups[id];
+    lookup.operation = operation;
+    lookup.select = select;
+    lookup.systemNames = systemNames;
+    lookup.publicRead = publicRead;
+    
+    if (m_systemLookupRpcAvailable && systemNames.size() >= SYSTEM_LOOKUP_RPC_MIN_SYSTEMS) {
+        requestSystemLookupRpc(id);
+    } else {
+        buildSystemLookupChunks(lookup);
+        requestMoreSystemLookupChunks(id);
+    }
     
-    if (reply) {
-        reply->setProperty("operation", "GET:bulk_system_images");
-        qDebug() << "Bulk system images request sent";
+    if (lookup.inFlight == 0) {
+        finishSystemLookup(id);
     }
 }
 
-bool SupabaseClient::checkSystemVisitedInJournal(const QString &systemName, const QString &commanderName)
+QByteArray SupabaseClient::inFilterValue(const QString &value)
 {
-    if (systemName.isEmpty() || commanderName.isEmpty()) {
-        qDebug() << "Invalid parameters for journal visit check";
-        return false;
+    // Quoted so commas and parentheses in system names are safe inside in.(...)
+    QString quoted = value;
+    quoted.replace('\\', "\\\\").replace('"', "\\\"");
+    return QUrl::toPercentEncoding("\"" + quoted + "\"");
+}
+
+void SupabaseClient::buildSystemLookupChunks(SystemLookup &lookup)
+{
+    // system=in.("A","B",...), each chunk cut before its encoded list outgrows the URL budget
+    QByteArray chunk;
+    for (const QString &name : std::as_const(lookup.systemNames)) {
+        const QByteArray value = inFilterValue(name);
+        if (!chunk.isEmpty() && chunk.size() + value.size() + 3 > SYSTEM_LOOKUP_MAX_FILTER_LENGTH) {
+            lookup.chunks.append(chunk);
+            chunk.clear();
+        }
+        if (!chunk.isEmpty()) {
+            chunk += "%2C";
+        }
+        chunk += value;
+    }
+    if (!chunk.isEmpty()) {
+        lookup.chunks.append(chunk);
     }
+}
+
+void SupabaseClient::requestMoreSystemLookupChunks(int id)
+{
+    SystemLookup &lookup = m_systemLookups[id];
+    while (!lookup.failed && !lookup.chunks.isEmpty() && lookup.inFlight < SYSTEM_LOOKUP_MAX_PARALLEL) {
+        const QByteArray chunk = lookup.chunks.takeFirst();
+        QNetworkRequest request = createRequest(QString("system_information?select=%1&system=in.(%2)")
+                                                .arg(lookup.select, QString::fromLatin1(chunk)));
+        if (lookup.publicRead) {
+            // IMPORTANT: Remove commander headers for public POI access
+            request.setRawHeader("x-commander-name", "");
+        }
+        
+        QNetworkReply *reply = m_networkManager->get(request);
+        if (!reply) {
+            qDebug() << "Failed to create" << supabaseOperationTag(lookup.operation) << "request";
+            lookup.failed = true;
+            return;
+        }
+        trackRequest(reply, lookup.operation);
+        requestContext(reply).lookupId = id;
+        lookup.inFlight++;
+    }
+}
+
+void SupabaseClient::requestSystemLookupRpc(int id)
+{
+    // Very large sets go in a POST body to
+    //   system_information_for_systems(system_names text[]) returns setof system_information
+    // and fall back to chunked GETs when the server does not have that function
+    SystemLookup &lookup = m_systemLookups[id];
+    QJsonObject body;
+    body["system_names"] = QJsonArray::fromStringList(lookup.systemNames);
     
-    qDebug() << "Checking if" << commanderName << "visited" << systemName << "in journal logs";
+    QNetworkRequest request = createRequest("rpc/system_information_for_systems?select=" + lookup.select);
+    if (lookup.publicRead) {
+        request.setRawHeader("x-commander-name", "");
+    }
     
-    // Get the journal directory (this should be configurable, but for now use default)
-    QString journalPath = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation) + "/Frontier Developments/Elite Dangerous";
-    QDir journalDir(journalPath);
+    QNetworkReply *reply = m_networkManager->post(request, QJsonDocument(body).toJson(QJsonDocument::Compact));
+    if (!reply) {
+        lookup.failed = true;
+        return;
+    }
+    trackRequest(reply, lookup.operation);
+    requestContext(reply).lookupId = id;
+    requestContext(reply).lookupRpc = true;
+    lookup.inFlight++;
+}
+
+void SupabaseClient::handleSystemLookupReply(const SupabaseRequestContext &context, QNetworkReply *reply)
+{
+    auto it = m_systemLookups.find(context.lookupId);
+    if (it == m_systemLookups.end()) {
+        return;
+    }
+    SystemLookup &lookup = it.value();
+    lookup.inFlight--;
     
-    if (!journalDir.exists()) {
-        qDebug() << "Journal directory does not exist:" << journalPath;
-        return false;
+    const int httpStatus = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (context.lookupRpc && httpStatus == 404) {
+        qDebug() << "No system_information_for_systems function on the server - using chunked lookups";
+        m_systemLookupRpcAvailable = false;
+        m_networkMetrics.recordRetry(metricsTag(context));
+        buildSystemLookupChunks(lookup);
+        requestMoreSystemLookupChunks(context.lookupId);
+    } else {
+        bool success = false;
+        const QJsonObject response = parseReply(reply, success);
+        if (!success) {
+            if (!lookup.failed) {
+                qWarning() << "Supabase request failed:" << context.tag << "-" << response.value("message").toString();
+                emit networkError(response.value("message").toString("Network error"));
+            }
+            lookup.failed = true;
+        } else {
+            for (const QJsonValue &row : response.value("data").toArray()) {
+                lookup.rows.append(row);
+            }
+            requestMoreSystemLookupChunks(context.lookupId);
+        }
     }
     
-    // Get all journal files, sorted by date (newest first)
-    QStringList filters;
-    filters << "Journal.*.log";
-    QFileInfoList journalFiles = journalDir.entryInfoList(filters, QDir::Files | QDir::Readable, QDir::Time);
+    if (lookup.inFlight == 0) {
+        finishSystemLookup(context.lookupId);
+    }
+}
+
+void SupabaseClient::finishSystemLookup(int id)
+{
+    const SystemLookup lookup = m_systemLookups.take(id);
+    if (lookup.failed) {
+        // A partial result would clear badges of systems whose chunk never arrived
+        return;
+    }
     
-    qDebug() << "Scanning" << journalFiles.size() << "journal files for visit to" << systemName;
+    if (lookup.operation == SupabaseOperation::GetPoiDataForMerge) {
+        mergePoiRows(lookup.systemNames, lookup.rows);
+    } else if (lookup.operation == SupabaseOperation::GetBulkSystemImages) {
+        emitBulkSystemImages(lookup.rows);
+    }
+}
+
+bool SupabaseClient::checkSystemVisitedInJournal(const QString &systemName, const QString &commanderName)
+{
+    if (systemName.isEmpty() || commanderName.isEmpty()) {
+        qDebug() << "Invalid parameters for journal visit check";
+        return false;
+    }
     
-    // Scan through recent journals (limit to last 20 files for performance)
-    for (int i = 0; i < qMin(20, journalFiles.size()); i++) {
-        const QFileInfo &fileInfo = journalFiles[i];
-        QString journalFile = fileInfo.absoluteFilePath();
-        
-        QFile file(journalFile);
-        if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-            continue;
-        }
-        
-        QTextStream stream(&file);
-        while (!stream.atEnd()) {
-            QString line = stream.readLine().trimmed();
-            if (line.isEmpty()) continue;
-            
-            // Check for FSDJump or CarrierJump events to this system
-            if ((line.contains("\"event\":\"FSDJump\"") || line.contains("\"event\":\"CarrierJump\"")) && 
-                line.contains(QString("\"%1\"").arg(systemName))) {
-                
-                QJsonParseError parseError;
-                QJsonDocument doc = QJsonDocument::fromJson(line.toUtf8(), &parseError);
-                
-                if (parseError.error == QJsonParseError::NoError) {
-                    QJsonObject data = doc.object();
-                    QString jumpSystem = data.value("StarSystem").toString();
-                    QString commander = data.value("Commander").toString();
-                    
-                    // Check if this is the right system and commander
-                    if (jumpSystem == systemName && 
-                        (commander.isEmpty() || commander == commanderName)) {
-                        qDebug() << "Found visit to" << systemName << "by" << commanderName << "in journal";
-                        file.close();
-                        return true;
-                    }
-                }
-            }
-        }
-        
-        file.close();
+    if (!m_journalMonitor) {
+        qDebug() << "No journal monitor available for visit check";
+        return false;
     }
     
-    qDebug() << "No visit found for" << systemName << "by" << commanderName << "in recent journals";
-    return false;
+    // Answered from the in-memory visited-systems index - no journal I/O per check
+    bool visited = m_journalMonitor->isSystemVisited(systemName, commanderName);
+    qDebug() << "Journal visit check:" << commanderName << (visited ? "has visited" : "has not visited") << systemName;
+    return visited;
 }
 
 void SupabaseClient::getTakenSystemForCommander(const QString &systemName, const QString &commanderName)
@@ -4035,9 +5533,9 @@ void SupabaseClient::getTakenSystemForCommander(const QString &systemName, const
     QNetworkReply *reply = m_networkManager->get(request);
     
     if (reply) {
-        reply->setProperty("operation", "GET:taken_system_specific");
-        reply->setProperty("systemName", systemName);
-        reply->setProperty("commanderName", commanderName);
+        trackRequest(reply, SupabaseOperation::GetTakenSystemSpecific);
+        requestContext(reply).systemName = systemName;
+        requestContext(reply).commanderName = commanderName;
         qDebug() << "getTakenSystemForCommander: Request sent for" << systemName << "with edited flag";
     } else {
         qDebug() << "getTakenSystemForCommander: Failed to create network request!";
@@ -4047,38 +5545,28 @@ void SupabaseClient::getTakenSystemForCommander(const QString &systemName, const
 
 
 
-void SupabaseClient::fetchAndMergePOIData(QJsonArray &systemsArray)
+void SupabaseClient::fetchAndMergePOIData(const QStringList &systemNames)
 {
     if (m_supabaseUrl.isEmpty() || m_supabaseKey.isEmpty()) {
         qDebug() << "Supabase not configured for fetchAndMergePOIData";
         return;
     }
     
-    if (systemsArray.isEmpty()) {
+    if (systemNames.isEmpty()) {
         qDebug() << "No systems to fetch POI data for";
         return;
     }
     
-    qDebug() << "Fetching POI data for" << systemsArray.size() << "systems";
+    qDebug() << "Fetching POI data for" << systemNames.size() << "systems";
     
-    // Fetch all POI data from system_information table
-    QString endpoint = "system_information?select=system,potential_or_poi,discoverer,submitter";
+    if (m_offline) {
+        mergePoiRows(systemNames, localSystemInformation(systemNames));
+        return;
+    }
     
-    QNetworkRequest request = createRequest(endpoint);
     // Don't add commander headers - POI data should be public
-    
-    QNetworkReply *reply = m_networkManager->get(request);
-    
-    if (reply) {
-        reply->setProperty("operation", "GET:poi_data_for_merge");
-        reply->setProperty("systemsCount", systemsArray.size());
-        // Store the target systems we want to merge back into
-        QJsonDocument systemsDoc(systemsArray);
-        reply->setProperty("systemsToMerge", systemsDoc.toJson());
-        qDebug() << "fetchAndMergePOIData: Request sent for POI data";
-    } else {
-        qDebug() << "fetchAndMergePOIData: Failed to create network request!";
-    }
+    startSystemLookup(SupabaseOperation::GetPoiDataForMerge, "system,potential_or_poi,discoverer,submitter",
+                      systemNames, true);
 }
 
 void SupabaseClient::saveSystemInformation(const QString &systemName, const QVariantMap &information)
@@ -4115,9 +5603,9 @@ void SupabaseClient::saveSystemInformation(const QString &systemName, const QVar
     QNetworkReply *checkReply = m_networkManager->get(checkRequest);
     
     if (checkReply) {
-        checkReply->setProperty("operation", "CHECK:system_info_exists");
-        checkReply->setProperty("systemName", systemName);
-        checkReply->setProperty("information", information);
+        trackRequest(checkReply, SupabaseOperation::CheckSystemInfoExists);
+        requestContext(checkReply).systemName = systemName;
+        requestContext(checkReply).information = information;
         qDebug() << "Checking if system_information exists for" << systemName;
     } else {
         qDebug() << "Failed to create check request!";
@@ -4139,6 +5627,15 @@ void SupabaseClient::updateSystemPOIStatus(const QString &systemName, const QStr
         return;
     }
     
+    if (m_offline) {
+        journalOfflineMutation({{"op", "poi_update"}, {"system", systemName}, {"commander", m_currentCommander},
+                                {"poi_type", poiType}, {"discoverer", discoverer}, {"submitter", submitter},
+                                {"base_poi", cataloguePoiValue(systemName)}});
+        emit requestCompleted("updateSystemPOIStatus", true, "POI status saved (offline)");
+        fetchAndMergePOIData({systemName});
+        return;
+    }
+    
     qDebug() << "Updating POI status for" << systemName << "type:" << poiType << "discoverer:" << discoverer << "submitter:" << submitter;
     
     // Check if system_information record exists first
@@ -4156,11 +5653,11 @@ void SupabaseClient::updateSystemPOIStatus(const QString &systemName, const QStr
     QNetworkReply *checkReply = m_networkManager->get(checkRequest);
     
     if (checkReply) {
-        checkReply->setProperty("operation", "CHECK:poi_system_exists");
-        checkReply->setProperty("systemName", systemName);
-        checkReply->setProperty("poiType", poiType);
-        checkReply->setProperty("discoverer", discoverer);
-        checkReply->setProperty("submitter", submitter);
+        trackRequest(checkReply, SupabaseOperation::CheckPoiSystemExists);
+        requestContext(checkReply).systemName = systemName;
+        requestContext(checkReply).poiType = poiType;
+        requestContext(checkReply).discoverer = discoverer;
+        requestContext(checkReply).submitter = submitter;
         qDebug() << "Checking if system_information exists for POI update:" << systemName;
     } else {
         qDebug() << "Failed to create POI check request!";
@@ -8,6 +8,19 @@
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QString>
+#include <QStringList>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QSet>
+#include "journalindex.h"
+#include "localcatalogue.h"
+#include "supabaseoperation.h"
+#include "systemrecord.h"
+#include "coordinatestore.h"
+#include "networkmetrics.h"
+
+class JournalMonitor;
+class QTimer;
 
 class SupabaseClient : public QObject
 {
@@ -31,6 +44,9 @@ public:
     // Commander context for RLS policies
     Q_INVOKABLE void setCommanderContext(const QString &commanderName);
     
+    // Source of journal visit checks (uses the configured journal folder)
+    void setJournalMonitor(JournalMonitor *journalMonitor);
+    
     // Database operations
     Q_INVOKABLE void getSystems();
     Q_INVOKABLE void getTakenSystems();
@@ -40,6 +56,9 @@ public:
     Q_INVOKABLE void getRichardCategories();
     Q_INVOKABLE void getPresetImages(bool includeRichard = false);
     Q_INVOKABLE void getSystemsNear(double x, double y, double z, int limit = 50);
+    // Same bounded query around a route waypoint; answers with systemsNearPrefetched and
+    // leaves the commander's query and its radius alone
+    void prefetchSystemsNear(const QString &waypoint, double x, double y, double z, int limit);
     Q_INVOKABLE void getSystemInformation(const QString &systemName, const QString &category = "");
     Q_INVOKABLE void getSystemInformationFromDB(const QString &systemName);
     Q_INVOKABLE void getSystemInformationFromCategory(const QString &systemName, const QString &category);
@@ -50,6 +69,15 @@ public:
     Q_INVOKABLE void updateSystemVisited(const QString &systemName, bool visited);
     Q_INVOKABLE void updateSystemDone(const QString &systemName, bool done);
     Q_INVOKABLE void markSystemAsEdited(const QString &systemName);
+    // Taken updates and location are written behind: merged per row and sent in batches
+    Q_INVOKABLE void flushPendingWrites();
+    QJsonObject pendingTakenWrite(const QString &systemName) const;   // Queued, unsent fields of the row
+    
+    // Offline mode: entered when the backend stops answering, left when a probe gets through.
+    // Reads come from the local catalogue; claims, status and POI changes are journaled to disk
+    // and replayed in order, with conflict checks, once the backend is back
+    Q_INVOKABLE bool isOffline() const;
+    Q_INVOKABLE int pendingOfflineMutations() const;
     Q_INVOKABLE void checkAdminStatus(const QString &commander);
     Q_INVOKABLE void testAdminAccess(const QString &serviceKey);
     Q_INVOKABLE void getSystemDetails(const QString &systemName, const QString &category);
@@ -82,6 +110,18 @@ public:
     Q_INVOKABLE bool isFirstRun() const;
     Q_INVOKABLE void performIncrementalSync();
     
+    // Identical reads in flight share one request; list reads are kept for a per-operation TTL
+    Q_INVOKABLE void setCacheTtl(const QString &operation, int milliseconds);
+    Q_INVOKABLE void clearResponseCache();
+    
+    // Requests per operation since start (or the last reset): errors, retries, bytes each way,
+    // time to first byte and latency histogram, slowest first
+    Q_INVOKABLE QVariantList operationStats() const;
+    Q_INVOKABLE void resetOperationStats();
+    // Writes these stats plus any other sources (e.g. {"images": imageLoader.networkStats()})
+    // to network_metrics.json in AppData; returns the file path, empty on failure
+    Q_INVOKABLE QString writeNetworkMetricsSnapshot(const QVariantMap &otherSources = QVariantMap());
+    
 private:
     void getSystemDetailsWithCapitalizationHandling(const QString &systemName, const QString &category);
     void getSystemDetailsWithFieldName(const QString &systemName, const QString &category, const QString &fieldName);
@@ -99,6 +139,22 @@ public:
     // Utility methods
     Q_INVOKABLE double calculateDistance(double x1, double y1, double z1, double x2, double y2, double z2);
     Q_INVOKABLE bool isInAuthFailureCooldown() const;
+    
+    // Systems table held locally: decoded once per catalogue change, so callers can rank
+    // positions against it without a request
+    bool hasLocalCatalogue() const { return m_catalogue.hasTable("systems"); }
+    const SystemRecordList &catalogueSystems();
+    const CoordinateStore &catalogueCoordinates();
+    SystemRecordList rankSystemsNear(const SystemRecordList &systems, double x, double y, double z, int limit,
+                                     double maxDistance, int *inRange = nullptr);
+    // Same, with the coordinates of `systems` already laid out for the distance kernel
+    SystemRecordList rankSystemsNear(const SystemRecordList &systems, const CoordinateStore &coordinates,
+                                     double x, double y, double z, int limit, double maxDistance,
+                                     int *inRange = nullptr);
+#ifdef EDRH_BENCHMARKS
+    // Times the distance kernel on 10k, 100k and 1M random systems; results are also logged
+    Q_INVOKABLE QVariantList benchmarkDistanceKernel() const;
+#endif
 
 public slots:
     // Authentication methods - automatic security system like v1.4incomplete.py  
@@ -111,16 +167,22 @@ public slots:
 
 signals:
     void systemsReceived(const QJsonArray &systems);
+    // One page of a bulk systems load, ahead of the full systemsReceived; loaded counts the
+    // systems delivered so far including this page, total is the server row count (-1 if unknown)
+    void systemsPageReceived(const QJsonArray &systems, int loaded, int total);
     void takenSystemsReceived(const QJsonArray &taken);
     void poisReceived(const QJsonArray &pois);
     void categoriesReceived(const QJsonArray &categories);
     void presetImagesReceived(const QJsonArray &presetImages);
-    void nearestSystemsReceived(const QJsonArray &systems);
+    void nearestSystemsReceived(const SystemRecordList &systems);
+    void systemsNearPrefetched(const QString &waypoint, const SystemRecordList &systems);
     void systemInformationReceived(const QString &systemName, const QJsonObject &systemInfo);
     void systemClaimed(const QString &systemName, bool success);
     void systemUnclaimed(const QString &systemName, bool success);
     void systemMarkedVisited(const QString &systemName, bool success);
     void systemStatusUpdated(const QString &systemName, bool success);
+    // A taken row update was queued; fields are all values pending for the row so far
+    void takenWriteQueued(const QString &systemName, const QJsonObject &fields);
     void adminStatusReceived(bool isAdmin);
     void adminAccessTestComplete(bool hasAccess);
     void presetImageFound(const QString &systemName, const QString &imageUrl, const QString &category);
@@ -139,6 +201,13 @@ signals:
     void databaseSyncStatusChanged(const QString &status);
     void databaseSyncProgress(int current, int total, const QString &operation);
     void databaseSyncComplete(bool isFirstRun, int changesDetected);
+    void catalogueUpdated(const QStringList &changedTables);
+    
+    // Offline mode
+    void offlineModeChanged(bool offline);
+    void offlineMutationsChanged(int pending);
+    void offlineMutationConflict(const QString &systemName, const QString &operation, const QString &reason);
+    void offlineReplayFinished(int applied, int conflicts);
 
     // Authentication signals
     void securityCheckComplete(const QString &commanderName, bool isBlocked, const QString &reason = "");
@@ -148,16 +217,144 @@ signals:
 
 private slots:
     void handleNetworkReply(QNetworkReply *reply);
+    // aboutToQuit: the event loop won't run again, so queued and unanswered taken updates
+    // go to the offline journal instead of the wire
+    void journalWritesOnShutdown();
 
 private:
     QNetworkAccessManager *m_networkManager;
+    JournalMonitor *m_journalMonitor;
     QString m_supabaseUrl;
     QString m_supabaseKey;
     QString m_currentCommander;
     QStringList m_detectedCommanders;  // Store current commander for RLS policies
     QStringList m_pendingSystemsCategories; // Store systems categories while loading Richard categories
     // Cache of the most recent nearest systems payload for quick POI re-merge
-    QJsonArray m_cachedNearestSystems;
+    SystemRecordList m_cachedNearestSystems;
+    
+    // Bounded nearest-systems query: the box that last found enough systems, trimmed to the
+    // distance of the farthest system kept, is the next starting size
+    double m_systemsNearRadius;
+    int m_systemsNearGeneration;    // Counter handed out to every new query
+    QHash<QString, int> m_systemsNearQueries;           // Latest generation per waypoint ("" = commander)
+    QHash<QString, SystemRecordList> m_systemsNearRows; // Box pages received so far per waypoint
+    
+    // Local copy of the database, kept current by high-water mark delta syncs
+    LocalCatalogue m_catalogue;
+    SystemRecordList m_catalogueSystems;    // Decoded systems table, rebuilt when it changes
+    CoordinateStore m_catalogueCoordinates; // Coordinates of m_catalogueSystems, same order
+    bool m_catalogueSystemsStale;
+    bool m_catalogueSyncing;
+    QString m_catalogueSyncTable;
+    QStringList m_catalogueSyncQueue;
+    QStringList m_catalogueChangedTables;
+    int m_catalogueChanges;
+    QJsonArray m_pendingTakenRows;          // Own writes that arrived while taken was mid-download
+    QElapsedTimer m_catalogueSyncTimer;
+    QHash<QString, qint64> m_catalogueSyncedAt;     // Table -> last completed sync (ms since epoch)
+    static const int CATALOGUE_PAGE_SIZE = 1000;
+    
+    // Read coalescing and short-lived response cache, keyed by operation + endpoint
+    struct CachedResponse {
+        QString operation;
+        QJsonArray data;
+        qint64 expiresAt = 0;
+    };
+    QHash<QString, CachedResponse> m_responseCache;
+    QSet<QString> m_inFlightGets;
+    QHash<QString, int> m_cacheTtlMs;   // Overrides of the default TTL per operation
+    // Typed request state, keyed by reply until it is destroyed, and the per-operation reply handlers
+    using ReplyHandler = void (SupabaseClient::*)(const SupabaseRequestContext &, QNetworkReply *, const QJsonObject &);
+    QHash<QNetworkReply*, SupabaseRequestContext> m_requestContexts;
+    ReplyHandler m_replyHandlers[int(SupabaseOperation::Count)] = {};
+    NetworkMetrics m_networkMetrics;
+    
+    // Bulk list reads (systems, taken) fetched as parallel pages, keyed by SupabaseOperation
+    struct BulkFetch {
+        QString endpoint;
+        int total = -1;             // From Content-Range once the first page is in
+        int nextOffset = 0;
+        int inFlight = 0;           // Pages requested or being parsed
+        int received = 0;           // Rows parsed so far
+        int delivered = 0;          // Systems emitted through systemsPageReceived
+        QMap<int, QJsonArray> pages;    // Offset -> rows, reassembled in order at the end
+        bool failed = false;
+        QElapsedTimer timer;
+    };
+    QHash<int, BulkFetch> m_bulkFetches;
+    // One page parsed on the thread pool; handed back through a QFutureWatcher owned by the
+    // client, so a page finishing after the client is gone goes nowhere
+    struct ParsedBulkPage {
+        QJsonArray page;
+        int rowCount = 0;
+        bool ok = false;
+    };
+    static const int BULK_PAGE_SIZE = 1000;
+    static const int BULK_MAX_PARALLEL_PAGES = 4;
+    
+    // system_information lookups for a list of systems: in.(...) chunks of bounded URL length,
+    // a few at a time, merged before anything is emitted. Keyed by lookup id.
+    struct SystemLookup {
+        SupabaseOperation operation = SupabaseOperation::Unknown;
+        QString select;
+        QStringList systemNames;
+        QList<QByteArray> chunks;   // Encoded name lists not requested yet
+        int inFlight = 0;
+        QJsonArray rows;
+        bool failed = false;
+        bool publicRead = false;    // Sent without the commander header
+    };
+    QHash<int, SystemLookup> m_systemLookups;
+    int m_nextSystemLookupId;
+    bool m_systemLookupRpcAvailable;    // Cleared once the server turns out not to have the function
+    static const int SYSTEM_LOOKUP_MAX_FILTER_LENGTH = 6000;
+    static const int SYSTEM_LOOKUP_MAX_PARALLEL = 4;
+    static const int SYSTEM_LOOKUP_RPC_MIN_SYSTEMS = 1000;
+    
+    // Write-behind queue: one entry per (commander, system) taken row, sent on the flush timer
+    struct PendingTakenWrite {
+        QString commander;
+        QString systemName;
+        QJsonObject fields;
+    };
+    QHash<QString, PendingTakenWrite> m_pendingTakenWrites;
+    QStringList m_pendingTakenWriteOrder;
+    struct PendingLocation {
+        QString commanderName;
+        double x = 0.0;
+        double y = 0.0;
+        double z = 0.0;
+        QString systemName;
+        bool pending = false;
+    };
+    PendingLocation m_pendingLocation;
+    QTimer *m_writeFlushTimer;
+    static const int WRITE_FLUSH_DELAY_MS = 1500;
+    bool m_shuttingDown;        // Replies aborted from here on are already journaled
+    
+    // Offline mode and the durable journal of changes made while in it (JSON lines in AppData)
+    bool m_offline;
+    QTimer *m_offlineProbeTimer;
+    QString m_offlineJournalFile;
+    QVector<QJsonObject> m_offlineMutations;
+    bool m_replayOfflineAfterSync;
+    
+    // Journal replay: one entry in flight at a time, dropped from the journal once answered
+    bool m_replayingOffline;
+    int m_replayScope;              // > 0 while requests belonging to the current entry are sent
+    int m_replayOutstanding;        // Requests of the current entry still in flight
+    bool m_replayRetryLater;
+    QString m_replayRejection;
+    int m_replayApplied;
+    int m_replayConflicts;
+    QHash<QString, QString> m_replayOwners;     // Server state later entries are judged against
+    QHash<QString, QString> m_replayPois;
+    static const int OFFLINE_PROBE_INTERVAL_MS = 30000;
+    
+    static constexpr double SYSTEMS_NEAR_INITIAL_RADIUS = 500.0;    // LY
+    static constexpr double SYSTEMS_NEAR_MAX_RADIUS = 100000.0;     // Covers the whole galaxy
+    static constexpr double SYSTEMS_NEAR_GROWTH = 4.0;
+    static const int SYSTEMS_NEAR_PAGE_SIZE = 1000;                 // Stays under PostgREST's max-rows cap
     
     // Error handling and rate limiting
     qint64 m_lastAuthFailureTime;
@@ -182,14 +379,137 @@ private:
     // POI data for merging
     QJsonArray m_pendingPOIData;
     
+    // Journal folder whose commander scan is running in the background
+    QString m_pendingRenameScanPath;
+    
     // Helper methods
     QNetworkRequest createRequest(const QString &endpoint);
     void makeRequest(const QString &method, const QString &endpoint, const QJsonObject &data = QJsonObject());
     QJsonObject parseReply(QNetworkReply *reply, bool &success);
     bool shouldSkipRequestDueToAuthFailure();
-    void fetchAndMergePOIData(QJsonArray &systemsArray);
+    void requestSystemsNear(const QString &waypoint, double x, double y, double z, int limit, double radius,
+                            int generation, int offset = 0);
+    static SystemRecord systemRecordFromRow(const QJsonObject &row);
+    QStringList cachedNearestSystemNames() const;
+    
+    // Catalogue delta sync
+    void startCatalogueSync(const QStringList &tables);
+    void syncNextCatalogueTable();
+    void requestCataloguePage(const QString &table, int offset, const QString &highWater, int changes, bool fullDownload);
+    void requestCatalogueCount(const QString &table, bool afterFullDownload);
+    void handleCatalogueReply(const SupabaseRequestContext &context, QNetworkReply *reply);
+    void finishCatalogueSync();
+    void checkPresetImagesForChanges();
+    QJsonArray localTakenSystems() const;
+    void applyTakenWrite(const QJsonArray &rows);
+    QJsonArray localTakenRowsWith(const QStringList &systemNames, const QJsonObject &fields) const;
+    bool serveOrJoinGet(const QString &operation, const QString &endpoint);
+    void trackGet(QNetworkReply *reply, const QString &operation, const QString &endpoint);
+    void cacheResponse(const QString &key, const QString &operation, const QJsonArray &data);
+    int cacheTtl(const QString &operation) const;
+    void handleListResponse(const QString &operation, const QJsonArray &data);
+    void fetchAndMergePOIData(const QStringList &systemNames);
+    void mergePoiRows(const QStringList &systemNames, const QJsonArray &poiData);
+    void emitBulkSystemImages(const QJsonArray &imagesData);
     void mergePOIDataIntoSystems(QJsonArray &systemsArray);
-    void processSystemsReply(const QJsonArray &data);
+    static QJsonArray transformSystemRows(const QJsonArray &data);
+    
+    // Offline mode
+    bool isBackendUnreachable(QNetworkReply *reply) const;
+    void setOffline(bool offline);
+    void probeBackend();
+    void loadOfflineJournal();
+    void journalOfflineMutation(QJsonObject entry);
+    QString cataloguePoiValue(const QString &systemName) const;
+    QJsonArray localSystemInformation(const QStringList &systemNames = QStringList()) const;
+    void replayOfflineMutations();
+    void replayNextOfflineMutation();
+    void offlineReplayReplyFinished(QNetworkReply *reply);
+    void finishOfflineReplayEntry();
+    void stopOfflineReplay();
+    void dropFirstOfflineMutation();
+    void rewriteOfflineJournal();
+    
+    // Write-behind taken updates
+    void queueTakenWrite(const QString &systemName, const QJsonObject &fields);
+    void scheduleWriteFlush();
+    void sendTakenBatch(const QString &commander, const QStringList &systemNames, const QByteArray &filter, const QByteArray &body);
+    
+    // Chunked system_information lookups
+    void startSystemLookup(SupabaseOperation operation, const QString &select, const QStringList &systemNames, bool publicRead);
+    static QByteArray inFilterValue(const QString &value);
+    void buildSystemLookupChunks(SystemLookup &lookup);
+    void requestMoreSystemLookupChunks(int id);
+    void requestSystemLookupRpc(int id);
+    void handleSystemLookupReply(const SupabaseRequestContext &context, QNetworkReply *reply);
+    void finishSystemLookup(int id);
+    
+    // Paged bulk reads
+    void startBulkFetch(SupabaseOperation operation, const QString &endpoint);
+    void requestBulkPage(SupabaseOperation operation, int offset);
+    void requestMoreBulkPages(SupabaseOperation operation);
+    void handleBulkPage(const SupabaseRequestContext &context, QNetworkReply *reply);
+    void handleBulkPageParsed(SupabaseOperation operation, int offset, QJsonArray page, int rowCount, bool ok);
+    void finishBulkFetch(SupabaseOperation operation);
+    // The same paged delivery for the systems table, sorted and transformed on the pool
+    // from the local catalogue
+    void loadCatalogueSystemsPaged();
+    void processCommanderRenameScan(const QList<JournalFileSummary> &summaries);
+    // Reply dispatch
+    void registerReplyHandlers();
+    SupabaseRequestContext &requestContext(QNetworkReply *reply);
+    void trackRequest(QNetworkReply *reply, SupabaseOperation operation);
+    void trackRequest(QNetworkReply *reply, const QString &tag);    // Tags built at runtime
+    void watchReplyTiming(QNetworkReply *reply);
+    void trackOfflineReplay(SupabaseRequestContext &context);
+    static QString metricsTag(const SupabaseRequestContext &context);
+    void recordOperationStats(const SupabaseRequestContext &context, QNetworkReply *reply);
+    void onGetSystemsNear(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response);
+    void onGetTakenSystemSpecific(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response);
+    void onGetCurrentCommanderTaken(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response);
+    void onGetCategoriesSystems(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response);
+    void onGetCategoriesRichard(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response);
+    void onGetPresetImages(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response);
+    void onGetSystemInformationPrimary(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response);
+    void onGetSystemInformationCategory(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response);
+    void onGetSystemInformationDb(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response);
+    void onGetSystemDetails(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response);
+    void onGetSystemCategoryLookup(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response);
+    void onGetSystemDetailsRobust(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response);
+    void onGetAdminAccess(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response);
+    void onGetPois(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response);
+    void onRpcClaimSystem(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response);
+    void onRpcReleaseClaim(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response);
+    void onPostTaken(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response);
+    void onDeleteTaken(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response);
+    void onUpsertSystemInformationPoiSet(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response);
+    void onUpdateSystemInformationPoiClear(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response);
+    void onDeletePois(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response);
+    void onGetAllCommanders(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response);
+    void onPatchCommanderLocation(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response);
+    void onPatchTakenBatch(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response);
+    void onTestAdminAccess(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response);
+    void onGetWebhookConfig(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response);
+    void onPostWebhook(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response);
+    void onCheckSystemInfoExists(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response);
+    void onSystemInformationSaved(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response);
+    void onSetCommanderContext(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response);
+    void onImgbbUpload(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response);
+    void onGetPresetImageCategory(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response);
+    void onCheckPresetImagesCount(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response);
+    void onSecurityCheck(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response);
+    void onAddNewCommander(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response);
+    void onCheckBannedAlt(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response);
+    void onBlockRenamedCommander(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response);
+    void onLogLoginEvent(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response);
+    void onCheckSystemInfoForImage(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response);
+    void onSystemInfoImageSaved(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response);
+    void onCheckExistingClaim(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response);
+    void onCheckRecordsBeforeUpdate(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response);
+    void onUnclaimMarkEmpty(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response);
+    void onCheckSystemInfoExistsOnClaim(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response);
+    void onImgbbTest(const SupabaseRequestContext &context, QNetworkReply *reply, const QJsonObject &response);
+    
     // ImgBB helper
     void startImgbbUpload(const QString &filePath, const QString &systemName, int attempt = 1);
     static const int IMGBB_MAX_ATTEMPTS = 2;
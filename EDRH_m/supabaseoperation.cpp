@@ -0,0 +1,109 @@
+#include "supabaseoperation.h"
+#include <QHash>
+
+namespace {
+
+// Indexed by SupabaseOperation
+const char *const kOperationTags[] = {
+    "",
+    "GET:systems",
+    "GET:systems_near",
+    "GET:taken",
+    "GET:taken_system_specific",
+    "GET:current_commander_taken",
+    "GET:categories_systems",
+    "GET:categories_richard",
+    "GET:preset_images",
+    "GET:preset_image_category",
+    "GET:system_information_primary",
+    "GET:system_information_category",
+    "GET:system_information_db",
+    "GET:system_details",
+    "GET:system_details_robust",
+    "GET:system_category_lookup",
+    "GET:admin_access",
+    "GET:poi_data_for_merge",
+    "GET:pois",
+    "GET:all_commanders",
+    "GET:webhook_config",
+    "GET:bulk_system_images",
+    "RPC:claim_system",
+    "RPC:release_claim",
+    "POST:taken",
+    "DELETE:taken",
+    "DELETE:pois",
+    "UPSERT:system_information_poi_set",
+    "UPDATE:system_information_poi_clear",
+    "PATCH:commander_location",
+    "PATCH:taken_batch",
+    "UPDATE:system_information",
+    "UPDATE:system_info_image",
+    "UPDATE:system_images",
+    "INSERT:system_information",
+    "INSERT:system_info_image",
+    "POST:system_information",
+    "TEST:admin_access",
+    "POST:webhook",
+    "CHECK:system_info_exists",
+    "CHECK:system_info_exists_on_claim",
+    "CHECK:system_info_for_image",
+    "CHECK:preset_images_count",
+    "CHECK:poi_system_exists",
+    "CHECK:existing_claim",
+    "CHECK:records_before_update",
+    "UNCLAIM:mark_empty",
+    "SET:commander_context",
+    "IMGBB:upload",
+    "IMGBB:test",
+    "SYNC:page",
+    "SYNC:count",
+    "GET:probe",
+    "security_check",
+    "add_new_commander",
+    "check_banned_alt",
+    "block_renamed_commander",
+    "log_login_event",
+    "add_to_security",
+};
+
+static_assert(sizeof(kOperationTags) / sizeof(kOperationTags[0]) == size_t(SupabaseOperation::Count),
+              "every SupabaseOperation needs a tag");
+
+}
+
+const char *supabaseOperationTag(SupabaseOperation operation)
+{
+    const int index = int(operation);
+    return index < int(SupabaseOperation::Count) ? kOperationTags[index] : "";
+}
+
+SupabaseOperation supabaseOperationFromTag(const QString &tag)
+{
+    static const QHash<QString, SupabaseOperation> byTag = []() {
+        QHash<QString, SupabaseOperation> tags;
+        for (int i = 1; i < int(SupabaseOperation::Count); ++i) {
+            tags.insert(QString::fromLatin1(kOperationTags[i]), SupabaseOperation(i));
+        }
+        return tags;
+    }();
+
+    auto exact = byTag.constFind(tag);
+    if (exact != byTag.constEnd()) {
+        return exact.value();
+    }
+
+    // Runtime suffixes: "GET:admin_access?select=...", "POST:webhook:<event>", "PATCH:commander_location:<name>"
+    SupabaseOperation best = SupabaseOperation::Unknown;
+    qsizetype bestLength = 0;
+    for (auto it = byTag.constBegin(); it != byTag.constEnd(); ++it) {
+        const QString &known = it.key();
+        if (known.size() > bestLength && tag.size() > known.size() && tag.startsWith(known)) {
+            const QChar next = tag.at(known.size());
+            if (next == ':' || next == '?' || next == '&') {
+                best = it.value();
+                bestLength = known.size();
+            }
+        }
+    }
+    return best;
+}
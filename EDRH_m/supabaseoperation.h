@@ -0,0 +1,143 @@
+#ifndef SUPABASEOPERATION_H
+#define SUPABASEOPERATION_H
+
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QVariantMap>
+#include <QJsonObject>
+#include <QElapsedTimer>
+
+// Every request SupabaseClient sends, as a typed id. Replies are dispatched through a
+// table indexed by this id instead of comparing operation strings.
+enum class SupabaseOperation : quint8 {
+    Unknown,
+    GetSystems,
+    GetSystemsNear,
+    GetTaken,
+    GetTakenSystemSpecific,
+    GetCurrentCommanderTaken,
+    GetCategoriesSystems,
+    GetCategoriesRichard,
+    GetPresetImages,
+    GetPresetImageCategory,
+    GetSystemInformationPrimary,
+    GetSystemInformationCategory,
+    GetSystemInformationDb,
+    GetSystemDetails,
+    GetSystemDetailsRobust,
+    GetSystemCategoryLookup,
+    GetAdminAccess,
+    GetPoiDataForMerge,
+    GetPois,
+    GetAllCommanders,
+    GetWebhookConfig,
+    GetBulkSystemImages,
+    RpcClaimSystem,
+    RpcReleaseClaim,
+    PostTaken,
+    DeleteTaken,
+    DeletePois,
+    UpsertSystemInformationPoiSet,
+    UpdateSystemInformationPoiClear,
+    PatchCommanderLocation,
+    PatchTakenBatch,
+    UpdateSystemInformation,
+    UpdateSystemInfoImage,
+    UpdateSystemImages,
+    InsertSystemInformation,
+    InsertSystemInfoImage,
+    PostSystemInformation,
+    TestAdminAccess,
+    PostWebhook,
+    CheckSystemInfoExists,
+    CheckSystemInfoExistsOnClaim,
+    CheckSystemInfoForImage,
+    CheckPresetImagesCount,
+    CheckPoiSystemExists,
+    CheckExistingClaim,
+    CheckRecordsBeforeUpdate,
+    UnclaimMarkEmpty,
+    SetCommanderContext,
+    ImgbbUpload,
+    ImgbbTest,
+    SyncPage,
+    SyncCount,
+    ProbeBackend,
+    SecurityCheck,
+    AddNewCommander,
+    CheckBannedAlt,
+    BlockRenamedCommander,
+    LogLoginEvent,
+    AddToSecurity,
+    Count
+};
+
+// Operation tag used in logs and requestCompleted(), e.g. "GET:systems_near"
+const char *supabaseOperationTag(SupabaseOperation operation);
+
+// Resolve a tag built at runtime (makeRequest, webhooks) - exact match, else the longest known prefix
+SupabaseOperation supabaseOperationFromTag(const QString &tag);
+
+// Everything a reply handler needs to know about the request it answers
+struct SupabaseRequestContext
+{
+    SupabaseOperation operation = SupabaseOperation::Unknown;
+    QString tag;                // Full tag, including any runtime suffix (webhook event, commander)
+    QElapsedTimer timer;        // Started when the request was sent
+    qint64 firstByteMs = -1;    // Reply headers in; -1 until then
+    qint64 bytesUp = 0;
+
+    QString systemName;
+    QString commander;
+    QString commanderName;
+    QString altCommander;
+    QString category;
+    QString fieldName;
+    QString fallbackCategory;
+    QString fallbackUrl;
+    bool triedLowercase = false;
+    QString imageUrl;
+    QString poiType;
+    QString submitter;
+    QString discoverer;
+    QVariantMap information;
+    bool visited = false;
+    bool hasVisited = false;
+    bool done = false;
+
+    // systems_near
+    double refX = 0.0;
+    double refY = 0.0;
+    double refZ = 0.0;
+    int limit = 0;
+    double radius = 0.0;
+    int generation = 0;
+    QString waypoint;       // Route prefetch target, empty for the commander's own query
+
+    // POI merges, chunked system lookups and taken batches
+    QStringList systemNames;
+    QJsonObject fields;
+    int lookupId = 0;
+    bool lookupRpc = false;
+
+    // Catalogue sync
+    QString table;
+    QString cursor;
+    QString highWater;
+    int offset = 0;
+    int changes = 0;
+    bool fullDownload = false;
+
+    // Paged bulk reads (offset is shared with the catalogue sync)
+    bool bulkPage = false;
+    
+    // ImgBB uploads
+    QString filePath;
+    int attempt = 0;
+
+    QString cacheKey;           // Set for coalesced, cacheable reads
+    bool offlineReplay = false; // Sent for the offline journal entry being replayed
+};
+
+#endif // SUPABASEOPERATION_H
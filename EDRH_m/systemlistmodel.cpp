@@ -0,0 +1,308 @@
+#include "systemlistmodel.h"
+
+namespace {
+struct RoleKey {
+    int role;
+    const char *key;
+};
+
+// Row map key behind each named role
+const RoleKey ROLE_KEYS[] = {
+    { SystemListModel::NameRole, "name" },
+    { SystemListModel::CategoryRole, "category" },
+    { SystemListModel::CategoryListRole, "categoryList" },
+    { SystemListModel::CategoryColorRole, "categoryColor" },
+    { SystemListModel::DistanceRole, "distanceLy" },
+    { SystemListModel::PoiRole, "poi" },
+    { SystemListModel::DoneRole, "done" },
+    { SystemListModel::ClaimedRole, "claimed" },
+    { SystemListModel::ClaimedByRole, "claimedBy" },
+    { SystemListModel::ImagesRole, "images" },
+    { SystemListModel::XRole, "x" },
+    { SystemListModel::YRole, "y" },
+    { SystemListModel::ZRole, "z" },
+};
+
+QString rowName(const QVariantMap &row)
+{
+    return row.value("name").toString();
+}
+}
+
+SystemListModel::SystemListModel(QObject *parent)
+    : QAbstractListModel(parent)
+{
+}
+
+int SystemListModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_rows.size();
+}
+
+QVariant SystemListModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() < 0 || index.row() >= m_rows.size()) {
+        return QVariant();
+    }
+
+    const QVariantMap &row = m_rows.at(index.row());
+    if (role == SystemDataRole) {
+        return withDisplayFields(row);
+    }
+    if (role == Qt::DisplayRole) {
+        return row.value("name");
+    }
+    if (role == DistanceTextRole) {
+        return formatDistance(row.value("distanceLy", -1.0).toDouble());
+    }
+    for (const RoleKey &roleKey : ROLE_KEYS) {
+        if (roleKey.role == role) {
+            return row.value(QLatin1String(roleKey.key));
+        }
+    }
+    return QVariant();
+}
+
+QHash<int, QByteArray> SystemListModel::roleNames() const
+{
+    QHash<int, QByteArray> roles;
+    roles[SystemDataRole] = "systemData";
+    roles[DistanceTextRole] = "distance";
+    for (const RoleKey &roleKey : ROLE_KEYS) {
+        roles[roleKey.role] = roleKey.key;
+    }
+    return roles;
+}
+
+bool SystemListModel::setSystems(const QVariantList &systems)
+{
+    QVector<QVariantMap> incoming;
+    incoming.reserve(systems.size());
+    QHash<QString, int> incomingByName;
+    incomingByName.reserve(systems.size());
+    bool keyed = m_rowByName.size() == m_rows.size();
+    for (const QVariant &value : systems) {
+        const QVariantMap row = value.toMap();
+        const QString name = rowName(row);
+        if (name.isEmpty() || incomingByName.contains(name)) {
+            keyed = false;
+        } else {
+            incomingByName.insert(name, incoming.size());
+        }
+        incoming.append(row);
+    }
+
+    if (!keyed) {
+        // Rows without a unique name can't be matched up; fall back to a reset
+        if (incoming == m_rows) {
+            return false;
+        }
+        resetRows(incoming);
+        return true;
+    }
+
+    // Rows present on both sides must keep their relative order. Anything else is a
+    // re-rank (a jump moves every distance) and is cheaper to present as a reset.
+    int lastIncomingIndex = -1;
+    for (const QVariantMap &row : m_rows) {
+        const auto it = incomingByName.constFind(rowName(row));
+        if (it == incomingByName.constEnd()) {
+            continue;
+        }
+        if (it.value() < lastIncomingIndex) {
+            resetRows(incoming);
+            return true;
+        }
+        lastIncomingIndex = it.value();
+    }
+
+    const int oldCount = m_rows.size();
+    bool changed = false;
+
+    // Removals, bottom up in contiguous runs
+    for (int last = m_rows.size() - 1; last >= 0; ) {
+        if (incomingByName.contains(rowName(m_rows.at(last)))) {
+            --last;
+            continue;
+        }
+        int first = last;
+        while (first > 0 && !incomingByName.contains(rowName(m_rows.at(first - 1)))) {
+            --first;
+        }
+        beginRemoveRows(QModelIndex(), first, last);
+        m_rows.remove(first, last - first + 1);
+        endRemoveRows();
+        changed = true;
+        last = first - 1;
+    }
+
+    // The survivors now line up with their incoming order: walk both, updating rows in
+    // place and inserting runs of new names in between. m_rowByName still describes the
+    // old contents here, so it tells new names apart from survivors.
+    for (int i = 0; i < incoming.size(); ) {
+        if (i < m_rows.size() && rowName(m_rows.at(i)) == rowName(incoming.at(i))) {
+            const QVector<int> roles = changedRoles(m_rows.at(i), incoming.at(i));
+            if (!roles.isEmpty()) {
+                m_rows[i] = incoming.at(i);
+                const QModelIndex changedIndex = index(i);
+                emit dataChanged(changedIndex, changedIndex, roles);
+                changed = true;
+            }
+            ++i;
+            continue;
+        }
+
+        int last = i;
+        while (last + 1 < incoming.size() && !m_rowByName.contains(rowName(incoming.at(last + 1)))) {
+            ++last;
+        }
+        beginInsertRows(QModelIndex(), i, last);
+        m_rows.insert(i, last - i + 1, QVariantMap());
+        for (int row = i; row <= last; ++row) {
+            m_rows[row] = incoming.at(row);
+        }
+        endInsertRows();
+        changed = true;
+        i = last + 1;
+    }
+
+    rebuildIndex();
+    if (m_rows.size() != oldCount) {
+        emit countChanged();
+    }
+    return changed;
+}
+
+void SystemListModel::appendSystems(const QVariantList &systems)
+{
+    if (systems.isEmpty()) {
+        return;
+    }
+
+    const int first = m_rows.size();
+    const int added = int(systems.size());
+    beginInsertRows(QModelIndex(), first, first + added - 1);
+    m_rows.reserve(first + added);
+    for (const QVariant &value : systems) {
+        const QVariantMap row = value.toMap();
+        const QString name = rowName(row);
+        // A repeated name leaves the index short, and the next setSystems() resets
+        if (!name.isEmpty() && !m_rowByName.contains(name)) {
+            m_rowByName.insert(name, m_rows.size());
+        }
+        m_rows.append(row);
+    }
+    endInsertRows();
+    emit countChanged();
+}
+
+bool SystemListModel::updateSystem(const QString &name, const QVariantMap &fields)
+{
+    const auto it = m_rowByName.constFind(name);
+    if (it == m_rowByName.constEnd()) {
+        return false;
+    }
+
+    const int row = it.value();
+    QVariantMap updated = m_rows.at(row);
+    for (auto field = fields.constBegin(); field != fields.constEnd(); ++field) {
+        updated.insert(field.key(), field.value());
+    }
+    const QVector<int> roles = changedRoles(m_rows.at(row), updated);
+    if (roles.isEmpty()) {
+        return false;
+    }
+    m_rows[row] = updated;
+    const QModelIndex changedIndex = index(row);
+    emit dataChanged(changedIndex, changedIndex, roles);
+    return true;
+}
+
+void SystemListModel::clear()
+{
+    if (!m_rows.isEmpty()) {
+        resetRows(QVector<QVariantMap>());
+    }
+}
+
+QString SystemListModel::formatDistance(double distanceLy)
+{
+    if (distanceLy < 0.0) {
+        return QStringLiteral("N/A");
+    }
+    return QString::number(distanceLy, 'f', 1) + QStringLiteral(" LY");
+}
+
+QVariantMap SystemListModel::get(int row) const
+{
+    if (row < 0 || row >= m_rows.size()) {
+        return QVariantMap();
+    }
+    return withDisplayFields(m_rows.at(row));
+}
+
+int SystemListModel::indexOf(const QString &name) const
+{
+    return m_rowByName.value(name, -1);
+}
+
+QVariantList SystemListModel::toList() const
+{
+    QVariantList list;
+    list.reserve(m_rows.size());
+    for (const QVariantMap &row : m_rows) {
+        list.append(row);
+    }
+    return list;
+}
+
+QVariantMap SystemListModel::withDisplayFields(const QVariantMap &row)
+{
+    QVariantMap display = row;
+    display["distance"] = formatDistance(row.value("distanceLy", -1.0).toDouble());
+    return display;
+}
+
+QVector<int> SystemListModel::changedRoles(const QVariantMap &before, const QVariantMap &after) const
+{
+    if (before == after) {
+        return QVector<int>();
+    }
+
+    // systemData always changes with the row; the named roles only when their key did
+    QVector<int> roles { SystemDataRole };
+    for (const RoleKey &roleKey : ROLE_KEYS) {
+        const QLatin1String key(roleKey.key);
+        if (before.value(key) != after.value(key)) {
+            roles.append(roleKey.role);
+            if (roleKey.role == DistanceRole) {
+                roles.append(DistanceTextRole);
+            }
+        }
+    }
+    return roles;
+}
+
+void SystemListModel::resetRows(const QVector<QVariantMap> &rows)
+{
+    const int oldCount = m_rows.size();
+    beginResetModel();
+    m_rows = rows;
+    rebuildIndex();
+    endResetModel();
+    if (m_rows.size() != oldCount) {
+        emit countChanged();
+    }
+}
+
+void SystemListModel::rebuildIndex()
+{
+    m_rowByName.clear();
+    m_rowByName.reserve(m_rows.size());
+    for (int row = 0; row < m_rows.size(); ++row) {
+        const QString name = rowName(m_rows.at(row));
+        if (!name.isEmpty() && !m_rowByName.contains(name)) {
+            m_rowByName.insert(name, row);
+        }
+    }
+}
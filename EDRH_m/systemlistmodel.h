@@ -0,0 +1,74 @@
+#ifndef SYSTEMLISTMODEL_H
+#define SYSTEMLISTMODEL_H
+
+#include <QAbstractListModel>
+#include <QHash>
+#include <QVector>
+#include <QVariantList>
+#include <QVariantMap>
+
+// List of system rows (the maps EDRHController builds) keyed by system name. setSystems()
+// diffs against the current rows so views only see the rows that actually changed: a
+// claim flip or a new image is one dataChanged, not a rebuild of every delegate.
+// Rows carry distance as a number; the display string is only built for rows a view reads.
+class SystemListModel : public QAbstractListModel
+{
+    Q_OBJECT
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+
+public:
+    enum Roles {
+        SystemDataRole = Qt::UserRole + 1,  // Whole row as a map, for delegates taking systemData
+        NameRole,
+        CategoryRole,
+        CategoryListRole,
+        CategoryColorRole,
+        DistanceRole,                       // distanceLy, numeric (-1 when unknown)
+        DistanceTextRole,                   // "12.3 LY", formatted on read
+        PoiRole,
+        DoneRole,
+        ClaimedRole,
+        ClaimedByRole,
+        ImagesRole,
+        XRole,
+        YRole,
+        ZRole
+    };
+
+    explicit SystemListModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    int count() const { return m_rows.size(); }
+
+    // Replace the contents; returns true if anything changed
+    bool setSystems(const QVariantList &systems);
+    // Add rows at the end without diffing the existing ones (paged loads)
+    void appendSystems(const QVariantList &systems);
+    // Merge fields into one row; returns true if the row exists and changed
+    bool updateSystem(const QString &name, const QVariantMap &fields);
+    void clear();
+
+    // Display text for a distanceLy value
+    static QString formatDistance(double distanceLy);
+
+    Q_INVOKABLE QVariantMap get(int row) const;
+    Q_INVOKABLE int indexOf(const QString &name) const;
+    Q_INVOKABLE QVariantList toList() const;
+
+signals:
+    void countChanged();
+
+private:
+    static QVariantMap withDisplayFields(const QVariantMap &row);
+    QVector<int> changedRoles(const QVariantMap &before, const QVariantMap &after) const;
+    void resetRows(const QVector<QVariantMap> &rows);
+    void rebuildIndex();
+
+    QVector<QVariantMap> m_rows;
+    QHash<QString, int> m_rowByName;
+};
+
+#endif // SYSTEMLISTMODEL_H
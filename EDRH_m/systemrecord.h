@@ -0,0 +1,31 @@
+#ifndef SYSTEMRECORD_H
+#define SYSTEMRECORD_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QMetaType>
+
+// One system in the nearest-systems pipeline. Records are ranked, merged with POI and
+// claim data and handed to the controller as-is; they only become QVariantMaps for QML.
+struct SystemRecord
+{
+    QString name;
+    QStringList categories;     // Raw category names, one per database row for the system
+    double x = 0.0;
+    double y = 0.0;
+    double z = 0.0;
+    double distance = 0.0;      // LY from the reference position
+    QString poi;                // "POI", "Potential POI" or empty
+    bool claimed = false;
+    bool done = false;
+    QString claimedBy;
+    QString images;
+};
+
+using SystemRecordList = QVector<SystemRecord>;
+
+Q_DECLARE_METATYPE(SystemRecord)
+Q_DECLARE_METATYPE(SystemRecordList)
+
+#endif // SYSTEMRECORD_H
@@ -0,0 +1,143 @@
+#include "visitedsystemsindex.h"
+
+namespace {
+
+const int kBitsPerItem = 10;   // ~1% false positives with 7 hashes
+const int kHashCount = 7;
+const int kMinimumItems = 1024;
+
+}
+
+VisitedSystemsIndex::VisitedSystemsIndex()
+    : m_bloomItems(0)
+    , m_bloomEnabled(true)
+{
+    rebuildBloomFilter(kMinimumItems);
+}
+
+QString VisitedSystemsIndex::normalise(const QString &systemName)
+{
+    // System names are case-insensitive in game
+    return systemName.trimmed().toLower();
+}
+
+void VisitedSystemsIndex::insert(const QString &commander, const QString &systemName)
+{
+    if (systemName.isEmpty()) {
+        return;
+    }
+
+    const QString key = normalise(systemName);
+    QSet<QString> &systems = m_systems[commander];
+    if (systems.contains(key)) {
+        return;
+    }
+    systems.insert(key);
+
+    if (m_bloomEnabled) {
+        if (m_bloomItems + 1 > m_bloomBits.size() * 64 / kBitsPerItem) {
+            rebuildBloomFilter((m_bloomItems + 1) * 2);
+        } else {
+            addToBloom(key);
+        }
+    }
+}
+
+bool VisitedSystemsIndex::contains(const QString &commander, const QString &systemName) const
+{
+    const QString key = normalise(systemName);
+    if (m_bloomEnabled && !mightContain(key)) {
+        return false;
+    }
+
+    auto it = m_systems.constFind(commander);
+    return it != m_systems.constEnd() && it->contains(key);
+}
+
+bool VisitedSystemsIndex::containsAnyCommander(const QString &systemName) const
+{
+    const QString key = normalise(systemName);
+    if (m_bloomEnabled && !mightContain(key)) {
+        return false;
+    }
+
+    for (auto it = m_systems.constBegin(); it != m_systems.constEnd(); ++it) {
+        if (it->contains(key)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void VisitedSystemsIndex::clear()
+{
+    m_systems.clear();
+    rebuildBloomFilter(kMinimumItems);
+}
+
+int VisitedSystemsIndex::systemCount() const
+{
+    int total = 0;
+    for (auto it = m_systems.constBegin(); it != m_systems.constEnd(); ++it) {
+        total += it->size();
+    }
+    return total;
+}
+
+void VisitedSystemsIndex::setBloomFilterEnabled(bool enabled)
+{
+    if (m_bloomEnabled == enabled) {
+        return;
+    }
+    m_bloomEnabled = enabled;
+    if (enabled) {
+        rebuildBloomFilter(qMax(kMinimumItems, systemCount() * 2));
+    } else {
+        m_bloomBits.clear();
+        m_bloomItems = 0;
+    }
+}
+
+void VisitedSystemsIndex::rebuildBloomFilter(int expectedItems)
+{
+    const int bitCount = qMax(kMinimumItems, expectedItems) * kBitsPerItem;
+    m_bloomBits.fill(0, (bitCount + 63) / 64);
+    m_bloomItems = 0;
+
+    for (auto it = m_systems.constBegin(); it != m_systems.constEnd(); ++it) {
+        for (const QString &key : *it) {
+            addToBloom(key);
+        }
+    }
+}
+
+void VisitedSystemsIndex::addToBloom(const QString &key)
+{
+    // Double hashing: k probes derived from two independent hashes
+    const quint64 bitCount = quint64(m_bloomBits.size()) * 64;
+    const quint64 h1 = qHash(key, 0x9e3779b9u);
+    const quint64 h2 = qHash(key, 0x85ebca6bu) | 1;
+    for (int i = 0; i < kHashCount; ++i) {
+        const quint64 bit = (h1 + i * h2) % bitCount;
+        m_bloomBits[int(bit / 64)] |= (quint64(1) << (bit % 64));
+    }
+    m_bloomItems++;
+}
+
+bool VisitedSystemsIndex::mightContain(const QString &key) const
+{
+    if (m_bloomBits.isEmpty()) {
+        return true;
+    }
+
+    const quint64 bitCount = quint64(m_bloomBits.size()) * 64;
+    const quint64 h1 = qHash(key, 0x9e3779b9u);
+    const quint64 h2 = qHash(key, 0x85ebca6bu) | 1;
+    for (int i = 0; i < kHashCount; ++i) {
+        const quint64 bit = (h1 + i * h2) % bitCount;
+        if (!(m_bloomBits[int(bit / 64)] & (quint64(1) << (bit % 64)))) {
+            return false;
+        }
+    }
+    return true;
+}
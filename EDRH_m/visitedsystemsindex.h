@@ -0,0 +1,40 @@
+#ifndef VISITEDSYSTEMSINDEX_H
+#define VISITEDSYSTEMSINDEX_H
+
+#include <QString>
+#include <QHash>
+#include <QSet>
+#include <QVector>
+
+// Per-commander set of visited systems built from the journals.
+// Lookups are O(1); an optional Bloom filter answers most "never visited" checks
+// without touching the hash sets at all.
+class VisitedSystemsIndex
+{
+public:
+    VisitedSystemsIndex();
+
+    void insert(const QString &commander, const QString &systemName);
+    bool contains(const QString &commander, const QString &systemName) const;
+    bool containsAnyCommander(const QString &systemName) const;
+    void clear();
+
+    int systemCount() const;
+    int commanderCount() const { return m_systems.size(); }
+
+    void setBloomFilterEnabled(bool enabled);
+    bool bloomFilterEnabled() const { return m_bloomEnabled; }
+
+private:
+    static QString normalise(const QString &systemName);
+    void rebuildBloomFilter(int expectedItems);
+    void addToBloom(const QString &key);
+    bool mightContain(const QString &key) const;
+
+    QHash<QString, QSet<QString>> m_systems;  // Commander -> normalised system names
+    QVector<quint64> m_bloomBits;
+    int m_bloomItems;
+    bool m_bloomEnabled;
+};
+
+#endif // VISITEDSYSTEMSINDEX_H